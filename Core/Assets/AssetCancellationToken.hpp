@@ -0,0 +1,17 @@
+#pragma once
+
+#include <atomic>
+
+namespace Core
+{
+    // Shared between a requester (usually a Scene) and its in-flight loads. Cancelled loads are dropped at the next stage boundary.
+    class AssetCancellationToken
+    {
+    public:
+        void Cancel() { bCancelled.store(true, std::memory_order_release); }
+        bool IsCancelled() const { return bCancelled.load(std::memory_order_acquire); }
+
+    private:
+        std::atomic<bool> bCancelled{false};
+    };
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace sf
+{
+    class Texture;
+    class Font;
+    class SoundBuffer;
+}
+
+namespace Core
+{
+    class TileSheet;
+
+    // Index into the registry's dense array for T, plus the slot generation it was issued for.
+    // A handle to a released asset stays harmless: its generation no longer matches and lookups return nullptr.
+    template <typename T>
+    class AssetHandle
+    {
+    public:
+        AssetHandle() = default;
+        AssetHandle(std::uint32_t InIndex, std::uint32_t InGeneration)
+            : Index(InIndex)
+              , Generation(InGeneration)
+        {
+        }
+
+        std::uint32_t GetIndex() const { return Index; }
+        std::uint32_t GetGeneration() const { return Generation; }
+        bool IsValid() const { return Generation != 0; }
+
+        bool operator==(const AssetHandle& Other) const = default;
+
+    private:
+        std::uint32_t Index = 0;
+        std::uint32_t Generation = 0;
+    };
+
+    using TextureHandle = AssetHandle<sf::Texture>;
+    using FontHandle = AssetHandle<sf::Font>;
+    using SoundHandle = AssetHandle<sf::SoundBuffer>;
+    using TileSheetHandle = AssetHandle<TileSheet>;
+}
+
+namespace std
+{
+    template <typename T>
+    struct hash<Core::AssetHandle<T>>
+    {
+        size_t operator()(const Core::AssetHandle<T>& Handle) const noexcept
+        {
+            return std::hash<std::uint64_t>{}(static_cast<std::uint64_t>(Handle.GetGeneration()) << 32 | Handle.GetIndex());
+        }
+    };
+}
@@ -1,15 +1,16 @@
 ﻿#pragma once
 
+#include <atomic>
+
 namespace Core
 {
     class AssetId
     {
     public:
+        // Each default-constructed id is unique; allocation is atomic so loader threads can create ids
         AssetId()
+            : Id(NextId.fetch_add(1, std::memory_order_relaxed))
         {
-            static int LastId = 0;
-            Id = LastId;
-            ++LastId;
         }
 
         int Get() const { return Id; }
@@ -21,8 +22,17 @@ namespace Core
         static const AssetId Zero;
 
     private:
+        explicit AssetId(int InId)
+            : Id(InId)
+        {
+        }
+
+        inline static std::atomic<int> NextId{1};
+
         int Id;
     };
+
+    inline const AssetId AssetId::Zero{0};
 }
 
 namespace std
@@ -1,9 +1,10 @@
 ﻿#include "AssetLoader.h"
 
+#include "../Systems/AssetPipelineSystem.h"
 #include "../Systems/AssetRegistrySystem.h"
 #include "../Systems/DataAssetRegistrySystem.h"
-#include <future>
-#include "../Async/Awaitable.hpp"
+#include <algorithm>
+#include <utility>
 
 #include "DataAsset.h"
 #include "../Utils/StringUtils.h"
@@ -11,200 +12,379 @@
 #include "Handlers/TextureHandler.h"
 #include "Handlers/FontHandler.h"
 #include "Handlers/SoundHandler.h"
+#include "../Log/Log.h"
 
 
 namespace Core
 {
+    namespace
+    {
+        AssetPipelineSystem::DecodeFunction MakeDecodeFunction(std::shared_ptr<IAssetTypeHandler> Handler)
+        {
+            return [Handler](const AssetLoader::LoadRequest& Request, std::span<const std::byte> Bytes)
+            {
+                return Handler->Decode(Request, Bytes);
+            };
+        }
+
+        AssetPipelineSystem::UploadFunction MakeUploadFunction(std::shared_ptr<IAssetTypeHandler> Handler)
+        {
+            if (!Handler->RequiresUpload())
+            {
+                return nullptr;
+            }
+
+            return [Handler](std::shared_ptr<void> Decoded)
+            {
+                return Handler->Upload(std::move(Decoded));
+            };
+        }
+
+        AssetPipelineSystem::DecodeFunction MakeDataAssetDecodeFunction()
+        {
+            return [](const AssetLoader::LoadRequest& ObjectRequest, std::span<const std::byte> Bytes)
+            {
+                std::optional<DataAsset> LoadedDataAsset = DataAsset::LoadFromMemory(Bytes, ObjectRequest.Path);
+                if (!LoadedDataAsset)
+                {
+                    return std::shared_ptr<DataAsset>();
+                }
+
+                // Dependency edges are found here on the decode worker rather than on the loader's thread
+                for (const ComponentData& Component : LoadedDataAsset->Components)
+                {
+                    AssetLoader::ScanForAssets(Component.Data, LoadedDataAsset->AssetReferences);
+                }
+                return std::make_shared<DataAsset>(std::move(LoadedDataAsset.value()));
+            };
+        }
+    }
+
     AssetLoader::AssetLoader(std::shared_ptr<AssetRegistrySystem> AssetRegistry,
-                             std::shared_ptr<DataAssetRegistrySystem> DataAssetRegistry)
-        : AssetRegistry(std::move(AssetRegistry)), DataAssetRegistry(std::move(DataAssetRegistry))
+                             std::shared_ptr<DataAssetRegistrySystem> DataAssetRegistry,
+                             std::shared_ptr<AssetPipelineSystem> Pipeline)
+        : AssetRegistry(std::move(AssetRegistry))
+          , DataAssetRegistry(std::move(DataAssetRegistry))
+          , Pipeline(std::move(Pipeline))
     {
         RegisterTypeHandlers();
     }
 
-    AssetLoader::~AssetLoader() = default;
+    AssetLoader::~AssetLoader()
+    {
+        // Acquired but never handed to a caller, so nobody else will release them
+        for (AssetId Id : AcquiredIds)
+        {
+            AssetRegistry->Release(Id);
+        }
+    }
 
     void AssetLoader::RegisterTypeHandlers()
     {
-        TypeHandlers[AssetType::Texture] = std::make_unique<TextureHandler>();
-        TypeHandlers[AssetType::Font] = std::make_unique<FontHandler>();
-        TypeHandlers[AssetType::Sound] = std::make_unique<SoundHandler>();
+        TypeHandlers[AssetType::Texture] = std::make_shared<TextureHandler>();
+        TypeHandlers[AssetType::Font] = std::make_shared<FontHandler>();
+        TypeHandlers[AssetType::Sound] = std::make_shared<SoundHandler>();
     }
 
-    void AssetLoader::QueueTexture(const std::string& Path)
+    void AssetLoader::QueueTexture(const std::string& Path, LoadPriority Priority)
     {
-        if (ShouldQueue(Path, AssetType::Texture))
-        {
-            QueuedRequests.push_back({AssetType::Texture, Path});
-        }
+        QueueRequest({.Type = AssetType::Texture, .Path = Path, .Priority = Priority});
+    }
+
+    void AssetLoader::QueueFont(const std::string& Path, unsigned int FontSize, LoadPriority Priority)
+    {
+        QueueRequest({.Type = AssetType::Font, .Path = Path, .FontSize = FontSize, .Priority = Priority});
     }
 
-    void AssetLoader::QueueFont(const std::string& Path, unsigned int FontSize)
+    void AssetLoader::QueueSound(const std::string& Path, LoadPriority Priority)
     {
-        if (ShouldQueue(Path, AssetType::Font))
+        QueueRequest({.Type = AssetType::Sound, .Path = Path, .Priority = Priority});
+    }
+
+    void AssetLoader::QueueObject(const std::string Type)
+    {
+        const std::string Name = ToLowercase(Type);
+
+        // Already decoded by an earlier load; its recorded edges are enough to requeue whatever it references
+        if (DataAssetRegistry->Contains(Name))
         {
-            QueuedRequests.push_back({AssetType::Font, Path, FontSize});
+            QueueReferencedAssets(*DataAssetRegistry->Get(Name));
+            return;
         }
+
+        const std::string ObjectPath = "Game/Assets/Objects/" + Name + ".json";
+
+        // Objects must exist before the scene spawns, so they never wait behind other requests
+        QueueRequest({.Type = AssetType::Object, .Path = ObjectPath, .Priority = LoadPriority::Critical});
     }
 
-    void AssetLoader::QueueSound(const std::string& Path)
+    void AssetLoader::QueueRequest(LoadRequest Request)
     {
-        if (ShouldQueue(Path, AssetType::Sound))
+        Request.Priority = std::max(Request.Priority, PriorityFloor);
+
+        RequestKey Key{Request.Type, Request.Path};
+
+        // Already stored, possibly only cached from an earlier scene: take a reference instead of loading again
+        if (Request.Type != AssetType::Object && !SubmittedRequests.contains(Key))
         {
-            QueuedRequests.push_back({AssetType::Sound, Path});
+            if (AssetId Existing = AssetRegistry->Acquire(Request.Path); Existing.IsValid())
+            {
+                AcquiredIds.push_back(Existing);
+                SubmittedRequests.insert(std::move(Key));
+                return;
+            }
         }
+
+        if (SubmittedRequests.contains(Key))
+        {
+            return;
+        }
+
+        // A second reference can only make an asset more urgent
+        if (auto Existing = QueuedIndex.find(Key); Existing != QueuedIndex.end())
+        {
+            LoadPriority& QueuedPriority = QueuedRequests[Existing->second].Priority;
+            QueuedPriority = std::min(QueuedPriority, Request.Priority);
+            return;
+        }
+
+        QueuedIndex.emplace(std::move(Key), QueuedRequests.size());
+        QueuedRequests.push_back(std::move(Request));
     }
 
-    void AssetLoader::QueueObject(const std::string Type)
+    void AssetLoader::QueueReferencedAssets(const DataAsset& Asset)
     {
-        const std::string ObjectPath = "Game/Assets/Objects/" + ToLowercase(Type) + ".json";
-
-        if (ShouldQueue(ObjectPath, AssetType::Object))
+        for (const std::string& Path : Asset.AssetReferences)
         {
-            QueuedRequests.push_back({AssetType::Object, ObjectPath});
+            switch (GetAssetTypeFromExtension(Path))
+            {
+            case AssetType::Texture:
+                QueueTexture(Path);
+                break;
+            case AssetType::Sound:
+                QueueSound(Path);
+                break;
+            case AssetType::Font:
+                QueueFont(Path);
+                break;
+            default:
+                break;
+            }
         }
     }
 
     void AssetLoader::Clear()
     {
         QueuedRequests.clear();
+        QueuedIndex.clear();
+    }
+
+    void AssetLoader::SetCancellationToken(std::shared_ptr<const AssetCancellationToken> Token)
+    {
+        CancellationToken = std::move(Token);
+    }
+
+    std::size_t AssetLoader::RequestKeyHash::operator()(const RequestKey& Key) const
+    {
+        const std::size_t PathHash = std::hash<std::string>{}(Key.Path);
+        return PathHash ^ (static_cast<std::size_t>(Key.Type) + 0x9e3779b9 + (PathHash << 6) + (PathHash >> 2));
     }
 
-    void AssetLoader::SeparateRequestsByType(
-        std::vector<LoadRequest>& OutObjectRequests,
-        std::vector<LoadRequest>& OutBinaryRequests)
+    std::vector<AssetLoader::LoadRequest> AssetLoader::TakeQueuedRequests(LoadPriority MaxPriority,
+                                                                          bool bIncludeObjects)
     {
-        for (const auto& Request : QueuedRequests)
+        std::vector<LoadRequest> Taken;
+        std::erase_if(QueuedRequests, [&](LoadRequest& Request)
         {
-            if (Request.Type == AssetType::Object)
+            if (Request.Priority > MaxPriority || (!bIncludeObjects && Request.Type == AssetType::Object))
             {
-                OutObjectRequests.push_back(Request);
+                return false;
             }
-            else
+            SubmittedRequests.insert({Request.Type, Request.Path});
+            Taken.push_back(std::move(Request));
+            return true;
+        });
+
+        if (!Taken.empty())
+        {
+            QueuedIndex.clear();
+            for (std::size_t Index = 0; Index < QueuedRequests.size(); ++Index)
             {
-                OutBinaryRequests.push_back(Request);
+                QueuedIndex.emplace(RequestKey{QueuedRequests[Index].Type, QueuedRequests[Index].Path}, Index);
             }
         }
+        return Taken;
     }
 
-    Task<std::vector<AssetLoader::LoadedAsset>> AssetLoader::LoadAssetsInParallel(
-        const std::vector<LoadRequest>& Requests)
+    void AssetLoader::SubmitQueued(LoadPriority MaxPriority, std::deque<LoadAwaiter>& OutLoads)
     {
-        std::vector<std::future<LoadedAsset>> Futures;
-        Futures.reserve(Requests.size());
-
-        for (const auto& Request : Requests)
+        const std::vector<LoadRequest> Requests = TakeQueuedRequests(MaxPriority, true);
+        for (const LoadRequest& Request : Requests)
         {
-            Futures.push_back(std::async(std::launch::async, [this, Request]()
-            {
-                LoadedAsset Asset = LoadAsset(Request);
-                ++CompletedCount;
-                return Asset;
-            }));
+            OutLoads.push_back(SubmitToPipeline(Request));
         }
+        TotalCount += static_cast<int>(Requests.size());
+    }
 
-        std::vector<LoadedAsset> Results;
-        Results.reserve(Futures.size());
-        for (auto& Future : Futures)
+    void AssetLoader::ProcessLoadedDataAsset(const LoadedAsset& Result)
+    {
+        if (!Result.Success)
         {
-            Results.push_back(co_await Future);
+            if (!Result.Cancelled)
+            {
+                Log::Warning(ELogCategory::Assets, "Could not load DataAsset: %s", Result.Path.c_str());
+            }
+            return;
         }
 
-        co_return Results;
+        auto LoadedDataAsset = std::static_pointer_cast<DataAsset>(Result.Data);
+        DataAssetRegistry->Store(LoadedDataAsset->Name, LoadedDataAsset);
+        QueueReferencedAssets(*LoadedDataAsset);
     }
 
-    void AssetLoader::ProcessLoadedDataAssets(const std::vector<LoadedAsset>& LoadedAssets)
+    std::optional<AssetId> AssetLoader::ProcessLoadedBinaryAsset(const LoadedAsset& Result)
     {
-        for (const auto& Result : LoadedAssets)
+        if (!Result.Success)
         {
-            if (Result.Success)
+            if (!Result.Cancelled)
             {
-                auto LoadedDataAsset = std::static_pointer_cast<DataAsset>(Result.Data);
-                DataAssetRegistry->Store(LoadedDataAsset->Name, LoadedDataAsset);
-
-                for (const auto& Component : LoadedDataAsset->Components)
-                {
-                    std::vector<AssetReference> DiscoveredAssets;
-                    ScanForAssets(Component.Data, DiscoveredAssets);
-
-                    for (const auto& AssetRef : DiscoveredAssets)
-                    {
-                        switch (AssetRef.Type)
-                        {
-                        case AssetType::Texture:
-                            QueueTexture(AssetRef.Path);
-                            break;
-                        case AssetType::Sound:
-                            QueueSound(AssetRef.Path);
-                            break;
-                        case AssetType::Font:
-                            QueueFont(AssetRef.Path);
-                            break;
-                        default:
-                            break;
-                        }
-                    }
-                }
-            }
-            else
-            {
-                std::printf("Could not load DataAsset: %s\n", Result.Path.c_str());
+                Log::Warning(ELogCategory::Assets, "Could not load asset with path: %s", Result.Path.c_str());
             }
+            return std::nullopt;
+        }
+
+        auto HandlerIt = TypeHandlers.find(Result.Type);
+        if (HandlerIt == TypeHandlers.end())
+        {
+            return std::nullopt;
         }
+        return HandlerIt->second->Store(Result.Data, Result.Path, *AssetRegistry);
     }
 
-    std::vector<AssetId> AssetLoader::ProcessLoadedBinaryAssets(const std::vector<LoadedAsset>& LoadedAssets)
+    Task<std::vector<AssetId>> AssetLoader::LoadAllAsync()
     {
-        std::vector<AssetId> LoadedIds;
+        TotalCount = 0;
+        CompletedCount = 0;
+
+        std::vector<AssetId> AllLoadedIds = co_await LoadQueuedAsync(LoadPriority::Background);
 
-        for (const auto& Result : LoadedAssets)
+        Clear();
+        co_return AllLoadedIds;
+    }
+
+    Task<std::vector<AssetId>> AssetLoader::LoadQueuedAsync(LoadPriority MaxPriority)
+    {
+        // Deque so loads already being awaited stay put while newly discovered dependencies are appended
+        std::deque<LoadAwaiter> Loads;
+        SubmitQueued(MaxPriority, Loads);
+
+        std::vector<AssetId> LoadedIds;
+        for (std::size_t Index = 0; Index < Loads.size(); ++Index)
         {
-            if (Result.Success)
+            const LoadedAsset Result = co_await Loads[Index];
+            ++CompletedCount;
+
+            if (Result.Type == AssetType::Object)
             {
-                auto HandlerIt = TypeHandlers.find(Result.Type);
-                if (HandlerIt != TypeHandlers.end())
-                {
-                    AssetId Id = HandlerIt->second->Store(Result.Data, Result.Path, *AssetRegistry);
-                    LoadedIds.push_back(Id);
-                }
+                ProcessLoadedDataAsset(Result);
+                SubmitQueued(MaxPriority, Loads);
             }
-            else
+            else if (std::optional<AssetId> Id = ProcessLoadedBinaryAsset(Result))
             {
-                std::printf("Could not load asset with path: %s\n", Result.Path.c_str());
+                LoadedIds.push_back(*Id);
             }
         }
 
-        return LoadedIds;
+        LoadedIds.insert(LoadedIds.end(), AcquiredIds.begin(), AcquiredIds.end());
+        AcquiredIds.clear();
+
+        co_return LoadedIds;
     }
 
-    Task<std::vector<AssetId>> AssetLoader::LoadAllAsync()
+    std::size_t AssetLoader::StreamQueued(std::function<void(AssetId)> OnStored)
     {
-        TotalCount = static_cast<int>(QueuedRequests.size());
-        CompletedCount = 0;
+        const std::vector<LoadRequest> BinaryRequests = TakeQueuedRequests(LoadPriority::Background, false);
 
-        std::vector<LoadRequest> ObjectRequests;
-        std::vector<LoadRequest> BinaryRequests;
-        SeparateRequestsByType(ObjectRequests, BinaryRequests);
+        for (const LoadRequest& Request : BinaryRequests)
+        {
+            auto HandlerIt = TypeHandlers.find(Request.Type);
+            if (HandlerIt == TypeHandlers.end())
+            {
+                Log::Warning(ELogCategory::Assets, "Could not stream asset with unknown type: %s", Request.Path.c_str());
+                continue;
+            }
+
+            std::shared_ptr<IAssetTypeHandler> Handler = HandlerIt->second;
+            LoadRequest StreamedRequest = Request;
+            StreamedRequest.CancellationToken = CancellationToken;
+
+            Pipeline->SubmitStreaming(StreamedRequest, MakeDecodeFunction(Handler), MakeUploadFunction(Handler),
+                                      [Handler, Registry = AssetRegistry, OnStored](const LoadedAsset& Result)
+                                      {
+                                          if (!Result.Success)
+                                          {
+                                              Log::Warning(ELogCategory::Assets, "Could not stream asset with path: %s", Result.Path.c_str());
+                                              return;
+                                          }
+
+                                          const AssetId Id = Handler->Store(Result.Data, Result.Path, *Registry);
+                                          if (OnStored)
+                                          {
+                                              OnStored(Id);
+                                          }
+                                      });
+        }
 
-        std::vector<LoadedAsset> LoadedDataAssets = co_await LoadAssetsInParallel(ObjectRequests);
-        ProcessLoadedDataAssets(LoadedDataAssets);
+        return BinaryRequests.size();
+    }
 
-        TotalCount = static_cast<int>(QueuedRequests.size());
+    void AssetLoader::StreamReload(AssetType Type, const std::string& Path, std::function<void(const LoadedAsset&)> OnReloaded)
+    {
+        const LoadRequest Request{.Type = Type, .Path = Path};
 
-        BinaryRequests.clear();
-        for (const auto& Request : QueuedRequests)
+        if (Type == AssetType::Object)
         {
-            if (Request.Type != AssetType::Object)
-            {
-                BinaryRequests.push_back(Request);
-            }
+            Pipeline->SubmitStreaming(Request, MakeDataAssetDecodeFunction(), nullptr,
+                                      [Registry = DataAssetRegistry, OnReloaded](const LoadedAsset& Result)
+                                      {
+                                          if (!Result.Success)
+                                          {
+                                              Log::Warning(ELogCategory::Assets, "Could not reload asset with path: %s", Result.Path.c_str());
+                                              return;
+                                          }
+
+                                          auto Reloaded = std::static_pointer_cast<DataAsset>(Result.Data);
+                                          Registry->Store(Reloaded->Name, Reloaded);
+                                          if (OnReloaded)
+                                          {
+                                              OnReloaded(Result);
+                                          }
+                                      });
+            return;
         }
 
-        std::vector<LoadedAsset> LoadedBinaryAssets = co_await LoadAssetsInParallel(BinaryRequests);
-        std::vector<AssetId> AllLoadedIds = ProcessLoadedBinaryAssets(LoadedBinaryAssets);
+        auto HandlerIt = TypeHandlers.find(Type);
+        if (HandlerIt == TypeHandlers.end())
+        {
+            Log::Warning(ELogCategory::Assets, "Could not reload asset with unknown type: %s", Path.c_str());
+            return;
+        }
 
-        QueuedRequests.clear();
-        co_return AllLoadedIds;
+        std::shared_ptr<IAssetTypeHandler> Handler = HandlerIt->second;
+        Pipeline->SubmitStreaming(Request, MakeDecodeFunction(Handler), MakeUploadFunction(Handler),
+                                  [Handler, Registry = AssetRegistry, OnReloaded](const LoadedAsset& Result)
+                                  {
+                                      if (!Result.Success || !Handler->Replace(Result.Data, Result.Path, *Registry))
+                                      {
+                                          Log::Warning(ELogCategory::Assets, "Could not reload asset with path: %s", Result.Path.c_str());
+                                          return;
+                                      }
+
+                                      if (OnReloaded)
+                                      {
+                                          OnReloaded(Result);
+                                      }
+                                  });
     }
 
     float AssetLoader::GetProgress() const
@@ -223,15 +403,11 @@ namespace Core
             return false;
         }
 
-        // :TODO: Usage of this func can be made more performant instead of iterating through all the queued requests
-        // for each asset to be loaded at least once.
-        return !std::any_of(QueuedRequests.begin(), QueuedRequests.end(), [&](const LoadRequest& Request)
-        {
-            return Type == Request.Type && Request.Path == Path;
-        });
+        const RequestKey Key{Type, Path};
+        return !QueuedIndex.contains(Key) && !SubmittedRequests.contains(Key);
     }
 
-    AssetLoader::AssetType AssetLoader::GetAssetTypeFromExtension(const std::string& Path) const
+    AssetLoader::AssetType AssetLoader::GetAssetTypeFromExtension(const std::string& Path)
     {
         if (Path.ends_with(".png") || Path.ends_with(".jpg") ||
             Path.ends_with(".jpeg") || Path.ends_with(".bmp"))
@@ -250,67 +426,96 @@ namespace Core
         return AssetType::Invalid;
     }
 
-    void AssetLoader::ScanForAssets(const nlohmann::json& Data, std::vector<AssetReference>& OutAssets)
+    void AssetLoader::ScanForAssets(const nlohmann::json& Data, std::vector<std::string>& OutPaths)
     {
         if (Data.is_string())
         {
-            std::string str = Data.get<std::string>();
-            AssetType type = GetAssetTypeFromExtension(str);
-            if (type != AssetType::Invalid)
+            const std::string& str = Data.get_ref<const std::string&>();
+            if (GetAssetTypeFromExtension(str) != AssetType::Invalid &&
+                std::find(OutPaths.begin(), OutPaths.end(), str) == OutPaths.end())
             {
-                OutAssets.push_back({str, type});
+                OutPaths.push_back(str);
             }
         }
         else if (Data.is_object())
         {
-            for (auto& [Key, value] : Data.items())
+            for (const auto& [Key, value] : Data.items())
             {
-                ScanForAssets(value, OutAssets);
+                ScanForAssets(value, OutPaths);
             }
         }
         else if (Data.is_array())
         {
-            for (auto& Element : Data)
+            for (const auto& Element : Data)
             {
-                ScanForAssets(Element, OutAssets);
+                ScanForAssets(Element, OutPaths);
             }
         }
 
         // Don't check primitives e.g., ints and don't recurse further
     }
 
-    AssetLoader::LoadedAsset AssetLoader::LoadAsset(const LoadRequest& Request)
+    AssetLoader::LoadAwaiter AssetLoader::SubmitToPipeline(const LoadRequest& QueuedRequest)
     {
+        LoadRequest Request = QueuedRequest;
+        Request.CancellationToken = CancellationToken;
+
         if (Request.Type == AssetType::Object)
         {
-            LoadedAsset Result;
-            Result.Type = Request.Type;
-            Result.Path = Request.Path;
-            Result.Success = false;
-
-            if (std::optional<DataAsset> LoadedDataAsset = DataAsset::LoadFromFile(Request.Path))
-            {
-                Result.Data = std::make_shared<DataAsset>(std::move(LoadedDataAsset.value()));
-                Result.Success = true;
-            }
-            else
-            {
-                Result.ErrorMessage = "Failed to load asset";
-            }
-            return Result;
+            return Pipeline->Submit(Request, MakeDataAssetDecodeFunction());
         }
 
         auto HandlerIt = TypeHandlers.find(Request.Type);
         if (HandlerIt != TypeHandlers.end())
         {
-            return HandlerIt->second->Load(Request);
+            return Pipeline->Submit(Request, MakeDecodeFunction(HandlerIt->second), MakeUploadFunction(HandlerIt->second));
         }
 
-        LoadedAsset Result;
-        Result.Type = Request.Type;
-        Result.Path = Request.Path;
-        Result.Success = false;
-        Result.ErrorMessage = "Unknown asset type";
-        return Result;
+        auto State = std::make_shared<PendingLoad>();
+        State->Complete({.Type = Request.Type,
+                         .Path = Request.Path,
+                         .Data = nullptr,
+                         .Success = false,
+                         .ErrorMessage = "Unknown asset type",
+                         .Cancelled = false});
+        return LoadAwaiter{std::move(State)};
+    }
+
+    void AssetLoader::PendingLoad::Complete(LoadedAsset InResult)
+    {
+        std::coroutine_handle<> Awaiting;
+        {
+            std::lock_guard Lock(Mutex);
+            Result = std::move(InResult);
+            Awaiting = std::exchange(Continuation, nullptr);
+        }
+
+        if (Awaiting)
+        {
+            Awaiting.resume();
+        }
+    }
+
+    bool AssetLoader::LoadAwaiter::await_ready() const
+    {
+        std::lock_guard Lock(State->Mutex);
+        return State->Result.has_value();
+    }
+
+    bool AssetLoader::LoadAwaiter::await_suspend(std::coroutine_handle<> Handle)
+    {
+        // The job may have finished since await_ready; then carry on without suspending
+        std::lock_guard Lock(State->Mutex);
+        if (State->Result)
+        {
+            return false;
+        }
+        State->Continuation = Handle;
+        return true;
+    }
+
+    AssetLoader::LoadedAsset AssetLoader::LoadAwaiter::await_resume()
+    {
+        return std::move(*State->Result);
     }
 }
@@ -1,19 +1,29 @@
 ﻿#pragma once
 
+#include <atomic>
+#include <coroutine>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "../Async/Task.hpp"
 #include "AssetId.hpp"
+#include "AssetCancellationToken.hpp"
 #include "../ThirdParty/json.hpp"
 
 namespace Core
 {
     class AssetRegistrySystem;
+    class AssetPipelineSystem;
     class DataAssetRegistrySystem;
     class IAssetTypeHandler;
+    struct DataAsset;
 }
 
 namespace Core
@@ -30,11 +40,24 @@ namespace Core
             Object
         };
 
+        // Lower values are read, decoded and uploaded first
+        enum class LoadPriority
+        {
+            Critical,
+            Visible,
+            NearCamera,
+            Background
+        };
+
+        static constexpr std::size_t LoadPriorityCount = 4;
+
         struct LoadRequest
         {
             AssetType Type;
             std::string Path;
             unsigned int FontSize = 16;
+            LoadPriority Priority = LoadPriority::Visible;
+            std::shared_ptr<const AssetCancellationToken> CancellationToken = nullptr;
         };
 
         struct LoadedAsset
@@ -44,62 +67,122 @@ namespace Core
             std::shared_ptr<void> Data;
             bool Success;
             std::string ErrorMessage;
+            bool Cancelled = false;
+        };
+
+        // Shared between a submitted job and whoever awaits it
+        struct PendingLoad
+        {
+            std::mutex Mutex;
+            std::optional<LoadedAsset> Result;
+            std::coroutine_handle<> Continuation;
+
+            // Resumes the awaiting coroutine on the calling thread, if it is already suspended
+            void Complete(LoadedAsset InResult);
+        };
+
+        // Awaits a load without a thread of its own: the pipeline resumes the coroutine from whichever of its
+        // threads finishes the last stage
+        struct LoadAwaiter
+        {
+            std::shared_ptr<PendingLoad> State;
+
+            bool await_ready() const;
+            bool await_suspend(std::coroutine_handle<> Handle);
+            LoadedAsset await_resume();
         };
 
         AssetLoader(std::shared_ptr<AssetRegistrySystem> AssetRegistry,
-                    std::shared_ptr<DataAssetRegistrySystem> DataAssetRegistry);
+                    std::shared_ptr<DataAssetRegistrySystem> DataAssetRegistry,
+                    std::shared_ptr<AssetPipelineSystem> Pipeline);
         ~AssetLoader();
 
-        void QueueTexture(const std::string& Path);
-        void QueueFont(const std::string& Path, unsigned int FontSize = 16);
-        void QueueSound(const std::string& Path);
+        void QueueTexture(const std::string& Path, LoadPriority Priority = LoadPriority::Visible);
+        void QueueFont(const std::string& Path, unsigned int FontSize = 16, LoadPriority Priority = LoadPriority::Visible);
+        void QueueSound(const std::string& Path, LoadPriority Priority = LoadPriority::Visible);
         void QueueObject(std::string Type);
 
         void Clear();
 
+        // Applied to every request submitted afterwards
+        void SetCancellationToken(std::shared_ptr<const AssetCancellationToken> Token);
+
+        // Requests queued afterwards are never more urgent than Floor, e.g. Background for prefetching
+        void SetPriorityFloor(LoadPriority Floor) { PriorityFloor = Floor; }
+
         Task<std::vector<AssetId>> LoadAllAsync();
 
+        // Loads every queued request at or above MaxPriority and waits for them. Assets referenced by a DataAsset are
+        // queued as soon as that DataAsset decodes, and started right away if they fall within MaxPriority.
+        Task<std::vector<AssetId>> LoadQueuedAsync(LoadPriority MaxPriority);
+
+        // Submits the remaining queued requests without waiting. OnStored runs on the main thread as each asset lands
+        // in the registry; nothing is stored once the cancellation token fires.
+        std::size_t StreamQueued(std::function<void(AssetId)> OnStored);
+
+        // Reads an already loaded asset again through its handler and swaps it in place in the registry, keeping its
+        // id and handles; DataAssets replace their registry entry. OnReloaded runs on the main thread after the swap.
+        void StreamReload(AssetType Type, const std::string& Path, std::function<void(const LoadedAsset&)> OnReloaded);
+
         float GetProgress() const;
         int GetCompletedCount() const { return CompletedCount; }
 
         bool ShouldQueue(const std::string& Path, AssetType Type) const;
 
+        static AssetType GetAssetTypeFromExtension(const std::string& Path);
+
+        // Collects every texture, font and sound path referenced anywhere in Data, without duplicates
+        static void ScanForAssets(const nlohmann::json& Data, std::vector<std::string>& OutPaths);
+
     private:
-        struct AssetReference
+        struct RequestKey
         {
-            std::string Path;
             AssetType Type;
-        };
+            std::string Path;
 
-        AssetType GetAssetTypeFromExtension(const std::string& Path) const;
-        void ScanForAssets(const nlohmann::json& Data, std::vector<AssetReference>& OutAssets);
+            bool operator==(const RequestKey& Other) const = default;
+        };
 
-        void SeparateRequestsByType(
-            std::vector<LoadRequest>& OutObjectRequests,
-            std::vector<LoadRequest>& OutBinaryRequests
-        );
+        struct RequestKeyHash
+        {
+            std::size_t operator()(const RequestKey& Key) const;
+        };
 
-        Task<std::vector<LoadedAsset>> LoadAssetsInParallel(
-            const std::vector<LoadRequest>& Requests
-        );
+        void QueueRequest(LoadRequest Request);
+        void QueueReferencedAssets(const DataAsset& Asset);
 
-        void ProcessLoadedDataAssets(const std::vector<LoadedAsset>& LoadedAssets);
+        std::vector<LoadRequest> TakeQueuedRequests(LoadPriority MaxPriority, bool bIncludeObjects);
+        void SubmitQueued(LoadPriority MaxPriority, std::deque<LoadAwaiter>& OutLoads);
 
-        std::vector<AssetId> ProcessLoadedBinaryAssets(const std::vector<LoadedAsset>& LoadedAssets);
+        void ProcessLoadedDataAsset(const LoadedAsset& Result);
+        std::optional<AssetId> ProcessLoadedBinaryAsset(const LoadedAsset& Result);
 
         void RegisterTypeHandlers();
 
     private:
-        std::unordered_map<AssetType, std::unique_ptr<IAssetTypeHandler>> TypeHandlers;
+        // Shared so streamed requests can outlive the loader that submitted them
+        std::unordered_map<AssetType, std::shared_ptr<IAssetTypeHandler>> TypeHandlers;
 
         std::shared_ptr<AssetRegistrySystem> AssetRegistry;
         std::shared_ptr<DataAssetRegistrySystem> DataAssetRegistry;
+        std::shared_ptr<AssetPipelineSystem> Pipeline;
 
+        // Requests in queue order, with a (type, path) index for O(1) dedup and priority promotion
         std::vector<LoadRequest> QueuedRequests;
+        std::unordered_map<RequestKey, std::size_t, RequestKeyHash> QueuedIndex;
+
+        // Everything this loader has handed to the pipeline, so a dependency discovered late is never submitted twice
+        std::unordered_set<RequestKey, RequestKeyHash> SubmittedRequests;
+
+        std::shared_ptr<const AssetCancellationToken> CancellationToken;
+        LoadPriority PriorityFloor = LoadPriority::Critical;
+
+        // References taken on already-stored assets at queue time, handed back with the next batch of loaded ids
+        std::vector<AssetId> AcquiredIds;
 
         std::atomic<int> CompletedCount{0};
         std::atomic<int> TotalCount{0};
 
-        LoadedAsset LoadAsset(const LoadRequest& Request);
+        LoadAwaiter SubmitToPipeline(const LoadRequest& Request);
     };
 }
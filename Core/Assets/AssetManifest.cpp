@@ -1,14 +1,36 @@
 #include "AssetManifest.h"
 
-#include <fstream>
-#include <cstdio>
 
+#include "CookedJsonCache.h"
+#include "MappedFile.h"
 #include "../ThirdParty/json.hpp"
+#include "../Log/Log.h"
 
 using json = nlohmann::json;
 
 namespace Core
 {
+    namespace
+    {
+        AssetLoader::LoadPriority ParsePriority(const nlohmann::json& EntryJson)
+        {
+            const std::string Priority = EntryJson.value("priority", "visible");
+            if (Priority == "critical")
+            {
+                return AssetLoader::LoadPriority::Critical;
+            }
+            if (Priority == "near")
+            {
+                return AssetLoader::LoadPriority::NearCamera;
+            }
+            if (Priority == "background")
+            {
+                return AssetLoader::LoadPriority::Background;
+            }
+            return AssetLoader::LoadPriority::Visible;
+        }
+    }
+
     AssetManifest AssetManifest::FromJson(const nlohmann::json& Data, const std::string& basePath)
     {
         AssetManifest Manifest;
@@ -22,6 +44,7 @@ namespace Core
                 Entry.Id = FontJson.value("id", "");
                 Entry.Path = basePath + FontJson.value("path", "");
                 Entry.Size = FontJson.value("size", 16);
+                Entry.Priority = ParsePriority(FontJson);
 
                 if (!Entry.Path.empty())
                 {
@@ -38,6 +61,7 @@ namespace Core
                 AssetEntry Entry;
                 Entry.Id = TextureJson.value("id", "");
                 Entry.Path = basePath + TextureJson.value("path", "");
+                Entry.Priority = ParsePriority(TextureJson);
 
                 if (!Entry.Path.empty())
                 {
@@ -54,6 +78,7 @@ namespace Core
                 AssetEntry Entry;
                 Entry.Id = SoundJson.value("id", "");
                 Entry.Path = basePath + SoundJson.value("path", "");
+                Entry.Priority = ParsePriority(SoundJson);
 
                 if (!Entry.Path.empty())
                 {
@@ -79,27 +104,58 @@ namespace Core
 
     AssetManifest AssetManifest::LoadFromFile(const std::string& path, const std::string& basePath)
     {
-        std::ifstream File(path);
-        if (!File.is_open())
+        std::unique_ptr<MappedFile> File = MappedFile::Open(path);
+        if (!File)
+        {
+            Log::Error(ELogCategory::Assets, "Failed to open asset manifest: %s", path.c_str());
+            return AssetManifest{};
+        }
+
+        std::optional<json> Data = CookedJsonCache::Load(path, File->GetBytes());
+        if (!Data)
+        {
+            return AssetManifest{};
+        }
+
+        try
+        {
+            AssetManifest Manifest = FromJson(*Data, basePath);
+
+            Log::Verbose(ELogCategory::Assets, "Loaded asset manifest: %s (%zu fonts, %zu textures, %zu sounds, %zu objects)",
+                         path.c_str(), Manifest.Fonts.size(), Manifest.Textures.size(), Manifest.Sounds.size(),
+                         Manifest.Objects.size());
+
+            return Manifest;
+        }
+        catch (const json::exception& E)
+        {
+            Log::Error(ELogCategory::Assets, "Failed to parse asset manifest %s: %s", path.c_str(), E.what());
+            return AssetManifest{};
+        }
+    }
+
+    AssetManifest AssetManifest::LoadFromMemory(std::span<const std::byte> Bytes, const std::string& path,
+                                                const std::string& basePath)
+    {
+        std::optional<json> Data = CookedJsonCache::Load(path, Bytes);
+        if (!Data)
         {
-            std::printf("Failed to open asset manifest: %s\n", path.c_str());
             return AssetManifest{};
         }
 
         try
         {
-            json Data = json::parse(File);
-            AssetManifest Manifest = FromJson(Data, basePath);
+            AssetManifest Manifest = FromJson(*Data, basePath);
 
-            std::printf("Loaded asset manifest: %s (%zu fonts, %zu textures, %zu sounds, %zu objects)\n",
-                        path.c_str(), Manifest.Fonts.size(), Manifest.Textures.size(), Manifest.Sounds.size(),
-                        Manifest.Objects.size());
+            Log::Verbose(ELogCategory::Assets, "Loaded packed asset manifest: %s (%zu fonts, %zu textures, %zu sounds, %zu objects)",
+                         path.c_str(), Manifest.Fonts.size(), Manifest.Textures.size(), Manifest.Sounds.size(),
+                         Manifest.Objects.size());
 
             return Manifest;
         }
         catch (const json::exception& E)
         {
-            std::printf("Failed to parse asset manifest %s: %s\n", path.c_str(), E.what());
+            Log::Error(ELogCategory::Assets, "Failed to parse asset manifest %s: %s", path.c_str(), E.what());
             return AssetManifest{};
         }
     }
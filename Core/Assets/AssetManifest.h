@@ -1,8 +1,10 @@
 #pragma once
 
+#include <span>
 #include <string>
 #include <vector>
 
+#include "AssetLoader.h"
 #include "../ThirdParty/json.hpp"
 #include "../World/WorldEnvironment.h"
 
@@ -13,6 +15,9 @@ namespace Core
         std::string Id;
         std::string Path;
         unsigned int Size = 16;
+
+        // "critical" entries load before the scene becomes interactive; the rest stream in afterwards
+        AssetLoader::LoadPriority Priority = AssetLoader::LoadPriority::Visible;
     };
 
     struct ObjectEntry
@@ -30,5 +35,7 @@ namespace Core
 
         static AssetManifest FromJson(const nlohmann::json& Data, const std::string& basePath = "");
         static AssetManifest LoadFromFile(const std::string& path, const std::string& basePath = "");
+        static AssetManifest LoadFromMemory(std::span<const std::byte> Bytes, const std::string& path,
+                                            const std::string& basePath = "");
     };
 }
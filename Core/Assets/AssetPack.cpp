@@ -0,0 +1,149 @@
+#include "AssetPack.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "LzCompression.h"
+#include "../Log/Log.h"
+
+namespace Core
+{
+    std::unique_ptr<AssetPack> AssetPack::Open(const std::string& Path)
+    {
+        std::unique_ptr<MappedFile> File = MappedFile::Open(Path);
+        if (!File)
+        {
+            return nullptr;
+        }
+
+        const std::span<const std::byte> Bytes = File->GetBytes();
+
+        AssetPackFormat::Header Header;
+        if (Bytes.size() < sizeof(Header))
+        {
+            Log::Error(ELogCategory::Assets, "Asset pack too small: %s", Path.c_str());
+            return nullptr;
+        }
+        std::memcpy(&Header, Bytes.data(), sizeof(Header));
+
+        if (Header.Magic != AssetPackFormat::Magic || Header.Version != AssetPackFormat::Version)
+        {
+            Log::Error(ELogCategory::Assets, "Asset pack has an unsupported format: %s", Path.c_str());
+            return nullptr;
+        }
+
+        const std::uint64_t IndexSize = static_cast<std::uint64_t>(Header.EntryCount) * sizeof(AssetPackFormat::Entry);
+        if (Header.IndexOffset % alignof(AssetPackFormat::Entry) != 0 || Header.IndexOffset > Bytes.size() ||
+            IndexSize > Bytes.size() - Header.IndexOffset || Header.PathsOffset > Bytes.size())
+        {
+            Log::Error(ELogCategory::Assets, "Asset pack index is out of bounds: %s", Path.c_str());
+            return nullptr;
+        }
+
+        std::unique_ptr<AssetPack> Pack(new AssetPack());
+        Pack->Entries = {reinterpret_cast<const AssetPackFormat::Entry*>(Bytes.data() + Header.IndexOffset), Header.EntryCount};
+        Pack->Paths = {reinterpret_cast<const char*>(Bytes.data() + Header.PathsOffset), Bytes.size() - Header.PathsOffset};
+        Pack->PackPath = Path;
+
+        for (const AssetPackFormat::Entry& Entry : Pack->Entries)
+        {
+            if (Entry.Offset > Bytes.size() || Entry.StoredSize > Bytes.size() - Entry.Offset ||
+                static_cast<std::uint64_t>(Entry.PathOffset) + Entry.PathLength > Pack->Paths.size())
+            {
+                Log::Error(ELogCategory::Assets, "Asset pack entry is out of bounds: %s", Path.c_str());
+                return nullptr;
+            }
+        }
+
+        Pack->File = std::move(File);
+
+        Log::Info(ELogCategory::Assets, "Mounted asset pack: %s (%zu entries, %s)", Path.c_str(), Pack->Entries.size(),
+                  Pack->File->IsMapped() ? "mapped" : "buffered");
+        return Pack;
+    }
+
+    bool AssetPack::Contains(std::string_view Path) const
+    {
+        return FindEntry(Path) != nullptr;
+    }
+
+    std::optional<AssetPackBlob> AssetPack::Read(std::string_view Path) const
+    {
+        const AssetPackFormat::Entry* Entry = FindEntry(Path);
+        if (!Entry)
+        {
+            return std::nullopt;
+        }
+
+        const std::span<const std::byte> Stored = File->GetBytes().subspan(Entry->Offset, Entry->StoredSize);
+
+        switch (Entry->Compression)
+        {
+        case AssetPackFormat::CompressionMethod::None:
+            return AssetPackBlob{.Bytes = Stored, .Storage = nullptr};
+        case AssetPackFormat::CompressionMethod::Lz:
+            {
+                auto Storage = std::make_shared<std::vector<std::byte>>(Entry->Size);
+                if (!LzCompression::Decompress(Stored, *Storage))
+                {
+                    Log::Error(ELogCategory::Assets, "Failed to decompress packed asset: %s", Path);
+                    return std::nullopt;
+                }
+                return AssetPackBlob{.Bytes = *Storage, .Storage = std::move(Storage)};
+            }
+        }
+
+        Log::Warning(ELogCategory::Assets, "Unknown compression for packed asset: %s", Path);
+        return std::nullopt;
+    }
+
+    std::vector<std::string> AssetPack::GetPaths(std::string_view Directory, std::string_view Extension) const
+    {
+        // "Assets/Tile" must not match "Assets/TileSheets/..."
+        std::string Prefix = AssetPackFormat::NormalizePath(Directory);
+        if (!Prefix.empty() && !Prefix.ends_with('/'))
+        {
+            Prefix += '/';
+        }
+
+        std::vector<std::string> Result;
+        for (const AssetPackFormat::Entry& Entry : Entries)
+        {
+            const std::string_view EntryPath = GetEntryPath(Entry);
+            if (EntryPath.starts_with(Prefix) && EntryPath.ends_with(Extension))
+            {
+                Result.emplace_back(EntryPath);
+            }
+        }
+
+        std::sort(Result.begin(), Result.end());
+        return Result;
+    }
+
+    const AssetPackFormat::Entry* AssetPack::FindEntry(std::string_view Path) const
+    {
+        const std::string Normalized = AssetPackFormat::NormalizePath(Path);
+        const std::uint64_t Hash = AssetPackFormat::HashPath(Normalized);
+
+        auto It = std::lower_bound(Entries.begin(), Entries.end(), Hash,
+                                   [](const AssetPackFormat::Entry& Entry, std::uint64_t Value)
+                                   {
+                                       return Entry.PathHash < Value;
+                                   });
+
+        // Entries sharing a hash sit next to each other; the stored path settles collisions
+        for (; It != Entries.end() && It->PathHash == Hash; ++It)
+        {
+            if (GetEntryPath(*It) == Normalized)
+            {
+                return &*It;
+            }
+        }
+        return nullptr;
+    }
+
+    std::string_view AssetPack::GetEntryPath(const AssetPackFormat::Entry& Entry) const
+    {
+        return Paths.substr(Entry.PathOffset, Entry.PathLength);
+    }
+}
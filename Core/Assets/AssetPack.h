@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AssetPackFormat.hpp"
+#include "MappedFile.h"
+
+namespace Core
+{
+    struct AssetPackBlob
+    {
+        std::span<const std::byte> Bytes;
+
+        // Only set for compressed entries, Bytes points into it. Uncompressed entries view the mapping directly.
+        std::shared_ptr<const std::vector<std::byte>> Storage;
+    };
+
+    // Read-only, memory-mapped pack built by Tools/AssetPacker. Lookups are safe from loader threads.
+    class AssetPack
+    {
+    public:
+        static std::unique_ptr<AssetPack> Open(const std::string& Path);
+
+        bool Contains(std::string_view Path) const;
+        std::optional<AssetPackBlob> Read(std::string_view Path) const;
+
+        // Sorted paths of every entry under Directory, with or without its trailing slash, whose name ends with Extension
+        std::vector<std::string> GetPaths(std::string_view Directory, std::string_view Extension = {}) const;
+
+        std::size_t GetEntryCount() const { return Entries.size(); }
+        const std::string& GetPackPath() const { return PackPath; }
+
+    private:
+        AssetPack() = default;
+
+        const AssetPackFormat::Entry* FindEntry(std::string_view Path) const;
+        std::string_view GetEntryPath(const AssetPackFormat::Entry& Entry) const;
+
+        std::unique_ptr<MappedFile> File;
+        std::span<const AssetPackFormat::Entry> Entries;
+        std::string_view Paths;
+        std::string PackPath;
+    };
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Core
+{
+    // On-disk layout of a .pak file, shared by the runtime reader and the offline packer:
+    //   [Header][blobs, each aligned to BlobAlignment][Entry x EntryCount, sorted by PathHash][path strings]
+    namespace AssetPackFormat
+    {
+        constexpr std::uint32_t Magic = 0x4B41504D; // "MPAK"
+        constexpr std::uint32_t Version = 1;
+        constexpr std::uint64_t BlobAlignment = 16;
+
+        enum class CompressionMethod : std::uint32_t
+        {
+            None = 0,
+            Lz = 1
+        };
+
+        struct Header
+        {
+            std::uint32_t Magic = AssetPackFormat::Magic;
+            std::uint32_t Version = AssetPackFormat::Version;
+            std::uint32_t EntryCount = 0;
+            std::uint32_t Reserved = 0;
+            std::uint64_t IndexOffset = 0;
+            std::uint64_t PathsOffset = 0;
+        };
+
+        struct Entry
+        {
+            std::uint64_t PathHash = 0;
+            std::uint64_t Offset = 0;
+            std::uint64_t StoredSize = 0;
+            std::uint64_t Size = 0;
+            std::uint32_t PathOffset = 0;
+            std::uint32_t PathLength = 0;
+            CompressionMethod Compression = CompressionMethod::None;
+            std::uint32_t Reserved = 0;
+        };
+
+        static_assert(sizeof(Header) == 32);
+        static_assert(sizeof(Entry) == 48);
+
+        // Paths are stored relative to the working directory with forward slashes, e.g. "Game/Assets/global.json"
+        inline std::string NormalizePath(std::string_view Path)
+        {
+            std::string Normalized(Path);
+            for (char& Character : Normalized)
+            {
+                if (Character == '\\')
+                {
+                    Character = '/';
+                }
+            }
+            while (Normalized.starts_with("./"))
+            {
+                Normalized.erase(0, 2);
+            }
+            return Normalized;
+        }
+
+        // FNV-1a, hashed over the normalized path
+        inline std::uint64_t HashPath(std::string_view NormalizedPath)
+        {
+            std::uint64_t Hash = 0xcbf29ce484222325ull;
+            for (const char Character : NormalizedPath)
+            {
+                Hash ^= static_cast<std::uint8_t>(Character);
+                Hash *= 0x100000001b3ull;
+            }
+            return Hash;
+        }
+
+        constexpr std::uint64_t AlignUp(std::uint64_t Value, std::uint64_t Alignment)
+        {
+            return (Value + Alignment - 1) & ~(Alignment - 1);
+        }
+    }
+}
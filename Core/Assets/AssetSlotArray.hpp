@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "AssetHandle.hpp"
+
+namespace Core
+{
+    // Dense, generation-checked storage for one asset type.
+    // Slots live in fixed-size chunks that never move once published, so Get is an array load plus two atomic reads
+    // and is safe from any thread. Add, Remove and Clear must be serialized by the owner.
+    template <typename T>
+    class AssetSlotArray
+    {
+    public:
+        static constexpr std::uint32_t ChunkSize = 256;
+        static constexpr std::uint32_t MaxChunks = 256;
+
+        AssetSlotArray() = default;
+        AssetSlotArray(const AssetSlotArray&) = delete;
+        AssetSlotArray& operator=(const AssetSlotArray&) = delete;
+
+        AssetHandle<T> Add(std::shared_ptr<T> Asset);
+        void Remove(AssetHandle<T> Handle);
+        void Clear();
+
+        // Swaps the asset behind a live handle; the generation is kept, so outstanding handles resolve to the new asset
+        bool Replace(AssetHandle<T> Handle, std::shared_ptr<T> Asset);
+
+        std::shared_ptr<const T> Get(AssetHandle<T> Handle) const;
+
+        // Visits live assets in slot order, which is the order they were first stored in unless slots were reused
+        template <typename Func>
+        void ForEach(Func&& Visitor) const;
+
+        std::uint32_t GetLiveCount() const { return LiveCount.load(std::memory_order_relaxed); }
+
+    private:
+        struct Slot
+        {
+            // Bumped on every Remove; 0 means the slot has never been used
+            std::atomic<std::uint32_t> Generation{0};
+            std::atomic<std::shared_ptr<T>> Asset;
+        };
+
+        struct Chunk
+        {
+            std::array<Slot, ChunkSize> Slots;
+        };
+
+        Slot* FindSlot(std::uint32_t Index) const;
+
+        std::array<std::atomic<Chunk*>, MaxChunks> Chunks{};
+        std::atomic<std::uint32_t> SlotCount{0};
+        std::atomic<std::uint32_t> LiveCount{0};
+
+        // Writer side only
+        std::vector<std::unique_ptr<Chunk>> OwnedChunks;
+        std::vector<std::uint32_t> FreeIndices;
+    };
+
+    template <typename T>
+    AssetHandle<T> AssetSlotArray<T>::Add(std::shared_ptr<T> Asset)
+    {
+        std::uint32_t Index;
+        if (!FreeIndices.empty())
+        {
+            Index = FreeIndices.back();
+            FreeIndices.pop_back();
+        }
+        else
+        {
+            Index = SlotCount.load(std::memory_order_relaxed);
+            const std::uint32_t ChunkIndex = Index / ChunkSize;
+            if (ChunkIndex >= MaxChunks)
+            {
+                return {};
+            }
+            if (ChunkIndex == OwnedChunks.size())
+            {
+                OwnedChunks.push_back(std::make_unique<Chunk>());
+                Chunks[ChunkIndex].store(OwnedChunks.back().get(), std::memory_order_release);
+            }
+            SlotCount.store(Index + 1, std::memory_order_release);
+        }
+
+        Slot& Target = *FindSlot(Index);
+        std::uint32_t Generation = Target.Generation.load(std::memory_order_relaxed);
+        if (Generation == 0)
+        {
+            Generation = 1;
+            Target.Generation.store(Generation, std::memory_order_relaxed);
+        }
+        Target.Asset.store(std::move(Asset), std::memory_order_release);
+        LiveCount.fetch_add(1, std::memory_order_relaxed);
+
+        return {Index, Generation};
+    }
+
+    template <typename T>
+    void AssetSlotArray<T>::Remove(AssetHandle<T> Handle)
+    {
+        Slot* Target = FindSlot(Handle.GetIndex());
+        if (!Target || Target->Generation.load(std::memory_order_relaxed) != Handle.GetGeneration())
+        {
+            return;
+        }
+
+        // Invalidate outstanding handles before dropping the asset, so readers never see a stale pointer as live
+        Target->Generation.store(Handle.GetGeneration() + 1, std::memory_order_release);
+        Target->Asset.store(nullptr, std::memory_order_release);
+        FreeIndices.push_back(Handle.GetIndex());
+        LiveCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    bool AssetSlotArray<T>::Replace(AssetHandle<T> Handle, std::shared_ptr<T> Asset)
+    {
+        Slot* Target = FindSlot(Handle.GetIndex());
+        if (!Target || !Handle.IsValid() || Target->Generation.load(std::memory_order_relaxed) != Handle.GetGeneration())
+        {
+            return false;
+        }
+
+        // Readers that already loaded the old asset keep it alive until they let go
+        Target->Asset.store(std::move(Asset), std::memory_order_release);
+        return true;
+    }
+
+    template <typename T>
+    void AssetSlotArray<T>::Clear()
+    {
+        const std::uint32_t Count = SlotCount.load(std::memory_order_relaxed);
+        for (std::uint32_t Index = 0; Index < Count; ++Index)
+        {
+            Slot& Target = *FindSlot(Index);
+            if (Target.Asset.load(std::memory_order_relaxed))
+            {
+                Remove({Index, Target.Generation.load(std::memory_order_relaxed)});
+            }
+        }
+    }
+
+    template <typename T>
+    std::shared_ptr<const T> AssetSlotArray<T>::Get(AssetHandle<T> Handle) const
+    {
+        const Slot* Target = FindSlot(Handle.GetIndex());
+        if (!Target || !Handle.IsValid() || Target->Generation.load(std::memory_order_acquire) != Handle.GetGeneration())
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<T> Asset = Target->Asset.load(std::memory_order_acquire);
+
+        // The slot may have been released and reused between the two loads
+        if (Target->Generation.load(std::memory_order_acquire) != Handle.GetGeneration())
+        {
+            return nullptr;
+        }
+        return Asset;
+    }
+
+    template <typename T>
+    template <typename Func>
+    void AssetSlotArray<T>::ForEach(Func&& Visitor) const
+    {
+        const std::uint32_t Count = SlotCount.load(std::memory_order_acquire);
+        for (std::uint32_t Index = 0; Index < Count; ++Index)
+        {
+            if (std::shared_ptr<T> Asset = FindSlot(Index)->Asset.load(std::memory_order_acquire))
+            {
+                Visitor(std::shared_ptr<const T>(std::move(Asset)));
+            }
+        }
+    }
+
+    template <typename T>
+    typename AssetSlotArray<T>::Slot* AssetSlotArray<T>::FindSlot(std::uint32_t Index) const
+    {
+        if (Index >= SlotCount.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+
+        Chunk* Owner = Chunks[Index / ChunkSize].load(std::memory_order_acquire);
+        return Owner ? &Owner->Slots[Index % ChunkSize] : nullptr;
+    }
+}
@@ -0,0 +1,184 @@
+#include "CookedJsonCache.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "AssetPackFormat.hpp"
+#include "MappedFile.h"
+#include "../Log/Log.h"
+
+namespace Core::CookedJsonCache
+{
+    namespace
+    {
+        constexpr std::uint32_t Magic = 0x4E534A43; // "CJSN"
+        constexpr std::uint32_t Version = 1;
+
+        // Followed by the MessagePack encoding of the source
+        struct CookedHeader
+        {
+            std::uint32_t Magic = CookedJsonCache::Magic;
+            std::uint32_t Version = CookedJsonCache::Version;
+            std::uint64_t ContentHash = 0;
+            std::uint64_t SourceSize = 0;
+        };
+
+        static_assert(sizeof(CookedHeader) == 24);
+
+        std::optional<nlohmann::json> ParseSource(std::string_view SourcePath, std::span<const std::byte> SourceBytes)
+        {
+            const char* Begin = reinterpret_cast<const char*>(SourceBytes.data());
+            try
+            {
+                return nlohmann::json::parse(Begin, Begin + SourceBytes.size());
+            }
+            catch (const nlohmann::json::exception& E)
+            {
+                Log::Error(ELogCategory::Assets, "Failed to parse JSON %s: %s", SourcePath, E.what());
+                return std::nullopt;
+            }
+        }
+
+        std::optional<nlohmann::json> ReadCooked(const std::filesystem::path& CookedPath, const CookedHeader& Expected)
+        {
+            // A missing entry is the normal cold path, don't let MappedFile report it
+            std::error_code Error;
+            if (!std::filesystem::exists(CookedPath, Error))
+            {
+                return std::nullopt;
+            }
+
+            std::unique_ptr<MappedFile> File = MappedFile::Open(CookedPath.string());
+            if (!File || File->GetBytes().size() < sizeof(CookedHeader))
+            {
+                return std::nullopt;
+            }
+
+            const std::span<const std::byte> Bytes = File->GetBytes();
+            CookedHeader Header;
+            std::memcpy(&Header, Bytes.data(), sizeof(Header));
+            if (Header.Magic != Expected.Magic || Header.Version != Expected.Version ||
+                Header.ContentHash != Expected.ContentHash || Header.SourceSize != Expected.SourceSize)
+            {
+                return std::nullopt;
+            }
+
+            const auto* Begin = reinterpret_cast<const std::uint8_t*>(Bytes.data() + sizeof(Header));
+            const auto* End = reinterpret_cast<const std::uint8_t*>(Bytes.data() + Bytes.size());
+            nlohmann::json Json = nlohmann::json::from_msgpack(Begin, End, true, false);
+            if (Json.is_discarded())
+            {
+                return std::nullopt;
+            }
+            return Json;
+        }
+
+        bool WriteCooked(const std::filesystem::path& CookedPath, const CookedHeader& Header, const nlohmann::json& Json)
+        {
+            static std::atomic<std::uint32_t> NextTempId{0};
+
+            std::error_code Error;
+            std::filesystem::create_directories(CookedPath.parent_path(), Error);
+
+            std::vector<std::uint8_t> Encoded;
+            nlohmann::json::to_msgpack(Json, Encoded);
+
+            // Written aside and renamed over the entry so concurrent readers never see a partial file
+            std::filesystem::path TempPath = CookedPath;
+            TempPath += "." + std::to_string(NextTempId.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+            {
+                std::ofstream Stream(TempPath, std::ios::binary | std::ios::trunc);
+                Stream.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+                Stream.write(reinterpret_cast<const char*>(Encoded.data()), static_cast<std::streamsize>(Encoded.size()));
+                if (!Stream)
+                {
+                    Log::Error(ELogCategory::Assets, "Failed to write cooked asset: %s", TempPath.string().c_str());
+                    Stream.close();
+                    std::filesystem::remove(TempPath, Error);
+                    return false;
+                }
+            }
+
+            std::filesystem::rename(TempPath, CookedPath, Error);
+            if (Error)
+            {
+                Log::Error(ELogCategory::Assets, "Failed to write cooked asset %s: %s", CookedPath.string().c_str(), Error.message().c_str());
+                std::filesystem::remove(TempPath, Error);
+                return false;
+            }
+            return true;
+        }
+
+        CookedHeader MakeHeader(std::span<const std::byte> SourceBytes)
+        {
+            CookedHeader Header;
+            Header.ContentHash = HashContent(SourceBytes);
+            Header.SourceSize = SourceBytes.size();
+            return Header;
+        }
+    }
+
+    std::optional<nlohmann::json> Load(std::string_view SourcePath, std::span<const std::byte> SourceBytes)
+    {
+        if (SourceBytes.size() < MinSourceBytes)
+        {
+            return ParseSource(SourcePath, SourceBytes);
+        }
+
+        const std::filesystem::path CookedPath = GetCookedPath(SourcePath);
+        const CookedHeader Header = MakeHeader(SourceBytes);
+        if (std::optional<nlohmann::json> Cooked = ReadCooked(CookedPath, Header))
+        {
+            return Cooked;
+        }
+
+        std::optional<nlohmann::json> Json = ParseSource(SourcePath, SourceBytes);
+        if (Json)
+        {
+            WriteCooked(CookedPath, Header, *Json);
+        }
+        return Json;
+    }
+
+    bool Cook(std::string_view SourcePath, std::span<const std::byte> SourceBytes)
+    {
+        std::optional<nlohmann::json> Json = ParseSource(SourcePath, SourceBytes);
+        return Json && WriteCooked(GetCookedPath(SourcePath), MakeHeader(SourceBytes), *Json);
+    }
+
+    std::filesystem::path GetCookedPath(std::string_view SourcePath)
+    {
+        const std::string Normalized = AssetPackFormat::NormalizePath(SourcePath);
+        const std::filesystem::path Source(Normalized);
+
+        char HashText[17];
+        std::snprintf(HashText, sizeof(HashText), "%016llx",
+                      static_cast<unsigned long long>(AssetPackFormat::HashPath(Normalized)));
+
+        // File name kept for readability, the path hash tells same-named sources apart
+        return std::filesystem::path(CacheDirectory) / (Source.stem().string() + "." + HashText + ".msgpack");
+    }
+
+    std::uint64_t HashContent(std::span<const std::byte> Bytes)
+    {
+        // FNV-1a over 64-bit words rather than bytes; it only has to notice edits, and runs on every load
+        std::uint64_t Hash = 0xcbf29ce484222325ull;
+        std::size_t Position = 0;
+        for (; Position + sizeof(std::uint64_t) <= Bytes.size(); Position += sizeof(std::uint64_t))
+        {
+            std::uint64_t Word;
+            std::memcpy(&Word, Bytes.data() + Position, sizeof(Word));
+            Hash = (Hash ^ Word) * 0x100000001b3ull;
+        }
+        for (; Position < Bytes.size(); ++Position)
+        {
+            Hash = (Hash ^ static_cast<std::uint8_t>(Bytes[Position])) * 0x100000001b3ull;
+        }
+        return Hash;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "../ThirdParty/json.hpp"
+
+namespace Core
+{
+    // Binary cache for JSON assets (DataAssets, scene files, manifests). Each source is cooked to MessagePack under
+    // CacheDirectory, keyed by its normalized path and validated against a hash of its content, so an edited source
+    // simply overwrites its stale entry on the next load. Safe to use from loader threads.
+    namespace CookedJsonCache
+    {
+        constexpr const char* CacheDirectory = "Game/Cooked";
+
+        // Smaller sources are always parsed directly; opening a cache entry costs more than parsing them
+        constexpr std::size_t MinSourceBytes = 4096;
+
+        // Decodes the cooked entry when it matches SourceBytes, otherwise parses the JSON and cooks it for next time.
+        // Returns nullopt when the source is not valid JSON.
+        std::optional<nlohmann::json> Load(std::string_view SourcePath, std::span<const std::byte> SourceBytes);
+
+        // Parses SourceBytes and writes its entry regardless of MinSourceBytes. Used by the offline cook step.
+        bool Cook(std::string_view SourcePath, std::span<const std::byte> SourceBytes);
+
+        std::filesystem::path GetCookedPath(std::string_view SourcePath);
+        std::uint64_t HashContent(std::span<const std::byte> Bytes);
+    }
+}
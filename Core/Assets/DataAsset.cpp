@@ -1,21 +1,38 @@
 ﻿#include "DataAsset.h"
 
-#include <fstream>
+
+#include "CookedJsonCache.h"
+#include "MappedFile.h"
+#include "../Log/Log.h"
 
 namespace Core
 {
     std::optional<DataAsset> DataAsset::LoadFromFile(const std::string& Path)
     {
-        std::ifstream File(Path);
-        if (!File.is_open())
+        std::unique_ptr<MappedFile> File = MappedFile::Open(Path);
+        if (!File)
+        {
+            Log::Error(ELogCategory::Assets, "Failed to open DataAsset: %s", Path.c_str());
+            return std::nullopt;
+        }
+
+        return LoadFromMemory(File->GetBytes(), Path);
+    }
+
+    std::optional<DataAsset> DataAsset::LoadFromMemory(std::span<const std::byte> Bytes, const std::string& Path)
+    {
+        std::optional<nlohmann::json> Json = CookedJsonCache::Load(Path, Bytes);
+        if (!Json)
         {
-            std::printf("Failed to open DataAsset: %s\n", Path.c_str());
+            Log::Error(ELogCategory::Assets, "Failed to parse DataAsset: %s", Path.c_str());
             return std::nullopt;
         }
 
-        nlohmann::json Json;
-        File >> Json;
+        return FromJson(*Json, Path);
+    }
 
+    DataAsset DataAsset::FromJson(const nlohmann::json& Json, const std::string& Path)
+    {
         DataAsset Asset;
         const size_t LastSlash = Path.find_last_of("/\\");
         const size_t LastDot = Path.find_last_of('.');
@@ -26,7 +43,7 @@ namespace Core
             {
                 ComponentData CompData;
                 CompData.Type = ComponentJson.value("type", "");
-                CompData.Data = ComponentJson["data"];
+                CompData.Data = ComponentJson.value("data", nlohmann::json());
                 Asset.Components.push_back(CompData);
             }
         }
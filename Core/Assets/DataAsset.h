@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <optional>
+#include <span>
 #include "../ThirdParty/json.hpp"
 
 namespace Core
@@ -18,6 +19,13 @@ namespace Core
         std::string Name;
         std::vector<ComponentData> Components;
 
+        // Texture, font and sound paths referenced by any component; the DataAsset's edges in the load graph
+        std::vector<std::string> AssetReferences;
+
         static std::optional<DataAsset> LoadFromFile(const std::string& Path);
+        static std::optional<DataAsset> LoadFromMemory(std::span<const std::byte> Bytes, const std::string& Path);
+
+    private:
+        static DataAsset FromJson(const nlohmann::json& Json, const std::string& Path);
     };
 }
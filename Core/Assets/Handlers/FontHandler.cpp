@@ -1,29 +1,52 @@
 #include "FontHandler.h"
 
+#include <vector>
+
 #include <SFML/Graphics/Font.hpp>
 
 #include "../AssetLoader.h"
 #include "../../Systems/AssetRegistrySystem.h"
+#include "../../Log/Log.h"
 
 namespace Core
 {
-    AssetLoader::LoadedAsset FontHandler::Load(const AssetLoader::LoadRequest& Request)
+    namespace
+    {
+        // sf::Font streams glyphs from its source for as long as it lives, so the bytes travel with it
+        struct PackedFont
+        {
+            std::vector<std::byte> Bytes;
+            sf::Font Font;
+        };
+    }
+
+    std::shared_ptr<void> FontHandler::Decode(const AssetLoader::LoadRequest& Request, std::span<const std::byte> Bytes)
     {
-        auto Font = std::make_shared<sf::Font>();
-        AssetLoader::LoadedAsset Result{AssetLoader::AssetType::Font, Request.Path};
-        Result.Success = Font->openFromFile(Request.Path);
-        Result.Data = Font;
-        if (!Result.Success)
+        auto Packed = std::make_shared<PackedFont>();
+        Packed->Bytes.assign(Bytes.begin(), Bytes.end());
+        if (!Packed->Font.openFromMemory(Packed->Bytes.data(), Packed->Bytes.size()))
         {
-            Result.ErrorMessage = "Failed to load font";
+            Log::Error(ELogCategory::Assets, "Failed to decode font: %s", Request.Path.c_str());
+            return nullptr;
         }
-        return Result;
+        return Packed;
     }
 
     AssetId FontHandler::Store(std::shared_ptr<void> Data, const std::string& Path,
                                AssetRegistrySystem& Registry)
     {
-        return Registry.Store<sf::Font>(std::static_pointer_cast<sf::Font>(Data), Path);
+        // The registry holds the font by an aliasing pointer; the source bytes are what it costs in memory
+        std::shared_ptr<PackedFont> Packed = std::static_pointer_cast<PackedFont>(Data);
+        const std::size_t SizeBytes = Packed->Bytes.size();
+        return Registry.Store<sf::Font>(std::shared_ptr<sf::Font>(Packed, &Packed->Font), Path, SizeBytes);
+    }
+
+    bool FontHandler::Replace(std::shared_ptr<void> Data, const std::string& Path,
+                              AssetRegistrySystem& Registry)
+    {
+        std::shared_ptr<PackedFont> Packed = std::static_pointer_cast<PackedFont>(Data);
+        const std::size_t SizeBytes = Packed->Bytes.size();
+        return Registry.Replace<sf::Font>(Path, std::shared_ptr<sf::Font>(Packed, &Packed->Font), SizeBytes);
     }
 
     void FontHandler::Unload(AssetId Id, AssetRegistrySystem& Registry)
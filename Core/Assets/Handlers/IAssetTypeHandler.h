@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <span>
 #include <string>
 
 #include "../AssetId.hpp"
@@ -15,9 +17,19 @@ namespace Core
     public:
         virtual ~IAssetTypeHandler() = default;
 
-        virtual AssetLoader::LoadedAsset Load(const AssetLoader::LoadRequest& Request) = 0;
+        // Runs on a decode worker: builds a CPU-side object from raw bytes. Must not touch the GPU. Returns nullptr on failure.
+        virtual std::shared_ptr<void> Decode(const AssetLoader::LoadRequest& Request, std::span<const std::byte> Bytes) = 0;
+
+        // Runs on the main thread within the per-frame upload budget, only when RequiresUpload() is true
+        virtual bool RequiresUpload() const { return false; }
+        virtual std::shared_ptr<void> Upload(std::shared_ptr<void> Decoded) { return Decoded; }
+
         virtual AssetId Store(std::shared_ptr<void> Data, const std::string& Path,
                              AssetRegistrySystem& Registry) = 0;
+
+        // Swaps freshly loaded Data in for the asset already stored at Path; used by hot reload
+        virtual bool Replace(std::shared_ptr<void> Data, const std::string& Path,
+                             AssetRegistrySystem& Registry) = 0;
         virtual void Unload(AssetId Id, AssetRegistrySystem& Registry) = 0;
     };
 }
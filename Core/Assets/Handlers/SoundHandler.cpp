@@ -4,20 +4,20 @@
 
 #include "../AssetLoader.h"
 #include "../../Systems/AssetRegistrySystem.h"
+#include "../../Log/Log.h"
 
 namespace Core
 {
-    AssetLoader::LoadedAsset SoundHandler::Load(const AssetLoader::LoadRequest& Request)
+    std::shared_ptr<void> SoundHandler::Decode(const AssetLoader::LoadRequest& Request, std::span<const std::byte> Bytes)
     {
+        // Samples are decoded and held in memory, so the buffer needs no main-thread step
         auto SoundBuffer = std::make_shared<sf::SoundBuffer>();
-        AssetLoader::LoadedAsset Result{AssetLoader::AssetType::Sound, Request.Path};
-        Result.Success = SoundBuffer->loadFromFile(Request.Path);
-        Result.Data = SoundBuffer;
-        if (!Result.Success)
+        if (!SoundBuffer->loadFromMemory(Bytes.data(), Bytes.size()))
         {
-            Result.ErrorMessage = "Failed to load sound";
+            Log::Error(ELogCategory::Assets, "Failed to decode sound: %s", Request.Path.c_str());
+            return nullptr;
         }
-        return Result;
+        return SoundBuffer;
     }
 
     AssetId SoundHandler::Store(std::shared_ptr<void> Data, const std::string& Path,
@@ -26,6 +26,12 @@ namespace Core
         return Registry.Store<sf::SoundBuffer>(std::static_pointer_cast<sf::SoundBuffer>(Data), Path);
     }
 
+    bool SoundHandler::Replace(std::shared_ptr<void> Data, const std::string& Path,
+                               AssetRegistrySystem& Registry)
+    {
+        return Registry.Replace<sf::SoundBuffer>(Path, std::static_pointer_cast<sf::SoundBuffer>(Data));
+    }
+
     void SoundHandler::Unload(AssetId Id, AssetRegistrySystem& Registry)
     {
         Registry.Unload(Id);
@@ -1,23 +1,33 @@
 #include "TextureHandler.h"
 
+#include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/Texture.hpp>
 
 #include "../AssetLoader.h"
 #include "../../Systems/AssetRegistrySystem.h"
+#include "../../Log/Log.h"
 
 namespace Core
 {
-    AssetLoader::LoadedAsset TextureHandler::Load(const AssetLoader::LoadRequest& Request)
+    std::shared_ptr<void> TextureHandler::Decode(const AssetLoader::LoadRequest& Request, std::span<const std::byte> Bytes)
+    {
+        auto Image = std::make_shared<sf::Image>();
+        if (!Image->loadFromMemory(Bytes.data(), Bytes.size()))
+        {
+            Log::Error(ELogCategory::Assets, "Failed to decode texture: %s", Request.Path.c_str());
+            return nullptr;
+        }
+        return Image;
+    }
+
+    std::shared_ptr<void> TextureHandler::Upload(std::shared_ptr<void> Decoded)
     {
         auto Texture = std::make_shared<sf::Texture>();
-        AssetLoader::LoadedAsset Result{AssetLoader::AssetType::Texture, Request.Path};
-        Result.Success = Texture->loadFromFile(Request.Path);
-        Result.Data = Texture;
-        if (!Result.Success)
+        if (!Texture->loadFromImage(*std::static_pointer_cast<sf::Image>(Decoded)))
         {
-            Result.ErrorMessage = "Failed to load texture";
+            return nullptr;
         }
-        return Result;
+        return Texture;
     }
 
     AssetId TextureHandler::Store(std::shared_ptr<void> Data, const std::string& Path,
@@ -26,6 +36,12 @@ namespace Core
         return Registry.Store<sf::Texture>(std::static_pointer_cast<sf::Texture>(Data), Path);
     }
 
+    bool TextureHandler::Replace(std::shared_ptr<void> Data, const std::string& Path,
+                                 AssetRegistrySystem& Registry)
+    {
+        return Registry.Replace<sf::Texture>(Path, std::static_pointer_cast<sf::Texture>(Data));
+    }
+
     void TextureHandler::Unload(AssetId Id, AssetRegistrySystem& Registry)
     {
         Registry.Unload(Id);
@@ -7,9 +7,13 @@ namespace Core
     class TextureHandler : public IAssetTypeHandler
     {
     public:
-        AssetLoader::LoadedAsset Load(const AssetLoader::LoadRequest& Request) override;
+        std::shared_ptr<void> Decode(const AssetLoader::LoadRequest& Request, std::span<const std::byte> Bytes) override;
+        bool RequiresUpload() const override { return true; }
+        std::shared_ptr<void> Upload(std::shared_ptr<void> Decoded) override;
         AssetId Store(std::shared_ptr<void> Data, const std::string& Path,
                      AssetRegistrySystem& Registry) override;
+        bool Replace(std::shared_ptr<void> Data, const std::string& Path,
+                     AssetRegistrySystem& Registry) override;
         void Unload(AssetId Id, AssetRegistrySystem& Registry) override;
     };
 }
@@ -0,0 +1,191 @@
+#include "LzCompression.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+namespace Core::LzCompression
+{
+    namespace
+    {
+        constexpr std::size_t MinMatch = 4;
+        constexpr std::size_t LastLiterals = 5;
+        constexpr std::size_t MatchSearchLimit = 12;
+        constexpr std::size_t MaxOffset = 65535;
+        constexpr unsigned HashBits = 12;
+
+        std::uint32_t Read32(std::span<const std::byte> Data, std::size_t Position)
+        {
+            std::uint32_t Value;
+            std::memcpy(&Value, Data.data() + Position, sizeof(Value));
+            return Value;
+        }
+
+        std::size_t HashSequence(std::uint32_t Sequence)
+        {
+            return (Sequence * 2654435761u) >> (32 - HashBits);
+        }
+
+        void WriteExtraLength(std::vector<std::byte>& Output, std::size_t Length)
+        {
+            while (Length >= 255)
+            {
+                Output.push_back(std::byte{255});
+                Length -= 255;
+            }
+            Output.push_back(static_cast<std::byte>(Length));
+        }
+
+        void WriteSequence(std::vector<std::byte>& Output, std::span<const std::byte> Literals, std::size_t Offset,
+                           std::size_t MatchLength)
+        {
+            const std::size_t LiteralToken = std::min<std::size_t>(Literals.size(), 15);
+            const std::size_t MatchToken = MatchLength >= MinMatch ? std::min<std::size_t>(MatchLength - MinMatch, 15) : 0;
+            Output.push_back(static_cast<std::byte>((LiteralToken << 4) | MatchToken));
+
+            if (LiteralToken == 15)
+            {
+                WriteExtraLength(Output, Literals.size() - 15);
+            }
+            Output.insert(Output.end(), Literals.begin(), Literals.end());
+
+            if (MatchLength < MinMatch)
+            {
+                return;
+            }
+
+            Output.push_back(static_cast<std::byte>(Offset & 0xFF));
+            Output.push_back(static_cast<std::byte>((Offset >> 8) & 0xFF));
+            if (MatchToken == 15)
+            {
+                WriteExtraLength(Output, MatchLength - MinMatch - 15);
+            }
+        }
+
+        bool ReadExtraLength(std::span<const std::byte> Input, std::size_t& Position, std::size_t& Length)
+        {
+            std::uint8_t Value = 0;
+            do
+            {
+                if (Position >= Input.size())
+                {
+                    return false;
+                }
+                Value = static_cast<std::uint8_t>(Input[Position++]);
+                Length += Value;
+            }
+            while (Value == 255);
+            return true;
+        }
+    }
+
+    std::vector<std::byte> Compress(std::span<const std::byte> Input)
+    {
+        const std::size_t Size = Input.size();
+
+        std::vector<std::byte> Output;
+        Output.reserve(Size + Size / 255 + 16);
+
+        std::vector<std::int64_t> HashTable(std::size_t{1} << HashBits, -1);
+        std::size_t Anchor = 0;
+        std::size_t Position = 0;
+
+        // The format requires the final bytes to be literals, so matches stop short of the end
+        if (Size > MatchSearchLimit)
+        {
+            const std::size_t SearchEnd = Size - MatchSearchLimit;
+            const std::size_t MatchEnd = Size - LastLiterals;
+
+            while (Position < SearchEnd)
+            {
+                const std::uint32_t Sequence = Read32(Input, Position);
+                const std::size_t Hash = HashSequence(Sequence);
+                const std::int64_t Candidate = HashTable[Hash];
+                HashTable[Hash] = static_cast<std::int64_t>(Position);
+
+                if (Candidate < 0 || Position - static_cast<std::size_t>(Candidate) > MaxOffset ||
+                    Read32(Input, static_cast<std::size_t>(Candidate)) != Sequence)
+                {
+                    ++Position;
+                    continue;
+                }
+
+                const std::size_t MatchStart = static_cast<std::size_t>(Candidate);
+                std::size_t MatchLength = MinMatch;
+                while (Position + MatchLength < MatchEnd && Input[MatchStart + MatchLength] == Input[Position + MatchLength])
+                {
+                    ++MatchLength;
+                }
+
+                WriteSequence(Output, Input.subspan(Anchor, Position - Anchor), Position - MatchStart, MatchLength);
+                Position += MatchLength;
+                Anchor = Position;
+            }
+        }
+
+        WriteSequence(Output, Input.subspan(Anchor), 0, 0);
+        return Output;
+    }
+
+    bool Decompress(std::span<const std::byte> Input, std::span<std::byte> Output)
+    {
+        std::size_t In = 0;
+        std::size_t Out = 0;
+
+        while (In < Input.size())
+        {
+            const std::uint8_t Token = static_cast<std::uint8_t>(Input[In++]);
+
+            std::size_t LiteralLength = Token >> 4;
+            if (LiteralLength == 15 && !ReadExtraLength(Input, In, LiteralLength))
+            {
+                return false;
+            }
+            if (LiteralLength > Input.size() - In || LiteralLength > Output.size() - Out)
+            {
+                return false;
+            }
+
+            std::memcpy(Output.data() + Out, Input.data() + In, LiteralLength);
+            In += LiteralLength;
+            Out += LiteralLength;
+
+            // The last sequence carries literals only
+            if (In == Input.size())
+            {
+                break;
+            }
+
+            if (Input.size() - In < 2)
+            {
+                return false;
+            }
+            const std::size_t Offset = static_cast<std::size_t>(Input[In]) | (static_cast<std::size_t>(Input[In + 1]) << 8);
+            In += 2;
+            if (Offset == 0 || Offset > Out)
+            {
+                return false;
+            }
+
+            std::size_t MatchLength = Token & 0x0F;
+            if (MatchLength == 15 && !ReadExtraLength(Input, In, MatchLength))
+            {
+                return false;
+            }
+            MatchLength += MinMatch;
+            if (MatchLength > Output.size() - Out)
+            {
+                return false;
+            }
+
+            // Matches may overlap their own output, so copy forward byte by byte
+            for (std::size_t Index = 0; Index < MatchLength; ++Index)
+            {
+                Output[Out + Index] = Output[Out - Offset + Index];
+            }
+            Out += MatchLength;
+        }
+
+        return Out == Output.size();
+    }
+}
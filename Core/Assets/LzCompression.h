@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace Core
+{
+    // Small LZ77 block codec in the LZ4 block layout: fast to decode, no external dependency.
+    namespace LzCompression
+    {
+        std::vector<std::byte> Compress(std::span<const std::byte> Input);
+
+        // Output must be sized to the exact decompressed size. Returns false on malformed input.
+        bool Decompress(std::span<const std::byte> Input, std::span<std::byte> Output);
+    }
+}
@@ -0,0 +1,109 @@
+#include "MappedFile.h"
+
+#include <fstream>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../Log/Log.h"
+#endif
+
+namespace Core
+{
+    std::unique_ptr<MappedFile> MappedFile::Open(const std::string& Path)
+    {
+        std::unique_ptr<MappedFile> File(new MappedFile());
+
+#ifdef _WIN32
+        HANDLE FileHandle = CreateFileA(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (FileHandle != INVALID_HANDLE_VALUE)
+        {
+            LARGE_INTEGER FileSize;
+            if (GetFileSizeEx(FileHandle, &FileSize) && FileSize.QuadPart > 0)
+            {
+                HANDLE MappingHandle = CreateFileMappingA(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (MappingHandle)
+                {
+                    if (void* View = MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0))
+                    {
+                        File->FileHandle = FileHandle;
+                        File->MappingHandle = MappingHandle;
+                        File->Data = static_cast<const std::byte*>(View);
+                        File->Size = static_cast<std::size_t>(FileSize.QuadPart);
+                        File->bMapped = true;
+                        return File;
+                    }
+                    CloseHandle(MappingHandle);
+                }
+            }
+            CloseHandle(FileHandle);
+        }
+#else
+        const int Descriptor = open(Path.c_str(), O_RDONLY);
+        if (Descriptor >= 0)
+        {
+            struct stat Stat;
+            if (fstat(Descriptor, &Stat) == 0 && Stat.st_size > 0)
+            {
+                void* View = mmap(nullptr, static_cast<std::size_t>(Stat.st_size), PROT_READ, MAP_PRIVATE, Descriptor, 0);
+                if (View != MAP_FAILED)
+                {
+                    close(Descriptor);
+                    File->Data = static_cast<const std::byte*>(View);
+                    File->Size = static_cast<std::size_t>(Stat.st_size);
+                    File->bMapped = true;
+                    return File;
+                }
+            }
+            close(Descriptor);
+        }
+#endif
+
+        std::ifstream Stream(Path, std::ios::binary | std::ios::ate);
+        if (!Stream.is_open())
+        {
+            Log::Error(ELogCategory::Assets, "Failed to open file: %s", Path.c_str());
+            return nullptr;
+        }
+
+        const std::streamsize FileSize = Stream.tellg();
+        Stream.seekg(0, std::ios::beg);
+        File->FallbackBuffer.resize(static_cast<std::size_t>(FileSize));
+        if (FileSize > 0 && !Stream.read(reinterpret_cast<char*>(File->FallbackBuffer.data()), FileSize))
+        {
+            Log::Error(ELogCategory::Assets, "Failed to read file: %s", Path.c_str());
+            return nullptr;
+        }
+
+        File->Data = File->FallbackBuffer.data();
+        File->Size = File->FallbackBuffer.size();
+        return File;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        if (!bMapped)
+        {
+            return;
+        }
+
+#ifdef _WIN32
+        UnmapViewOfFile(Data);
+        CloseHandle(static_cast<HANDLE>(MappingHandle));
+        CloseHandle(static_cast<HANDLE>(FileHandle));
+#else
+        munmap(const_cast<std::byte*>(Data), Size);
+#endif
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace Core
+{
+    // Read-only view of a whole file. Memory-maps when the platform allows it and falls back to a single read.
+    class MappedFile
+    {
+    public:
+        static std::unique_ptr<MappedFile> Open(const std::string& Path);
+
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        std::span<const std::byte> GetBytes() const { return {Data, Size}; }
+        bool IsMapped() const { return bMapped; }
+
+    private:
+        MappedFile() = default;
+
+        const std::byte* Data = nullptr;
+        std::size_t Size = 0;
+        bool bMapped = false;
+        std::vector<std::byte> FallbackBuffer;
+
+#ifdef _WIN32
+        void* FileHandle = nullptr;
+        void* MappingHandle = nullptr;
+#endif
+    };
+}
@@ -0,0 +1,470 @@
+#include "AsyncFileReader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "../Log/Log.h"
+#endif
+
+namespace Core
+{
+    namespace
+    {
+        std::shared_ptr<std::vector<std::byte>> ReadWholeFile(const std::string& Path)
+        {
+            std::ifstream Stream(Path, std::ios::binary | std::ios::ate);
+            if (!Stream.is_open())
+            {
+                return nullptr;
+            }
+
+            const std::streamsize Size = Stream.tellg();
+            Stream.seekg(0, std::ios::beg);
+
+            auto Bytes = std::make_shared<std::vector<std::byte>>(static_cast<std::size_t>(Size));
+            if (Size > 0 && !Stream.read(reinterpret_cast<char*>(Bytes->data()), Size))
+            {
+                return nullptr;
+            }
+            return Bytes;
+        }
+    }
+
+#ifdef __linux__
+    namespace
+    {
+        // Files up to this size are read into a registered buffer, larger ones straight into their destination
+        constexpr std::size_t RegisteredBufferBytes = 64 * 1024;
+
+        // A single read never asks for more than this; longer files take several
+        constexpr std::size_t MaxReadBytes = 1u << 30;
+
+        int SetupRing(unsigned Entries, io_uring_params& Params)
+        {
+            return static_cast<int>(syscall(__NR_io_uring_setup, Entries, &Params));
+        }
+
+        int EnterRing(int RingHandle, unsigned ToSubmit, unsigned MinComplete)
+        {
+            return static_cast<int>(syscall(__NR_io_uring_enter, RingHandle, ToSubmit, MinComplete,
+                                            MinComplete > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0));
+        }
+
+        int RegisterRing(int RingHandle, unsigned Opcode, const void* Arguments, unsigned Count)
+        {
+            return static_cast<int>(syscall(__NR_io_uring_register, RingHandle, Opcode, Arguments, Count));
+        }
+
+        template <typename T>
+        T* RingField(void* Base, std::uint32_t Offset)
+        {
+            return reinterpret_cast<T*>(static_cast<std::byte*>(Base) + Offset);
+        }
+    }
+
+    // Shared ring state plus one slot per in-flight read; slot i owns registered buffer i
+    struct AsyncFileReader::Ring
+    {
+        struct Slot
+        {
+            PendingRead Request;
+            std::shared_ptr<std::vector<std::byte>> Bytes;
+            std::size_t Offset = 0;
+            bool bRegistered = false;
+        };
+
+        int Handle = -1;
+
+        void* SqRing = nullptr;
+        std::size_t SqRingBytes = 0;
+        void* CqRing = nullptr;
+        std::size_t CqRingBytes = 0;
+        io_uring_sqe* Sqes = nullptr;
+        std::size_t SqesBytes = 0;
+
+        unsigned* SqHead = nullptr;
+        unsigned* SqTail = nullptr;
+        unsigned SqMask = 0;
+        unsigned SqEntries = 0;
+        unsigned* SqArray = nullptr;
+        unsigned* CqHead = nullptr;
+        unsigned* CqTail = nullptr;
+        unsigned CqMask = 0;
+        io_uring_cqe* Cqes = nullptr;
+
+        std::unique_ptr<std::byte[]> Buffers;
+        bool bBuffersRegistered = false;
+
+        std::vector<Slot> Slots;
+        std::vector<unsigned> FreeSlots;
+
+        static std::unique_ptr<Ring> Create(unsigned Depth);
+        ~Ring();
+
+        // Queues the next read for Slots[Index] for the next io_uring_enter; false while the submission queue is full
+        bool Prepare(unsigned Index);
+
+        // Takes back every read prepared but not yet consumed by the kernel and returns their slots
+        std::vector<unsigned> Unprepare();
+    };
+
+    std::unique_ptr<AsyncFileReader::Ring> AsyncFileReader::Ring::Create(unsigned Depth)
+    {
+        io_uring_params Params{};
+        const int Handle = SetupRing(Depth, Params);
+        if (Handle < 0)
+        {
+            return nullptr;
+        }
+
+        auto NewRing = std::make_unique<Ring>();
+        NewRing->Handle = Handle;
+
+        NewRing->SqRingBytes = Params.sq_off.array + Params.sq_entries * sizeof(unsigned);
+        NewRing->CqRingBytes = Params.cq_off.cqes + Params.cq_entries * sizeof(io_uring_cqe);
+        const bool bSingleMap = (Params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (bSingleMap)
+        {
+            NewRing->SqRingBytes = NewRing->CqRingBytes = std::max(NewRing->SqRingBytes, NewRing->CqRingBytes);
+        }
+
+        NewRing->SqRing = mmap(nullptr, NewRing->SqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                               Handle, IORING_OFF_SQ_RING);
+        if (NewRing->SqRing == MAP_FAILED)
+        {
+            NewRing->SqRing = nullptr;
+            return nullptr;
+        }
+
+        if (bSingleMap)
+        {
+            NewRing->CqRing = NewRing->SqRing;
+        }
+        else
+        {
+            NewRing->CqRing = mmap(nullptr, NewRing->CqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                   Handle, IORING_OFF_CQ_RING);
+            if (NewRing->CqRing == MAP_FAILED)
+            {
+                NewRing->CqRing = nullptr;
+                return nullptr;
+            }
+        }
+
+        NewRing->SqesBytes = Params.sq_entries * sizeof(io_uring_sqe);
+        void* Sqes = mmap(nullptr, NewRing->SqesBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, Handle,
+                          IORING_OFF_SQES);
+        if (Sqes == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        NewRing->Sqes = static_cast<io_uring_sqe*>(Sqes);
+
+        NewRing->SqHead = RingField<unsigned>(NewRing->SqRing, Params.sq_off.head);
+        NewRing->SqTail = RingField<unsigned>(NewRing->SqRing, Params.sq_off.tail);
+        NewRing->SqMask = *RingField<unsigned>(NewRing->SqRing, Params.sq_off.ring_mask);
+        NewRing->SqEntries = *RingField<unsigned>(NewRing->SqRing, Params.sq_off.ring_entries);
+        NewRing->SqArray = RingField<unsigned>(NewRing->SqRing, Params.sq_off.array);
+        NewRing->CqHead = RingField<unsigned>(NewRing->CqRing, Params.cq_off.head);
+        NewRing->CqTail = RingField<unsigned>(NewRing->CqRing, Params.cq_off.tail);
+        NewRing->CqMask = *RingField<unsigned>(NewRing->CqRing, Params.cq_off.ring_mask);
+        NewRing->Cqes = RingField<io_uring_cqe>(NewRing->CqRing, Params.cq_off.cqes);
+
+        // Pinned once up front instead of per read. Registration can fail under a low memlock limit; plain reads still work.
+        NewRing->Buffers = std::make_unique<std::byte[]>(static_cast<std::size_t>(Depth) * RegisteredBufferBytes);
+        std::vector<iovec> Vectors(Depth);
+        for (unsigned Index = 0; Index < Depth; ++Index)
+        {
+            Vectors[Index] = {NewRing->Buffers.get() + Index * RegisteredBufferBytes, RegisteredBufferBytes};
+        }
+        NewRing->bBuffersRegistered = RegisterRing(Handle, IORING_REGISTER_BUFFERS, Vectors.data(), Depth) == 0;
+
+        NewRing->Slots.resize(Depth);
+        for (unsigned Index = Depth; Index > 0; --Index)
+        {
+            NewRing->FreeSlots.push_back(Index - 1);
+        }
+
+        return NewRing;
+    }
+
+    AsyncFileReader::Ring::~Ring()
+    {
+        if (Sqes)
+        {
+            munmap(Sqes, SqesBytes);
+        }
+        if (CqRing && CqRing != SqRing)
+        {
+            munmap(CqRing, CqRingBytes);
+        }
+        if (SqRing)
+        {
+            munmap(SqRing, SqRingBytes);
+        }
+        if (Handle >= 0)
+        {
+            close(Handle);
+        }
+    }
+
+    bool AsyncFileReader::Ring::Prepare(unsigned Index)
+    {
+        // Only this thread produces submissions, so the tail can be read plainly; the kernel moves the head
+        const unsigned Tail = *SqTail;
+        if (Tail - std::atomic_ref<unsigned>(*SqHead).load(std::memory_order_acquire) >= SqEntries)
+        {
+            return false;
+        }
+
+        Slot& Target = Slots[Index];
+        const std::size_t Remaining = Target.Request.Size - Target.Offset;
+        const unsigned SqeIndex = Tail & SqMask;
+        io_uring_sqe& Sqe = Sqes[SqeIndex];
+        std::memset(&Sqe, 0, sizeof(Sqe));
+
+        Sqe.fd = Target.Request.File;
+        Sqe.off = Target.Offset;
+        Sqe.len = static_cast<std::uint32_t>(std::min(Remaining, MaxReadBytes));
+        Sqe.user_data = Index;
+        if (Target.bRegistered)
+        {
+            Sqe.opcode = IORING_OP_READ_FIXED;
+            Sqe.addr = reinterpret_cast<std::uint64_t>(Buffers.get() + Index * RegisteredBufferBytes + Target.Offset);
+            Sqe.buf_index = static_cast<std::uint16_t>(Index);
+        }
+        else
+        {
+            Sqe.opcode = IORING_OP_READ;
+            Sqe.addr = reinterpret_cast<std::uint64_t>(Target.Bytes->data() + Target.Offset);
+        }
+
+        SqArray[SqeIndex] = SqeIndex;
+        std::atomic_ref<unsigned>(*SqTail).store(Tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::vector<unsigned> AsyncFileReader::Ring::Unprepare()
+    {
+        // Without SQPOLL the kernel only reads entries during io_uring_enter, so moving the tail back is safe here
+        const unsigned Head = std::atomic_ref<unsigned>(*SqHead).load(std::memory_order_acquire);
+        std::vector<unsigned> Indices;
+        for (unsigned Entry = Head; Entry != *SqTail; ++Entry)
+        {
+            Indices.push_back(static_cast<unsigned>(Sqes[SqArray[Entry & SqMask]].user_data));
+        }
+        std::atomic_ref<unsigned>(*SqTail).store(Head, std::memory_order_release);
+        return Indices;
+    }
+#endif
+
+    AsyncFileReader::AsyncFileReader(std::size_t QueueDepth, std::size_t FallbackConcurrency)
+        : FallbackWorkers(FallbackConcurrency)
+    {
+#ifdef __linux__
+        Uring = Ring::Create(static_cast<unsigned>(std::clamp<std::size_t>(QueueDepth, 1, 4096)));
+        if (Uring)
+        {
+            RingThread = std::thread(&AsyncFileReader::RunRing, this);
+        }
+        else
+        {
+            Log::Warning(ELogCategory::Assets, "io_uring unavailable, reading files on a thread pool");
+        }
+#endif
+    }
+
+    AsyncFileReader::~AsyncFileReader()
+    {
+        {
+            std::lock_guard Lock(Mutex);
+            bStopping = true;
+        }
+        Condition.notify_all();
+
+        if (RingThread.joinable())
+        {
+            RingThread.join();
+        }
+    }
+
+    void AsyncFileReader::Read(std::string Path, ReadCallback OnComplete)
+    {
+#ifdef __linux__
+        if (Uring)
+        {
+            // Opening and sizing are metadata lookups; only the read itself goes through the ring
+            const int File = open(Path.c_str(), O_RDONLY | O_CLOEXEC);
+            struct stat Status{};
+            if (File < 0 || fstat(File, &Status) != 0)
+            {
+                if (File >= 0)
+                {
+                    close(File);
+                }
+                OnComplete(nullptr);
+                return;
+            }
+
+            if (Status.st_size == 0)
+            {
+                close(File);
+                OnComplete(std::make_shared<std::vector<std::byte>>());
+                return;
+            }
+
+            {
+                std::lock_guard Lock(Mutex);
+                Queued.push_back({std::move(Path), std::move(OnComplete), File, static_cast<std::size_t>(Status.st_size)});
+            }
+            Condition.notify_one();
+            return;
+        }
+#endif
+
+        FallbackWorkers.Enqueue([Path = std::move(Path), OnComplete = std::move(OnComplete)]()
+        {
+            OnComplete(ReadWholeFile(Path));
+        });
+    }
+
+    void AsyncFileReader::RunRing()
+    {
+#ifdef __linux__
+        Ring& State = *Uring;
+
+        // Slots holding a read, whether waiting for queue space, prepared but not yet consumed, or with the kernel
+        std::size_t InFlight = 0;
+        std::deque<unsigned> Unprepared;
+        unsigned Unsubmitted = 0;
+
+        auto Finish = [&State, &InFlight](unsigned Index, std::shared_ptr<std::vector<std::byte>> Bytes)
+        {
+            Ring::Slot& Target = State.Slots[Index];
+            close(Target.Request.File);
+            ReadCallback OnComplete = std::move(Target.Request.OnComplete);
+            Target = {};
+            State.FreeSlots.push_back(Index);
+            --InFlight;
+
+            OnComplete(std::move(Bytes));
+        };
+
+        while (true)
+        {
+            {
+                std::unique_lock Lock(Mutex);
+                if (InFlight == 0)
+                {
+                    Condition.wait(Lock, [this]()
+                    {
+                        return bStopping || !Queued.empty();
+                    });
+                    if (Queued.empty())
+                    {
+                        return;
+                    }
+                }
+
+                // Everything queued since the last pass goes out in one submission
+                while (!Queued.empty() && !State.FreeSlots.empty())
+                {
+                    const unsigned Index = State.FreeSlots.back();
+                    State.FreeSlots.pop_back();
+
+                    Ring::Slot& Target = State.Slots[Index];
+                    Target.Request = std::move(Queued.front());
+                    Queued.pop_front();
+                    Target.Offset = 0;
+                    Target.bRegistered = State.bBuffersRegistered && Target.Request.Size <= RegisteredBufferBytes;
+                    Target.Bytes = Target.bRegistered
+                        ? nullptr
+                        : std::make_shared<std::vector<std::byte>>(Target.Request.Size);
+
+                    Unprepared.push_back(Index);
+                    ++InFlight;
+                }
+            }
+
+            while (!Unprepared.empty() && State.Prepare(Unprepared.front()))
+            {
+                Unprepared.pop_front();
+                ++Unsubmitted;
+            }
+
+            // Only wait for a completion when something is with the kernel or about to be
+            const bool bExpectCompletion = InFlight > Unprepared.size();
+            const int Submitted = EnterRing(State.Handle, Unsubmitted, bExpectCompletion ? 1 : 0);
+            if (Submitted >= 0)
+            {
+                Unsubmitted -= static_cast<unsigned>(Submitted);
+            }
+            else if (errno == EAGAIN || errno == EBUSY)
+            {
+                // Out of kernel resources or the completion queue is full; reap what has finished and submit the rest
+                // on the next pass
+                if (InFlight == Unprepared.size() + Unsubmitted)
+                {
+                    std::this_thread::yield();
+                }
+            }
+            else if (errno != EINTR)
+            {
+                // The kernel will never take these, so fail them rather than leave their callers waiting
+                Log::Error(ELogCategory::Assets, "io_uring_enter failed: %s", std::strerror(errno));
+                for (const unsigned Index : State.Unprepare())
+                {
+                    Finish(Index, nullptr);
+                }
+                Unsubmitted = 0;
+            }
+
+            unsigned Head = *State.CqHead;
+            const unsigned Tail = std::atomic_ref<unsigned>(*State.CqTail).load(std::memory_order_acquire);
+            for (; Head != Tail; ++Head)
+            {
+                const io_uring_cqe& Completion = State.Cqes[Head & State.CqMask];
+                const unsigned Index = static_cast<unsigned>(Completion.user_data);
+                Ring::Slot& Target = State.Slots[Index];
+
+                // Regular files can come back short; read the rest from where this one stopped
+                const bool bFailed = Completion.res <= 0;
+                if (!bFailed)
+                {
+                    Target.Offset += static_cast<std::size_t>(Completion.res);
+                    if (Target.Offset < Target.Request.Size)
+                    {
+                        Unprepared.push_back(Index);
+                        continue;
+                    }
+                }
+
+                std::shared_ptr<std::vector<std::byte>> Bytes;
+                if (!bFailed)
+                {
+                    Bytes = std::move(Target.Bytes);
+                    if (Target.bRegistered)
+                    {
+                        const std::byte* Source = State.Buffers.get() + Index * RegisteredBufferBytes;
+                        Bytes = std::make_shared<std::vector<std::byte>>(Source, Source + Target.Request.Size);
+                    }
+                }
+
+                Finish(Index, std::move(Bytes));
+            }
+            std::atomic_ref<unsigned>(*State.CqHead).store(Head, std::memory_order_release);
+        }
+#endif
+    }
+}
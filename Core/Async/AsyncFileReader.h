@@ -0,0 +1,64 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool.h"
+
+namespace Core
+{
+    // Whole-file reads that never block the caller. On Linux one thread drives an io_uring: reads queued from any
+    // thread are batched into a single submission, up to QueueDepth are in flight at once, and small files land in
+    // registered buffers. Where io_uring is unavailable the same reads run as blocking reads on a small ThreadPool.
+    class AsyncFileReader
+    {
+    public:
+        // Bytes is null on failure. Runs on the reader's completion thread, or on the caller's when the file cannot be
+        // opened; keep it short, other completions wait behind it.
+        using ReadCallback = std::function<void(std::shared_ptr<std::vector<std::byte>> Bytes)>;
+
+        AsyncFileReader(std::size_t QueueDepth, std::size_t FallbackConcurrency);
+
+        // Completes every queued and in-flight read first
+        ~AsyncFileReader();
+
+        AsyncFileReader(const AsyncFileReader&) = delete;
+        AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+        void Read(std::string Path, ReadCallback OnComplete);
+
+        bool IsUsingIoUring() const { return Uring != nullptr; }
+        void SetFallbackConcurrency(std::size_t Concurrency) { FallbackWorkers.SetMaxConcurrency(Concurrency); }
+
+    private:
+        struct PendingRead
+        {
+            std::string Path;
+            ReadCallback OnComplete;
+            int File = -1;
+            std::size_t Size = 0;
+        };
+
+        struct Ring;
+
+        void RunRing();
+
+        // Owned by the ring thread once set up; null when io_uring is unavailable
+        std::unique_ptr<Ring> Uring;
+
+        std::mutex Mutex;
+        std::condition_variable Condition;
+        std::deque<PendingRead> Queued;
+        bool bStopping = false;
+        std::thread RingThread;
+
+        ThreadPool FallbackWorkers;
+    };
+}
@@ -0,0 +1,111 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace Core
+{
+    ThreadPool::ThreadPool(std::size_t MaxConcurrency)
+        : MaxConcurrency(std::max<std::size_t>(MaxConcurrency, 1))
+    {
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard Lock(Mutex);
+            bStopping = true;
+        }
+        Condition.notify_all();
+
+        for (std::thread& Thread : Threads)
+        {
+            Thread.join();
+        }
+    }
+
+    void ThreadPool::Enqueue(std::function<void()> Job, std::size_t Priority)
+    {
+        {
+            std::lock_guard Lock(Mutex);
+            if (Jobs.size() <= Priority)
+            {
+                Jobs.resize(Priority + 1);
+            }
+            Jobs[Priority].push_back(std::move(Job));
+            ++QueuedCount;
+            SpawnThreadsLocked();
+        }
+        Condition.notify_one();
+    }
+
+    void ThreadPool::SetMaxConcurrency(std::size_t InMaxConcurrency)
+    {
+        {
+            std::lock_guard Lock(Mutex);
+            MaxConcurrency = std::max<std::size_t>(InMaxConcurrency, 1);
+            SpawnThreadsLocked();
+        }
+        Condition.notify_all();
+    }
+
+    std::size_t ThreadPool::GetMaxConcurrency() const
+    {
+        std::lock_guard Lock(Mutex);
+        return MaxConcurrency;
+    }
+
+    std::size_t ThreadPool::GetQueuedCount() const
+    {
+        std::lock_guard Lock(Mutex);
+        return QueuedCount;
+    }
+
+    std::size_t ThreadPool::GetActiveCount() const
+    {
+        std::lock_guard Lock(Mutex);
+        return ActiveCount;
+    }
+
+    void ThreadPool::SpawnThreadsLocked()
+    {
+        const std::size_t Wanted = std::min(MaxConcurrency, ActiveCount + QueuedCount);
+        while (Threads.size() < Wanted)
+        {
+            Threads.emplace_back(&ThreadPool::WorkerLoop, this);
+        }
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        std::unique_lock Lock(Mutex);
+        while (true)
+        {
+            Condition.wait(Lock, [this]()
+            {
+                return bStopping || (QueuedCount > 0 && ActiveCount < MaxConcurrency);
+            });
+
+            // Queued jobs still run on shutdown; they usually own promises someone is waiting on
+            if (QueuedCount == 0)
+            {
+                return;
+            }
+
+            auto Queue = std::find_if(Jobs.begin(), Jobs.end(), [](const auto& Level)
+            {
+                return !Level.empty();
+            });
+            std::function<void()> Job = std::move(Queue->front());
+            Queue->pop_front();
+            --QueuedCount;
+            ++ActiveCount;
+
+            Lock.unlock();
+            Job();
+            Lock.lock();
+
+            --ActiveCount;
+            Condition.notify_one();
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Core
+{
+    // Job queue with an adjustable cap on how many jobs run at once. Threads are spawned lazily up to the cap.
+    // Lower Priority values run first; jobs of equal priority run in FIFO order.
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(std::size_t MaxConcurrency);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void Enqueue(std::function<void()> Job, std::size_t Priority = 0);
+
+        // Lowering the cap lets running jobs finish; surplus threads simply stay idle
+        void SetMaxConcurrency(std::size_t InMaxConcurrency);
+        std::size_t GetMaxConcurrency() const;
+
+        std::size_t GetQueuedCount() const;
+        std::size_t GetActiveCount() const;
+
+    private:
+        void SpawnThreadsLocked();
+        void WorkerLoop();
+
+        mutable std::mutex Mutex;
+        std::condition_variable Condition;
+        std::vector<std::deque<std::function<void()>>> Jobs;
+        std::size_t QueuedCount = 0;
+        std::vector<std::thread> Threads;
+        std::size_t MaxConcurrency = 1;
+        std::size_t ActiveCount = 0;
+        bool bStopping = false;
+    };
+}
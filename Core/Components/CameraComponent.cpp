@@ -20,20 +20,23 @@ namespace Core
     void CameraComponent::SetZoom(float Zoom)
     {
         ZoomLevel = Zoom;
+        MarkChanged();
     }
 
     void CameraComponent::SetViewport(float Left, float Top, float Width, float Height)
     {
         Viewport = sf::FloatRect{{Left, Top}, {Width, Height}};
+        MarkChanged();
     }
 
     sf::View CameraComponent::GetView() const
     {
         sf::View View;
 
+        const sf::Vector2f CameraPosition = GetOwner()->Transform()->GetWorldPosition();
         sf::Vector2f RoundedPosition(
-            std::round(GetOwner()->Transform()->Position.x),
-            std::round(GetOwner()->Transform()->Position.y)
+            std::round(CameraPosition.x),
+            std::round(CameraPosition.y)
         );
 
         View.setCenter(RoundedPosition);
@@ -1,6 +1,7 @@
 ﻿#include "Component.h"
 
 #include "../Systems/AssetRegistrySystem.h"
+#include "../World/World.h"
 
 namespace Core
 {
@@ -19,4 +20,22 @@ namespace Core
         }
         return nullptr;
     }
+
+    void Component::MarkChanged()
+    {
+        ++ChangeTracking.Version;
+
+        if (!ChangeTracking.bRegistered || ChangeTracking.bChangePending)
+        {
+            return;
+        }
+
+        if (WorldObject* Owner = GetOwner())
+        {
+            if (World* OwningWorld = Owner->GetWorld())
+            {
+                OwningWorld->RecordComponentChanged(*this);
+            }
+        }
+    }
 }
@@ -1,8 +1,11 @@
 ﻿#pragma once
 
+#include <concepts>
 #include <memory>
 
+#include "ComponentPhase.hpp"
 #include "../EngineContext.hpp"
+#include "../World/ComponentChanges.hpp"
 #include "../Interfaces/IRenderable.hpp"
 #include "../Interfaces/ITickable.hpp"
 #include "../World/WorldObject.h"
@@ -43,8 +46,23 @@ namespace Core
             return nlohmann::json::object();
         }
 
+        // Puts the component back to a state an earlier ToJson returned, for editor undo. Initialize only sets the
+        // keys present, so components whose ToJson leaves out defaults override this to reset them first.
+        virtual void RestoreJson(const nlohmann::json& Data)
+        {
+            Initialize(Data);
+        }
+
         const std::string& GetName() const { return Name; }
 
+        ComponentPhase GetPhases() const { return EnabledPhases; }
+        void SetPhases(ComponentPhase InPhases) { EnabledPhases = InPhases; }
+
+        // Bumps the change version and reports the component in next frame's World::GetChanges<T>()
+        void MarkChanged();
+        std::uint64_t GetChangeVersion() const { return ChangeTracking.Version; }
+        ComponentChangeTracking& GetChangeTracking() { return ChangeTracking; }
+
         template <typename T>
             requires IsComponent<T>
         T* GetComponent()
@@ -66,5 +84,29 @@ namespace Core
         std::weak_ptr<WorldObject> OwnerWeak;
         std::shared_ptr<EngineContext> Context;
         std::string Name;
+        ComponentPhase EnabledPhases = ComponentPhase::All;
+        ComponentChangeTracking ChangeTracking;
     };
+
+    template <typename T>
+    constexpr ComponentPhase DetectComponentPhases()
+    {
+        if constexpr (requires { { T::Phases } -> std::convertible_to<ComponentPhase>; })
+        {
+            return T::Phases;
+        }
+        else
+        {
+            ComponentPhase Detected = ComponentPhase::None;
+            if constexpr (!std::is_same_v<decltype(&T::Tick), void (Component::*)(float)>)
+            {
+                Detected |= ComponentPhase::Tick;
+            }
+            if constexpr (!std::is_same_v<decltype(&T::Render), void (Component::*)()>)
+            {
+                Detected |= ComponentPhase::Render;
+            }
+            return Detected;
+        }
+    }
 }
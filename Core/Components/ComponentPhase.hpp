@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Core
+{
+    enum class ComponentPhase : std::uint8_t
+    {
+        None = 0,
+        Tick = 1 << 0,
+        Render = 1 << 1,
+        All = Tick | Render
+    };
+
+    constexpr ComponentPhase operator|(ComponentPhase A, ComponentPhase B)
+    {
+        return static_cast<ComponentPhase>(static_cast<std::uint8_t>(A) | static_cast<std::uint8_t>(B));
+    }
+
+    constexpr ComponentPhase operator&(ComponentPhase A, ComponentPhase B)
+    {
+        return static_cast<ComponentPhase>(static_cast<std::uint8_t>(A) & static_cast<std::uint8_t>(B));
+    }
+
+    constexpr ComponentPhase& operator|=(ComponentPhase& A, ComponentPhase B)
+    {
+        A = A | B;
+        return A;
+    }
+
+    constexpr bool HasPhase(ComponentPhase Phases, ComponentPhase Phase)
+    {
+        return (Phases & Phase) != ComponentPhase::None;
+    }
+
+    // Defined in Component.h once Component is complete. Components may opt out of detection by declaring
+    // `static constexpr ComponentPhase Phases`.
+    template <typename T>
+    constexpr ComponentPhase DetectComponentPhases();
+}
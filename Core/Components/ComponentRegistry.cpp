@@ -1,8 +1,9 @@
 ﻿#include "ComponentRegistry.h"
 
-#include <cstdio>
 #include <utility>
 
+#include "../Log/Log.h"
+
 namespace Core
 {
     ComponentRegistry& ComponentRegistry::Get()
@@ -11,10 +12,10 @@ namespace Core
         return Instance;
     }
 
-    void ComponentRegistry::Register(const std::string& Name, FactoryFunc Factory)
+    void ComponentRegistry::Register(const std::string& Name, FactoryFunc Factory, ComponentPhase Phases)
     {
-        Factories[Name] = std::move(Factory);
-        std::printf("Registered component: %s\n", Name.c_str());
+        Factories[Name] = {std::move(Factory), Phases};
+        Log::Verbose(ELogCategory::Components, "Registered component: %s", Name.c_str());
     }
 
     std::shared_ptr<Component> ComponentRegistry::Create(const std::string& Name,
@@ -24,10 +25,15 @@ namespace Core
         auto It = Factories.find(Name);
         if (It != Factories.end())
         {
-            return It->second(Owner, std::move(Context));
+            std::shared_ptr<Component> Created = It->second.Factory(Owner, std::move(Context));
+            if (Created)
+            {
+                Created->SetPhases(It->second.Phases);
+            }
+            return Created;
         }
 
-        std::printf("Warning: Unknown component type '%s'\n", Name.c_str());
+        Log::Warning(ELogCategory::Components, "Unknown component type '%s'", Name.c_str());
         return nullptr;
     }
 
@@ -43,4 +49,15 @@ namespace Core
 
         return TypeNames;
     }
+
+    ComponentPhase ComponentRegistry::GetPhases(const std::string& Name) const
+    {
+        auto It = Factories.find(Name);
+        if (It != Factories.end())
+        {
+            return It->second.Phases;
+        }
+
+        return ComponentPhase::All;
+    }
 }
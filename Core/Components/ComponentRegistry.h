@@ -19,13 +19,20 @@ namespace Core
 
         static ComponentRegistry& Get();
 
-        void Register(const std::string& Name, FactoryFunc Factory);
+        void Register(const std::string& Name, FactoryFunc Factory, ComponentPhase Phases = ComponentPhase::All);
         std::shared_ptr<Component> Create(const std::string& Name, const std::shared_ptr<WorldObject>& Owner, std::shared_ptr<EngineContext> Context);
         std::vector<std::string> GetRegisteredTypeNames() const;
+        ComponentPhase GetPhases(const std::string& Name) const;
 
     private:
+        struct Registration
+        {
+            FactoryFunc Factory;
+            ComponentPhase Phases = ComponentPhase::All;
+        };
+
         ComponentRegistry() = default;
-        std::unordered_map<std::string, FactoryFunc> Factories;
+        std::unordered_map<std::string, Registration> Factories;
     };
 
 #define REGISTER_COMPONENT(ClassName) \
@@ -34,7 +41,7 @@ namespace Core
             Core::ComponentRegistry::Get().Register(#ClassName, \
             [](const std::shared_ptr<Core::WorldObject>& Owner, std::shared_ptr<Core::EngineContext> Context) { \
             return std::make_shared<ClassName>(Owner, Context); \
-            }); \
+            }, Core::DetectComponentPhases<ClassName>()); \
         return true; \
         }(); \
     }
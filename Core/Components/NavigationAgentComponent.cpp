@@ -0,0 +1,277 @@
+#include "NavigationAgentComponent.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "PlayerCharacterComponent.h"
+#include "TileMapComponent.h"
+#include "TransformComponent.h"
+#include "../Log/Log.h"
+#include "../Navigation/FlowField.h"
+#include "../SystemsRegistry.hpp"
+#include "../Systems/NavigationSystem.h"
+#include "../World/World.h"
+#include "../World/WorldConstants.h"
+#include "../World/WorldObject.h"
+
+namespace Core
+{
+    REGISTER_COMPONENT(NavigationAgentComponent);
+
+    namespace
+    {
+        // The closest a waypoint counts as reached, however slowly the agent moves
+        constexpr float MinArrivalDistance = 2.0f;
+
+        sf::Vector2f GetMapOrigin(TileMapComponent& Map)
+        {
+            if (WorldObject* Owner = Map.GetOwner())
+            {
+                if (std::shared_ptr<TransformComponent> Transform = Owner->Components().Get<TransformComponent>())
+                {
+                    return Transform->GetWorldPosition();
+                }
+            }
+            return {0.0f, 0.0f};
+        }
+
+        TilePoint ToTile(sf::Vector2f Point, sf::Vector2f MapOrigin)
+        {
+            return {static_cast<int>(std::floor((Point.x - MapOrigin.x) / WorldConstants::TileSize)),
+                    static_cast<int>(std::floor((Point.y - MapOrigin.y) / WorldConstants::TileSize))};
+        }
+
+        // The owner's position is the top-left of a tile-sized footprint; it stands on the tile under the middle
+        TilePoint GetStandingTile(sf::Vector2f Position, sf::Vector2f MapOrigin)
+        {
+            return ToTile(Position + sf::Vector2f(WorldConstants::TileSize, WorldConstants::TileSize) * 0.5f, MapOrigin);
+        }
+
+        // The owner position that lines it up with Tile
+        sf::Vector2f ToPosition(TilePoint Tile, sf::Vector2f MapOrigin)
+        {
+            return MapOrigin + sf::Vector2f(static_cast<float>(Tile.X), static_cast<float>(Tile.Y)) * WorldConstants::TileSize;
+        }
+
+        void StepTowards(TransformComponent& Transform, PlayerCharacterComponent* Character, sf::Vector2f Offset,
+                         float StepLength)
+        {
+            const float Distance = Offset.length();
+            if (Distance == 0.0f)
+            {
+                return;
+            }
+
+            if (Character)
+            {
+                Character->AddMovementInput(Offset / Distance);
+            }
+            else
+            {
+                Transform.Translate(Offset / Distance * std::min(StepLength, Distance));
+            }
+        }
+    }
+
+    NavigationAgentComponent::NavigationAgentComponent(const std::shared_ptr<WorldObject>& Owner,
+                                                       std::shared_ptr<EngineContext> Context)
+        : Component(Owner, std::move(Context), "NavigationAgentComponent")
+    {
+    }
+
+    bool NavigationAgentComponent::Initialize(const nlohmann::json& Data)
+    {
+        Speed = Data.value("speed", Speed);
+        return true;
+    }
+
+    nlohmann::json NavigationAgentComponent::ToJson() const
+    {
+        return {{"speed", Speed}};
+    }
+
+    std::shared_ptr<TileMapComponent> NavigationAgentComponent::FindMap(sf::Vector2f WorldTarget, sf::Vector2f& OutMapOrigin) const
+    {
+        World* OwningWorld = GetOwner() ? GetOwner()->GetWorld() : nullptr;
+        if (!OwningWorld)
+        {
+            return nullptr;
+        }
+
+        // The first map the target lies on
+        for (const auto& [MapComponent] : OwningWorld->Query<TileMapComponent>())
+        {
+            const sf::Vector2f Origin = GetMapOrigin(*MapComponent);
+            const TilePoint Goal = ToTile(WorldTarget, Origin);
+            if (Goal.X >= 0 && Goal.Y >= 0 && Goal.X < static_cast<int>(MapComponent->GetWidth()) &&
+                Goal.Y < static_cast<int>(MapComponent->GetHeight()) && MapComponent->GetOwner())
+            {
+                OutMapOrigin = Origin;
+                return MapComponent->GetOwner()->Components().Get<TileMapComponent>();
+            }
+        }
+
+        Log::Warning(ELogCategory::Components, "NavigationAgentComponent: no tile map under (%.1f, %.1f)", WorldTarget.x,
+                     WorldTarget.y);
+        return nullptr;
+    }
+
+    void NavigationAgentComponent::MoveTo(sf::Vector2f WorldTarget)
+    {
+        Stop();
+
+        WorldObject* Owner = GetOwner();
+        std::shared_ptr<NavigationSystem> Navigation = GetContext().SystemsRegistry->GetCoreSystem<NavigationSystem>();
+        if (!Owner || !Navigation || !Owner->Transform())
+        {
+            return;
+        }
+
+        sf::Vector2f MapOrigin;
+        std::shared_ptr<TileMapComponent> Map = FindMap(WorldTarget, MapOrigin);
+        if (!Map)
+        {
+            return;
+        }
+
+        const TilePoint Start = GetStandingTile(Owner->Transform()->GetWorldPosition(), MapOrigin);
+        const TilePoint Goal = ToTile(WorldTarget, MapOrigin);
+
+        bWaitingForPath = true;
+        std::weak_ptr<NavigationAgentComponent> Self = Owner->Components().Get<NavigationAgentComponent>();
+        Navigation->RequestPath(Map, Start, Goal, [Self, Id = RequestId, MapOrigin](const PathResult& Result)
+        {
+            std::shared_ptr<NavigationAgentComponent> Agent = Self.lock();
+            if (Agent && Agent->RequestId == Id)
+            {
+                Agent->OnPathFound(Result, MapOrigin);
+            }
+        });
+    }
+
+    void NavigationAgentComponent::FlowTo(sf::Vector2f WorldTarget)
+    {
+        Stop();
+
+        sf::Vector2f MapOrigin;
+        if (std::shared_ptr<TileMapComponent> Map = FindMap(WorldTarget, MapOrigin))
+        {
+            FlowMap = Map;
+            FlowMapOrigin = MapOrigin;
+            FlowGoal = ToTile(WorldTarget, MapOrigin);
+        }
+    }
+
+    void NavigationAgentComponent::Stop()
+    {
+        ++RequestId;
+        bWaitingForPath = false;
+        Waypoints.clear();
+        NextWaypoint = 0;
+        FlowMap.reset();
+    }
+
+    void NavigationAgentComponent::OnPathFound(const PathResult& Result, sf::Vector2f MapOrigin)
+    {
+        bWaitingForPath = false;
+        if (!Result.IsFound())
+        {
+            Log::Verbose(ELogCategory::Components, "NavigationAgentComponent: no path from (%d, %d) to (%d, %d)",
+                         Result.Start.X, Result.Start.Y, Result.Goal.X, Result.Goal.Y);
+            return;
+        }
+
+        Waypoints.clear();
+        for (const TilePoint& Waypoint : Result.Waypoints)
+        {
+            Waypoints.push_back(ToPosition(Waypoint, MapOrigin));
+        }
+        NextWaypoint = 0;
+    }
+
+    void NavigationAgentComponent::Tick(float DeltaTimeS)
+    {
+        WorldObject* Owner = GetOwner();
+        TransformComponent* Transform = Owner ? Owner->Transform() : nullptr;
+        if (!Transform)
+        {
+            return;
+        }
+
+        PlayerCharacterComponent* Character = GetComponent<PlayerCharacterComponent>();
+        const float StepLength = (Character ? Character->GetMovementSpeed() : Speed) * DeltaTimeS;
+
+        if (!FlowMap.expired())
+        {
+            FollowFlowField(*Transform, Character, StepLength);
+        }
+        else if (NextWaypoint < Waypoints.size())
+        {
+            FollowPath(*Transform, Character, StepLength);
+        }
+    }
+
+    void NavigationAgentComponent::FollowPath(TransformComponent& Transform, PlayerCharacterComponent* Character,
+                                              float StepLength)
+    {
+        const float ArrivalDistance = std::max(MinArrivalDistance, StepLength);
+
+        // Waypoints already within reach are passed without stopping
+        sf::Vector2f ToWaypoint = Waypoints[NextWaypoint] - Transform.GetWorldPosition();
+        while (ToWaypoint.length() <= ArrivalDistance && NextWaypoint + 1 < Waypoints.size())
+        {
+            ++NextWaypoint;
+            ToWaypoint = Waypoints[NextWaypoint] - Transform.GetWorldPosition();
+        }
+
+        // A character only moves whole steps, so it stops within one of the end; a bare transform lands on it
+        if (NextWaypoint + 1 == Waypoints.size() && ToWaypoint.length() <= ArrivalDistance)
+        {
+            if (!Character)
+            {
+                Transform.Translate(ToWaypoint);
+            }
+            ++NextWaypoint;
+            return;
+        }
+
+        StepTowards(Transform, Character, ToWaypoint, StepLength);
+    }
+
+    void NavigationAgentComponent::FollowFlowField(TransformComponent& Transform, PlayerCharacterComponent* Character,
+                                                   float StepLength)
+    {
+        std::shared_ptr<TileMapComponent> Map = FlowMap.lock();
+        std::shared_ptr<NavigationSystem> Navigation = GetContext().SystemsRegistry->GetCoreSystem<NavigationSystem>();
+        std::shared_ptr<const FlowField> Field = Navigation ? Navigation->GetFlowField(Map, FlowGoal) : nullptr;
+        if (!Field)
+        {
+            // Still being built
+            return;
+        }
+
+        // Heads for the tile the field points to from the one the owner stands on; a tile cut off from the goal
+        // waits there, in case an edit opens a way
+        const sf::Vector2f Position = Transform.GetWorldPosition();
+        const TilePoint Tile = GetStandingTile(Position, FlowMapOrigin);
+        const TilePoint Step = Field->GetStep(Tile.X, Tile.Y);
+        const TilePoint Next{Tile.X + Step.X, Tile.Y + Step.Y};
+        if (!(Tile == FlowGoal) && Step == TilePoint{})
+        {
+            return;
+        }
+
+        const sf::Vector2f ToNext = ToPosition(Next, FlowMapOrigin) - Position;
+        if (Next == FlowGoal && ToNext.length() <= std::max(MinArrivalDistance, StepLength))
+        {
+            if (!Character)
+            {
+                Transform.Translate(ToNext);
+            }
+            Stop();
+            return;
+        }
+
+        StepTowards(Transform, Character, ToNext, StepLength);
+    }
+}
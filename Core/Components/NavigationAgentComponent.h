@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Component.h"
+#include "ComponentRegistry.h"
+#include "../Navigation/PathCache.h"
+#include <SFML/System/Vector2.hpp>
+
+namespace Core
+{
+    class PlayerCharacterComponent;
+    class TileMapComponent;
+    class TransformComponent;
+
+    // Walks its owner to a point in the world, along a path from the NavigationSystem or down a flow field shared
+    // with everything else heading there. A PlayerCharacterComponent on the owner does the moving when there is
+    // one, at its own speed and colliding as it would; otherwise the transform is moved directly at Speed.
+    class NavigationAgentComponent : public Component
+    {
+    public:
+        NavigationAgentComponent(const std::shared_ptr<WorldObject>& Owner, std::shared_ptr<EngineContext> Context);
+
+        bool Initialize(const nlohmann::json& Data) override;
+        void Tick(float DeltaTimeS) override;
+        nlohmann::json ToJson() const override;
+
+        // Replaces whatever the agent was doing. It sets off once the path arrives, a frame or more later, and stays
+        // where it is when the target cannot be reached.
+        void MoveTo(sf::Vector2f WorldTarget);
+
+        // Like MoveTo, but for crowds: every agent flowing to the same tile follows one flow field, read a tile at a
+        // time each tick, instead of asking for a path of its own. Edits to the map reroute it without a new request.
+        void FlowTo(sf::Vector2f WorldTarget);
+
+        void Stop();
+        bool IsMoving() const { return bWaitingForPath || NextWaypoint < Waypoints.size() || !FlowMap.expired(); }
+
+        void SetSpeed(float InSpeed) { Speed = InSpeed; }
+        float GetSpeed() const { return Speed; }
+
+    private:
+        // The map under WorldTarget and the world position of its top-left corner
+        std::shared_ptr<TileMapComponent> FindMap(sf::Vector2f WorldTarget, sf::Vector2f& OutMapOrigin) const;
+
+        // MapOrigin is the world position of the map's top-left corner when the path was asked for
+        void OnPathFound(const PathResult& Result, sf::Vector2f MapOrigin);
+
+        void FollowPath(TransformComponent& Transform, PlayerCharacterComponent* Character, float StepLength);
+        void FollowFlowField(TransformComponent& Transform, PlayerCharacterComponent* Character, float StepLength);
+
+        float Speed = 120.0f;
+
+        // Owner positions, each one lining the owner up with a tile the path turns at
+        std::vector<sf::Vector2f> Waypoints;
+        std::size_t NextWaypoint = 0;
+
+        // Paths asked for before the latest MoveTo or Stop are ignored when they arrive
+        std::uint64_t RequestId = 0;
+        bool bWaitingForPath = false;
+
+        // Set while flowing to FlowGoal, a tile of FlowMap
+        std::weak_ptr<TileMapComponent> FlowMap;
+        sf::Vector2f FlowMapOrigin;
+        TilePoint FlowGoal;
+    };
+}
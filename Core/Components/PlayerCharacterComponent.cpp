@@ -1,6 +1,8 @@
 #include "PlayerCharacterComponent.h"
 #include "ComponentRegistry.h"
+#include "TileMapComponent.h"
 #include "TransformComponent.h"
+#include "../World/World.h"
 #include "../World/WorldObject.h"
 #include <cmath>
 
@@ -37,12 +39,23 @@ namespace Core
 
         if (std::shared_ptr<TransformComponent> Transform = GetOwner()->Components().Get<TransformComponent>())
         {
-            Transform->Position += Movement;
+            // Cut short where the collision box would run into a solid tile
+            if (World* OwningWorld = GetOwner()->GetWorld())
+            {
+                const sf::FloatRect WorldBox(Transform->GetWorldPosition() + CollisionBox.position, CollisionBox.size);
+                Movement = TileMapComponent::MoveBoxInWorld(*OwningWorld, WorldBox, Movement);
+            }
+            Transform->Translate(Movement);
         }
 
         AccumulatedMovementInput = sf::Vector2f(0.0f, 0.0f);
     }
 
+    void PlayerCharacterComponent::SetCollisionBox(sf::Vector2f Offset, sf::Vector2f Size)
+    {
+        CollisionBox = sf::FloatRect(Offset, Size);
+    }
+
     void PlayerCharacterComponent::AddMovementInput(sf::Vector2f Direction, float Scale)
     {
         AccumulatedMovementInput += Direction * Scale;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Component.h"
+#include <SFML/Graphics/Rect.hpp>
 #include <SFML/System/Vector2.hpp>
 
 namespace Core
@@ -18,8 +19,15 @@ namespace Core
         void SetMovementSpeed(float Speed) { MovementSpeed = Speed; }
         float GetMovementSpeed() const { return MovementSpeed; }
 
+        // The box that collides with solid tiles, relative to the character's position
+        void SetCollisionBox(sf::Vector2f Offset, sf::Vector2f Size);
+        sf::FloatRect GetCollisionBox() const { return CollisionBox; }
+
     private:
         sf::Vector2f AccumulatedMovementInput{0.0f, 0.0f};
         float MovementSpeed = 200.0f;
+
+        // A little under a tile, so the character fits through one-tile gaps without lining up exactly
+        sf::FloatRect CollisionBox{{2.0f, 4.0f}, {12.0f, 12.0f}};
     };
 }
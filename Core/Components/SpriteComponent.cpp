@@ -5,6 +5,7 @@
 #include "../EngineContext.hpp"
 #include "../SystemsRegistry.hpp"
 #include "../Systems/AssetRegistrySystem.h"
+#include "../Log/Log.h"
 
 namespace Core
 {
@@ -27,10 +28,23 @@ namespace Core
             return false;
         }
 
-        std::shared_ptr<const sf::Texture> Texture = AssetRegistry->Get<sf::Texture>(TextureAssetId);
+        Texture = AssetRegistry->Find<sf::Texture>(TextureAssetId);
         if (!Texture)
         {
-            return false;
+            // Not resident yet; draw the placeholder until the texture streams in
+            Texture = AssetRegistry->GetPlaceholderTexture();
+            if (!Texture)
+            {
+                Log::Warning(ELogCategory::Components, "Asset not found for path: %s", TextureAssetId.c_str());
+                return false;
+            }
+            PendingTexturePath = TextureAssetId;
+            ObservedStoreVersion = AssetRegistry->GetStoreVersion();
+        }
+        else
+        {
+            TextureAsset = AssetRegistry->GetHandle<sf::Texture>(TextureAssetId);
+            ObservedReloadVersion = AssetRegistry->GetReloadVersion();
         }
 
         Sprite = std::make_shared<sf::Sprite>(*Texture);
@@ -38,15 +52,63 @@ namespace Core
         return true;
     }
 
+    void SpriteComponent::ResolvePendingTexture()
+    {
+        std::shared_ptr<AssetRegistrySystem> AssetRegistry = GetContext().SystemsRegistry->GetCoreSystem<
+            AssetRegistrySystem>();
+        if (!AssetRegistry || AssetRegistry->GetStoreVersion() == ObservedStoreVersion)
+        {
+            return;
+        }
+
+        ObservedStoreVersion = AssetRegistry->GetStoreVersion();
+        if (std::shared_ptr<const sf::Texture> Loaded = AssetRegistry->Find<sf::Texture>(PendingTexturePath))
+        {
+            Texture = std::move(Loaded);
+            Sprite->setTexture(*Texture, true);
+            TextureAsset = AssetRegistry->GetHandle<sf::Texture>(PendingTexturePath);
+            ObservedReloadVersion = AssetRegistry->GetReloadVersion();
+            PendingTexturePath.clear();
+        }
+    }
+
+    void SpriteComponent::RebindReloadedTexture()
+    {
+        std::shared_ptr<AssetRegistrySystem> AssetRegistry = GetContext().SystemsRegistry->GetCoreSystem<
+            AssetRegistrySystem>();
+        if (!AssetRegistry || AssetRegistry->GetReloadVersion() == ObservedReloadVersion)
+        {
+            return;
+        }
+
+        ObservedReloadVersion = AssetRegistry->GetReloadVersion();
+        std::shared_ptr<const sf::Texture> Current = AssetRegistry->Get(TextureAsset);
+        if (Current && Current != Texture)
+        {
+            Texture = std::move(Current);
+            Sprite->setTexture(*Texture, true);
+        }
+    }
+
     void SpriteComponent::Render()
     {
         if (!Sprite)
             return;
 
+        if (!PendingTexturePath.empty())
+        {
+            ResolvePendingTexture();
+        }
+        else if (TextureAsset.IsValid())
+        {
+            RebindReloadedTexture();
+        }
+
+        sf::RenderStates States;
         if (TransformComponent* Transform = GetComponent<TransformComponent>())
         {
-            Sprite->setPosition(Transform->Position);
+            States.transform = Transform->GetWorldTransform();
         }
-        GetContext().Renderer->draw(*Sprite);
+        GetContext().Renderer->draw(*Sprite, States);
     }
 }
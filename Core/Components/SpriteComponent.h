@@ -2,8 +2,12 @@
 
 #include "Component.h"
 #include "ComponentRegistry.h"
+#include "../Assets/AssetHandle.hpp"
 #include "SFML/Graphics.hpp"
 
+#include <cstdint>
+#include <string>
+
 namespace Core
 {
     class SpriteComponent : public Component
@@ -15,6 +19,19 @@ namespace Core
         void Render() override;
 
     private:
+        // Swaps the placeholder for the real texture once it has streamed in
+        void ResolvePendingTexture();
+
+        // Picks up a hot-reloaded texture; the sprite keeps the old one alive until then
+        void RebindReloadedTexture();
+
         std::shared_ptr<sf::Sprite> Sprite = nullptr;
+        std::shared_ptr<const sf::Texture> Texture;
+
+        std::string PendingTexturePath;
+        std::uint64_t ObservedStoreVersion = 0;
+
+        TextureHandle TextureAsset;
+        std::uint64_t ObservedReloadVersion = 0;
     };
 }
@@ -6,7 +6,10 @@
 #include "../SystemsRegistry.hpp"
 #include "../Systems/AssetRegistrySystem.h"
 #include "../TileMap/TileSheet.h"
+#include "../World/World.h"
 #include "../World/WorldConstants.h"
+#include <algorithm>
+#include <bit>
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 
@@ -80,6 +83,7 @@ namespace Core
     {
         TileMapData = TileMap(Width, Height);
         UpdateLayerVisibility();
+        MarkChanged();
     }
 
     void TileMapComponent::UpdateLayerVisibility()
@@ -97,6 +101,7 @@ namespace Core
         if (Layer < LayerVisibility.size())
         {
             LayerVisibility[Layer] = bVisible;
+            MarkChanged();
         }
     }
 
@@ -120,17 +125,18 @@ namespace Core
         }
 
         std::vector<std::shared_ptr<const TileSheet>> TileSheets = AssetRegistry->GetAllTileSheets();
-        if (TileSheets.empty())
+        std::shared_ptr<const sf::Texture> Placeholder = AssetRegistry->GetPlaceholderTexture();
+        if (TileSheets.empty() && !Placeholder)
         {
             return;
         }
 
-        sf::Vector2f ObjectPosition(0.0f, 0.0f);
+        sf::RenderStates States;
         if (WorldObject* Owner = GetOwner())
         {
             if (std::shared_ptr<TransformComponent> Transform = Owner->Components().Get<TransformComponent>())
             {
-                ObjectPosition = Transform->Position;
+                States.transform = Transform->GetWorldTransform();
             }
         }
 
@@ -141,46 +147,59 @@ namespace Core
                 continue;
             }
 
-            for (uint Y = 0; Y < TileMapData.GetHeight(); ++Y)
+            // Empty chunks are skipped whole, and only the set bits of each occupied row are visited
+            for (uint ChunkY = 0; ChunkY < TileMapData.GetChunkRows(); ++ChunkY)
             {
-                for (uint X = 0; X < TileMapData.GetWidth(); ++X)
+                for (uint ChunkX = 0; ChunkX < TileMapData.GetChunkColumns(); ++ChunkX)
                 {
-                    const Tile& Tile = TileMapData.GetTile(X, Y, Layer);
-
-                    if (Tile.IsEmpty())
-                    {
-                        continue;
-                    }
-
-                    std::optional<uint> TileSheetId = Tile.GetTileSheetId();
-                    uint TileSheetIndex = TileSheetId.value();
-
-                    if (TileSheetIndex >= TileSheets.size())
-                    {
-                        continue;
-                    }
-
-                    std::shared_ptr<const TileSheet> TileSheet = TileSheets[TileSheetIndex];
-                    if (!TileSheet)
+                    if (TileMapData.IsChunkEmpty(Layer, ChunkX, ChunkY))
                     {
                         continue;
                     }
 
-                    std::shared_ptr<const sf::Texture> Texture = TileSheet->GetTexture();
-                    if (!Texture)
+                    const uint LastY = std::min(TileMapData.GetHeight(), (ChunkY + 1) * TileMap::ChunkSize);
+                    for (uint Y = ChunkY * TileMap::ChunkSize; Y < LastY; ++Y)
                     {
-                        continue;
+                        for (std::uint32_t Occupied = TileMapData.GetChunkRowOccupancy(Layer, ChunkX, Y); Occupied != 0;
+                             Occupied &= Occupied - 1)
+                        {
+                            const uint X = ChunkX * TileMap::ChunkSize + std::countr_zero(Occupied);
+                            const Tile& Tile = TileMapData.GetTile(X, Y, Layer);
+
+                            std::optional<uint> TileSheetId = Tile.GetTileSheetId();
+                            uint TileSheetIndex = TileSheetId.value();
+
+                            std::shared_ptr<const TileSheet> TileSheet = TileSheetIndex < TileSheets.size()
+                                ? TileSheets[TileSheetIndex]
+                                : nullptr;
+                            std::shared_ptr<const sf::Texture> Texture = TileSheet ? TileSheet->GetTexture() : nullptr;
+
+                            // Sheets that are still streaming in draw as placeholder tiles
+                            sf::IntRect TileRect;
+                            if (Texture)
+                            {
+                                TileRect = TileSheet->GetTileRect(Tile.GetTileIndex());
+                            }
+                            else if (Placeholder)
+                            {
+                                Texture = Placeholder;
+                                TileRect = sf::IntRect({0, 0}, {static_cast<int>(WorldConstants::TileSize),
+                                                                static_cast<int>(WorldConstants::TileSize)});
+                            }
+                            else
+                            {
+                                continue;
+                            }
+
+                            sf::Sprite TileSprite(*Texture);
+                            TileSprite.setTextureRect(TileRect);
+
+                            sf::Vector2f TileLocalPos(X * WorldConstants::TileSize, Y * WorldConstants::TileSize);
+                            TileSprite.setPosition(TileLocalPos);
+
+                            Context.Renderer->draw(TileSprite, States);
+                        }
                     }
-
-                    sf::IntRect TileRect = TileSheet->GetTileRect(Tile.GetTileIndex());
-
-                    sf::Sprite TileSprite(*Texture);
-                    TileSprite.setTextureRect(TileRect);
-
-                    sf::Vector2f TileLocalPos(X * WorldConstants::TileSize, Y * WorldConstants::TileSize);
-                    TileSprite.setPosition(TileLocalPos + ObjectPosition);
-
-                    Context.Renderer->draw(TileSprite);
                 }
             }
         }
@@ -189,32 +208,71 @@ namespace Core
     TileMapComponent::TileBounds TileMapComponent::GetValidTileBounds() const
     {
         TileBounds Bounds;
-        Bounds.MinX = TileMapData.GetWidth();
-        Bounds.MinY = TileMapData.GetHeight();
-        Bounds.MaxX = 0;
-        Bounds.MaxY = 0;
-        Bounds.IsValid = false;
+        if (const std::optional<TileMapBounds> Used = TileMapData.GetUsedBounds())
+        {
+            Bounds.MinX = Used->MinX;
+            Bounds.MinY = Used->MinY;
+            Bounds.MaxX = Used->MaxX;
+            Bounds.MaxY = Used->MaxY;
+            Bounds.IsValid = true;
+        }
 
-        for (uint Layer = 0; Layer < TileMapData.GetLayerCount(); ++Layer)
+        return Bounds;
+    }
+
+    const TileCollisionGrid& TileMapComponent::GetCollisionGrid()
+    {
+        bool bSheetsChanged = false;
+        if (std::shared_ptr<AssetRegistrySystem> AssetRegistry = GetContext().SystemsRegistry->GetCoreSystem<AssetRegistrySystem>())
         {
-            for (uint Y = 0; Y < TileMapData.GetHeight(); ++Y)
+            const std::uint64_t StoreVersion = AssetRegistry->GetStoreVersion();
+            const std::uint64_t ReloadVersion = AssetRegistry->GetReloadVersion();
+            if (StoreVersion != CollisionStoreVersion || ReloadVersion != CollisionReloadVersion)
             {
-                for (uint X = 0; X < TileMapData.GetWidth(); ++X)
-                {
-                    const Tile& Tile = TileMapData.GetTile(X, Y, Layer);
-                    if (!Tile.IsEmpty())
-                    {
-                        Bounds.IsValid = true;
-                        if (X < Bounds.MinX) Bounds.MinX = X;
-                        if (X > Bounds.MaxX) Bounds.MaxX = X;
-                        if (Y < Bounds.MinY) Bounds.MinY = Y;
-                        if (Y > Bounds.MaxY) Bounds.MaxY = Y;
-                    }
-                }
+                CollisionStoreVersion = StoreVersion;
+                CollisionReloadVersion = ReloadVersion;
+
+                // Most stores are other kinds of asset; the grid is only rebuilt when a sheet came or went
+                std::vector<std::shared_ptr<const TileSheet>> TileSheets = AssetRegistry->GetAllTileSheets();
+                bSheetsChanged = TileSheets != CollisionSheets;
+                CollisionSheets = std::move(TileSheets);
             }
         }
 
-        return Bounds;
+        CollisionGrid.Update(TileMapData, [this](const Tile& Tile)
+        {
+            const uint TileSheetIndex = Tile.GetTileSheetId().value();
+            return TileSheetIndex < CollisionSheets.size() && CollisionSheets[TileSheetIndex] &&
+                CollisionSheets[TileSheetIndex]->IsTileSolid(Tile.GetTileIndex());
+        }, bSheetsChanged);
+
+        return CollisionGrid;
+    }
+
+    CollisionMove TileMapComponent::MoveBox(const sf::FloatRect& WorldBox, sf::Vector2f Delta)
+    {
+        sf::Vector2f Origin(0.0f, 0.0f);
+        if (WorldObject* Owner = GetOwner())
+        {
+            if (std::shared_ptr<TransformComponent> Transform = Owner->Components().Get<TransformComponent>())
+            {
+                Origin = Transform->GetWorldPosition();
+            }
+        }
+
+        const CollisionBox LocalBox{WorldBox.position.x - Origin.x, WorldBox.position.y - Origin.y, WorldBox.size.x,
+                                    WorldBox.size.y};
+        return GetCollisionGrid().Sweep(LocalBox, Delta.x, Delta.y, WorldConstants::TileSize);
+    }
+
+    sf::Vector2f TileMapComponent::MoveBoxInWorld(World& InWorld, const sf::FloatRect& WorldBox, sf::Vector2f Delta)
+    {
+        for (const auto& [MapComponent] : InWorld.Query<TileMapComponent>())
+        {
+            const CollisionMove Move = MapComponent->MoveBox(WorldBox, Delta);
+            Delta = sf::Vector2f(Move.X, Move.Y);
+        }
+        return Delta;
     }
 
     nlohmann::json TileMapComponent::ToJson() const
@@ -2,10 +2,15 @@
 
 #include "Component.h"
 #include "ComponentRegistry.h"
+#include "../TileMap/TileCollisionGrid.h"
 #include "../TileMap/TileMap.h"
+#include <SFML/Graphics/Rect.hpp>
 
 namespace Core
 {
+	class TileSheet;
+	class World;
+
 	class TileMapComponent : public Component
 	{
 	public:
@@ -42,6 +47,16 @@ namespace Core
 
 		TileBounds GetValidTileBounds() const;
 
+		// Brought up to date with the tiles and the sheets' solidity on each call; only changed chunks are rebuilt
+		const TileCollisionGrid& GetCollisionGrid();
+
+		// Sweeps a box given in world space through the solid tiles and returns how far it may move. The map is taken
+		// to be translated only, not rotated or scaled.
+		CollisionMove MoveBox(const sf::FloatRect& WorldBox, sf::Vector2f Delta);
+
+		// MoveBox against every tile map in the world in turn, for anything that moves through it
+		static sf::Vector2f MoveBoxInWorld(World& InWorld, const sf::FloatRect& WorldBox, sf::Vector2f Delta);
+
 		nlohmann::json ToJson() const;
 
 	private:
@@ -49,5 +64,12 @@ namespace Core
 
 		TileMap TileMapData{DefaultTileMapSize, DefaultTileMapSize};
 		std::vector<bool> LayerVisibility;
+
+		TileCollisionGrid CollisionGrid;
+
+		// The sheets the grid was built against, refreshed when the asset registry stores or replaces anything
+		std::vector<std::shared_ptr<const TileSheet>> CollisionSheets;
+		std::uint64_t CollisionStoreVersion = 0;
+		std::uint64_t CollisionReloadVersion = 0;
 	};
 }
@@ -1,6 +1,8 @@
 #include "TransformComponent.h"
 
 #include "ComponentRegistry.h"
+#include "../World/World.h"
+#include "../Log/Log.h"
 
 namespace Core
 {
@@ -11,6 +13,25 @@ namespace Core
     {
     }
 
+    TransformComponent::~TransformComponent()
+    {
+        if (std::shared_ptr<TransformComponent> CurrentParent = Parent.lock())
+        {
+            CurrentParent->RemoveChild(this);
+        }
+
+        // Orphaned children become roots; they resolve lazily since the world may already be tearing down
+        for (const std::weak_ptr<TransformComponent>& ChildWeak : Children)
+        {
+            if (std::shared_ptr<TransformComponent> Child = ChildWeak.lock())
+            {
+                Child->Parent.reset();
+                Child->UpdateDepth(0);
+                Child->PropagateWorldDirty(false);
+            }
+        }
+    }
+
     bool TransformComponent::Initialize(const nlohmann::json& Data)
     {
         if (Data.contains("x"))
@@ -21,6 +42,288 @@ namespace Core
         {
             Position.y = Data["y"].get<float>();
         }
+        if (Data.contains("rotation"))
+        {
+            RotationDegrees = Data["rotation"].get<float>();
+        }
+        if (Data.contains("scaleX"))
+        {
+            Scale.x = Data["scaleX"].get<float>();
+        }
+        if (Data.contains("scaleY"))
+        {
+            Scale.y = Data["scaleY"].get<float>();
+        }
+        if (Data.contains("parent"))
+        {
+            PendingParentName = Data["parent"].get<std::string>();
+        }
+        MarkLocalDirty();
         return true;
     }
+
+    void TransformComponent::Start()
+    {
+        // Parents are referenced by object name, so they can only be resolved once the whole scene exists
+        if (!PendingParentName.empty())
+        {
+            std::shared_ptr<TransformComponent> ParentTransform;
+            if (World* OwningWorld = GetOwner() ? GetOwner()->GetWorld() : nullptr)
+            {
+                if (std::shared_ptr<WorldObject> ParentObject = OwningWorld->Objects().GetByName(PendingParentName))
+                {
+                    ParentTransform = ParentObject->Components().Get<TransformComponent>();
+                }
+            }
+
+            if (!ParentTransform || !SetParent(ParentTransform, false))
+            {
+                Log::Warning(ELogCategory::Components, "Transform parent '%s' could not be resolved", PendingParentName.c_str());
+            }
+            PendingParentName.clear();
+        }
+
+        QueueWorldUpdate();
+    }
+
+    nlohmann::json TransformComponent::ToJson() const
+    {
+        nlohmann::json Data;
+        Data["x"] = Position.x;
+        Data["y"] = Position.y;
+
+        if (RotationDegrees != 0.0f)
+        {
+            Data["rotation"] = RotationDegrees;
+        }
+        if (Scale.x != 1.0f || Scale.y != 1.0f)
+        {
+            Data["scaleX"] = Scale.x;
+            Data["scaleY"] = Scale.y;
+        }
+
+        if (std::shared_ptr<TransformComponent> CurrentParent = Parent.lock())
+        {
+            if (WorldObject* ParentOwner = CurrentParent->GetOwner(); ParentOwner && !ParentOwner->GetName().empty())
+            {
+                Data["parent"] = ParentOwner->GetName();
+            }
+        }
+        else if (!PendingParentName.empty())
+        {
+            Data["parent"] = PendingParentName;
+        }
+
+        return Data;
+    }
+
+    void TransformComponent::RestoreJson(const nlohmann::json& Data)
+    {
+        RotationDegrees = 0.0f;
+        Scale = {1.0f, 1.0f};
+
+        // Parents are left alone; a pending name would only be resolved at the next Start
+        nlohmann::json Values = Data;
+        Values.erase("parent");
+        Initialize(Values);
+    }
+
+    void TransformComponent::SetPosition(const sf::Vector2f& InPosition)
+    {
+        if (Position == InPosition)
+            return;
+
+        Position = InPosition;
+        MarkLocalDirty();
+    }
+
+    void TransformComponent::Translate(const sf::Vector2f& Delta)
+    {
+        SetPosition(Position + Delta);
+    }
+
+    void TransformComponent::SetRotation(float InDegrees)
+    {
+        if (RotationDegrees == InDegrees)
+            return;
+
+        RotationDegrees = InDegrees;
+        MarkLocalDirty();
+    }
+
+    void TransformComponent::SetScale(const sf::Vector2f& InScale)
+    {
+        if (Scale == InScale)
+            return;
+
+        Scale = InScale;
+        MarkLocalDirty();
+    }
+
+    sf::Vector2f TransformComponent::GetWorldPosition() const
+    {
+        return GetWorldTransform().transformPoint({0.0f, 0.0f});
+    }
+
+    void TransformComponent::SetWorldPosition(const sf::Vector2f& InWorldPosition)
+    {
+        if (std::shared_ptr<TransformComponent> CurrentParent = Parent.lock())
+        {
+            SetPosition(CurrentParent->GetWorldTransform().getInverse().transformPoint(InWorldPosition));
+        }
+        else
+        {
+            SetPosition(InWorldPosition);
+        }
+    }
+
+    const sf::Transform& TransformComponent::GetLocalTransform() const
+    {
+        if (bLocalDirty)
+        {
+            LocalTransform = sf::Transform::Identity;
+            LocalTransform.translate(Position).rotate(sf::degrees(RotationDegrees)).scale(Scale);
+            bLocalDirty = false;
+        }
+        return LocalTransform;
+    }
+
+    const sf::Transform& TransformComponent::GetWorldTransform() const
+    {
+        if (bWorldDirty)
+        {
+            if (std::shared_ptr<TransformComponent> CurrentParent = Parent.lock())
+            {
+                WorldTransform = CurrentParent->GetWorldTransform() * GetLocalTransform();
+            }
+            else
+            {
+                WorldTransform = GetLocalTransform();
+            }
+            bWorldDirty = false;
+        }
+        return WorldTransform;
+    }
+
+    bool TransformComponent::SetParent(const std::shared_ptr<TransformComponent>& NewParent, bool bKeepWorldPosition)
+    {
+        std::shared_ptr<TransformComponent> CurrentParent = Parent.lock();
+        if (NewParent == CurrentParent)
+        {
+            return true;
+        }
+
+        for (std::shared_ptr<TransformComponent> Ancestor = NewParent; Ancestor; Ancestor = Ancestor->GetParent())
+        {
+            if (Ancestor.get() == this)
+            {
+                return false;
+            }
+        }
+
+        const sf::Vector2f WorldPosition = GetWorldPosition();
+
+        if (CurrentParent)
+        {
+            CurrentParent->RemoveChild(this);
+        }
+
+        Parent = NewParent;
+        if (NewParent)
+        {
+            NewParent->Children.push_back(weak_from_this());
+        }
+
+        UpdateDepth(NewParent ? NewParent->Depth + 1 : 0);
+        MarkChanged();
+        MarkWorldDirty();
+
+        if (bKeepWorldPosition)
+        {
+            SetWorldPosition(WorldPosition);
+        }
+        return true;
+    }
+
+    void TransformComponent::UpdateWorldTransforms()
+    {
+        GetWorldTransform();
+
+        // A clean child means its whole subtree is clean, so unmoved branches are skipped entirely
+        for (const std::weak_ptr<TransformComponent>& ChildWeak : Children)
+        {
+            if (std::shared_ptr<TransformComponent> Child = ChildWeak.lock(); Child && Child->bWorldDirty)
+            {
+                Child->UpdateWorldTransforms();
+            }
+        }
+    }
+
+    void TransformComponent::MarkLocalDirty()
+    {
+        bLocalDirty = true;
+        MarkChanged();
+        MarkWorldDirty();
+    }
+
+    void TransformComponent::MarkWorldDirty()
+    {
+        if (bWorldDirty)
+            return;
+
+        PropagateWorldDirty(true);
+        QueueWorldUpdate();
+    }
+
+    void TransformComponent::PropagateWorldDirty(bool bRecordChange)
+    {
+        // A dirty transform always has dirty descendants, so propagation can stop at the first dirty node
+        if (bWorldDirty)
+            return;
+
+        bWorldDirty = true;
+        for (const std::weak_ptr<TransformComponent>& ChildWeak : Children)
+        {
+            if (std::shared_ptr<TransformComponent> Child = ChildWeak.lock())
+            {
+                if (bRecordChange)
+                {
+                    Child->MarkChanged();
+                }
+                Child->PropagateWorldDirty(bRecordChange);
+            }
+        }
+    }
+
+    void TransformComponent::QueueWorldUpdate()
+    {
+        if (WorldObject* Owner = GetOwner())
+        {
+            if (World* OwningWorld = Owner->GetWorld())
+            {
+                OwningWorld->QueueTransformUpdate(weak_from_this());
+            }
+        }
+    }
+
+    void TransformComponent::UpdateDepth(std::uint32_t InDepth)
+    {
+        Depth = InDepth;
+        for (const std::weak_ptr<TransformComponent>& ChildWeak : Children)
+        {
+            if (std::shared_ptr<TransformComponent> Child = ChildWeak.lock())
+            {
+                Child->UpdateDepth(InDepth + 1);
+            }
+        }
+    }
+
+    void TransformComponent::RemoveChild(const TransformComponent* Child)
+    {
+        std::erase_if(Children, [Child](const std::weak_ptr<TransformComponent>& ChildWeak)
+        {
+            const std::shared_ptr<TransformComponent> Locked = ChildWeak.lock();
+            return !Locked || Locked.get() == Child;
+        });
+    }
 }
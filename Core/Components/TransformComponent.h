@@ -1,17 +1,71 @@
 #pragma once
 
+#include <vector>
 #include "Component.h"
+#include <SFML/Graphics/Transform.hpp>
 #include <SFML/System/Vector2.hpp>
 
 namespace Core
 {
-    class TransformComponent : public Component
+    class TransformComponent : public Component, public std::enable_shared_from_this<TransformComponent>
     {
     public:
         TransformComponent(const std::shared_ptr<WorldObject>& Owner, std::shared_ptr<EngineContext> Context);
+        ~TransformComponent() override;
+
+        bool Initialize(const nlohmann::json& Data) override;
+        void Start() override;
+        nlohmann::json ToJson() const override;
+        void RestoreJson(const nlohmann::json& Data) override;
+
+        // Local values are relative to the parent transform, or to the world when there is no parent
+        const sf::Vector2f& GetPosition() const { return Position; }
+        void SetPosition(const sf::Vector2f& InPosition);
+        void Translate(const sf::Vector2f& Delta);
+
+        float GetRotation() const { return RotationDegrees; }
+        void SetRotation(float InDegrees);
+
+        const sf::Vector2f& GetScale() const { return Scale; }
+        void SetScale(const sf::Vector2f& InScale);
+
+        sf::Vector2f GetWorldPosition() const;
+        void SetWorldPosition(const sf::Vector2f& InWorldPosition);
+
+        const sf::Transform& GetLocalTransform() const;
+        const sf::Transform& GetWorldTransform() const;
+
+        // Returns false if the new parent is this transform or one of its descendants
+        bool SetParent(const std::shared_ptr<TransformComponent>& NewParent, bool bKeepWorldPosition = true);
+        std::shared_ptr<TransformComponent> GetParent() const { return Parent.lock(); }
+        const std::vector<std::weak_ptr<TransformComponent>>& GetChildren() const { return Children; }
+        std::uint32_t GetDepth() const { return Depth; }
+
+        bool IsWorldTransformDirty() const { return bWorldDirty; }
+
+        // Recomputes this transform and every dirty descendant. Called by World's batched update pass.
+        void UpdateWorldTransforms();
+
+    private:
+        void MarkLocalDirty();
+        void MarkWorldDirty();
+        void PropagateWorldDirty(bool bRecordChange);
+        void QueueWorldUpdate();
+        void UpdateDepth(std::uint32_t InDepth);
+        void RemoveChild(const TransformComponent* Child);
 
         sf::Vector2f Position{0.0f, 0.0f};
+        float RotationDegrees = 0.0f;
+        sf::Vector2f Scale{1.0f, 1.0f};
 
-        bool Initialize(const nlohmann::json& Data) override;
+        std::weak_ptr<TransformComponent> Parent;
+        std::vector<std::weak_ptr<TransformComponent>> Children;
+        std::uint32_t Depth = 0;
+        std::string PendingParentName;
+
+        mutable sf::Transform LocalTransform;
+        mutable sf::Transform WorldTransform;
+        mutable bool bLocalDirty = true;
+        mutable bool bWorldDirty = true;
     };
 }
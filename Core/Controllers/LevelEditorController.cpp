@@ -13,6 +13,7 @@
 #include "../World/ComponentManager.h"
 #include "../TileMap/Tile.h"
 #include "../TileMap/TileMap.h"
+#include "../TileMap/TileMapOps.h"
 #include "imgui.h"
 #include <algorithm>
 
@@ -36,7 +37,7 @@ namespace Core
 
         if (GetOwner()->Transform())
         {
-            InitialCameraPosition = GetOwner()->Transform()->Position;
+            InitialCameraPosition = GetOwner()->Transform()->GetPosition();
         }
 
         if (std::shared_ptr<Core::WorldObject> TileMapObject = GetOwner()->GetWorld()->Objects().GetByName("TileMap"))
@@ -78,6 +79,9 @@ namespace Core
         {
             EditorTool CurrentTool = ScenePtr->GetModel().GetCurrentTool();
 
+            // In case the release that ended the last stroke went to another window
+            EndTileEdit();
+
             if (CurrentTool == EditorTool::Brush)
             {
                 bIsPainting = true;
@@ -170,6 +174,7 @@ namespace Core
         if (Event.button == sf::Mouse::Button::Left)
         {
             bIsPainting = false;
+            EndTileEdit();
 
             std::shared_ptr<LevelDesignerScene> ScenePtr = Scene.lock();
             if (ScenePtr)
@@ -246,7 +251,7 @@ namespace Core
 
             WorldCoordinate Delta = LastPanWorldPos - CurrentWorldPos;
 
-            GetOwner()->Transform()->Position += Delta.Value;
+            GetOwner()->Transform()->Translate(Delta.Value);
 
             LastPanWorldPos = Projector->WindowToWorld(WindowCoords, CamPtr->GetView());
         }
@@ -310,7 +315,7 @@ namespace Core
         WorldCoordinate WorldPosAfterZoom = Projector->WindowToWorld(MousePos, CamPtr->GetView());
         WorldCoordinate Delta = WorldPosBeforeZoom - WorldPosAfterZoom;
 
-        GetOwner()->Transform()->Position += Delta.Value;
+        GetOwner()->Transform()->Translate(Delta.Value);
     }
 
     void LevelEditorController::OnKeyPressed(const sf::Event::KeyPressed& Event)
@@ -321,6 +326,23 @@ namespace Core
         if (!ScenePtr)
             return;
 
+        // Text fields have their own undo
+        if (Event.control && !ImGui::GetIO().WantTextInput)
+        {
+            if (Event.code == sf::Keyboard::Key::Z && !Event.shift)
+            {
+                EndTileEdit();
+                ScenePtr->GetModel().Undo();
+                return;
+            }
+            if (Event.code == sf::Keyboard::Key::Y || Event.code == sf::Keyboard::Key::Z)
+            {
+                EndTileEdit();
+                ScenePtr->GetModel().Redo();
+                return;
+            }
+        }
+
         if (Event.code == sf::Keyboard::Key::G)
         {
             ScenePtr->GetModel().ToggleGrid();
@@ -353,7 +375,7 @@ namespace Core
             }
             if (GetOwner()->Transform())
             {
-                GetOwner()->Transform()->Position = InitialCameraPosition;
+                GetOwner()->Transform()->SetPosition(InitialCameraPosition);
             }
         }
         else if (Event.code == sf::Keyboard::Key::S)
@@ -417,6 +439,12 @@ namespace Core
 
         Core::uint CurrentLayer = ScenePtr->GetModel().GetCurrentLayer();
 
+        if (!TileEdits.IsRecording(TileMapPtr.get(), CurrentLayer))
+        {
+            EndTileEdit();
+            TileEdits.Begin(TileMapPtr, CurrentLayer, "Paint Tiles");
+        }
+
         for (int OffsetY = 0; OffsetY < Selection.SelectionRect.Height(); ++OffsetY)
         {
             for (int OffsetX = 0; OffsetX < Selection.SelectionRect.Width(); ++OffsetX)
@@ -429,10 +457,10 @@ namespace Core
                     continue;
 
                 int TileIndex = Selection.GetTileIndex(sf::Vector2i(OffsetX, OffsetY), TileSheetColumns);
-                TileMapPtr->GetTileMap().SetTile(TargetX, TargetY, CurrentLayer,
-                    Tile(Selection.TileSheetIndex.value(), TileIndex));
+                TileEdits.SetTile(TargetX, TargetY, Tile(Selection.TileSheetIndex.value(), TileIndex));
             }
         }
+        TileMapPtr->MarkChanged();
     }
 
     void LevelEditorController::DeleteTile(WindowCoordinate MousePos)
@@ -460,7 +488,15 @@ namespace Core
             return;
 
         Core::uint CurrentLayer = ScenePtr->GetModel().GetCurrentLayer();
-        TileMapPtr->GetTileMap().SetTile(TileCoords.X(), TileCoords.Y(), CurrentLayer, Tile());
+
+        if (!TileEdits.IsRecording(TileMapPtr.get(), CurrentLayer))
+        {
+            EndTileEdit();
+            TileEdits.Begin(TileMapPtr, CurrentLayer, "Erase Tiles");
+        }
+
+        TileEdits.SetTile(TileCoords.X(), TileCoords.Y(), Tile());
+        TileMapPtr->MarkChanged();
     }
 
     void LevelEditorController::EyedropperTile(WindowCoordinate MousePos)
@@ -542,43 +578,34 @@ namespace Core
         Core::uint CurrentLayer = ScenePtr->GetModel().GetCurrentLayer();
         Core::TileMap& TileMapData = TileMapPtr->GetTileMap();
 
-        Tile TargetTile = TileMapData.GetTile(StartTileCoords.X(), StartTileCoords.Y(), CurrentLayer);
+        const Tile TargetTile = TileMapData.GetTile(StartTileCoords.X(), StartTileCoords.Y(), CurrentLayer);
 
         int TileSheetColumns = ScenePtr->GetModel().GetTileSheetColumns(Selection.TileSheetIndex.value());
         int ReplacementTileIndex = Selection.GetTileIndex(sf::Vector2i(0, 0), TileSheetColumns);
         Tile ReplacementTile(Selection.TileSheetIndex.value(), ReplacementTileIndex);
 
-        if (TargetTile.GetTileSheetId() == ReplacementTile.GetTileSheetId() &&
-            TargetTile.GetTileIndex() == ReplacementTile.GetTileIndex())
+        if (TargetTile == ReplacementTile)
             return;
 
-        std::vector<TileCoordinate> Stack;
-        Stack.push_back(StartTileCoords);
-
-        while (!Stack.empty())
-        {
-            TileCoordinate Current = Stack.back();
-            Stack.pop_back();
-
-            if (Current.X() >= TileMapData.GetWidth() || Current.Y() >= TileMapData.GetHeight())
-                continue;
-
-            Tile CurrentTile = TileMapData.GetTile(Current.X(), Current.Y(), CurrentLayer);
-
-            if (CurrentTile.GetTileSheetId() != TargetTile.GetTileSheetId() ||
-                CurrentTile.GetTileIndex() != TargetTile.GetTileIndex())
-                continue;
+        std::vector<TileSpan> FilledSpans;
+        if (TileMapOps::FloodFill(TileMapData, CurrentLayer, StartTileCoords.X(), StartTileCoords.Y(), ReplacementTile,
+                                  &FilledSpans) == 0)
+            return;
 
-            TileMapData.SetTile(Current.X(), Current.Y(), CurrentLayer, ReplacementTile);
+        EndTileEdit();
+        TileEdits.Begin(TileMapPtr, CurrentLayer, "Fill Tiles");
+        TileEdits.RecordSpans(FilledSpans, TargetTile, ReplacementTile);
+        EndTileEdit();
+        TileMapPtr->MarkChanged();
+    }
 
-            if (Current.X() > 0)
-                Stack.push_back(TileCoordinate(Current.X() - 1, Current.Y()));
-            if (Current.X() < TileMapData.GetWidth() - 1)
-                Stack.push_back(TileCoordinate(Current.X() + 1, Current.Y()));
-            if (Current.Y() > 0)
-                Stack.push_back(TileCoordinate(Current.X(), Current.Y() - 1));
-            if (Current.Y() < TileMapData.GetHeight() - 1)
-                Stack.push_back(TileCoordinate(Current.X(), Current.Y() + 1));
+    void LevelEditorController::EndTileEdit()
+    {
+        std::unique_ptr<TileEditCommand> Command = TileEdits.Finish();
+        std::shared_ptr<LevelDesignerScene> ScenePtr = Scene.lock();
+        if (Command && ScenePtr)
+        {
+            ScenePtr->GetModel().GetHistory().Push(std::move(Command));
         }
     }
 }
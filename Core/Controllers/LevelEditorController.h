@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Controller.h"
+#include "../Editor/EditorCommands.h"
 #include "../Coordinates/WindowCoordinate.h"
 #include "../Coordinates/WorldCoordinate.h"
 
@@ -31,12 +32,16 @@ namespace Core
         void EyedropperTile(WindowCoordinate MousePos);
         void FloodFill(WindowCoordinate MousePos);
 
+        // Pushes the tiles changed since the stroke began to the editor history
+        void EndTileEdit();
+
         std::weak_ptr<CameraComponent> Camera;
         std::weak_ptr<LevelDesignerScene> Scene;
         std::weak_ptr<TileMapComponent> TileMap;
 
         bool bIsPanning = false;
         bool bIsPainting = false;
+        TileEditRecorder TileEdits;
         WindowCoordinate LastMousePosition{0, 0};
         WorldCoordinate LastPanWorldPos;
 
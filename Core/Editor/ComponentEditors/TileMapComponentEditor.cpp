@@ -31,6 +31,7 @@ namespace Core
                 Width <= static_cast<int>(TileMapComponent::MaxTileMapSize))
             {
                 TileMapData.Resize(static_cast<Core::uint>(Width), TileMapData.GetHeight());
+                TileMapComp->MarkChanged();
             }
         }
 
@@ -40,6 +41,7 @@ namespace Core
                 Height <= static_cast<int>(TileMapComponent::MaxTileMapSize))
             {
                 TileMapData.Resize(TileMapData.GetWidth(), static_cast<Core::uint>(Height));
+                TileMapComp->MarkChanged();
             }
         }
 
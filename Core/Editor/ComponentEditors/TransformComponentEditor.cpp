@@ -21,7 +21,33 @@ namespace Core
         }
 
         ImGui::Text("Position");
-        ImGui::InputFloat("X##TransformPos", &Transform->Position.x);
-        ImGui::InputFloat("Y##TransformPos", &Transform->Position.y);
+        sf::Vector2f Position = Transform->GetPosition();
+        bool bPositionChanged = ImGui::InputFloat("X##TransformPos", &Position.x);
+        bPositionChanged |= ImGui::InputFloat("Y##TransformPos", &Position.y);
+        if (bPositionChanged)
+        {
+            Transform->SetPosition(Position);
+        }
+
+        float Rotation = Transform->GetRotation();
+        if (ImGui::InputFloat("Rotation##TransformRot", &Rotation))
+        {
+            Transform->SetRotation(Rotation);
+        }
+
+        ImGui::Text("Scale");
+        sf::Vector2f Scale = Transform->GetScale();
+        bool bScaleChanged = ImGui::InputFloat("X##TransformScale", &Scale.x);
+        bScaleChanged |= ImGui::InputFloat("Y##TransformScale", &Scale.y);
+        if (bScaleChanged)
+        {
+            Transform->SetScale(Scale);
+        }
+
+        if (std::shared_ptr<TransformComponent> Parent = Transform->GetParent())
+        {
+            const WorldObject* ParentOwner = Parent->GetOwner();
+            ImGui::Text("Parent: %s", ParentOwner && !ParentOwner->GetName().empty() ? ParentOwner->GetName().c_str() : "(unnamed)");
+        }
     }
 }
@@ -0,0 +1,275 @@
+#include "EditorCommands.h"
+
+#include <algorithm>
+
+#include "../Components/Component.h"
+#include "../Components/TileMapComponent.h"
+#include "../Log/Log.h"
+#include "../TileMap/Tile.h"
+#include "../TileMap/TileMap.h"
+#include "../TileMap/TileMapOps.h"
+
+namespace Core
+{
+    namespace
+    {
+        PackedTile PackTile(const Tile& InTile)
+        {
+            const std::optional<uint> TileSheetId = InTile.GetTileSheetId();
+            if (!TileSheetId.has_value())
+            {
+                return 0;
+            }
+            return (static_cast<PackedTile>(TileSheetId.value()) + 1) << 32 | InTile.GetTileIndex();
+        }
+
+        Tile UnpackTile(PackedTile Packed)
+        {
+            if (Packed == 0)
+            {
+                return Tile();
+            }
+            return Tile(static_cast<uint>((Packed >> 32) - 1), static_cast<uint>(Packed & 0xFFFFFFFFu));
+        }
+
+        std::size_t GetJsonSize(const nlohmann::json& Value)
+        {
+            return Value.dump().size();
+        }
+    }
+
+    TileEditCommand::TileEditCommand(std::weak_ptr<TileMapComponent> InTarget, uint InLayer, std::vector<Run> InRuns,
+                                     const char* InName)
+        : Target(std::move(InTarget)), Layer(InLayer), Runs(std::move(InRuns)), Name(InName)
+    {
+    }
+
+    std::size_t TileEditCommand::GetMemorySize() const
+    {
+        return sizeof(TileEditCommand) + Runs.capacity() * sizeof(Run);
+    }
+
+    std::size_t TileEditCommand::GetTileCount() const
+    {
+        std::size_t Count = 0;
+        for (const Run& Span : Runs)
+        {
+            Count += Span.Length;
+        }
+        return Count;
+    }
+
+    void TileEditCommand::Apply(bool bForward) const
+    {
+        std::shared_ptr<TileMapComponent> TileMapPtr = Target.lock();
+        if (!TileMapPtr)
+        {
+            return;
+        }
+
+        TileMap& Map = TileMapPtr->GetTileMap();
+        if (!Map.IsValidLayer(Layer))
+        {
+            Log::Warning(ELogCategory::Editor, "'%s' skipped: layer %u no longer exists", Name, Layer);
+            return;
+        }
+
+        for (const Run& Span : Runs)
+        {
+            const Tile Value = UnpackTile(bForward ? Span.New : Span.Old);
+            for (uint Offset = 0; Offset < Span.Length; ++Offset)
+            {
+                // The map may have been resized since
+                if (Map.IsValidCoordinate(Span.X + Offset, Span.Y))
+                {
+                    Map.SetTile(Span.X + Offset, Span.Y, Layer, Value);
+                }
+            }
+        }
+        TileMapPtr->MarkChanged();
+    }
+
+    void TileEditRecorder::Begin(std::shared_ptr<TileMapComponent> InTarget, uint InLayer, const char* InName)
+    {
+        Target = std::move(InTarget);
+        Layer = InLayer;
+        Width = Target ? Target->GetTileMap().GetWidth() : 0;
+        Name = InName;
+        Changes.clear();
+        SpanRuns.clear();
+    }
+
+    bool TileEditRecorder::IsRecording(const TileMapComponent* InTarget, uint InLayer) const
+    {
+        return Target && Target.get() == InTarget && Layer == InLayer;
+    }
+
+    void TileEditRecorder::SetTile(uint X, uint Y, const Tile& NewTile)
+    {
+        if (!Target)
+        {
+            return;
+        }
+
+        TileMap& Map = Target->GetTileMap();
+        if (!Map.IsValidLayer(Layer) || !Map.IsValidCoordinate(X, Y))
+        {
+            return;
+        }
+
+        const PackedTile Old = PackTile(Map.GetTile(X, Y, Layer));
+        const PackedTile New = PackTile(NewTile);
+        if (Old == New)
+        {
+            return;
+        }
+
+        Map.SetTile(X, Y, Layer, NewTile);
+        Changes.push_back({static_cast<std::uint64_t>(Y) * Width + X, Old, New});
+    }
+
+    void TileEditRecorder::RecordSpans(const std::vector<TileSpan>& Spans, const Tile& Old, const Tile& New)
+    {
+        if (!Target)
+        {
+            return;
+        }
+
+        const PackedTile PackedOld = PackTile(Old);
+        const PackedTile PackedNew = PackTile(New);
+        if (PackedOld == PackedNew)
+        {
+            return;
+        }
+
+        SpanRuns.reserve(SpanRuns.size() + Spans.size());
+        for (const TileSpan& Span : Spans)
+        {
+            if (Span.Length > 0)
+            {
+                SpanRuns.push_back({Span.X, Span.Y, Span.Length, PackedOld, PackedNew});
+            }
+        }
+    }
+
+    std::unique_ptr<TileEditCommand> TileEditRecorder::Finish()
+    {
+        std::shared_ptr<TileMapComponent> FinishedTarget = std::move(Target);
+        if (!FinishedTarget || (Changes.empty() && SpanRuns.empty()))
+        {
+            Changes.clear();
+            SpanRuns.clear();
+            return nullptr;
+        }
+
+        // Stable, so repeated changes to a cell stay in the order they happened
+        std::stable_sort(Changes.begin(), Changes.end(), [](const Change& A, const Change& B)
+        {
+            return A.Index < B.Index;
+        });
+
+        std::vector<TileEditCommand::Run> Runs;
+        std::size_t First = 0;
+        while (First < Changes.size())
+        {
+            std::size_t Last = First;
+            while (Last + 1 < Changes.size() && Changes[Last + 1].Index == Changes[First].Index)
+            {
+                ++Last;
+            }
+
+            const std::uint64_t Index = Changes[First].Index;
+            const PackedTile Old = Changes[First].Old;
+            const PackedTile New = Changes[Last].New;
+            First = Last + 1;
+
+            // Painted over and back again within the stroke
+            if (Old == New)
+            {
+                continue;
+            }
+
+            const uint X = static_cast<uint>(Index % Width);
+            const uint Y = static_cast<uint>(Index / Width);
+
+            if (!Runs.empty())
+            {
+                TileEditCommand::Run& Previous = Runs.back();
+                if (Previous.Y == Y && Previous.X + Previous.Length == X && Previous.Old == Old && Previous.New == New)
+                {
+                    ++Previous.Length;
+                    continue;
+                }
+            }
+            Runs.push_back({X, Y, 1, Old, New});
+        }
+        Changes.clear();
+
+        if (!SpanRuns.empty())
+        {
+            Runs.insert(Runs.end(), SpanRuns.begin(), SpanRuns.end());
+            SpanRuns.clear();
+            std::sort(Runs.begin(), Runs.end(), [](const TileEditCommand::Run& A, const TileEditCommand::Run& B)
+            {
+                return A.Y != B.Y ? A.Y < B.Y : A.X < B.X;
+            });
+        }
+
+        if (Runs.empty())
+        {
+            return nullptr;
+        }
+
+        Runs.shrink_to_fit();
+        return std::make_unique<TileEditCommand>(FinishedTarget, Layer, std::move(Runs), Name);
+    }
+
+    ComponentEditCommand::ComponentEditCommand(const char* InName)
+        : Name(InName)
+    {
+    }
+
+    void ComponentEditCommand::Add(const std::shared_ptr<Component>& Target, const nlohmann::json& Before,
+                                   const nlohmann::json& After)
+    {
+        if (!Target || Before == After)
+        {
+            return;
+        }
+
+        Entry NewEntry;
+        NewEntry.Target = Target;
+        NewEntry.Forward = nlohmann::json::diff(Before, After);
+        NewEntry.Reverse = nlohmann::json::diff(After, Before);
+
+        MemorySize += sizeof(Entry) + GetJsonSize(NewEntry.Forward) + GetJsonSize(NewEntry.Reverse);
+        Entries.push_back(std::move(NewEntry));
+    }
+
+    void ComponentEditCommand::Apply(bool bForward) const
+    {
+        for (const Entry& Edit : Entries)
+        {
+            std::shared_ptr<Component> Target = Edit.Target.lock();
+            if (!Target)
+            {
+                continue;
+            }
+
+            nlohmann::json Restored;
+            try
+            {
+                Restored = Target->ToJson().patch(bForward ? Edit.Forward : Edit.Reverse);
+            }
+            catch (const nlohmann::json::exception& Exception)
+            {
+                Log::Warning(ELogCategory::Editor, "'%s' skipped on %s: %s", Name, Target->GetName().c_str(),
+                             Exception.what());
+                continue;
+            }
+
+            Target->RestoreJson(Restored);
+            Target->MarkChanged();
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EditorHistory.h"
+#include "../Common.h"
+#include "../ThirdParty/json.hpp"
+
+namespace Core
+{
+    class Component;
+    class Tile;
+    class TileMapComponent;
+    struct TileSpan;
+
+    // A tile as TileSheetId + 1 in the high half and TileIndex in the low half; 0 is an empty tile
+    using PackedTile = std::uint64_t;
+
+    // Tile changes on one layer, as horizontal runs of cells that all went from the same tile to the same tile
+    class TileEditCommand : public EditorCommand
+    {
+    public:
+        struct Run
+        {
+            uint X = 0;
+            uint Y = 0;
+            uint Length = 0;
+            PackedTile Old = 0;
+            PackedTile New = 0;
+        };
+
+        TileEditCommand(std::weak_ptr<TileMapComponent> InTarget, uint InLayer, std::vector<Run> InRuns, const char* InName);
+
+        void Undo() override { Apply(false); }
+        void Redo() override { Apply(true); }
+        std::size_t GetMemorySize() const override;
+        const char* GetName() const override { return Name; }
+
+        std::size_t GetTileCount() const;
+
+    private:
+        void Apply(bool bForward) const;
+
+        std::weak_ptr<TileMapComponent> Target;
+        uint Layer;
+        std::vector<Run> Runs;
+        const char* Name;
+    };
+
+    // Sets tiles for one brush stroke or fill and collects what changed into a single TileEditCommand
+    class TileEditRecorder
+    {
+    public:
+        void Begin(std::shared_ptr<TileMapComponent> InTarget, uint InLayer, const char* InName);
+        bool IsRecording() const { return Target != nullptr; }
+        bool IsRecording(const TileMapComponent* InTarget, uint InLayer) const;
+
+        // Cells outside the map are ignored
+        void SetTile(uint X, uint Y, const Tile& NewTile);
+
+        // Records tiles a bulk edit such as TileMapOps::FloodFill already changed from Old to New. They must not
+        // overlap tiles set through SetTile in the same edit.
+        void RecordSpans(const std::vector<TileSpan>& Spans, const Tile& Old, const Tile& New);
+
+        // Null when the stroke left every tile as it was. A tile set more than once keeps its first old and last
+        // new value.
+        std::unique_ptr<TileEditCommand> Finish();
+
+    private:
+        struct Change
+        {
+            std::uint64_t Index;
+            PackedTile Old;
+            PackedTile New;
+        };
+
+        std::shared_ptr<TileMapComponent> Target;
+        uint Layer = 0;
+        uint Width = 0;
+        const char* Name = "";
+        std::vector<Change> Changes;
+        std::vector<TileEditCommand::Run> SpanRuns;
+    };
+
+    // Component edits across any number of objects, kept as JSON patches between each component's ToJson before and
+    // after. Applied through Component::RestoreJson.
+    class ComponentEditCommand : public EditorCommand
+    {
+    public:
+        explicit ComponentEditCommand(const char* InName);
+
+        // Does nothing when Before and After match
+        void Add(const std::shared_ptr<Component>& Target, const nlohmann::json& Before, const nlohmann::json& After);
+        bool IsEmpty() const { return Entries.empty(); }
+
+        void Undo() override { Apply(false); }
+        void Redo() override { Apply(true); }
+        std::size_t GetMemorySize() const override { return MemorySize; }
+        const char* GetName() const override { return Name; }
+
+    private:
+        struct Entry
+        {
+            std::weak_ptr<Component> Target;
+            nlohmann::json Forward;
+            nlohmann::json Reverse;
+        };
+
+        void Apply(bool bForward) const;
+
+        std::vector<Entry> Entries;
+        std::size_t MemorySize = sizeof(ComponentEditCommand);
+        const char* Name;
+    };
+}
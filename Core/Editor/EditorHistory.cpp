@@ -0,0 +1,95 @@
+#include "EditorHistory.h"
+
+namespace Core
+{
+    void EditorHistory::Push(std::unique_ptr<EditorCommand> Command)
+    {
+        if (!Command)
+        {
+            return;
+        }
+
+        for (const std::unique_ptr<EditorCommand>& Discarded : RedoStack)
+        {
+            MemoryUsage -= Discarded->GetMemorySize();
+        }
+        RedoStack.clear();
+
+        MemoryUsage += Command->GetMemorySize();
+        UndoStack.push_back(std::move(Command));
+        EnforceBudget();
+    }
+
+    bool EditorHistory::Undo()
+    {
+        if (UndoStack.empty())
+        {
+            return false;
+        }
+
+        std::unique_ptr<EditorCommand> Command = std::move(UndoStack.back());
+        UndoStack.pop_back();
+        Command->Undo();
+        RedoStack.push_back(std::move(Command));
+        return true;
+    }
+
+    bool EditorHistory::Redo()
+    {
+        if (RedoStack.empty())
+        {
+            return false;
+        }
+
+        std::unique_ptr<EditorCommand> Command = std::move(RedoStack.back());
+        RedoStack.pop_back();
+        Command->Redo();
+        UndoStack.push_back(std::move(Command));
+        return true;
+    }
+
+    const char* EditorHistory::GetUndoName() const
+    {
+        return UndoStack.empty() ? nullptr : UndoStack.back()->GetName();
+    }
+
+    const char* EditorHistory::GetRedoName() const
+    {
+        return RedoStack.empty() ? nullptr : RedoStack.back()->GetName();
+    }
+
+    void EditorHistory::Clear()
+    {
+        UndoStack.clear();
+        RedoStack.clear();
+        MemoryUsage = 0;
+    }
+
+    void EditorHistory::SetMemoryBudget(std::size_t Bytes)
+    {
+        MemoryBudget = Bytes;
+        EnforceBudget();
+    }
+
+    void EditorHistory::EnforceBudget()
+    {
+        while (MemoryUsage > MemoryBudget)
+        {
+            // The furthest edits from the current state go first, at either end
+            if (UndoStack.size() > 1)
+            {
+                MemoryUsage -= UndoStack.front()->GetMemorySize();
+                UndoStack.pop_front();
+            }
+            else if (!RedoStack.empty())
+            {
+                MemoryUsage -= RedoStack.front()->GetMemorySize();
+                RedoStack.pop_front();
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <vector>
+
+namespace Core
+{
+    // One undoable edit, already applied when it is pushed. Commands reach their targets through weak pointers, so
+    // undoing an edit to something since removed does nothing.
+    class EditorCommand
+    {
+    public:
+        virtual ~EditorCommand() = default;
+
+        virtual void Undo() = 0;
+        virtual void Redo() = 0;
+
+        // Approximate bytes held, counted against the history's memory budget
+        virtual std::size_t GetMemorySize() const = 0;
+        virtual const char* GetName() const = 0;
+    };
+
+    class EditorHistory
+    {
+    public:
+        static constexpr std::size_t DefaultMemoryBudget = 64 * 1024 * 1024;
+
+        // Clears the redo stack
+        void Push(std::unique_ptr<EditorCommand> Command);
+
+        bool Undo();
+        bool Redo();
+        bool CanUndo() const { return !UndoStack.empty(); }
+        bool CanRedo() const { return !RedoStack.empty(); }
+
+        // Null when there is nothing to undo or redo
+        const char* GetUndoName() const;
+        const char* GetRedoName() const;
+
+        void Clear();
+
+        // Oldest edits are dropped first once over budget; the newest undo is always kept, however large
+        void SetMemoryBudget(std::size_t Bytes);
+        std::size_t GetMemoryBudget() const { return MemoryBudget; }
+        std::size_t GetMemoryUsage() const { return MemoryUsage; }
+
+    private:
+        void EnforceBudget();
+
+        std::deque<std::unique_ptr<EditorCommand>> UndoStack;
+        // Back is the next to redo
+        std::deque<std::unique_ptr<EditorCommand>> RedoStack;
+        std::size_t MemoryUsage = 0;
+        std::size_t MemoryBudget = DefaultMemoryBudget;
+    };
+}
@@ -1,15 +1,18 @@
 #include "LevelDesignerModel.h"
+#include "EditorCommands.h"
 #include "../World/World.h"
 #include "../World/WorldObject.h"
 #include "../Components/TileMapComponent.h"
 #include "../Components/TransformComponent.h"
 #include "../Scene/SceneLoader.h"
+#include "../Scene/SceneAssetHandoff.h"
+#include "../Assets/AssetCancellationToken.hpp"
 #include "../EngineContext.hpp"
 #include "../SystemsRegistry.hpp"
 #include "../Systems/AssetRegistrySystem.h"
 #include "../TileMap/TileSheet.h"
+#include "../Log/Log.h"
 #include <filesystem>
-#include <fstream>
 
 namespace Core
 {
@@ -60,6 +63,37 @@ namespace Core
     {
     }
 
+    LevelDesignerModel::~LevelDesignerModel()
+    {
+        // Streamed completions capture this model
+        if (LoadCancellation)
+        {
+            LoadCancellation->Cancel();
+        }
+    }
+
+    std::vector<AssetId> LevelDesignerModel::GetSceneAssetIds() const
+    {
+        std::vector<AssetId> Ids = SceneAssets;
+        Ids.insert(Ids.end(), StreamedSceneAssets.begin(), StreamedSceneAssets.end());
+        return Ids;
+    }
+
+    void LevelDesignerModel::ReleaseSceneAssets()
+    {
+        if (LoadCancellation)
+        {
+            LoadCancellation->Cancel();
+        }
+
+        std::shared_ptr<AssetRegistrySystem> AssetRegistry = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
+        std::vector<AssetId> Outgoing = std::move(SceneAssets);
+        Outgoing.insert(Outgoing.end(), StreamedSceneAssets.begin(), StreamedSceneAssets.end());
+        SceneAssets.clear();
+        StreamedSceneAssets.clear();
+        HandOffSceneAssets(*AssetRegistry, Outgoing, {});
+    }
+
     std::shared_ptr<WorldObject> LevelDesignerModel::CreateObject()
     {
         return WorldRef.Objects().CreateObject();
@@ -92,13 +126,7 @@ namespace Core
             return;
         }
 
-        const nlohmann::json SceneJson = WorldRef.ToJson();
-        std::ofstream File(CurrentScene.GetPath());
-        if (File.is_open())
-        {
-            File << SceneJson.dump(4);
-            File.close();
-        }
+        Saver.Save(WorldRef, CurrentScene.GetPath());
     }
 
     void LevelDesignerModel::SaveSceneAs(const std::string& SceneName)
@@ -110,17 +138,45 @@ namespace Core
 
     Task<> LevelDesignerModel::LoadScene(const std::string& SceneName)
     {
+        // A save still in flight may be for the scene about to be read
+        Saver.Wait();
+        History.Clear();
         WorldRef.Objects().Clear();
 
         const std::string ScenePath = "Game/Assets/Scenes/" + SceneName + ".json";
         CurrentScene.SetPath(ScenePath);
 
+        // Taken on the main thread, before the first suspension, while no streamed completion can touch them
+        if (LoadCancellation)
+        {
+            LoadCancellation->Cancel();
+        }
+        LoadCancellation = std::make_shared<AssetCancellationToken>();
+
+        std::vector<AssetId> Outgoing = std::move(SceneAssets);
+        Outgoing.insert(Outgoing.end(), StreamedSceneAssets.begin(), StreamedSceneAssets.end());
+        SceneAssets.clear();
+        StreamedSceneAssets.clear();
+
         SceneLoader Loader(Context);
-        co_await Loader.LoadScene(SceneName, WorldRef);
+        std::vector<AssetId> Incoming = co_await Loader.LoadScene(SceneName, WorldRef, LoadCancellation,
+                                                                  [this](AssetId Id)
+                                                                  {
+                                                                      StreamedSceneAssets.push_back(Id);
+                                                                  });
+
+        // Assets the previous scene shared with this one were acquired by the load, so releasing now costs no IO
+        std::shared_ptr<AssetRegistrySystem> AssetRegistry = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
+        const SceneAssetHandoff Handoff = HandOffSceneAssets(*AssetRegistry, Outgoing, Incoming);
+        Log::Info(ELogCategory::Editor, "Editor loaded '%s': %zu assets kept, %zu new, %zu released", SceneName.c_str(), Handoff.Kept,
+                  Handoff.Loaded, Handoff.Released);
+
+        SceneAssets = std::move(Incoming);
     }
 
     void LevelDesignerModel::NewScene()
     {
+        History.Clear();
         WorldRef.Objects().Clear();
         CurrentScene.Clear();
     }
@@ -287,7 +343,7 @@ namespace Core
             if (!Transform)
                 continue;
 
-            const sf::Vector2f ObjectPos = Transform->Position;
+            const sf::Vector2f ObjectPos = Transform->GetWorldPosition();
             const sf::Vector2f Delta = WorldPos.Value - ObjectPos;
             const float DistanceSq = Delta.x * Delta.x + Delta.y * Delta.y;
 
@@ -326,14 +382,16 @@ namespace Core
         CurrentDragMode = Mode;
         DragStartPos = StartPos;
         DraggedObjectsInitialPositions.clear();
+        DraggedObjectsInitialTransforms.clear();
 
         const std::vector<std::shared_ptr<WorldObject>> SelectedObjects = Selection.GetAllValid();
         for (const std::shared_ptr<WorldObject>& Object : SelectedObjects)
         {
-            TransformComponent* Transform = Object->Transform();
+            std::shared_ptr<TransformComponent> Transform = Object->Components().Get<TransformComponent>();
             if (Transform)
             {
-                DraggedObjectsInitialPositions.emplace_back(Object.get(), Transform->Position);
+                DraggedObjectsInitialPositions.emplace_back(Object.get(), Transform->GetWorldPosition());
+                DraggedObjectsInitialTransforms.emplace_back(Transform, Transform->ToJson());
             }
         }
     }
@@ -363,7 +421,7 @@ namespace Core
             TransformComponent* Transform = Object->Transform();
             if (Transform)
             {
-                Transform->Position = InitialPos + ConstrainedDelta;
+                Transform->SetWorldPosition(InitialPos + ConstrainedDelta);
             }
         }
     }
@@ -373,6 +431,21 @@ namespace Core
         bIsDraggingObjects = false;
         CurrentDragMode = DragMode::None;
         DraggedObjectsInitialPositions.clear();
+
+        std::unique_ptr<ComponentEditCommand> Command = std::make_unique<ComponentEditCommand>("Move Objects");
+        for (const std::pair<std::weak_ptr<TransformComponent>, nlohmann::json>& Pair : DraggedObjectsInitialTransforms)
+        {
+            if (std::shared_ptr<TransformComponent> Transform = Pair.first.lock())
+            {
+                Command->Add(Transform, Pair.second, Transform->ToJson());
+            }
+        }
+        DraggedObjectsInitialTransforms.clear();
+
+        if (!Command->IsEmpty())
+        {
+            History.Push(std::move(Command));
+        }
     }
 
     sf::FloatRect LevelDesignerModel::GetObjectBounds(const WorldObject* Object) const
@@ -384,7 +457,7 @@ namespace Core
         if (!Transform)
             return sf::FloatRect(sf::Vector2f(0, 0), sf::Vector2f(0, 0));
 
-        const sf::Vector2f Position = Transform->Position;
+        const sf::Vector2f Position = Transform->GetWorldPosition();
         constexpr float BoundsSize = 10.0f;
         constexpr float HalfSize = BoundsSize / 2.0f;
 
@@ -413,7 +486,7 @@ namespace Core
             if (!Transform)
                 continue;
 
-            const sf::Vector2f Delta = Transform->Position - WorldPos.Value;
+            const sf::Vector2f Delta = Transform->GetWorldPosition() - WorldPos.Value;
             const float DistanceSq = Delta.x * Delta.x + Delta.y * Delta.y;
 
             if (DistanceSq < ClosestDistanceSq)
@@ -6,17 +6,23 @@
 #include <optional>
 #include <chrono>
 #include "../Async/Task.hpp"
+#include "../Assets/AssetId.hpp"
 #include "../Common.h"
 #include "../Coordinates/TypedRect.hpp"
 #include "../Coordinates/WorldCoordinate.h"
 #include "../Coordinates/WindowCoordinate.h"
+#include "EditorHistory.h"
 #include "ObjectSelection.h"
+#include "SceneSaver.h"
+#include "../ThirdParty/json.hpp"
 
 namespace Core
 {
     class World;
     class WorldObject;
     class TileMapComponent;
+    class TransformComponent;
+    class AssetCancellationToken;
     struct EngineContext;
 
     enum class EditorTool
@@ -80,6 +86,11 @@ namespace Core
     {
     public:
         LevelDesignerModel(World& InWorld, std::shared_ptr<EngineContext> InContext);
+        ~LevelDesignerModel();
+
+        // Drops the references held for the loaded scene; called when the editor exits
+        void ReleaseSceneAssets();
+        std::vector<AssetId> GetSceneAssetIds() const;
 
         std::shared_ptr<WorldObject> CreateObject();
         void RemoveObject(const std::shared_ptr<WorldObject>& Object);
@@ -87,11 +98,20 @@ namespace Core
         bool MoveObjectDown(const std::shared_ptr<WorldObject>& Object);
         const std::vector<std::shared_ptr<WorldObject>>& GetAllObjects() const;
 
+        // Snapshots the scene and writes it in the background; see SceneSaver
         void SaveScene();
         void SaveSceneAs(const std::string& SceneName);
+        void WaitForSave() { Saver.Wait(); }
+        SceneSaveStatus GetSaveStatus() const { return Saver.GetStatus(); }
         Task<> LoadScene(const std::string& SceneName);
         void NewScene();
 
+        // Edits made through the editor tools; cleared when another scene is loaded or started
+        EditorHistory& GetHistory() { return History; }
+        const EditorHistory& GetHistory() const { return History; }
+        void Undo() { History.Undo(); }
+        void Redo() { History.Redo(); }
+
         const SceneInfo& GetCurrentScene() const { return CurrentScene; }
         std::vector<std::string> GetAvailableScenes() const;
         bool CanPlayTest() const;
@@ -164,6 +184,13 @@ namespace Core
         World& WorldRef;
         std::shared_ptr<EngineContext> Context;
         SceneInfo CurrentScene;
+        SceneSaver Saver;
+        EditorHistory History;
+
+        // References held for the scene being edited, handed off when another scene is loaded
+        std::vector<AssetId> SceneAssets;
+        std::vector<AssetId> StreamedSceneAssets;
+        std::shared_ptr<AssetCancellationToken> LoadCancellation;
 
         TileSelection CurrentSelection;
         int CurrentTileSheetIndex = 0;
@@ -179,6 +206,7 @@ namespace Core
         DragMode CurrentDragMode = DragMode::None;
         WorldCoordinate DragStartPos;
         std::vector<std::pair<WorldObject*, sf::Vector2f>> DraggedObjectsInitialPositions;
+        std::vector<std::pair<std::weak_ptr<TransformComponent>, nlohmann::json>> DraggedObjectsInitialTransforms;
         bool bMouseOverBlockingUI = false;
 
         bool bIsPreviewingTime = false;
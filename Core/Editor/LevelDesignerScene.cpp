@@ -25,6 +25,20 @@ namespace Core
         CreateEditorInfrastructure();
     }
 
+    void LevelDesignerScene::OnExit()
+    {
+        Model.ReleaseSceneAssets();
+        Scene::OnExit();
+    }
+
+    std::vector<AssetId> LevelDesignerScene::GetAssetIds() const
+    {
+        std::vector<AssetId> Ids = Scene::GetAssetIds();
+        const std::vector<AssetId> ModelIds = Model.GetSceneAssetIds();
+        Ids.insert(Ids.end(), ModelIds.begin(), ModelIds.end());
+        return Ids;
+    }
+
     void LevelDesignerScene::CreateEditorInfrastructure()
     {
         std::shared_ptr<WorldObject> CameraObj = Model.CreateObject();
@@ -34,6 +48,7 @@ namespace Core
         CameraComponent* Camera = CameraObj->Components().Add<CameraComponent>();
         Camera->SetZoom(0.25f);
         CameraObj->Components().Add<LevelEditorController>();
+        World.SetActiveCamera(CameraObj->Components().Get<CameraComponent>());
     }
 
     void LevelDesignerScene::PreRender()
@@ -132,7 +147,7 @@ namespace Core
 
             if (std::shared_ptr<TransformComponent> Transform = CameraObject->Components().Get<TransformComponent>())
             {
-                Transform->Position = sf::Vector2f(0.0f, 0.0f);
+                Transform->SetPosition(sf::Vector2f(0.0f, 0.0f));
             }
         }
     }
@@ -15,6 +15,9 @@ namespace Core
         LevelDesignerScene(std::shared_ptr<EngineContext> InContext);
 
         void OnLoad() override;
+        void OnExit() override;
+
+        std::vector<AssetId> GetAssetIds() const override;
         void PreRender() override;
         void RenderUI() override;
 
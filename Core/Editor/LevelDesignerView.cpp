@@ -68,6 +68,24 @@ namespace Core
                 ImGui::EndMenu();
             }
 
+            if (ImGui::BeginMenu("Edit"))
+            {
+                const char* UndoName = ViewModel.GetUndoName();
+                const std::string UndoLabel = UndoName ? std::string("Undo ") + UndoName : "Undo";
+                if (ImGui::MenuItem(UndoLabel.c_str(), "Ctrl+Z", false, UndoName != nullptr))
+                {
+                    ViewModel.Undo();
+                }
+
+                const char* RedoName = ViewModel.GetRedoName();
+                const std::string RedoLabel = RedoName ? std::string("Redo ") + RedoName : "Redo";
+                if (ImGui::MenuItem(RedoLabel.c_str(), "Ctrl+Y", false, RedoName != nullptr))
+                {
+                    ViewModel.Redo();
+                }
+                ImGui::EndMenu();
+            }
+
             if (ImGui::BeginMenu("View"))
             {
                 const bool bShowGrid = ViewModel.IsGridVisible();
@@ -90,6 +108,8 @@ namespace Core
                 bShowEnvironmentPanel = !bShowEnvironmentPanel;
             }
 
+            RenderSaveStatus();
+
             const float MenuBarHeight = ImGui::GetWindowSize().y;
             const float PlayButtonWidth = 80.0f;
             const float BackButtonWidth = 80.0f;
@@ -105,7 +125,9 @@ namespace Core
 
             if (ImGui::Button("Play", ImVec2(PlayButtonWidth - 10, MenuBarHeight - 4)))
             {
+                // Play test reads the scene back from disk
                 ViewModel.SaveScene();
+                ViewModel.WaitForSave();
 
                 const std::string SceneName = ViewModel.GetModel().GetCurrentScene().GetName();
                 if (!SceneName.empty())
@@ -141,6 +163,26 @@ namespace Core
         RenderOpenSceneModal(LoadingTask);
     }
 
+    void LevelDesignerView::RenderSaveStatus()
+    {
+        const SceneSaveStatus Status = ViewModel.GetSaveStatus();
+        switch (Status.State)
+        {
+        case SceneSaveState::Idle:
+            break;
+        case SceneSaveState::Saving:
+            ImGui::TextDisabled("Saving...");
+            break;
+        case SceneSaveState::Saved:
+            ImGui::TextDisabled("Saved (%.0f ms, %zu/%zu objects, %zu/%zu chunks re-encoded)", Status.DurationMs,
+                                Status.ObjectsEncoded, Status.ObjectCount, Status.ChunksEncoded, Status.ChunkCount);
+            break;
+        case SceneSaveState::Failed:
+            ImGui::TextColored(UITheme::ErrorText, "Save failed");
+            break;
+        }
+    }
+
     void LevelDesignerView::RenderSaveAsModal()
     {
         if (bShowSaveAsModal)
@@ -689,6 +731,7 @@ namespace Core
         if (ImGui::Button("+", ImVec2(50, 0)))
         {
             TileMapData.AddLayer();
+            TileMapComp->MarkChanged();
             ViewModel.SetCurrentLayer(LayerCount);
         }
         ImGui::SameLine();
@@ -697,6 +740,7 @@ namespace Core
             if (LayerCount > 1)
             {
                 TileMapData.RemoveLayer(ViewModel.GetCurrentLayer());
+                TileMapComp->MarkChanged();
                 if (ViewModel.GetCurrentLayer() >= TileMapData.GetLayerCount())
                 {
                     ViewModel.SetCurrentLayer(TileMapData.GetLayerCount() - 1);
@@ -709,6 +753,7 @@ namespace Core
             if (ViewModel.GetCurrentLayer() < LayerCount - 1)
             {
                 TileMapData.SwapLayers(ViewModel.GetCurrentLayer(), ViewModel.GetCurrentLayer() + 1);
+                TileMapComp->MarkChanged();
                 ViewModel.SetCurrentLayer(ViewModel.GetCurrentLayer() + 1);
             }
         }
@@ -718,6 +763,7 @@ namespace Core
             if (ViewModel.GetCurrentLayer() > 0)
             {
                 TileMapData.SwapLayers(ViewModel.GetCurrentLayer(), ViewModel.GetCurrentLayer() - 1);
+                TileMapComp->MarkChanged();
                 ViewModel.SetCurrentLayer(ViewModel.GetCurrentLayer() - 1);
             }
         }
@@ -1041,7 +1087,7 @@ namespace Core
             const TransformComponent* Transform = HoveredObject->Transform();
             if (Transform)
             {
-                const sf::Vector2f Position = Transform->Position;
+                const sf::Vector2f Position = Transform->GetWorldPosition();
                 constexpr float BoundsSize = 10.0f;
                 constexpr float HalfSize = BoundsSize / 2.0f;
 
@@ -1074,7 +1120,7 @@ namespace Core
             if (!Transform)
                 continue;
 
-            const sf::Vector2f Position = Transform->Position;
+            const sf::Vector2f Position = Transform->GetWorldPosition();
             constexpr float BoundsSize = 10.0f;
             constexpr float HalfSize = BoundsSize / 2.0f;
 
@@ -1103,7 +1149,7 @@ namespace Core
             if (!Transform)
                 continue;
 
-            const sf::Vector2f Position = Transform->Position;
+            const sf::Vector2f Position = Transform->GetWorldPosition();
             constexpr float BoundsSize = 10.0f;
             constexpr float HalfSize = BoundsSize / 2.0f;
 
@@ -38,6 +38,7 @@ namespace Core
         void RenderSaveAsModal();
         void RenderOpenSceneModal(std::optional<Task<>>& LoadingTask);
         void RenderEnvironmentPanel();
+        void RenderSaveStatus();
 
         LevelDesignerViewModel& ViewModel;
 
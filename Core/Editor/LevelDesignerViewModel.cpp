@@ -130,6 +130,36 @@ namespace Core
         Model.SaveSceneAs(SceneName);
     }
 
+    void LevelDesignerViewModel::WaitForSave()
+    {
+        Model.WaitForSave();
+    }
+
+    SceneSaveStatus LevelDesignerViewModel::GetSaveStatus() const
+    {
+        return Model.GetSaveStatus();
+    }
+
+    void LevelDesignerViewModel::Undo()
+    {
+        Model.Undo();
+    }
+
+    void LevelDesignerViewModel::Redo()
+    {
+        Model.Redo();
+    }
+
+    const char* LevelDesignerViewModel::GetUndoName() const
+    {
+        return Model.GetHistory().GetUndoName();
+    }
+
+    const char* LevelDesignerViewModel::GetRedoName() const
+    {
+        return Model.GetHistory().GetRedoName();
+    }
+
     Task<void> LevelDesignerViewModel::LoadScene(const std::string& SceneName)
     {
         return Model.LoadScene(SceneName);
@@ -24,6 +24,7 @@ namespace Core
     struct TileSelection;
     struct EngineContext;
     class SceneInfo;
+    struct SceneSaveStatus;
     enum class EditorTool;
     template<typename T> class Task;
 
@@ -54,8 +55,16 @@ namespace Core
         void NewScene();
         void SaveScene();
         void SaveSceneAs(const std::string& SceneName);
+        void WaitForSave();
+        SceneSaveStatus GetSaveStatus() const;
         Task<void> LoadScene(const std::string& SceneName);
 
+        void Undo();
+        void Redo();
+        // Null when there is nothing to undo or redo
+        const char* GetUndoName() const;
+        const char* GetRedoName() const;
+
         void SetMouseOverBlockingUI(bool bBlocking);
 
         void StartTimePreview();
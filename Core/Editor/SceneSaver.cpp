@@ -0,0 +1,637 @@
+#include "SceneSaver.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <optional>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+#include "../Components/Component.h"
+#include "../Components/TileMapComponent.h"
+#include "../Log/Log.h"
+#include "../TileMap/TileMap.h"
+#include "../World/World.h"
+#include "../World/WorldObject.h"
+
+namespace Core
+{
+    struct SceneSaver::Snapshot
+    {
+        struct Chunk
+        {
+            std::uint64_t Revision = 0;
+            uint OriginX = 0;
+            uint OriginY = 0;
+            uint Width = 0;
+            uint Height = 0;
+
+            // Only copied when no earlier snapshot held this revision
+            bool bCopied = false;
+            std::vector<Tile> Tiles;
+        };
+
+        struct TileMapData
+        {
+            uint Width = 0;
+            uint Height = 0;
+            uint ChunkColumns = 0;
+            std::vector<std::vector<Chunk>> Layers;
+        };
+
+        struct ComponentData
+        {
+            std::string Type;
+            nlohmann::json Data;
+            std::optional<TileMapData> TileMap;
+        };
+
+        struct Object
+        {
+            std::uint64_t Id = 0;
+            bool bChanged = true;
+            std::string Name;
+            std::vector<ComponentData> Components;
+        };
+
+        std::string Path;
+        nlohmann::json Environment;
+        std::vector<Object> Objects;
+
+        std::chrono::steady_clock::time_point Requested;
+        std::size_t ObjectsChanged = 0;
+        std::size_t ChunksCopied = 0;
+        std::size_t ChunkCount = 0;
+    };
+
+    namespace
+    {
+        // Nesting depths in the file as World::ToJson().dump(4) lays it out
+        constexpr int ObjectDepth = 2;
+        constexpr int ComponentDepth = 4;
+        constexpr int TileMapDepth = 5;
+        constexpr int LayerDepth = 7;
+        constexpr int TileDepth = 9;
+
+        void AppendIndent(std::string& Out, int Depth)
+        {
+            Out.append(static_cast<std::size_t>(Depth) * 4, ' ');
+        }
+
+        void AppendUnsigned(std::string& Out, uint Value)
+        {
+            char Buffer[16];
+            const std::to_chars_result Result = std::to_chars(Buffer, Buffer + sizeof(Buffer), Value);
+            Out.append(Buffer, Result.ptr);
+        }
+
+        // For a value whose first line continues a line at Depth
+        void AppendJson(std::string& Out, const nlohmann::json& Value, int Depth)
+        {
+            for (const char Character : Value.dump(4))
+            {
+                Out += Character;
+                if (Character == '\n')
+                {
+                    AppendIndent(Out, Depth);
+                }
+            }
+        }
+
+        void AppendTile(std::string& Out, const Tile& Entry, uint X, uint Y)
+        {
+            AppendIndent(Out, TileDepth);
+            Out += "{\n";
+            AppendIndent(Out, TileDepth + 1);
+            Out += "\"tileIndex\": ";
+            AppendUnsigned(Out, Entry.GetTileIndex());
+            Out += ",\n";
+            AppendIndent(Out, TileDepth + 1);
+            Out += "\"tileSheetId\": ";
+            AppendUnsigned(Out, Entry.GetTileSheetId().value_or(0));
+            Out += ",\n";
+            AppendIndent(Out, TileDepth + 1);
+            Out += "\"x\": ";
+            AppendUnsigned(Out, X);
+            Out += ",\n";
+            AppendIndent(Out, TileDepth + 1);
+            Out += "\"y\": ";
+            AppendUnsigned(Out, Y);
+            Out += "\n";
+            AppendIndent(Out, TileDepth);
+            Out += "}";
+        }
+
+        // In the order Save copies chunks: layer by layer, row by row
+        void AppendChunkRevisions(const TileMap& Map, std::vector<std::uint64_t>& OutRevisions)
+        {
+            for (uint Layer = 0; Layer < Map.GetLayerCount(); ++Layer)
+            {
+                for (uint ChunkY = 0; ChunkY < Map.GetChunkRows(); ++ChunkY)
+                {
+                    for (uint ChunkX = 0; ChunkX < Map.GetChunkColumns(); ++ChunkX)
+                    {
+                        OutRevisions.push_back(Map.GetChunkRevision(Layer, ChunkX, ChunkY));
+                    }
+                }
+            }
+        }
+
+        bool IsSameObject(const std::string& Name,
+                          const std::vector<std::pair<std::weak_ptr<Component>, std::uint64_t>>& Versions,
+                          const std::vector<std::uint64_t>& ChunkRevisions,
+                          const std::string& PreviousName,
+                          const std::vector<std::pair<std::weak_ptr<Component>, std::uint64_t>>& PreviousVersions,
+                          const std::vector<std::uint64_t>& PreviousChunkRevisions)
+        {
+            // Tile edits move chunk revisions even when nothing marked the component changed
+            if (Name != PreviousName || Versions.size() != PreviousVersions.size() || ChunkRevisions != PreviousChunkRevisions)
+            {
+                return false;
+            }
+
+            // Holding the weak pointers keeps a new component from reusing an old one's address
+            for (std::size_t Index = 0; Index < Versions.size(); ++Index)
+            {
+                if (Versions[Index].first.lock() != PreviousVersions[Index].first.lock()
+                    || Versions[Index].second != PreviousVersions[Index].second)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool WriteFileAtomically(const std::string& Path, const std::string& Contents)
+        {
+            const std::string TempPath = Path + ".tmp";
+
+            std::FILE* File = std::fopen(TempPath.c_str(), "wb");
+            if (!File)
+            {
+                return false;
+            }
+
+            bool bWritten = std::fwrite(Contents.data(), 1, Contents.size(), File) == Contents.size();
+            bWritten = std::fflush(File) == 0 && bWritten;
+#ifdef __linux__
+            // The rename must not reach the disk before the data it points at
+            bWritten = fsync(fileno(File)) == 0 && bWritten;
+#endif
+            bWritten = std::fclose(File) == 0 && bWritten;
+
+            std::error_code Error;
+            if (bWritten)
+            {
+                std::filesystem::rename(TempPath, Path, Error);
+                if (!Error)
+                {
+                    return true;
+                }
+            }
+
+            std::filesystem::remove(TempPath, Error);
+            return false;
+        }
+    }
+
+    void SceneSaver::Save(World& InWorld, const std::string& Path)
+    {
+        if (bCachesLost.exchange(false, std::memory_order_acquire))
+        {
+            ObjectRecords.clear();
+            SnapshotChunks.clear();
+        }
+
+        auto Job = std::make_shared<Snapshot>();
+        Job->Requested = std::chrono::steady_clock::now();
+        Job->Path = Path;
+        Job->Environment = InWorld.GetEnvironment().ToJson();
+
+        std::unordered_map<std::uint64_t, ObjectRecord> Records;
+        std::unordered_set<std::uint64_t> Chunks;
+
+        for (const std::shared_ptr<WorldObject>& Object : InWorld.Objects().GetAll())
+        {
+            if (!Object || Object->GetTag() != ObjectTag::Game)
+            {
+                continue;
+            }
+
+            ObjectRecord Record;
+            Record.Name = Object->GetName();
+            for (const auto& [TypeIndex, ComponentPtr] : Object->Components().GetAll())
+            {
+                if (!ComponentPtr)
+                {
+                    continue;
+                }
+
+                Record.ComponentVersions.emplace_back(ComponentPtr, ComponentPtr->GetChangeVersion());
+                if (const TileMapComponent* TileMapComp = dynamic_cast<const TileMapComponent*>(ComponentPtr.get()))
+                {
+                    AppendChunkRevisions(TileMapComp->GetTileMap(), Record.ChunkRevisions);
+                }
+            }
+
+            Snapshot::Object& Entry = Job->Objects.emplace_back();
+            Entry.Id = Object->GetWorldId();
+
+            auto Previous = ObjectRecords.find(Entry.Id);
+            if (Entry.Id != 0 && Previous != ObjectRecords.end()
+                && IsSameObject(Record.Name, Record.ComponentVersions, Record.ChunkRevisions, Previous->second.Name,
+                                Previous->second.ComponentVersions, Previous->second.ChunkRevisions))
+            {
+                Entry.bChanged = false;
+            }
+            else
+            {
+                Entry.Name = Record.Name;
+                ++Job->ObjectsChanged;
+
+                for (const auto& [TypeIndex, ComponentPtr] : Object->Components().GetAll())
+                {
+                    if (!ComponentPtr)
+                    {
+                        continue;
+                    }
+
+                    Snapshot::ComponentData& Data = Entry.Components.emplace_back();
+                    Data.Type = ComponentPtr->GetName();
+
+                    const TileMapComponent* TileMapComp = dynamic_cast<const TileMapComponent*>(ComponentPtr.get());
+                    if (!TileMapComp)
+                    {
+                        Data.Data = ComponentPtr->ToJson();
+                        continue;
+                    }
+
+                    // Tiles dominate the file; copy only chunks the worker has not encoded yet
+                    const TileMap& Map = TileMapComp->GetTileMap();
+                    Snapshot::TileMapData& MapData = Data.TileMap.emplace();
+                    MapData.Width = Map.GetWidth();
+                    MapData.Height = Map.GetHeight();
+                    MapData.ChunkColumns = Map.GetChunkColumns();
+
+                    for (uint Layer = 0; Layer < Map.GetLayerCount(); ++Layer)
+                    {
+                        const std::vector<Tile>& LayerTiles = Map.GetLayerTiles(Layer);
+                        std::vector<Snapshot::Chunk>& LayerChunks = MapData.Layers.emplace_back();
+
+                        for (uint ChunkY = 0; ChunkY < Map.GetChunkRows(); ++ChunkY)
+                        {
+                            for (uint ChunkX = 0; ChunkX < Map.GetChunkColumns(); ++ChunkX)
+                            {
+                                Snapshot::Chunk& Chunk = LayerChunks.emplace_back();
+                                Chunk.Revision = Map.GetChunkRevision(Layer, ChunkX, ChunkY);
+                                Chunk.OriginX = ChunkX * TileMap::ChunkSize;
+                                Chunk.OriginY = ChunkY * TileMap::ChunkSize;
+                                Chunk.Width = std::min(TileMap::ChunkSize, Map.GetWidth() - Chunk.OriginX);
+                                Chunk.Height = std::min(TileMap::ChunkSize, Map.GetHeight() - Chunk.OriginY);
+
+                                if (SnapshotChunks.contains(Chunk.Revision))
+                                {
+                                    continue;
+                                }
+
+                                Chunk.bCopied = true;
+                                Chunk.Tiles.reserve(static_cast<std::size_t>(Chunk.Width) * Chunk.Height);
+                                for (uint Row = 0; Row < Chunk.Height; ++Row)
+                                {
+                                    const auto RowStart = LayerTiles.begin()
+                                        + static_cast<std::ptrdiff_t>((Chunk.OriginY + Row) * Map.GetWidth() + Chunk.OriginX);
+                                    Chunk.Tiles.insert(Chunk.Tiles.end(), RowStart, RowStart + Chunk.Width);
+                                }
+                                ++Job->ChunksCopied;
+                            }
+                        }
+                    }
+                }
+            }
+
+            Job->ChunkCount += Record.ChunkRevisions.size();
+            Chunks.insert(Record.ChunkRevisions.begin(), Record.ChunkRevisions.end());
+            if (Entry.Id != 0)
+            {
+                Records[Entry.Id] = std::move(Record);
+            }
+        }
+
+        ObjectRecords = std::move(Records);
+        SnapshotChunks = std::move(Chunks);
+
+        {
+            std::lock_guard Lock(StatusMutex);
+            ++PendingCount;
+            Status.State = SceneSaveState::Saving;
+            Status.Path = Path;
+        }
+
+        Worker.Enqueue([this, Job]()
+        {
+            Write(*Job);
+        });
+    }
+
+    void SceneSaver::Wait()
+    {
+        std::unique_lock Lock(StatusMutex);
+        StatusChanged.wait(Lock, [this]()
+        {
+            return PendingCount == 0;
+        });
+    }
+
+    SceneSaveStatus SceneSaver::GetStatus() const
+    {
+        std::lock_guard Lock(StatusMutex);
+        return Status;
+    }
+
+    void SceneSaver::Write(Snapshot& Job)
+    {
+        std::unordered_map<std::uint64_t, EncodedObject> Objects;
+        std::unordered_map<std::uint64_t, EncodedChunk> Chunks;
+
+        // Chunks this job refers to, whether encoded now or by an earlier job
+        auto KeepChunk = [this, &Chunks](std::uint64_t Revision) -> const EncodedChunk*
+        {
+            if (auto Kept = Chunks.find(Revision); Kept != Chunks.end())
+            {
+                return &Kept->second;
+            }
+            auto Previous = EncodedChunks.find(Revision);
+            if (Previous == EncodedChunks.end())
+            {
+                return nullptr;
+            }
+            return &Chunks.emplace(Revision, std::move(Previous->second)).first->second;
+        };
+
+        std::size_t ObjectsWritten = 0;
+        std::string Out = "{\n";
+        AppendIndent(Out, 1);
+        Out += "\"objects\": [";
+
+        bool bComplete = true;
+        for (Snapshot::Object& Entry : Job.Objects)
+        {
+            if (!Entry.bChanged)
+            {
+                auto Previous = EncodedObjects.find(Entry.Id);
+                if (Previous == EncodedObjects.end())
+                {
+                    bComplete = false;
+                    break;
+                }
+                for (const std::uint64_t Revision : Previous->second.ChunkRevisions)
+                {
+                    KeepChunk(Revision);
+                }
+
+                Out += ObjectsWritten++ == 0 ? "\n" : ",\n";
+                Out += Previous->second.Text;
+                Objects.emplace(Entry.Id, std::move(Previous->second));
+                continue;
+            }
+
+            EncodedObject Encoded;
+            std::string& Text = Encoded.Text;
+
+            AppendIndent(Text, ObjectDepth);
+            Text += "{\n";
+            AppendIndent(Text, ObjectDepth + 1);
+            Text += "\"components\": [";
+
+            for (std::size_t ComponentIndex = 0; ComponentIndex < Entry.Components.size(); ++ComponentIndex)
+            {
+                Snapshot::ComponentData& Data = Entry.Components[ComponentIndex];
+
+                Text += ComponentIndex == 0 ? "\n" : ",\n";
+                AppendIndent(Text, ComponentDepth);
+                Text += "{\n";
+                AppendIndent(Text, ComponentDepth + 1);
+                Text += "\"data\": ";
+
+                if (!Data.TileMap)
+                {
+                    AppendJson(Text, Data.Data, ComponentDepth + 1);
+                }
+                else
+                {
+                    const Snapshot::TileMapData& MapData = *Data.TileMap;
+
+                    Text += "{\n";
+                    AppendIndent(Text, TileMapDepth + 1);
+                    Text += "\"height\": ";
+                    AppendUnsigned(Text, MapData.Height);
+                    Text += ",\n";
+                    AppendIndent(Text, TileMapDepth + 1);
+                    Text += "\"layers\": [";
+
+                    for (std::size_t LayerIndex = 0; LayerIndex < MapData.Layers.size(); ++LayerIndex)
+                    {
+                        const std::vector<Snapshot::Chunk>& LayerChunks = MapData.Layers[LayerIndex];
+
+                        std::vector<const EncodedChunk*> LayerEncoded;
+                        LayerEncoded.reserve(LayerChunks.size());
+                        for (const Snapshot::Chunk& Chunk : LayerChunks)
+                        {
+                            if (Chunk.bCopied && !Chunks.contains(Chunk.Revision))
+                            {
+                                EncodedChunk NewChunk;
+                                for (uint Row = 0; Row < Chunk.Height; ++Row)
+                                {
+                                    NewChunk.RowOffsets.push_back(NewChunk.Text.size());
+                                    const std::size_t RowStart = NewChunk.Text.size();
+                                    for (uint Column = 0; Column < Chunk.Width; ++Column)
+                                    {
+                                        const Tile& Cell = Chunk.Tiles[Row * Chunk.Width + Column];
+                                        if (Cell.IsEmpty())
+                                        {
+                                            continue;
+                                        }
+                                        if (NewChunk.Text.size() != RowStart)
+                                        {
+                                            NewChunk.Text += ",\n";
+                                        }
+                                        AppendTile(NewChunk.Text, Cell, Chunk.OriginX + Column, Chunk.OriginY + Row);
+                                    }
+                                }
+                                NewChunk.RowOffsets.push_back(NewChunk.Text.size());
+                                Chunks.emplace(Chunk.Revision, std::move(NewChunk));
+                            }
+
+                            const EncodedChunk* Kept = KeepChunk(Chunk.Revision);
+                            if (!Kept)
+                            {
+                                bComplete = false;
+                                break;
+                            }
+                            LayerEncoded.push_back(Kept);
+                            Encoded.ChunkRevisions.push_back(Chunk.Revision);
+                        }
+                        if (!bComplete)
+                        {
+                            break;
+                        }
+
+                        Text += LayerIndex == 0 ? "\n" : ",\n";
+                        AppendIndent(Text, LayerDepth);
+                        Text += "{\n";
+                        AppendIndent(Text, LayerDepth + 1);
+                        Text += "\"tiles\": [";
+
+                        // Tiles go out row by row across the whole layer, so stitch each row from the chunks it crosses
+                        bool bAnyTile = false;
+                        for (uint Y = 0; Y < MapData.Height; ++Y)
+                        {
+                            const std::size_t ChunkRowStart = static_cast<std::size_t>(Y / TileMap::ChunkSize) * MapData.ChunkColumns;
+                            const uint Row = Y % TileMap::ChunkSize;
+
+                            for (uint ChunkX = 0; ChunkX < MapData.ChunkColumns; ++ChunkX)
+                            {
+                                const EncodedChunk& Chunk = *LayerEncoded[ChunkRowStart + ChunkX];
+                                const std::size_t Begin = Chunk.RowOffsets[Row];
+                                const std::size_t End = Chunk.RowOffsets[Row + 1];
+                                if (Begin == End)
+                                {
+                                    continue;
+                                }
+
+                                Text += bAnyTile ? ",\n" : "\n";
+                                Text.append(Chunk.Text, Begin, End - Begin);
+                                bAnyTile = true;
+                            }
+                        }
+
+                        if (bAnyTile)
+                        {
+                            Text += "\n";
+                            AppendIndent(Text, LayerDepth + 1);
+                        }
+                        Text += "]\n";
+                        AppendIndent(Text, LayerDepth);
+                        Text += "}";
+                    }
+                    if (!bComplete)
+                    {
+                        break;
+                    }
+
+                    if (!MapData.Layers.empty())
+                    {
+                        Text += "\n";
+                        AppendIndent(Text, TileMapDepth + 1);
+                    }
+                    Text += "],\n";
+                    AppendIndent(Text, TileMapDepth + 1);
+                    Text += "\"width\": ";
+                    AppendUnsigned(Text, MapData.Width);
+                    Text += "\n";
+                    AppendIndent(Text, TileMapDepth);
+                    Text += "}";
+                }
+
+                Text += ",\n";
+                AppendIndent(Text, ComponentDepth + 1);
+                Text += "\"type\": ";
+                Text += nlohmann::json(Data.Type).dump();
+                Text += "\n";
+                AppendIndent(Text, ComponentDepth);
+                Text += "}";
+            }
+            if (!bComplete)
+            {
+                break;
+            }
+
+            if (!Entry.Components.empty())
+            {
+                Text += "\n";
+                AppendIndent(Text, ObjectDepth + 1);
+            }
+            Text += "]";
+
+            if (!Entry.Name.empty())
+            {
+                Text += ",\n";
+                AppendIndent(Text, ObjectDepth + 1);
+                Text += "\"name\": ";
+                Text += nlohmann::json(Entry.Name).dump();
+            }
+
+            Text += "\n";
+            AppendIndent(Text, ObjectDepth);
+            Text += "}";
+
+            Out += ObjectsWritten++ == 0 ? "\n" : ",\n";
+            Out += Text;
+            Objects[Entry.Id] = std::move(Encoded);
+        }
+
+        if (ObjectsWritten > 0)
+        {
+            Out += "\n";
+            AppendIndent(Out, 1);
+        }
+        Out += "],\n";
+        AppendIndent(Out, 1);
+        Out += "\"worldEnvironment\": ";
+        AppendJson(Out, Job.Environment, 1);
+        Out += "\n}";
+
+        EncodedObjects = std::move(Objects);
+        EncodedChunks = std::move(Chunks);
+
+        if (!bComplete)
+        {
+            // Snapshot and worker caches went out of step; the next snapshot copies everything again
+            Log::Error(ELogCategory::Editor, "Scene save of %s skipped: encoded data for an unchanged object is missing",
+                       Job.Path.c_str());
+            EncodedObjects.clear();
+            EncodedChunks.clear();
+            bCachesLost.store(true, std::memory_order_release);
+            Finish(Job, false);
+            return;
+        }
+
+        Finish(Job, WriteFileAtomically(Job.Path, Out));
+    }
+
+    void SceneSaver::Finish(const Snapshot& Job, bool bSucceeded)
+    {
+        const double DurationMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - Job.Requested).count();
+
+        if (bSucceeded)
+        {
+            Log::Info(ELogCategory::Editor, "Saved %s in %.1f ms: %zu of %zu objects and %zu of %zu tile chunks re-encoded",
+                      Job.Path.c_str(), DurationMs, Job.ObjectsChanged, Job.Objects.size(), Job.ChunksCopied,
+                      Job.ChunkCount);
+        }
+        else
+        {
+            Log::Error(ELogCategory::Editor, "Failed to save %s", Job.Path.c_str());
+        }
+
+        {
+            std::lock_guard Lock(StatusMutex);
+            --PendingCount;
+            Status.DurationMs = DurationMs;
+            Status.ObjectsEncoded = Job.ObjectsChanged;
+            Status.ObjectCount = Job.Objects.size();
+            Status.ChunksEncoded = Job.ChunksCopied;
+            Status.ChunkCount = Job.ChunkCount;
+            if (PendingCount == 0)
+            {
+                Status.State = bSucceeded ? SceneSaveState::Saved : SceneSaveState::Failed;
+            }
+        }
+        StatusChanged.notify_all();
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../Async/ThreadPool.h"
+
+namespace Core
+{
+    class Component;
+    class World;
+
+    enum class SceneSaveState
+    {
+        Idle,
+        Saving,
+        Saved,
+        Failed
+    };
+
+    struct SceneSaveStatus
+    {
+        SceneSaveState State = SceneSaveState::Idle;
+        std::string Path;
+
+        // Of the last save that finished
+        double DurationMs = 0.0;
+        std::size_t ObjectsEncoded = 0;
+        std::size_t ObjectCount = 0;
+        std::size_t ChunksEncoded = 0;
+        std::size_t ChunkCount = 0;
+    };
+
+    // Saves the edited world without stalling the frame. Save snapshots the world on the calling thread, copying
+    // only objects and tile chunks that changed since the previous save; a worker encodes the snapshot, reusing the
+    // text of everything unchanged, and replaces the file through a rename so a crash mid-write keeps the old one.
+    // The output matches World::ToJson().dump(4).
+    class SceneSaver
+    {
+    public:
+        void Save(World& InWorld, const std::string& Path);
+
+        // Blocks until every requested save has been written or has failed
+        void Wait();
+
+        SceneSaveStatus GetStatus() const;
+
+    private:
+        struct Snapshot;
+
+        // What the last snapshot held for an object, to tell whether it changed since
+        struct ObjectRecord
+        {
+            std::string Name;
+            std::vector<std::pair<std::weak_ptr<Component>, std::uint64_t>> ComponentVersions;
+            std::vector<std::uint64_t> ChunkRevisions;
+        };
+
+        // Tiles of one chunk as they appear in the file, with where each of its rows starts
+        struct EncodedChunk
+        {
+            std::string Text;
+            std::vector<std::size_t> RowOffsets;
+        };
+
+        struct EncodedObject
+        {
+            std::string Text;
+            std::vector<std::uint64_t> ChunkRevisions;
+        };
+
+        void Write(Snapshot& Job);
+        void Finish(const Snapshot& Job, bool bSucceeded);
+
+        // Main thread
+        std::unordered_map<std::uint64_t, ObjectRecord> ObjectRecords;
+        std::unordered_set<std::uint64_t> SnapshotChunks;
+
+        // Save worker; one job at a time, in order, so it has encoded everything earlier snapshots skipped copying
+        std::unordered_map<std::uint64_t, EncodedObject> EncodedObjects;
+        std::unordered_map<std::uint64_t, EncodedChunk> EncodedChunks;
+        std::atomic<bool> bCachesLost{false};
+
+        mutable std::mutex StatusMutex;
+        std::condition_variable StatusChanged;
+        SceneSaveStatus Status;
+        std::size_t PendingCount = 0;
+
+        // Declared last so queued saves finish before the caches they use go away
+        ThreadPool Worker{1};
+    };
+}
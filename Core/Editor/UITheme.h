@@ -6,4 +6,5 @@ namespace Core::UITheme
 {
     constexpr ImVec4 PanelBackground = ImVec4(0.08f, 0.08f, 0.08f, 1.0f);
     constexpr ImVec4 MenuBarBackground = ImVec4(0.05f, 0.05f, 0.05f, 1.0f);
+    constexpr ImVec4 ErrorText = ImVec4(0.9f, 0.35f, 0.35f, 1.0f);
 }
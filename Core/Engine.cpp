@@ -6,6 +6,7 @@
 
 #include "EngineContext.hpp"
 #include "Engine/EngineLoader.h"
+#include "Systems/AssetPipelineSystem.h"
 #include "Systems/AssetRegistrySystem.h"
 #include "Systems/DataAssetRegistrySystem.h"
 #include "Systems/InputSystem.h"
@@ -14,6 +15,9 @@
 #include "Systems/ImGuiSystem.h"
 #include "Systems/CoordinateProjectionSystem.h"
 #include "Systems/ShaderPipeline.h"
+#include "Systems/HotReloadSystem.h"
+#include "Systems/NavigationSystem.h"
+#include "Log/Log.h"
 
 namespace Core
 {
@@ -29,6 +33,7 @@ namespace Core
         Context->Renderer = Context->Window.get();
 
         SystemsRegistry->Register<AssetRegistrySystem>(Context);
+        SystemsRegistry->Register<AssetPipelineSystem>(Context);
         SystemsRegistry->Register<ImGuiSystem>(Context);
         SystemsRegistry->Register<InputSystem>(Context);
         SystemsRegistry->Register<SceneManagerSystem>(Context);
@@ -36,20 +41,33 @@ namespace Core
         SystemsRegistry->Register<WorldObjectSystem>(Context);
         SystemsRegistry->Register<CoordinateProjectionSystem>(Context);
         SystemsRegistry->Register<ShaderPipeline>(Context);
+        SystemsRegistry->Register<HotReloadSystem>(Context);
+        SystemsRegistry->Register<NavigationSystem>(Context);
     }
 
     void Engine::Run()
     {
-        setvbuf(stdout, NULL, _IONBF, 0);
-        std::printf("Engine::Run()\n");
+        Log::OpenFile("Game/Logs/Engine.log");
+        Log::Info(ELogCategory::Engine, "Engine::Run()");
 
-        ForEachSystem([](const std::shared_ptr<CoreSystem>& System)
-        {
-            System->Start();
-        });
+        sf::Clock StartupClock;
+        StartupClock.start();
 
         EngineLoader Loader(Context);
-        Loader.LoadGlobalAssets();
+        Loader.Load([this]()
+        {
+            ForEachSystem([](const std::shared_ptr<CoreSystem>& System)
+            {
+                System->Start();
+            });
+        }, InitialScene ? InitialScene->GetManifestName() : std::string());
+
+        if (InitialScene)
+        {
+            SystemsRegistry->GetCoreSystem<SceneManagerSystem>()->Push(std::move(InitialScene));
+        }
+
+        bool bFirstFrameShown = false;
 
         sf::Clock FrameClock;
         FrameClock.start();
@@ -111,6 +129,13 @@ namespace Core
 
             Window->display();
 
+            if (!bFirstFrameShown)
+            {
+                bFirstFrameShown = true;
+                Loader.LogTimeline();
+                Log::Info(ELogCategory::Engine, "First interactive frame after %.1f ms", StartupClock.getElapsedTime().asSeconds() * 1000.f);
+            }
+
             if (bPendingShutdown)
             {
                 Window->close();
@@ -122,7 +147,8 @@ namespace Core
             System->Shutdown();
         });
 
-        std::printf("~Engine::Run()\n");
+        Log::Info(ELogCategory::Engine, "~Engine::Run()");
+        Log::Flush();
     }
 
     void Engine::Shutdown()
@@ -30,6 +30,9 @@ namespace Core
         std::shared_ptr<EngineContext> Context;
         bool bPendingShutdown = false;
 
+        // Created up front so startup can prefetch its assets; pushed once startup is done
+        std::shared_ptr<Scene> InitialScene;
+
         float AccumulatedTime = 0.0f;
         float AverageFPS = 0.0f;
         int FrameCount = 0;
@@ -39,7 +42,7 @@ namespace Core
         requires IsScene<T>
     void Engine::SetInitialScene()
     {
-        SystemsRegistry->GetCoreSystem<SceneManagerSystem>()->Push<T>();
+        InitialScene = std::make_shared<T>(Context);
     }
 
     template <typename Func>
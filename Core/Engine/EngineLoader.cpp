@@ -1,139 +1,248 @@
 #include "EngineLoader.h"
 
+#include <algorithm>
 #include <filesystem>
-#include <cstdio>
-#include <thread>
-#include <chrono>
 
 #include "../EngineContext.hpp"
 #include "../SystemsRegistry.hpp"
 #include "../Assets/AssetLoader.h"
 #include "../Assets/AssetManifest.h"
+#include "../Assets/AssetPack.h"
+#include "../Systems/AssetPipelineSystem.h"
 #include "../Systems/AssetRegistrySystem.h"
 #include "../Systems/DataAssetRegistrySystem.h"
+#include "../Systems/SceneManagerSystem.h"
+#include "../Systems/ShaderPipeline.h"
 #include "../Tilemap/TileSheet.h"
+#include "../Log/Log.h"
 
 namespace Core
 {
+    namespace
+    {
+        // Startup has a handful of steps; more workers than that would only sit idle
+        constexpr std::size_t StartupWorkerCount = 4;
+    }
+
     EngineLoader::EngineLoader(std::shared_ptr<EngineContext> Context)
         : Context(std::move(Context))
+          , Graph(StartupWorkerCount)
     {
     }
 
     EngineLoader::~EngineLoader() = default;
 
-    void EngineLoader::LoadGlobalAssets()
+    void EngineLoader::Load(const std::function<void()>& StartSystems, const std::string& InitialSceneName)
     {
-        const std::string GlobalAssetPath = "Game/Assets/global.json";
-        if (!std::filesystem::exists(GlobalAssetPath))
+        std::shared_ptr<AssetPipelineSystem> Pipeline = Context->SystemsRegistry->GetCoreSystem<AssetPipelineSystem>();
+
+        // ImGui and the placeholder texture need the window's context, so system startup stays on the main thread
+        Graph.Add("StartSystems", {}, EStartupAffinity::MainThread, [&StartSystems]()
         {
-            std::printf("Could not load global assets with path: %s\n", GlobalAssetPath.c_str());
-            return;
+            StartSystems();
+            return StartupGraph::ReadyCheck();
+        });
+
+        Graph.Add("MountPack", {}, EStartupAffinity::Worker, [this]()
+        {
+            MountAssetPack();
+            return StartupGraph::ReadyCheck();
+        });
+
+        Graph.Add("CompileShaders", {}, EStartupAffinity::Worker, [this]()
+        {
+            Context->SystemsRegistry->GetCoreSystem<ShaderPipeline>()->CompilePasses();
+            return StartupGraph::ReadyCheck();
+        });
+
+        // Everything below reads through the pack when there is one
+        Graph.Add("GlobalAssets", {"MountPack"}, EStartupAffinity::Worker, [this]()
+        {
+            return LoadGlobalAssets();
+        });
+
+        Graph.Add("ScanTileSheets", {"MountPack"}, EStartupAffinity::Worker, [this]()
+        {
+            TileSheetPaths = FindTileSheetPaths();
+            return StartupGraph::ReadyCheck();
+        });
+
+        Graph.Add("TileSheetTextures", {"ScanTileSheets"}, EStartupAffinity::Worker, [this]()
+        {
+            return LoadTileSheetTextures();
+        });
+
+        Graph.Add("TileSheets", {"TileSheetTextures"}, EStartupAffinity::Worker, [this]()
+        {
+            CreateTileSheetObjects(TileSheetPaths);
+            return StartupGraph::ReadyCheck();
+        });
+
+        // The scene manager is idle until the graph finishes, so its prefetch can be started from a worker
+        if (!InitialSceneName.empty())
+        {
+            Graph.Add("InitialScene", {"MountPack"}, EStartupAffinity::Worker, [this, InitialSceneName]()
+            {
+                std::shared_ptr<SceneManagerSystem> SceneManager = Context->SystemsRegistry->GetCoreSystem<SceneManagerSystem>();
+                SceneManager->Prefetch(InitialSceneName, AssetLoader::LoadPriority::Visible);
+                return StartupGraph::ReadyCheck([SceneManager, InitialSceneName]()
+                {
+                    return SceneManager->IsPrefetchReady(InitialSceneName);
+                });
+            });
+        }
+
+        Graph.Run([&Pipeline]()
+        {
+            return Pipeline->ProcessUploads(Pipeline->GetSettings().UploadBudgetMs, false);
+        });
+
+        if (GlobalLoader)
+        {
+            Log::Info(ELogCategory::Engine, "Loaded %d global assets", GlobalLoader->GetCompletedCount());
+        }
+        if (TileSheetLoader)
+        {
+            Log::Info(ELogCategory::Engine, "Loaded %d tilesheet textures", TileSheetLoader->GetCompletedCount());
         }
+        Pipeline->LogStats();
+    }
 
+    StartupGraph::ReadyCheck EngineLoader::LoadGlobalAssets()
+    {
         std::shared_ptr<AssetRegistrySystem> AssetRegistry = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
         std::shared_ptr<DataAssetRegistrySystem> DataAssetRegistry = Context->SystemsRegistry->GetCoreSystem<DataAssetRegistrySystem>();
-        AssetLoader Loader(AssetRegistry, DataAssetRegistry);
+        std::shared_ptr<AssetPipelineSystem> Pipeline = Context->SystemsRegistry->GetCoreSystem<AssetPipelineSystem>();
+        const AssetPack* Pack = AssetRegistry->GetMountedPack();
 
-        const AssetManifest Manifest = AssetManifest::LoadFromFile(GlobalAssetPath);
+        const std::string GlobalAssetPath = "Game/Assets/global.json";
+        std::optional<AssetPackBlob> GlobalBlob = Pack ? Pack->Read(GlobalAssetPath) : std::nullopt;
+        if (!GlobalBlob && !std::filesystem::exists(GlobalAssetPath))
+        {
+            Log::Warning(ELogCategory::Engine, "Could not load global assets with path: %s", GlobalAssetPath.c_str());
+            return nullptr;
+        }
+
+        GlobalLoader = std::make_unique<AssetLoader>(AssetRegistry, DataAssetRegistry, Pipeline);
+
+        const AssetManifest Manifest = GlobalBlob
+            ? AssetManifest::LoadFromMemory(GlobalBlob->Bytes, GlobalAssetPath)
+            : AssetManifest::LoadFromFile(GlobalAssetPath);
 
         for (const AssetEntry& TextureAssetEntry : Manifest.Textures)
         {
-            Loader.QueueTexture(TextureAssetEntry.Path);
+            GlobalLoader->QueueTexture(TextureAssetEntry.Path);
         }
 
         for (const AssetEntry& FontAssetEntry : Manifest.Fonts)
         {
-            Loader.QueueFont(FontAssetEntry.Path, FontAssetEntry.Size);
+            GlobalLoader->QueueFont(FontAssetEntry.Path, FontAssetEntry.Size);
         }
 
         for (const AssetEntry& SoundAssetEntry : Manifest.Sounds)
         {
-            Loader.QueueSound(SoundAssetEntry.Path);
+            GlobalLoader->QueueSound(SoundAssetEntry.Path);
         }
 
-        Task<std::vector<AssetId>> LoadTask = Loader.LoadAllAsync();
-        while (!LoadTask.await_ready())
+        GlobalLoadTask.emplace(GlobalLoader->LoadAllAsync());
+        return [this]()
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(3));
-        }
+            return GlobalLoadTask->await_ready();
+        };
+    }
 
-        std::printf("Loaded %d global assets\n", Loader.GetCompletedCount());
+    void EngineLoader::MountAssetPack()
+    {
+        const std::string PackPath = "Game/Assets.pak";
+        if (!std::filesystem::exists(PackPath))
+        {
+            return;
+        }
 
-        LoadGlobalTileSheets();
+        std::shared_ptr<AssetRegistrySystem> AssetRegistry = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
+        AssetRegistry->MountPack(PackPath);
     }
 
-    void EngineLoader::LoadGlobalTileSheets()
+    StartupGraph::ReadyCheck EngineLoader::LoadTileSheetTextures()
     {
-        const std::string TileSheetDirectory = "Game/Assets/Tilesheets/";
-        if (!std::filesystem::exists(TileSheetDirectory))
+        if (TileSheetPaths.empty())
         {
-            std::printf("TileSheet directory does not exist: %s\n", TileSheetDirectory.c_str());
-            return;
+            Log::Warning(ELogCategory::Engine, "No tilesheets found");
+            return nullptr;
         }
 
         std::shared_ptr<AssetRegistrySystem> AssetRegistry = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
         std::shared_ptr<DataAssetRegistrySystem> DataAssetRegistry = Context->SystemsRegistry->GetCoreSystem<DataAssetRegistrySystem>();
-        AssetLoader Loader(AssetRegistry, DataAssetRegistry);
+        std::shared_ptr<AssetPipelineSystem> Pipeline = Context->SystemsRegistry->GetCoreSystem<AssetPipelineSystem>();
+        TileSheetLoader = std::make_unique<AssetLoader>(AssetRegistry, DataAssetRegistry, Pipeline);
 
-        std::vector<std::string> TileSheetPaths;
+        for (const std::string& Path : TileSheetPaths)
+        {
+            TileSheetLoader->QueueTexture(Path);
+        }
 
-        for (const auto& Entry : std::filesystem::directory_iterator(TileSheetDirectory))
+        TileSheetLoadTask.emplace(TileSheetLoader->LoadAllAsync());
+        return [this]()
         {
-            if (Entry.is_regular_file() && Entry.path().extension() == ".tilesheet")
+            return TileSheetLoadTask->await_ready();
+        };
+    }
+
+    std::vector<std::string> EngineLoader::FindTileSheetPaths() const
+    {
+        const std::string TileSheetDirectory = "Game/Assets/Tilesheets/";
+
+        std::shared_ptr<AssetRegistrySystem> AssetRegistry = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
+        if (const AssetPack* Pack = AssetRegistry->GetMountedPack())
+        {
+            std::vector<std::string> PackedPaths = Pack->GetPaths(TileSheetDirectory, ".tilesheet");
+            if (!PackedPaths.empty())
             {
-                std::string Path = Entry.path().string();
-                std::replace(Path.begin(), Path.end(), '\\', '/');
-                TileSheetPaths.push_back(Path);
-                Loader.QueueTexture(Path);
+                return PackedPaths;
             }
         }
 
-        if (TileSheetPaths.empty())
+        std::vector<std::string> TileSheetPaths;
+        if (!std::filesystem::exists(TileSheetDirectory))
         {
-            std::printf("No tilesheets found in %s\n", TileSheetDirectory.c_str());
-            return;
+            Log::Warning(ELogCategory::Engine, "TileSheet directory does not exist: %s", TileSheetDirectory.c_str());
+            return TileSheetPaths;
         }
 
-        Task<std::vector<AssetId>> LoadTask = Loader.LoadAllAsync();
-        while (!LoadTask.await_ready())
+        for (const auto& Entry : std::filesystem::directory_iterator(TileSheetDirectory))
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(3));
+            if (Entry.is_regular_file() && Entry.path().extension() == ".tilesheet")
+            {
+                std::string Path = Entry.path().string();
+                std::replace(Path.begin(), Path.end(), '\\', '/');
+                TileSheetPaths.push_back(Path);
+            }
         }
 
-        std::printf("Loaded %d tilesheet textures\n", Loader.GetCompletedCount());
-
-        CreateTileSheetObjects();
+        // Directory order is unspecified; sorting keeps tilesheet ids stable between runs and between pack and loose files
+        std::sort(TileSheetPaths.begin(), TileSheetPaths.end());
+        return TileSheetPaths;
     }
 
-    void EngineLoader::CreateTileSheetObjects()
+    void EngineLoader::CreateTileSheetObjects(const std::vector<std::string>& TileSheetPaths)
     {
-        const std::string TileSheetDirectory = "Game/Assets/Tilesheets/";
         std::shared_ptr<AssetRegistrySystem> AssetRegistry = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
 
         uint TileSheetIdCounter = 1;
 
-        for (const auto& Entry : std::filesystem::directory_iterator(TileSheetDirectory))
+        for (const std::string& Path : TileSheetPaths)
         {
-            if (Entry.is_regular_file() && Entry.path().extension() == ".tilesheet")
+            std::optional<TileSheet> MaybeTileSheet = TileSheet::Create(Path, AssetRegistry.get());
+            if (MaybeTileSheet.has_value())
             {
-                std::string Path = Entry.path().string();
-                std::replace(Path.begin(), Path.end(), '\\', '/');
-
-                std::optional<TileSheet> MaybeTileSheet = TileSheet::Create(Path, AssetRegistry.get());
-                if (MaybeTileSheet.has_value())
-                {
-                    TileSheet Sheet = std::move(MaybeTileSheet.value());
-                    Sheet.SetId(TileSheetIdCounter++);
-
-                    // Prefix with "tilesheet://" to avoid collision in PathToAssetId map (texture already uses Path)
-                    std::string TileSheetKey = "tilesheet://" + Path;
-                    AssetRegistry->Store<TileSheet>(std::make_shared<TileSheet>(Sheet), TileSheetKey);
-                    std::printf("Created TileSheet: %s (%dx%d tiles)\n",
-                        Sheet.GetName().c_str(),
-                        Sheet.GetNumColumns(),
-                        Sheet.GetNumRows());
-                }
+                TileSheet Sheet = std::move(MaybeTileSheet.value());
+                Sheet.SetId(TileSheetIdCounter++);
+
+                AssetRegistry->Store<TileSheet>(std::make_shared<TileSheet>(Sheet), TileSheet::GetRegistryKey(Path));
+                Log::Verbose(ELogCategory::Engine, "Created TileSheet: %s (%dx%d tiles)",
+                    Sheet.GetName().c_str(),
+                    Sheet.GetNumColumns(),
+                    Sheet.GetNumRows());
             }
         }
     }
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "StartupGraph.h"
+#include "../Assets/AssetId.hpp"
+#include "../Async/Task.hpp"
 
 namespace Core
 {
     struct EngineContext;
+    class AssetLoader;
 
     class EngineLoader
     {
@@ -12,12 +21,30 @@ namespace Core
         EngineLoader(std::shared_ptr<EngineContext> Context);
         ~EngineLoader();
 
-        void LoadGlobalAssets();
+        // Starts the systems and brings in everything the first frame needs: the asset pack, global assets, tilesheets,
+        // shader passes and the initial scene's assets, overlapping whatever does not depend on each other. Returns
+        // once all of it is done; the initial scene can then be pushed without reading anything.
+        void Load(const std::function<void()>& StartSystems, const std::string& InitialSceneName);
+
+        void LogTimeline() const { Graph.LogTimeline(); }
 
     private:
-        void LoadGlobalTileSheets();
-        void CreateTileSheetObjects();
+        void MountAssetPack();
+        StartupGraph::ReadyCheck LoadGlobalAssets();
+        StartupGraph::ReadyCheck LoadTileSheetTextures();
+        std::vector<std::string> FindTileSheetPaths() const;
+        void CreateTileSheetObjects(const std::vector<std::string>& TileSheetPaths);
 
         std::shared_ptr<EngineContext> Context;
+
+        std::vector<std::string> TileSheetPaths;
+
+        // Loaders must outlive their tasks
+        std::unique_ptr<AssetLoader> GlobalLoader;
+        std::optional<Task<std::vector<AssetId>>> GlobalLoadTask;
+        std::unique_ptr<AssetLoader> TileSheetLoader;
+        std::optional<Task<std::vector<AssetId>>> TileSheetLoadTask;
+
+        StartupGraph Graph;
     };
 }
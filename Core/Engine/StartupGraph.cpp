@@ -0,0 +1,239 @@
+#include "StartupGraph.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "../Log/Log.h"
+
+namespace Core
+{
+    namespace
+    {
+        constexpr std::size_t TimelineWidth = 40;
+    }
+
+    StartupGraph::StartupGraph(std::size_t WorkerCount)
+        : Workers(WorkerCount)
+    {
+    }
+
+    void StartupGraph::Add(std::string Name, const std::vector<std::string>& Dependencies, EStartupAffinity Affinity,
+                           StepFunction Work)
+    {
+        Step NewStep;
+        NewStep.Name = std::move(Name);
+        NewStep.Affinity = Affinity;
+        NewStep.Work = std::move(Work);
+
+        for (const std::string& Dependency : Dependencies)
+        {
+            auto Found = std::find_if(Steps.begin(), Steps.end(), [&Dependency](const Step& Existing)
+            {
+                return Existing.Name == Dependency;
+            });
+            if (Found == Steps.end())
+            {
+                Log::Warning(ELogCategory::Engine, "Startup step '%s' depends on unknown step '%s'", NewStep.Name.c_str(),
+                             Dependency.c_str());
+                continue;
+            }
+            NewStep.Dependencies.push_back(static_cast<std::size_t>(Found - Steps.begin()));
+        }
+
+        Steps.push_back(std::move(NewStep));
+    }
+
+    void StartupGraph::Run(const std::function<std::size_t()>& PumpMainThread)
+    {
+        RunStart = Clock::now();
+        RemainingCount = Steps.size();
+
+        std::vector<std::size_t> MainThreadSteps;
+        while (true)
+        {
+            bool bChanged = false;
+            {
+                std::lock_guard Lock(Mutex);
+                bChanged = UpdateLocked();
+                if (RemainingCount == 0)
+                {
+                    break;
+                }
+                MainThreadSteps.swap(MainThreadQueue);
+            }
+
+            for (const std::size_t Index : MainThreadSteps)
+            {
+                RunStep(Index);
+            }
+            MainThreadSteps.clear();
+
+            // Steps waiting on loads need their uploads to run here
+            if (PumpMainThread() == 0 && !bChanged)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        RunEnd = Clock::now();
+    }
+
+    bool StartupGraph::UpdateLocked()
+    {
+        bool bChanged = false;
+
+        for (Step& Entry : Steps)
+        {
+            if (Entry.State != EStepState::Running || !Entry.bStarted)
+            {
+                continue;
+            }
+            if (Entry.IsReady && !Entry.IsReady())
+            {
+                continue;
+            }
+
+            // Steps that finished synchronously already have their end time
+            if (Entry.IsReady)
+            {
+                Entry.End = Clock::now();
+            }
+            Entry.State = EStepState::Done;
+            --RemainingCount;
+            bChanged = true;
+        }
+
+        for (std::size_t Index = 0; Index < Steps.size(); ++Index)
+        {
+            Step& Entry = Steps[Index];
+            if (Entry.State != EStepState::Waiting)
+            {
+                continue;
+            }
+
+            const bool bDependenciesDone = std::all_of(Entry.Dependencies.begin(), Entry.Dependencies.end(),
+                                                       [this](std::size_t Dependency)
+                                                       {
+                                                           return Steps[Dependency].State == EStepState::Done;
+                                                       });
+            if (!bDependenciesDone)
+            {
+                continue;
+            }
+
+            Entry.State = EStepState::Running;
+            bChanged = true;
+
+            if (Entry.Affinity == EStartupAffinity::MainThread)
+            {
+                MainThreadQueue.push_back(Index);
+            }
+            else
+            {
+                Workers.Enqueue([this, Index]()
+                {
+                    RunStep(Index);
+                });
+            }
+        }
+
+        return bChanged;
+    }
+
+    void StartupGraph::RunStep(std::size_t Index)
+    {
+        Step& Entry = Steps[Index];
+
+        const Clock::time_point Start = Clock::now();
+        ReadyCheck IsReady = Entry.Work ? Entry.Work() : nullptr;
+        const Clock::time_point End = Clock::now();
+
+        std::lock_guard Lock(Mutex);
+        Entry.Start = Start;
+        Entry.End = End;
+        Entry.IsReady = std::move(IsReady);
+        Entry.bStarted = true;
+
+        // Hand dependents straight on rather than wait for the main thread to notice
+        UpdateLocked();
+    }
+
+    double StartupGraph::GetOffsetMs(Clock::time_point Time) const
+    {
+        return std::chrono::duration<double, std::milli>(Time - RunStart).count();
+    }
+
+    void StartupGraph::LogTimeline() const
+    {
+        std::lock_guard Lock(Mutex);
+
+        const double TotalMs = GetOffsetMs(RunEnd);
+        double StepMs = 0.0;
+        for (const Step& Entry : Steps)
+        {
+            StepMs += GetOffsetMs(Entry.End) - GetOffsetMs(Entry.Start);
+        }
+
+        Log::Info(ELogCategory::Engine, "Startup timeline: %.1f ms total, %.1f ms of steps (%.1fx overlap)", TotalMs, StepMs,
+                  TotalMs > 0.0 ? StepMs / TotalMs : 1.0);
+
+        for (const Step& Entry : Steps)
+        {
+            const double StartMs = GetOffsetMs(Entry.Start);
+            const double EndMs = GetOffsetMs(Entry.End);
+
+            std::string Bar(TimelineWidth, ' ');
+            if (TotalMs > 0.0)
+            {
+                const auto First = static_cast<std::size_t>(StartMs / TotalMs * TimelineWidth);
+                const auto Last = static_cast<std::size_t>(EndMs / TotalMs * TimelineWidth);
+                for (std::size_t Column = std::min(First, TimelineWidth - 1); Column <= std::min(Last, TimelineWidth - 1); ++Column)
+                {
+                    Bar[Column] = '#';
+                }
+            }
+
+            Log::Info(ELogCategory::Engine, "  %-20s %-6s %8.1f %8.1f %8.1f ms |%s|", Entry.Name.c_str(),
+                      Entry.Affinity == EStartupAffinity::MainThread ? "main" : "worker",
+                      StartMs, EndMs, EndMs - StartMs, Bar.c_str());
+        }
+
+        if (Steps.empty())
+        {
+            return;
+        }
+
+        // Walk back from the last step to finish through whichever dependency held it up longest
+        auto LatestEnd = [this](const std::vector<std::size_t>& Indices) -> const Step*
+        {
+            const Step* Latest = nullptr;
+            for (const std::size_t Index : Indices)
+            {
+                if (!Latest || Steps[Index].End > Latest->End)
+                {
+                    Latest = &Steps[Index];
+                }
+            }
+            return Latest;
+        };
+
+        std::vector<std::size_t> AllSteps(Steps.size());
+        for (std::size_t Index = 0; Index < AllSteps.size(); ++Index)
+        {
+            AllSteps[Index] = Index;
+        }
+
+        std::vector<const Step*> CriticalPath;
+        for (const Step* Current = LatestEnd(AllSteps); Current; Current = LatestEnd(Current->Dependencies))
+        {
+            CriticalPath.push_back(Current);
+        }
+
+        std::string PathText;
+        for (auto PathIt = CriticalPath.rbegin(); PathIt != CriticalPath.rend(); ++PathIt)
+        {
+            PathText += PathText.empty() ? (*PathIt)->Name : " -> " + (*PathIt)->Name;
+        }
+        Log::Info(ELogCategory::Engine, "  Critical path: %s", PathText.c_str());
+    }
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../Async/ThreadPool.h"
+
+namespace Core
+{
+    enum class EStartupAffinity
+    {
+        Worker,
+        MainThread
+    };
+
+    // Startup steps and their dependencies. Each step starts as soon as everything it depends on is done, on a worker
+    // or on the main thread, so independent steps overlap. Records when every step ran for a timeline report.
+    class StartupGraph
+    {
+    public:
+        // Polled under the graph's lock, from the main thread or a worker; a step is done once this returns true
+        using ReadyCheck = std::function<bool()>;
+
+        // Steps that kick off asynchronous work return a ReadyCheck rather than blocking their thread; steps that
+        // finish inside the call return nullptr
+        using StepFunction = std::function<ReadyCheck()>;
+
+        explicit StartupGraph(std::size_t WorkerCount);
+
+        // Dependencies are step names added earlier
+        void Add(std::string Name, const std::vector<std::string>& Dependencies, EStartupAffinity Affinity,
+                 StepFunction Work);
+
+        // Returns once every step is done. In between main-thread steps, PumpMainThread runs and reports how much it
+        // did; the main thread sleeps briefly when it did nothing.
+        void Run(const std::function<std::size_t()>& PumpMainThread);
+
+        // Per-step start, end and duration relative to Run, plus the chain of steps that decided the total
+        void LogTimeline() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        enum class EStepState
+        {
+            Waiting,
+            Running,
+            Done
+        };
+
+        struct Step
+        {
+            std::string Name;
+            std::vector<std::size_t> Dependencies;
+            EStartupAffinity Affinity = EStartupAffinity::Worker;
+            StepFunction Work;
+
+            EStepState State = EStepState::Waiting;
+            bool bStarted = false;
+            ReadyCheck IsReady;
+            Clock::time_point Start;
+            Clock::time_point End;
+        };
+
+        void RunStep(std::size_t Index);
+
+        // Finishes steps whose work is done and starts the ones that became ready. Caller holds Mutex.
+        // Returns whether any step changed state.
+        bool UpdateLocked();
+
+        double GetOffsetMs(Clock::time_point Time) const;
+
+        std::vector<Step> Steps;
+        std::size_t RemainingCount = 0;
+
+        // Ready main-thread steps; workers finishing a step can make them ready too
+        std::vector<std::size_t> MainThreadQueue;
+
+        Clock::time_point RunStart;
+        Clock::time_point RunEnd;
+
+        mutable std::mutex Mutex;
+
+        // Declared last so workers are joined before the steps they write to go away
+        ThreadPool Workers;
+    };
+}
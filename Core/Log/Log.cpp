@@ -0,0 +1,342 @@
+#include "Log.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Core::Log
+{
+    namespace
+    {
+        // 256-byte slots, 1 MiB in total
+        constexpr std::size_t RingCapacity = 4096;
+        static_assert((RingCapacity & (RingCapacity - 1)) == 0, "RingCapacity must be a power of two");
+
+        constexpr std::chrono::milliseconds BatchInterval{1};
+
+        constexpr const char* LevelNames[] = {"Verbose", "Info", "Warning", "Error"};
+        constexpr const char* CategoryNames[] = {"Engine", "Assets", "Scene", "Render", "Components", "Editor", "Game"};
+        static_assert(std::size(CategoryNames) == static_cast<std::size_t>(ELogCategory::Count));
+
+        // Bounded MPSC ring: producers claim a position with a CAS on Head and publish through the slot's sequence,
+        // the writer thread is the only consumer. Sequence == Position: free for that position; Position + 1: filled.
+        class LogWriter
+        {
+        public:
+            LogWriter()
+                : StartTime(std::chrono::steady_clock::now())
+            {
+                for (std::size_t Index = 0; Index < RingCapacity; ++Index)
+                {
+                    Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+                }
+                for (std::atomic<ELogLevel>& Level : Levels)
+                {
+                    Level.store(ELogLevel::Info, std::memory_order_relaxed);
+                }
+
+                Thread = std::thread(&LogWriter::Run, this);
+            }
+
+            ~LogWriter()
+            {
+                bStopping.store(true, std::memory_order_release);
+                Wake();
+                Thread.join();
+
+                if (File)
+                {
+                    std::fclose(File);
+                }
+            }
+
+            Record* Claim(std::size_t& OutPosition)
+            {
+                std::size_t Position = Head.load(std::memory_order_relaxed);
+                while (true)
+                {
+                    Slot& Target = Slots[Position & (RingCapacity - 1)];
+                    const std::size_t Sequence = Target.Sequence.load(std::memory_order_acquire);
+                    const auto Difference = static_cast<std::ptrdiff_t>(Sequence - Position);
+                    if (Difference == 0)
+                    {
+                        if (Head.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+                        {
+                            OutPosition = Position;
+                            return &Target.Message;
+                        }
+                    }
+                    else if (Difference < 0)
+                    {
+                        // The writer has not caught up with the previous lap
+                        Dropped.fetch_add(1, std::memory_order_relaxed);
+                        return nullptr;
+                    }
+                    else
+                    {
+                        Position = Head.load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            void Publish(std::size_t Position)
+            {
+                Slots[Position & (RingCapacity - 1)].Sequence.store(Position + 1, std::memory_order_release);
+                Wake();
+            }
+
+            std::uint64_t GetTimeNs() const
+            {
+                return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - StartTime).count());
+            }
+
+            void SetLevel(ELogCategory Category, ELogLevel Level)
+            {
+                Levels[static_cast<std::size_t>(Category)].store(Level, std::memory_order_relaxed);
+            }
+
+            bool IsEnabled(ELogCategory Category, ELogLevel Level) const
+            {
+                return Level >= Levels[static_cast<std::size_t>(Category)].load(std::memory_order_relaxed);
+            }
+
+            bool OpenFile(const std::string& Path)
+            {
+                std::error_code Error;
+                std::filesystem::create_directories(std::filesystem::path(Path).parent_path(), Error);
+
+                std::FILE* NewFile = std::fopen(Path.c_str(), "w");
+                if (!NewFile)
+                {
+                    return false;
+                }
+
+                std::lock_guard Lock(FileMutex);
+                if (File)
+                {
+                    std::fclose(File);
+                }
+                File = NewFile;
+                return true;
+            }
+
+            void Flush()
+            {
+                // Bounded, in case a producer was suspended between claiming its slot and publishing it
+                const std::size_t Target = Head.load(std::memory_order_acquire);
+                const auto Deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                while (Written.load(std::memory_order_acquire) < Target && std::chrono::steady_clock::now() < Deadline)
+                {
+                    Wake();
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                }
+            }
+
+            std::uint64_t GetDroppedCount() const
+            {
+                return Dropped.load(std::memory_order_relaxed);
+            }
+
+        private:
+            struct Slot
+            {
+                std::atomic<std::size_t> Sequence;
+                Record Message;
+            };
+
+            void Wake()
+            {
+                WakeCounter.fetch_add(1, std::memory_order_release);
+                WakeCounter.notify_one();
+            }
+
+            void Run()
+            {
+                std::string Batch;
+                std::string Line;
+                std::uint64_t ReportedDropped = 0;
+
+                while (true)
+                {
+                    const std::uint32_t Observed = WakeCounter.load(std::memory_order_acquire);
+                    const bool bStop = bStopping.load(std::memory_order_acquire);
+
+                    std::size_t Drained = 0;
+                    while (true)
+                    {
+                        Slot& Next = Slots[Tail & (RingCapacity - 1)];
+                        if (Next.Sequence.load(std::memory_order_acquire) != Tail + 1)
+                        {
+                            break;
+                        }
+
+                        AppendLine(Next.Message, Line, Batch);
+                        Next.Sequence.store(Tail + RingCapacity, std::memory_order_release);
+                        ++Tail;
+                        ++Drained;
+                    }
+
+                    const std::uint64_t DroppedNow = Dropped.load(std::memory_order_relaxed);
+                    if (DroppedNow != ReportedDropped)
+                    {
+                        char Notice[96];
+                        std::snprintf(Notice, sizeof(Notice), "[log] dropped %llu messages, ring full\n",
+                                      static_cast<unsigned long long>(DroppedNow - ReportedDropped));
+                        Batch += Notice;
+                        ReportedDropped = DroppedNow;
+                    }
+
+                    if (!Batch.empty())
+                    {
+                        WriteBatch(Batch);
+                        Batch.clear();
+                    }
+                    Written.store(Tail, std::memory_order_release);
+
+                    if (Drained > 0)
+                    {
+                        continue;
+                    }
+                    if (bStop)
+                    {
+                        return;
+                    }
+
+                    WakeCounter.wait(Observed, std::memory_order_acquire);
+
+                    // Let the rest of a burst land so it goes out in one write; producers logging meanwhile find
+                    // nobody waiting and skip the wake-up
+                    if (!bStopping.load(std::memory_order_acquire))
+                    {
+                        std::this_thread::sleep_for(BatchInterval);
+                    }
+                }
+            }
+
+            void AppendLine(const Record& Message, std::string& Line, std::string& Batch) const
+            {
+                char Prefix[64];
+                const int PrefixLength = std::snprintf(Prefix, sizeof(Prefix), "[%10.3f] %-7s %-10s ",
+                                                       static_cast<double>(Message.TimeNs) / 1e9,
+                                                       LevelNames[static_cast<std::size_t>(Message.Level)],
+                                                       CategoryNames[static_cast<std::size_t>(Message.Category)]);
+                Batch.append(Prefix, PrefixLength > 0 ? static_cast<std::size_t>(PrefixLength) : 0);
+
+                Line.clear();
+                Message.Formatter(Message, Line);
+                while (!Line.empty() && Line.back() == '\n')
+                {
+                    Line.pop_back();
+                }
+                Batch += Line;
+                Batch += '\n';
+            }
+
+            void WriteBatch(const std::string& Batch)
+            {
+                std::fwrite(Batch.data(), 1, Batch.size(), stdout);
+                std::fflush(stdout);
+
+                std::lock_guard Lock(FileMutex);
+                if (File)
+                {
+                    std::fwrite(Batch.data(), 1, Batch.size(), File);
+                    std::fflush(File);
+                }
+            }
+
+            const std::chrono::steady_clock::time_point StartTime;
+
+            std::array<Slot, RingCapacity> Slots;
+            alignas(64) std::atomic<std::size_t> Head{0};
+            alignas(64) std::size_t Tail = 0;
+            std::atomic<std::size_t> Written{0};
+            std::atomic<std::uint64_t> Dropped{0};
+            std::atomic<std::uint32_t> WakeCounter{0};
+            std::atomic<bool> bStopping{false};
+
+            std::array<std::atomic<ELogLevel>, static_cast<std::size_t>(ELogCategory::Count)> Levels;
+
+            std::mutex FileMutex;
+            std::FILE* File = nullptr;
+
+            std::thread Thread;
+        };
+
+        LogWriter& GetWriter()
+        {
+            // Heap allocated so the 1 MiB ring stays off the static segment; joined and flushed at exit
+            static const std::unique_ptr<LogWriter> Writer = std::make_unique<LogWriter>();
+            return *Writer;
+        }
+    }
+
+    void SetLevel(ELogCategory Category, ELogLevel Level)
+    {
+        GetWriter().SetLevel(Category, Level);
+    }
+
+    bool IsEnabled(ELogCategory Category, ELogLevel Level)
+    {
+        return GetWriter().IsEnabled(Category, Level);
+    }
+
+    bool OpenFile(const std::string& Path)
+    {
+        return GetWriter().OpenFile(Path);
+    }
+
+    void Flush()
+    {
+        GetWriter().Flush();
+    }
+
+    std::uint64_t GetDroppedCount()
+    {
+        return GetWriter().GetDroppedCount();
+    }
+
+    namespace Detail
+    {
+        Record* Claim(std::size_t& OutPosition)
+        {
+            return GetWriter().Claim(OutPosition);
+        }
+
+        void Publish(std::size_t Position)
+        {
+            GetWriter().Publish(Position);
+        }
+
+        std::uint64_t GetTimeNs()
+        {
+            return GetWriter().GetTimeNs();
+        }
+
+        void AppendFormatted(std::string& Out, const char* Format, ...)
+        {
+            va_list Arguments;
+            va_start(Arguments, Format);
+            va_list Measure;
+            va_copy(Measure, Arguments);
+            const int Length = std::vsnprintf(nullptr, 0, Format, Measure);
+            va_end(Measure);
+
+            if (Length > 0)
+            {
+                const std::size_t Offset = Out.size();
+                Out.resize(Offset + static_cast<std::size_t>(Length) + 1);
+                std::vsnprintf(Out.data() + Offset, static_cast<std::size_t>(Length) + 1, Format, Arguments);
+                Out.resize(Offset + static_cast<std::size_t>(Length));
+            }
+            va_end(Arguments);
+        }
+    }
+}
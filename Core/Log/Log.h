@@ -0,0 +1,270 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// Messages below this level are compiled out entirely: 0 Verbose, 1 Info, 2 Warning, 3 Error
+#ifndef MIST_LOG_MIN_LEVEL
+#ifdef NDEBUG
+#define MIST_LOG_MIN_LEVEL 1
+#else
+#define MIST_LOG_MIN_LEVEL 0
+#endif
+#endif
+
+namespace Core
+{
+    enum class ELogLevel : std::uint8_t
+    {
+        Verbose,
+        Info,
+        Warning,
+        Error
+    };
+
+    enum class ELogCategory : std::uint8_t
+    {
+        Engine,
+        Assets,
+        Scene,
+        Render,
+        Components,
+        Editor,
+        Game,
+        Count
+    };
+
+    // Asynchronous logging. Callers copy the format string pointer and their arguments into a lock-free ring and
+    // return; a background thread formats them printf-style and writes them out in batches, to stdout and to the
+    // file given to OpenFile. A full ring drops messages rather than block, so logging never stalls the frame.
+    // Formats must be string literals. Arguments may be arithmetic values or strings (copied, so temporaries are
+    // fine); a message's strings are truncated to share PayloadCapacity bytes.
+    namespace Log
+    {
+        constexpr ELogLevel CompiledMinLevel = static_cast<ELogLevel>(MIST_LOG_MIN_LEVEL);
+
+        constexpr std::size_t PayloadCapacity = 224;
+
+        struct Record;
+        using FormatFunction = void (*)(const Record& Message, std::string& Out);
+
+        struct Record
+        {
+            std::uint64_t TimeNs = 0;
+            const char* Format = nullptr;
+            FormatFunction Formatter = nullptr;
+            ELogLevel Level = ELogLevel::Info;
+            ELogCategory Category = ELogCategory::Engine;
+            std::byte Payload[PayloadCapacity];
+        };
+
+        // Runtime filter on top of CompiledMinLevel; Info for every category by default
+        void SetLevel(ELogCategory Category, ELogLevel Level);
+        bool IsEnabled(ELogCategory Category, ELogLevel Level);
+
+        // Also writes every message to Path, replacing what was there. Returns false if it cannot be opened.
+        bool OpenFile(const std::string& Path);
+
+        // Blocks until everything logged before the call has been written
+        void Flush();
+
+        // Messages lost to a full ring since startup
+        std::uint64_t GetDroppedCount();
+
+        namespace Detail
+        {
+            // Returns null when the ring is full. Publish must follow once the record is filled in.
+            Record* Claim(std::size_t& OutPosition);
+            void Publish(std::size_t Position);
+
+            std::uint64_t GetTimeNs();
+
+            template <typename T>
+            constexpr bool IsString = std::is_same_v<T, const char*> || std::is_same_v<T, std::string>
+                || std::is_same_v<T, std::string_view>;
+
+            // String literals and char buffers are all stored as C strings
+            template <typename T>
+            using StoredType = std::conditional_t<std::is_same_v<std::decay_t<T>, char*>, const char*, std::decay_t<T>>;
+
+            template <typename T>
+            constexpr std::size_t ScalarSize = IsString<T> ? 0 : sizeof(T);
+
+            template <typename T>
+            std::string_view ToView(const T& Value)
+            {
+                if constexpr (std::is_pointer_v<T>)
+                {
+                    return Value ? std::string_view(Value) : std::string_view("(null)");
+                }
+                else
+                {
+                    return std::string_view(Value);
+                }
+            }
+
+            template <typename T>
+            std::size_t StringLength(const T& Value)
+            {
+                if constexpr (IsString<T>)
+                {
+                    return ToView(Value).size();
+                }
+                else
+                {
+                    return 0;
+                }
+            }
+
+            // Scalars are packed at the front at fixed offsets; strings follow, null terminated, sharing what is left.
+            // When they don't all fit, a string keeps at least an even share so one long path can't starve the rest.
+            struct Encoder
+            {
+                std::byte* Scalars;
+                std::byte* Strings;
+                const std::byte* End;
+                std::size_t StringsLeft;
+                std::size_t LaterStringBytes;
+
+                template <typename T>
+                void Add(const T& Value)
+                {
+                    if constexpr (IsString<T>)
+                    {
+                        const std::string_view Text = ToView(Value);
+                        --StringsLeft;
+                        LaterStringBytes -= Text.size();
+
+                        // Room excludes the terminators still to come
+                        const std::size_t Room = static_cast<std::size_t>(End - Strings) - StringsLeft - 1;
+                        const std::size_t EvenShare = Room / (StringsLeft + 1);
+                        const std::size_t Budget = Room > LaterStringBytes && Room - LaterStringBytes > EvenShare
+                            ? Room - LaterStringBytes
+                            : EvenShare;
+                        const std::size_t Length = Text.size() < Budget ? Text.size() : Budget;
+                        std::memcpy(Strings, Text.data(), Length);
+                        Strings[Length] = std::byte{0};
+                        Strings += Length + 1;
+                    }
+                    else
+                    {
+                        std::memcpy(Scalars, &Value, sizeof(T));
+                        Scalars += sizeof(T);
+                    }
+                }
+            };
+
+            struct Decoder
+            {
+                const std::byte* Scalars;
+                const std::byte* Strings;
+
+                template <typename T>
+                auto Get()
+                {
+                    if constexpr (IsString<T>)
+                    {
+                        const char* Text = reinterpret_cast<const char*>(Strings);
+                        Strings += std::strlen(Text) + 1;
+                        return Text;
+                    }
+                    else
+                    {
+                        T Value;
+                        std::memcpy(&Value, Scalars, sizeof(T));
+                        Scalars += sizeof(T);
+                        return Value;
+                    }
+                }
+            };
+
+            void AppendFormatted(std::string& Out, const char* Format, ...);
+
+            template <typename... Args>
+            void FormatRecord(const Record& Message, std::string& Out)
+            {
+                constexpr std::size_t ScalarBytes = (ScalarSize<Args> + ... + 0);
+                Decoder Reader{Message.Payload, Message.Payload + ScalarBytes};
+
+                // Braced initialization decodes in argument order
+                const std::tuple<decltype(Reader.Get<Args>())...> Values{Reader.Get<Args>()...};
+                std::apply([&Out, &Message](const auto&... Value)
+                {
+                    AppendFormatted(Out, Message.Format, Value...);
+                }, Values);
+            }
+
+            template <typename... Args>
+            void Enqueue(ELogLevel Level, ELogCategory Category, const char* Format, const Args&... Arguments)
+            {
+                static_assert(((std::is_arithmetic_v<Args> || IsString<Args>) && ...),
+                              "Log arguments must be arithmetic values or strings");
+
+                constexpr std::size_t ScalarBytes = (ScalarSize<Args> + ... + 0);
+                constexpr std::size_t StringCount = (static_cast<std::size_t>(IsString<Args>) + ... + 0);
+                static_assert(ScalarBytes + StringCount <= PayloadCapacity, "Too many log arguments");
+
+                std::size_t Position = 0;
+                Record* Message = Claim(Position);
+                if (!Message)
+                {
+                    return;
+                }
+
+                Message->TimeNs = GetTimeNs();
+                Message->Format = Format;
+                Message->Formatter = &FormatRecord<Args...>;
+                Message->Level = Level;
+                Message->Category = Category;
+
+                [[maybe_unused]] Encoder Writer{Message->Payload, Message->Payload + ScalarBytes,
+                                                Message->Payload + PayloadCapacity, StringCount,
+                                                (StringLength<Args>(Arguments) + ... + 0)};
+                (Writer.Add<Args>(Arguments), ...);
+
+                Publish(Position);
+            }
+        }
+
+        template <ELogLevel Level, typename... Args>
+        void Write(ELogCategory Category, const char* Format, const Args&... Arguments)
+        {
+            if constexpr (Level >= CompiledMinLevel)
+            {
+                if (IsEnabled(Category, Level))
+                {
+                    Detail::Enqueue<Detail::StoredType<Args>...>(Level, Category, Format, Arguments...);
+                }
+            }
+        }
+
+        template <typename... Args>
+        void Verbose(ELogCategory Category, const char* Format, const Args&... Arguments)
+        {
+            Write<ELogLevel::Verbose>(Category, Format, Arguments...);
+        }
+
+        template <typename... Args>
+        void Info(ELogCategory Category, const char* Format, const Args&... Arguments)
+        {
+            Write<ELogLevel::Info>(Category, Format, Arguments...);
+        }
+
+        template <typename... Args>
+        void Warning(ELogCategory Category, const char* Format, const Args&... Arguments)
+        {
+            Write<ELogLevel::Warning>(Category, Format, Arguments...);
+        }
+
+        template <typename... Args>
+        void Error(ELogCategory Category, const char* Format, const Args&... Arguments)
+        {
+            Write<ELogLevel::Error>(Category, Format, Arguments...);
+        }
+    }
+}
@@ -0,0 +1,279 @@
+#include "FlowField.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "../TileMap/TileMap.h"
+
+namespace Core
+{
+    namespace
+    {
+        // Offsets are laid out so that a direction and its reverse add up to 7
+        int Reverse(int Direction)
+        {
+            return 7 - Direction;
+        }
+
+        std::uint32_t GetMoveCost(int Direction)
+        {
+            return Direction == 0 || Direction == 2 || Direction == 5 || Direction == 7 ? FlowField::DiagonalCost
+                                                                                       : FlowField::StraightCost;
+        }
+
+        std::uint64_t MakeOpenEntry(std::uint32_t Cost, std::size_t Index)
+        {
+            return static_cast<std::uint64_t>(Cost) << 32 | static_cast<std::uint32_t>(Index);
+        }
+
+        void PushOpen(std::vector<std::uint64_t>& Open, std::uint32_t Cost, std::size_t Index)
+        {
+            Open.push_back(MakeOpenEntry(Cost, Index));
+            std::push_heap(Open.begin(), Open.end(), std::greater<>());
+        }
+    }
+
+    FlowField::FlowField(const TileCollisionGrid& InGrid, TilePoint InGoal)
+        : Grid(InGrid)
+          , Goal(InGoal)
+    {
+        Flood();
+    }
+
+    FlowField::FlowField(const FlowField& Previous, const TileCollisionGrid& InGrid)
+        : Grid(InGrid)
+          , Goal(Previous.Goal)
+    {
+        if (Grid.GetWidth() != Previous.Grid.GetWidth() || Grid.GetHeight() != Previous.Grid.GetHeight())
+        {
+            Flood();
+            return;
+        }
+
+        Costs = Previous.Costs;
+        Directions = Previous.Directions;
+        Update(Previous.Grid);
+    }
+
+    bool FlowField::CanMove(int X, int Y, int Direction) const
+    {
+        const TilePoint Offset = Offsets[Direction];
+        if (!IsInside(X + Offset.X, Y + Offset.Y) || Grid.IsSolid(X + Offset.X, Y + Offset.Y))
+        {
+            return false;
+        }
+        return Offset.X == 0 || Offset.Y == 0 || (!Grid.IsSolid(X + Offset.X, Y) && !Grid.IsSolid(X, Y + Offset.Y));
+    }
+
+    void FlowField::Flood()
+    {
+        const std::size_t TileCount = static_cast<std::size_t>(Grid.GetWidth()) * Grid.GetHeight();
+        Costs.assign(TileCount, Unreachable);
+        Directions.assign(TileCount, NoDirection);
+
+        if (!IsInside(Goal.X, Goal.Y) || Grid.IsSolid(Goal.X, Goal.Y))
+        {
+            return;
+        }
+
+        std::vector<std::uint64_t> Open;
+        Costs[GetIndex(Goal.X, Goal.Y)] = 0;
+        PushOpen(Open, 0, GetIndex(Goal.X, Goal.Y));
+        Propagate(Open);
+    }
+
+    void FlowField::Update(const TileCollisionGrid& PreviousGrid)
+    {
+        const int Width = static_cast<int>(Grid.GetWidth());
+        const int Height = static_cast<int>(Grid.GetHeight());
+
+        // Tiles that turned solid or open, looked for only in chunks whose version moved
+        std::vector<std::size_t> Changed;
+        for (uint ChunkY = 0; ChunkY < Grid.GetChunkRows(); ++ChunkY)
+        {
+            for (uint ChunkX = 0; ChunkX < Grid.GetChunkColumns(); ++ChunkX)
+            {
+                if (Grid.GetChunkVersion(ChunkX, ChunkY) == PreviousGrid.GetChunkVersion(ChunkX, ChunkY))
+                {
+                    continue;
+                }
+
+                const int FirstX = static_cast<int>(ChunkX * TileMap::ChunkSize);
+                const int FirstY = static_cast<int>(ChunkY * TileMap::ChunkSize);
+                for (int Y = FirstY; Y < std::min(FirstY + static_cast<int>(TileMap::ChunkSize), Height); ++Y)
+                {
+                    for (int X = FirstX; X < std::min(FirstX + static_cast<int>(TileMap::ChunkSize), Width); ++X)
+                    {
+                        if (Grid.IsSolid(X, Y) != PreviousGrid.IsSolid(X, Y))
+                        {
+                            Changed.push_back(GetIndex(X, Y));
+                        }
+                    }
+                }
+            }
+        }
+
+        if (Changed.empty())
+        {
+            return;
+        }
+
+        std::vector<bool> Invalid(Costs.size(), false);
+        std::vector<std::size_t> Invalidated;
+        auto Invalidate = [&](std::size_t Index)
+        {
+            Invalid[Index] = true;
+            Invalidated.push_back(Index);
+        };
+
+        // A changed tile loses its cost, and so does any tile next to one whose last move is no longer allowed
+        for (const std::size_t Index : Changed)
+        {
+            Invalidate(Index);
+        }
+        for (const std::size_t Index : Changed)
+        {
+            const int ChangedX = static_cast<int>(Index % Width);
+            const int ChangedY = static_cast<int>(Index / Width);
+            for (int Y = ChangedY - 1; Y <= ChangedY + 1; ++Y)
+            {
+                for (int X = ChangedX - 1; X <= ChangedX + 1; ++X)
+                {
+                    if (!IsInside(X, Y) || Invalid[GetIndex(X, Y)])
+                    {
+                        continue;
+                    }
+
+                    const std::size_t Neighbour = GetIndex(X, Y);
+                    if (Directions[Neighbour] != NoDirection && !CanMove(X, Y, Directions[Neighbour]))
+                    {
+                        Invalidate(Neighbour);
+                    }
+                }
+            }
+        }
+
+        // Then every tile whose way to the goal ran through one that lost its cost
+        for (std::size_t Next = 0; Next < Invalidated.size(); ++Next)
+        {
+            const int X = static_cast<int>(Invalidated[Next] % Width);
+            const int Y = static_cast<int>(Invalidated[Next] / Width);
+            for (int Direction = 0; Direction < 8; ++Direction)
+            {
+                const int NeighbourX = X + Offsets[Direction].X;
+                const int NeighbourY = Y + Offsets[Direction].Y;
+                if (IsInside(NeighbourX, NeighbourY))
+                {
+                    const std::size_t Neighbour = GetIndex(NeighbourX, NeighbourY);
+                    if (!Invalid[Neighbour] && Directions[Neighbour] == Reverse(Direction))
+                    {
+                        Invalidate(Neighbour);
+                    }
+                }
+            }
+        }
+
+        for (const std::size_t Index : Invalidated)
+        {
+            Costs[Index] = Unreachable;
+            Directions[Index] = NoDirection;
+        }
+
+        // Tiles that lost their cost take the cheapest their neighbours offer, and the tiles around each change
+        // spread again, since a tile that opened may give them a shorter way
+        std::vector<std::uint64_t> Open;
+        for (const std::size_t Index : Invalidated)
+        {
+            const int X = static_cast<int>(Index % Width);
+            const int Y = static_cast<int>(Index / Width);
+            if (Grid.IsSolid(X, Y))
+            {
+                continue;
+            }
+
+            if (TilePoint{X, Y} == Goal)
+            {
+                Costs[Index] = 0;
+                PushOpen(Open, 0, Index);
+                continue;
+            }
+
+            for (int Direction = 0; Direction < 8; ++Direction)
+            {
+                if (!CanMove(X, Y, Direction))
+                {
+                    continue;
+                }
+
+                const std::uint32_t NeighbourCost = Costs[GetIndex(X + Offsets[Direction].X, Y + Offsets[Direction].Y)];
+                if (NeighbourCost != Unreachable && NeighbourCost + GetMoveCost(Direction) < Costs[Index])
+                {
+                    Costs[Index] = NeighbourCost + GetMoveCost(Direction);
+                    Directions[Index] = static_cast<std::uint8_t>(Direction);
+                }
+            }
+            if (Costs[Index] != Unreachable)
+            {
+                PushOpen(Open, Costs[Index], Index);
+            }
+        }
+
+        for (const std::size_t Index : Changed)
+        {
+            const int ChangedX = static_cast<int>(Index % Width);
+            const int ChangedY = static_cast<int>(Index / Width);
+            for (int Y = ChangedY - 1; Y <= ChangedY + 1; ++Y)
+            {
+                for (int X = ChangedX - 1; X <= ChangedX + 1; ++X)
+                {
+                    if (IsInside(X, Y) && !Invalid[GetIndex(X, Y)] && Costs[GetIndex(X, Y)] != Unreachable)
+                    {
+                        // Marked so tiles around several changes are only queued once
+                        Invalid[GetIndex(X, Y)] = true;
+                        PushOpen(Open, Costs[GetIndex(X, Y)], GetIndex(X, Y));
+                    }
+                }
+            }
+        }
+
+        Propagate(Open);
+    }
+
+    void FlowField::Propagate(std::vector<std::uint64_t>& Open)
+    {
+        const int Width = static_cast<int>(Grid.GetWidth());
+        while (!Open.empty())
+        {
+            std::pop_heap(Open.begin(), Open.end(), std::greater<>());
+            const std::uint32_t Cost = static_cast<std::uint32_t>(Open.back() >> 32);
+            const std::size_t Index = static_cast<std::uint32_t>(Open.back());
+            Open.pop_back();
+
+            // Tiles queued again at a lower cost leave their older entries behind
+            if (Cost != Costs[Index])
+            {
+                continue;
+            }
+            ++CostedCount;
+
+            const int X = static_cast<int>(Index % Width);
+            const int Y = static_cast<int>(Index / Width);
+            for (int Direction = 0; Direction < 8; ++Direction)
+            {
+                if (!CanMove(X, Y, Direction))
+                {
+                    continue;
+                }
+
+                const std::size_t Neighbour = GetIndex(X + Offsets[Direction].X, Y + Offsets[Direction].Y);
+                const std::uint32_t NeighbourCost = Cost + GetMoveCost(Direction);
+                if (NeighbourCost < Costs[Neighbour])
+                {
+                    Costs[Neighbour] = NeighbourCost;
+                    Directions[Neighbour] = static_cast<std::uint8_t>(Reverse(Direction));
+                    PushOpen(Open, NeighbourCost, Neighbour);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "GridPathfinder.h"
+#include "../TileMap/TileCollisionGrid.h"
+
+namespace Core
+{
+    // The cheapest way to one goal from every tile of a TileCollisionGrid, for crowds heading to the same place. The
+    // integration field holds each tile's cost to the goal, found by a Dijkstra wavefront from it with the moves
+    // GridPathfinder allows. The direction field holds, per tile, the neighbour to step to next. Either is read in
+    // constant time, so any number of agents can follow one field. Fields are immutable once built.
+    class FlowField
+    {
+    public:
+        // Integer move costs, so the wavefront orders tiles exactly and an updated field's costs equal a rebuilt one's
+        static constexpr std::uint32_t StraightCost = 10;
+        static constexpr std::uint32_t DiagonalCost = 14;
+        static constexpr std::uint32_t Unreachable = std::numeric_limits<std::uint32_t>::max();
+
+        // Floods the whole grid from Goal
+        FlowField(const TileCollisionGrid& InGrid, TilePoint InGoal);
+
+        // Previous brought up to date with InGrid, which has to come from the same map. Only tiles whose way to the
+        // goal ran through a tile that changed, or that a changed tile opens a cheaper way for, are costed again. A
+        // grid of another size is flooded from scratch.
+        FlowField(const FlowField& Previous, const TileCollisionGrid& InGrid);
+
+        TilePoint GetGoal() const { return Goal; }
+        std::uint64_t GetVersion() const { return Grid.GetVersion(); }
+        uint GetWidth() const { return Grid.GetWidth(); }
+        uint GetHeight() const { return Grid.GetHeight(); }
+
+        // Unreachable for solid tiles, tiles cut off from the goal and tiles outside the grid
+        std::uint32_t GetCost(int X, int Y) const
+        {
+            return IsInside(X, Y) ? Costs[GetIndex(X, Y)] : Unreachable;
+        }
+
+        bool IsReachable(int X, int Y) const { return GetCost(X, Y) != Unreachable; }
+
+        // The offset of the neighbour to step to from (X, Y) on a cheapest way to the goal; zero at the goal and
+        // wherever it cannot be reached
+        TilePoint GetStep(int X, int Y) const
+        {
+            return IsInside(X, Y) ? Offsets[Directions[GetIndex(X, Y)]] : TilePoint{};
+        }
+
+        // Tiles whose cost was set by the build that made this field
+        std::size_t GetCostedCount() const { return CostedCount; }
+
+    private:
+        static constexpr std::uint8_t NoDirection = 8;
+        static constexpr TilePoint Offsets[9] = {{-1, -1}, {0, -1}, {1, -1}, {-1, 0}, {1, 0}, {-1, 1}, {0, 1}, {1, 1}, {0, 0}};
+
+        bool IsInside(int X, int Y) const
+        {
+            return X >= 0 && Y >= 0 && X < static_cast<int>(Grid.GetWidth()) && Y < static_cast<int>(Grid.GetHeight());
+        }
+
+        std::size_t GetIndex(int X, int Y) const
+        {
+            return static_cast<std::size_t>(Y) * Grid.GetWidth() + static_cast<std::size_t>(X);
+        }
+
+        // Whether a move from (X, Y) in Direction is allowed: onto an open tile, and for a diagonal, past two
+        bool CanMove(int X, int Y, int Direction) const;
+
+        void Flood();
+        void Update(const TileCollisionGrid& PreviousGrid);
+
+        // Spreads the wavefront from the tiles in Open, each queued as its cost above its index
+        void Propagate(std::vector<std::uint64_t>& Open);
+
+        TileCollisionGrid Grid;
+        TilePoint Goal;
+        std::vector<std::uint32_t> Costs;
+
+        // Index into Offsets per tile, towards the tile's cost came from
+        std::vector<std::uint8_t> Directions;
+        std::size_t CostedCount = 0;
+    };
+}
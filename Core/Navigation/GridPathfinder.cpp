@@ -0,0 +1,399 @@
+#include "GridPathfinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+#include "../TileMap/TileCollisionGrid.h"
+
+namespace Core
+{
+    namespace
+    {
+        int Sign(int Value)
+        {
+            return (Value > 0) - (Value < 0);
+        }
+    }
+
+    float GridPathfinder::GetDistance(TilePoint From, TilePoint To)
+    {
+        const int DX = std::abs(To.X - From.X);
+        const int DY = std::abs(To.Y - From.Y);
+        return static_cast<float>(std::max(DX, DY) - std::min(DX, DY)) + DiagonalCost * static_cast<float>(std::min(DX, DY));
+    }
+
+    std::vector<TilePoint> GridPathfinder::FindPath(const TileCollisionGrid& InGrid, TilePoint Start, TilePoint Goal,
+                                                    const TileMapBounds& InBounds, float* OutCost)
+    {
+        if (InGrid.GetWidth() == 0 || InGrid.GetHeight() == 0)
+        {
+            return {};
+        }
+
+        BeginSearch(InGrid, InBounds);
+        if (!IsOpen(Start.X, Start.Y) || !IsOpen(Goal.X, Goal.Y))
+        {
+            return {};
+        }
+
+        const std::uint32_t StartIndex = GetIndex(Start);
+        const std::uint32_t GoalIndex = GetIndex(Goal);
+        Push(StartIndex, 0.0f, StartIndex, GetDistance(Start, Goal));
+
+        std::uint32_t Current = 0;
+        while (PopOpen(Current))
+        {
+            if (Current == GoalIndex)
+            {
+                std::vector<TilePoint> Path;
+                for (std::uint32_t Index = GoalIndex; Index != StartIndex; Index = Parents[Index])
+                {
+                    Path.push_back(GetPoint(Index));
+                }
+                Path.push_back(Start);
+                std::reverse(Path.begin(), Path.end());
+
+                if (OutCost)
+                {
+                    *OutCost = Costs[GoalIndex];
+                }
+                return Path;
+            }
+
+            const TilePoint Point = GetPoint(Current);
+            const TilePoint Parent = GetPoint(Parents[Current]);
+
+            std::pair<int, int> Directions[8];
+            const int DirectionCount = GetJumpDirections(Point, Current == StartIndex ? nullptr : &Parent, Directions);
+            for (int Direction = 0; Direction < DirectionCount; ++Direction)
+            {
+                TilePoint JumpPoint;
+                if (!Jump(Point, Directions[Direction].first, Directions[Direction].second, Goal, JumpPoint))
+                {
+                    continue;
+                }
+
+                const std::uint32_t JumpIndex = GetIndex(JumpPoint);
+                if (ClosedStamps[JumpIndex] == Stamp)
+                {
+                    continue;
+                }
+
+                const float Cost = Costs[Current] + GetDistance(Point, JumpPoint);
+                if (SeenStamps[JumpIndex] != Stamp || Cost < Costs[JumpIndex])
+                {
+                    Push(JumpIndex, Cost, Current, Cost + GetDistance(JumpPoint, Goal));
+                }
+            }
+        }
+
+        return {};
+    }
+
+    void GridPathfinder::FindCosts(const TileCollisionGrid& InGrid, TilePoint Source, std::span<const TilePoint> Targets,
+                                   const TileMapBounds& InBounds, std::span<float> OutCosts)
+    {
+        std::fill(OutCosts.begin(), OutCosts.end(), std::numeric_limits<float>::infinity());
+        if (InGrid.GetWidth() == 0 || InGrid.GetHeight() == 0)
+        {
+            return;
+        }
+
+        BeginSearch(InGrid, InBounds);
+        if (!IsOpen(Source.X, Source.Y))
+        {
+            return;
+        }
+
+        std::size_t Remaining = std::count_if(Targets.begin(), Targets.end(), [this](const TilePoint& Target)
+        {
+            return IsOpen(Target.X, Target.Y);
+        });
+
+        const std::uint32_t SourceIndex = GetIndex(Source);
+        Push(SourceIndex, 0.0f, SourceIndex, 0.0f);
+
+        std::uint32_t Current = 0;
+        while (Remaining > 0 && PopOpen(Current))
+        {
+            const TilePoint Point = GetPoint(Current);
+            for (std::size_t Target = 0; Target < Targets.size(); ++Target)
+            {
+                if (Targets[Target] == Point)
+                {
+                    OutCosts[Target] = Costs[Current];
+                    --Remaining;
+                }
+            }
+
+            for (int DY = -1; DY <= 1; ++DY)
+            {
+                for (int DX = -1; DX <= 1; ++DX)
+                {
+                    const TilePoint Next{Point.X + DX, Point.Y + DY};
+                    if ((DX == 0 && DY == 0) || !IsOpen(Next.X, Next.Y))
+                    {
+                        continue;
+                    }
+
+                    const bool bDiagonal = DX != 0 && DY != 0;
+                    if (bDiagonal && (!IsOpen(Point.X + DX, Point.Y) || !IsOpen(Point.X, Point.Y + DY)))
+                    {
+                        continue;
+                    }
+
+                    const std::uint32_t NextIndex = GetIndex(Next);
+                    if (ClosedStamps[NextIndex] == Stamp)
+                    {
+                        continue;
+                    }
+
+                    const float Cost = Costs[Current] + (bDiagonal ? DiagonalCost : 1.0f);
+                    if (SeenStamps[NextIndex] != Stamp || Cost < Costs[NextIndex])
+                    {
+                        Push(NextIndex, Cost, Current, Cost);
+                    }
+                }
+            }
+        }
+    }
+
+    bool GridPathfinder::IsOpen(int X, int Y) const
+    {
+        return X >= static_cast<int>(Bounds.MinX) && Y >= static_cast<int>(Bounds.MinY) &&
+               X <= static_cast<int>(Bounds.MaxX) && Y <= static_cast<int>(Bounds.MaxY) && !Grid->IsSolid(X, Y);
+    }
+
+    std::uint32_t GridPathfinder::GetIndex(TilePoint Point) const
+    {
+        return static_cast<std::uint32_t>((Point.Y - static_cast<int>(Bounds.MinY)) * WindowWidth +
+                                          (Point.X - static_cast<int>(Bounds.MinX)));
+    }
+
+    TilePoint GridPathfinder::GetPoint(std::uint32_t Index) const
+    {
+        return {static_cast<int>(Bounds.MinX) + static_cast<int>(Index % WindowWidth),
+                static_cast<int>(Bounds.MinY) + static_cast<int>(Index / WindowWidth)};
+    }
+
+    void GridPathfinder::BeginSearch(const TileCollisionGrid& InGrid, const TileMapBounds& InBounds)
+    {
+        Grid = &InGrid;
+        Bounds = InBounds;
+        Bounds.MaxX = std::min(Bounds.MaxX, InGrid.GetWidth() - 1);
+        Bounds.MaxY = std::min(Bounds.MaxY, InGrid.GetHeight() - 1);
+        Bounds.MinX = std::min(Bounds.MinX, Bounds.MaxX);
+        Bounds.MinY = std::min(Bounds.MinY, Bounds.MaxY);
+        WindowWidth = static_cast<int>(Bounds.MaxX - Bounds.MinX + 1);
+
+        const std::size_t Area = static_cast<std::size_t>(WindowWidth) * (Bounds.MaxY - Bounds.MinY + 1);
+        if (SeenStamps.size() < Area)
+        {
+            SeenStamps.resize(Area, 0);
+            ClosedStamps.resize(Area, 0);
+            Costs.resize(Area);
+            Parents.resize(Area);
+        }
+
+        if (++Stamp == 0)
+        {
+            std::fill(SeenStamps.begin(), SeenStamps.end(), 0);
+            std::fill(ClosedStamps.begin(), ClosedStamps.end(), 0);
+            Stamp = 1;
+        }
+
+        Open.clear();
+        ExpandedCount = 0;
+    }
+
+    void GridPathfinder::Push(std::uint32_t Index, float Cost, std::uint32_t Parent, float Priority)
+    {
+        SeenStamps[Index] = Stamp;
+        Costs[Index] = Cost;
+        Parents[Index] = Parent;
+
+        Open.emplace_back(Priority, Index);
+        std::push_heap(Open.begin(), Open.end(), std::greater<>());
+    }
+
+    bool GridPathfinder::PopOpen(std::uint32_t& OutIndex)
+    {
+        while (!Open.empty())
+        {
+            std::pop_heap(Open.begin(), Open.end(), std::greater<>());
+            const std::uint32_t Index = Open.back().second;
+            Open.pop_back();
+
+            // Tiles pushed again at a lower cost leave their older entries behind
+            if (ClosedStamps[Index] == Stamp)
+            {
+                continue;
+            }
+
+            ClosedStamps[Index] = Stamp;
+            ++ExpandedCount;
+            OutIndex = Index;
+            return true;
+        }
+        return false;
+    }
+
+    bool GridPathfinder::Jump(TilePoint From, int DX, int DY, TilePoint Goal, TilePoint& OutJumpPoint) const
+    {
+        if (DX == 0 || DY == 0)
+        {
+            return JumpStraight(From, DX, DY, Goal, OutJumpPoint);
+        }
+
+        TilePoint Point = From;
+        while (true)
+        {
+            if (!IsOpen(Point.X + DX, Point.Y) || !IsOpen(Point.X, Point.Y + DY))
+            {
+                return false;
+            }
+
+            Point.X += DX;
+            Point.Y += DY;
+            if (!IsOpen(Point.X, Point.Y))
+            {
+                return false;
+            }
+
+            // A diagonal stops wherever one of its straight parts would find something
+            TilePoint Ignored;
+            if (Point == Goal || JumpStraight(Point, DX, 0, Goal, Ignored) || JumpStraight(Point, 0, DY, Goal, Ignored))
+            {
+                OutJumpPoint = Point;
+                return true;
+            }
+        }
+    }
+
+    bool GridPathfinder::JumpStraight(TilePoint From, int DX, int DY, TilePoint Goal, TilePoint& OutJumpPoint) const
+    {
+        TilePoint Point = From;
+        while (true)
+        {
+            Point.X += DX;
+            Point.Y += DY;
+            if (!IsOpen(Point.X, Point.Y))
+            {
+                return false;
+            }
+
+            // Stops beside the end of a wall it was running along, where a way around the wall opens up
+            const bool bForced = DX != 0
+                ? (IsOpen(Point.X, Point.Y - 1) && !IsOpen(Point.X - DX, Point.Y - 1)) ||
+                  (IsOpen(Point.X, Point.Y + 1) && !IsOpen(Point.X - DX, Point.Y + 1))
+                : (IsOpen(Point.X - 1, Point.Y) && !IsOpen(Point.X - 1, Point.Y - DY)) ||
+                  (IsOpen(Point.X + 1, Point.Y) && !IsOpen(Point.X + 1, Point.Y - DY));
+
+            if (Point == Goal || bForced)
+            {
+                OutJumpPoint = Point;
+                return true;
+            }
+        }
+    }
+
+    int GridPathfinder::GetJumpDirections(TilePoint Point, const TilePoint* Parent, std::pair<int, int> (&OutDirections)[8]) const
+    {
+        int Count = 0;
+        auto Add = [&](int DX, int DY) { OutDirections[Count++] = {DX, DY}; };
+
+        const int X = Point.X;
+        const int Y = Point.Y;
+
+        if (!Parent)
+        {
+            for (int DY = -1; DY <= 1; ++DY)
+            {
+                for (int DX = -1; DX <= 1; ++DX)
+                {
+                    if ((DX != 0 || DY != 0) && IsOpen(X + DX, Y + DY) &&
+                        (DX == 0 || DY == 0 || (IsOpen(X + DX, Y) && IsOpen(X, Y + DY))))
+                    {
+                        Add(DX, DY);
+                    }
+                }
+            }
+            return Count;
+        }
+
+        const int DX = Sign(X - Parent->X);
+        const int DY = Sign(Y - Parent->Y);
+
+        if (DX != 0 && DY != 0)
+        {
+            const bool bOpenX = IsOpen(X + DX, Y);
+            const bool bOpenY = IsOpen(X, Y + DY);
+            if (bOpenX)
+            {
+                Add(DX, 0);
+            }
+            if (bOpenY)
+            {
+                Add(0, DY);
+            }
+            if (bOpenX && bOpenY && IsOpen(X + DX, Y + DY))
+            {
+                Add(DX, DY);
+            }
+        }
+        else if (DX != 0)
+        {
+            const bool bAbove = IsOpen(X, Y - 1);
+            const bool bBelow = IsOpen(X, Y + 1);
+            if (IsOpen(X + DX, Y))
+            {
+                Add(DX, 0);
+                if (bAbove && IsOpen(X + DX, Y - 1))
+                {
+                    Add(DX, -1);
+                }
+                if (bBelow && IsOpen(X + DX, Y + 1))
+                {
+                    Add(DX, 1);
+                }
+            }
+            if (bAbove)
+            {
+                Add(0, -1);
+            }
+            if (bBelow)
+            {
+                Add(0, 1);
+            }
+        }
+        else
+        {
+            const bool bLeft = IsOpen(X - 1, Y);
+            const bool bRight = IsOpen(X + 1, Y);
+            if (IsOpen(X, Y + DY))
+            {
+                Add(0, DY);
+                if (bLeft && IsOpen(X - 1, Y + DY))
+                {
+                    Add(-1, DY);
+                }
+                if (bRight && IsOpen(X + 1, Y + DY))
+                {
+                    Add(1, DY);
+                }
+            }
+            if (bLeft)
+            {
+                Add(-1, 0);
+            }
+            if (bRight)
+            {
+                Add(1, 0);
+            }
+        }
+
+        return Count;
+    }
+}
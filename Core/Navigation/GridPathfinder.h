@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+#include "../Common.h"
+#include "../TileMap/TileMap.h"
+
+namespace Core
+{
+    class TileCollisionGrid;
+
+    struct TilePoint
+    {
+        int X = 0;
+        int Y = 0;
+
+        bool operator==(const TilePoint&) const = default;
+    };
+
+    struct TilePointHash
+    {
+        std::size_t operator()(const TilePoint& Point) const
+        {
+            return static_cast<std::size_t>(static_cast<std::uint64_t>(static_cast<std::uint32_t>(Point.Y)) << 32 |
+                                            static_cast<std::uint32_t>(Point.X)) * 0x9e3779b97f4a7c15ull;
+        }
+    };
+
+    // A* over the open tiles of a TileCollisionGrid, confined to a rectangle of it. Moves go to all eight neighbours,
+    // diagonals costing DiagonalCost, but a diagonal needs both tiles beside it open, so paths never clip the corner
+    // of a wall. Scratch memory is kept from one search to the next, so each thread needs its own pathfinder.
+    class GridPathfinder
+    {
+    public:
+        static constexpr float DiagonalCost = 1.41421356f;
+
+        // Jump point search: runs of tiles with no decision along them are jumped over instead of expanded one by
+        // one. Returns the turning points from Start to Goal, both included; consecutive ones lie on one straight or
+        // diagonal line. Empty when either end is blocked or outside Bounds, or no path stays inside it.
+        std::vector<TilePoint> FindPath(const TileCollisionGrid& InGrid, TilePoint Start, TilePoint Goal,
+                                        const TileMapBounds& InBounds, float* OutCost = nullptr);
+
+        // Dijkstra from Source, stopping once every target is settled. OutCosts[i] is the cost to Targets[i], or
+        // infinity when it cannot be reached inside Bounds.
+        void FindCosts(const TileCollisionGrid& InGrid, TilePoint Source, std::span<const TilePoint> Targets,
+                       const TileMapBounds& InBounds, std::span<float> OutCosts);
+
+        // Tiles taken off the open list by the last search
+        std::size_t GetExpandedCount() const { return ExpandedCount; }
+
+        // Cost of the cheapest move from From to To on an open grid
+        static float GetDistance(TilePoint From, TilePoint To);
+
+    private:
+        bool IsOpen(int X, int Y) const;
+        std::uint32_t GetIndex(TilePoint Point) const;
+        TilePoint GetPoint(std::uint32_t Index) const;
+
+        void BeginSearch(const TileCollisionGrid& InGrid, const TileMapBounds& InBounds);
+        void Push(std::uint32_t Index, float Cost, std::uint32_t Parent, float Priority);
+
+        // Pops the cheapest tile not yet closed, returning false when the open list runs out
+        bool PopOpen(std::uint32_t& OutIndex);
+
+        // Walks from From in direction (DX, DY) to the next tile a search has to decide at. False when the walk runs
+        // into a wall or out of bounds first.
+        bool Jump(TilePoint From, int DX, int DY, TilePoint Goal, TilePoint& OutJumpPoint) const;
+        bool JumpStraight(TilePoint From, int DX, int DY, TilePoint Goal, TilePoint& OutJumpPoint) const;
+
+        // The directions worth jumping in from a tile reached from Parent, or all open ones from the start tile
+        int GetJumpDirections(TilePoint Point, const TilePoint* Parent, std::pair<int, int> (&OutDirections)[8]) const;
+
+        const TileCollisionGrid* Grid = nullptr;
+        TileMapBounds Bounds;
+        int WindowWidth = 0;
+
+        // Per tile of the window. Tiles are only valid for this search when their stamp matches, so nothing has to
+        // be cleared between searches.
+        std::vector<std::uint32_t> SeenStamps;
+        std::vector<std::uint32_t> ClosedStamps;
+        std::vector<float> Costs;
+        std::vector<std::uint32_t> Parents;
+        std::uint32_t Stamp = 0;
+
+        std::vector<std::pair<float, std::uint32_t>> Open;
+        std::size_t ExpandedCount = 0;
+    };
+}
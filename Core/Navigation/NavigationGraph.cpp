@@ -0,0 +1,356 @@
+#include "NavigationGraph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <utility>
+
+namespace Core
+{
+    namespace
+    {
+        constexpr std::uint32_t NoNode = std::numeric_limits<std::uint32_t>::max();
+
+        // Open stretches along a border at least this long get a portal at each end instead of one in the middle
+        constexpr int LongBorderRun = 6;
+    }
+
+    NavigationGraph::NavigationGraph(const TileCollisionGrid& InGrid, const NavigationGraph* Previous,
+                                     GridPathfinder& Pathfinder)
+        : Grid(InGrid)
+          , ClusterColumns(InGrid.GetChunkColumns())
+          , ClusterRows(InGrid.GetChunkRows())
+    {
+        const bool bCanReuse = Previous && Previous->Grid.GetWidth() == Grid.GetWidth() &&
+                               Previous->Grid.GetHeight() == Grid.GetHeight();
+
+        auto HasChanged = [&](int ClusterX, int ClusterY)
+        {
+            if (ClusterX < 0 || ClusterY < 0 || ClusterX >= static_cast<int>(ClusterColumns) ||
+                ClusterY >= static_cast<int>(ClusterRows))
+            {
+                return false;
+            }
+            return Grid.GetChunkVersion(ClusterX, ClusterY) != Previous->Grid.GetChunkVersion(ClusterX, ClusterY);
+        };
+
+        // A cluster's portals also depend on the tiles just across its borders
+        Clusters.resize(static_cast<std::size_t>(ClusterColumns) * ClusterRows);
+        for (uint ClusterY = 0; ClusterY < ClusterRows; ++ClusterY)
+        {
+            for (uint ClusterX = 0; ClusterX < ClusterColumns; ++ClusterX)
+            {
+                const int X = static_cast<int>(ClusterX);
+                const int Y = static_cast<int>(ClusterY);
+                const std::size_t Index = ClusterY * ClusterColumns + ClusterX;
+
+                if (bCanReuse && !HasChanged(X, Y) && !HasChanged(X - 1, Y) && !HasChanged(X + 1, Y) &&
+                    !HasChanged(X, Y - 1) && !HasChanged(X, Y + 1))
+                {
+                    Clusters[Index] = Previous->Clusters[Index];
+                    continue;
+                }
+
+                Clusters[Index] = BuildCluster(ClusterX, ClusterY, Pathfinder);
+                ++RebuiltClusterCount;
+            }
+        }
+
+        ClusterFirstNode.reserve(Clusters.size());
+        for (std::size_t Index = 0; Index < Clusters.size(); ++Index)
+        {
+            ClusterFirstNode.push_back(static_cast<std::uint32_t>(NodeTiles.size()));
+            for (const Portal& Node : Clusters[Index]->Portals)
+            {
+                NodeTiles.push_back(Node.Tile);
+                NodeClusters.push_back(static_cast<std::uint32_t>(Index));
+            }
+        }
+
+        // Every portal has its twin on the other side of the border, since both clusters find the same stretches
+        NodeAcross.assign(NodeTiles.size(), NoNode);
+        for (std::size_t Node = 0; Node < NodeTiles.size(); ++Node)
+        {
+            const Portal& Source = Clusters[NodeClusters[Node]]->Portals[Node - ClusterFirstNode[NodeClusters[Node]]];
+            const uint AcrossCluster = GetClusterIndex(Source.Across);
+            const std::vector<Portal>& Candidates = Clusters[AcrossCluster]->Portals;
+
+            for (std::size_t Candidate = 0; Candidate < Candidates.size(); ++Candidate)
+            {
+                if (Candidates[Candidate].Tile == Source.Across && Candidates[Candidate].Across == Source.Tile)
+                {
+                    NodeAcross[Node] = ClusterFirstNode[AcrossCluster] + static_cast<std::uint32_t>(Candidate);
+                    break;
+                }
+            }
+        }
+    }
+
+    std::shared_ptr<const NavigationGraph::Cluster> NavigationGraph::BuildCluster(uint ClusterX, uint ClusterY,
+                                                                                  GridPathfinder& Pathfinder) const
+    {
+        std::shared_ptr<Cluster> Result = std::make_shared<Cluster>();
+        AddBorderPortals(ClusterX, ClusterY, -1, 0, Result->Portals);
+        AddBorderPortals(ClusterX, ClusterY, 0, -1, Result->Portals);
+        AddBorderPortals(ClusterX, ClusterY, 1, 0, Result->Portals);
+        AddBorderPortals(ClusterX, ClusterY, 0, 1, Result->Portals);
+
+        const std::size_t Count = Result->Portals.size();
+        std::vector<TilePoint> Tiles;
+        Tiles.reserve(Count);
+        for (const Portal& Node : Result->Portals)
+        {
+            Tiles.push_back(Node.Tile);
+        }
+
+        const TileMapBounds Bounds = GetClusterBounds(ClusterY * ClusterColumns + ClusterX);
+        Result->Costs.resize(Count * Count);
+        for (std::size_t Node = 0; Node < Count; ++Node)
+        {
+            Pathfinder.FindCosts(Grid, Tiles[Node], Tiles, Bounds, std::span<float>(Result->Costs.data() + Node * Count, Count));
+        }
+
+        return Result;
+    }
+
+    void NavigationGraph::AddBorderPortals(uint ClusterX, uint ClusterY, int DX, int DY, std::vector<Portal>& OutPortals) const
+    {
+        const int NeighbourX = static_cast<int>(ClusterX) + DX;
+        const int NeighbourY = static_cast<int>(ClusterY) + DY;
+        if (NeighbourX < 0 || NeighbourY < 0 || NeighbourX >= static_cast<int>(ClusterColumns) ||
+            NeighbourY >= static_cast<int>(ClusterRows))
+        {
+            return;
+        }
+
+        // A left or right border runs down the cluster's edge column, a top or bottom one along its edge row
+        const TileMapBounds Bounds = GetClusterBounds(ClusterY * ClusterColumns + ClusterX);
+        const bool bVertical = DX != 0;
+        const int Edge = bVertical ? static_cast<int>(DX < 0 ? Bounds.MinX : Bounds.MaxX)
+                                   : static_cast<int>(DY < 0 ? Bounds.MinY : Bounds.MaxY);
+        const int First = static_cast<int>(bVertical ? Bounds.MinY : Bounds.MinX);
+        const int Last = static_cast<int>(bVertical ? Bounds.MaxY : Bounds.MaxX);
+
+        auto GetTile = [&](int Along) { return bVertical ? TilePoint{Edge, Along} : TilePoint{Along, Edge}; };
+        auto AddPortal = [&](int Along)
+        {
+            const TilePoint Tile = GetTile(Along);
+            OutPortals.push_back({Tile, {Tile.X + DX, Tile.Y + DY}});
+        };
+
+        int RunStart = First;
+        for (int Along = First; Along <= Last + 1; ++Along)
+        {
+            const TilePoint Tile = GetTile(Along);
+            const bool bOpen = Along <= Last && !Grid.IsSolid(Tile.X, Tile.Y) && !Grid.IsSolid(Tile.X + DX, Tile.Y + DY);
+            if (bOpen)
+            {
+                continue;
+            }
+
+            const int Length = Along - RunStart;
+            if (Length >= LongBorderRun)
+            {
+                AddPortal(RunStart);
+                AddPortal(Along - 1);
+            }
+            else if (Length > 0)
+            {
+                AddPortal(RunStart + Length / 2);
+            }
+            RunStart = Along + 1;
+        }
+    }
+
+    TileMapBounds NavigationGraph::GetClusterBounds(uint ClusterIndex) const
+    {
+        const uint MinX = ClusterIndex % ClusterColumns * ClusterSize;
+        const uint MinY = ClusterIndex / ClusterColumns * ClusterSize;
+        return {MinX, MinY, std::min(MinX + ClusterSize, Grid.GetWidth()) - 1, std::min(MinY + ClusterSize, Grid.GetHeight()) - 1};
+    }
+
+    uint NavigationGraph::GetClusterIndex(TilePoint Tile) const
+    {
+        return static_cast<uint>(Tile.Y) / ClusterSize * ClusterColumns + static_cast<uint>(Tile.X) / ClusterSize;
+    }
+
+    std::vector<TilePoint> NavigationGraph::FindPath(TilePoint Start, TilePoint Goal, GridPathfinder& Pathfinder,
+                                                     float* OutCost) const
+    {
+        const int Width = static_cast<int>(Grid.GetWidth());
+        const int Height = static_cast<int>(Grid.GetHeight());
+        auto IsOpen = [&](TilePoint Tile)
+        {
+            return Tile.X >= 0 && Tile.Y >= 0 && Tile.X < Width && Tile.Y < Height && !Grid.IsSolid(Tile.X, Tile.Y);
+        };
+
+        if (!IsOpen(Start) || !IsOpen(Goal))
+        {
+            return {};
+        }
+
+        // Ends close together are searched for directly, in a window around both
+        const int Reach = static_cast<int>(ClusterSize);
+        if (std::max(std::abs(Goal.X - Start.X), std::abs(Goal.Y - Start.Y)) <= Reach)
+        {
+            const TileMapBounds Window{
+                static_cast<uint>(std::max(std::min(Start.X, Goal.X) - Reach, 0)),
+                static_cast<uint>(std::max(std::min(Start.Y, Goal.Y) - Reach, 0)),
+                static_cast<uint>(std::min(std::max(Start.X, Goal.X) + Reach, Width - 1)),
+                static_cast<uint>(std::min(std::max(Start.Y, Goal.Y) + Reach, Height - 1))
+            };
+            std::vector<TilePoint> Path = Pathfinder.FindPath(Grid, Start, Goal, Window, OutCost);
+            if (!Path.empty())
+            {
+                return Path;
+            }
+        }
+
+        // Costs from each end to the portals of its own cluster
+        const uint StartCluster = GetClusterIndex(Start);
+        const uint GoalCluster = GetClusterIndex(Goal);
+
+        std::vector<TilePoint> StartPortals;
+        for (const Portal& Node : Clusters[StartCluster]->Portals)
+        {
+            StartPortals.push_back(Node.Tile);
+        }
+        std::vector<float> StartCosts(StartPortals.size());
+        Pathfinder.FindCosts(Grid, Start, StartPortals, GetClusterBounds(StartCluster), StartCosts);
+
+        std::vector<TilePoint> GoalPortals;
+        for (const Portal& Node : Clusters[GoalCluster]->Portals)
+        {
+            GoalPortals.push_back(Node.Tile);
+        }
+        std::vector<float> GoalCosts(GoalPortals.size());
+        Pathfinder.FindCosts(Grid, Goal, GoalPortals, GetClusterBounds(GoalCluster), GoalCosts);
+
+        // A* over the portals, with the goal as one extra node reached from the goal cluster's portals
+        const std::uint32_t GoalNode = static_cast<std::uint32_t>(NodeTiles.size());
+        std::vector<float> Costs(NodeTiles.size() + 1, std::numeric_limits<float>::infinity());
+        std::vector<std::uint32_t> Parents(NodeTiles.size() + 1, NoNode);
+        std::vector<bool> Closed(NodeTiles.size() + 1, false);
+        std::vector<std::pair<float, std::uint32_t>> Open;
+
+        auto Relax = [&](std::uint32_t Node, float Cost, std::uint32_t Parent)
+        {
+            if (Closed[Node] || Cost >= Costs[Node])
+            {
+                return;
+            }
+            Costs[Node] = Cost;
+            Parents[Node] = Parent;
+            Open.emplace_back(Cost + (Node == GoalNode ? 0.0f : GridPathfinder::GetDistance(NodeTiles[Node], Goal)), Node);
+            std::push_heap(Open.begin(), Open.end(), std::greater<>());
+        };
+
+        for (std::size_t Local = 0; Local < StartCosts.size(); ++Local)
+        {
+            if (std::isfinite(StartCosts[Local]))
+            {
+                Relax(ClusterFirstNode[StartCluster] + static_cast<std::uint32_t>(Local), StartCosts[Local], NoNode);
+            }
+        }
+
+        bool bFound = false;
+        while (!Open.empty())
+        {
+            std::pop_heap(Open.begin(), Open.end(), std::greater<>());
+            const std::uint32_t Node = Open.back().second;
+            Open.pop_back();
+
+            if (Closed[Node])
+            {
+                continue;
+            }
+            Closed[Node] = true;
+
+            if (Node == GoalNode)
+            {
+                bFound = true;
+                break;
+            }
+
+            const std::uint32_t ClusterIndex = NodeClusters[Node];
+            const std::uint32_t Local = Node - ClusterFirstNode[ClusterIndex];
+            const Cluster& Current = *Clusters[ClusterIndex];
+            const std::size_t Count = Current.Portals.size();
+
+            if (ClusterIndex == GoalCluster && std::isfinite(GoalCosts[Local]))
+            {
+                Relax(GoalNode, Costs[Node] + GoalCosts[Local], Node);
+            }
+
+            for (std::size_t Other = 0; Other < Count; ++Other)
+            {
+                const float Cost = Current.Costs[Local * Count + Other];
+                if (Other != Local && std::isfinite(Cost))
+                {
+                    Relax(ClusterFirstNode[ClusterIndex] + static_cast<std::uint32_t>(Other), Costs[Node] + Cost, Node);
+                }
+            }
+
+            if (NodeAcross[Node] != NoNode)
+            {
+                Relax(NodeAcross[Node], Costs[Node] + 1.0f, Node);
+            }
+        }
+
+        if (!bFound)
+        {
+            return {};
+        }
+
+        std::vector<TilePoint> Portals;
+        for (std::uint32_t Node = Parents[GoalNode]; Node != NoNode; Node = Parents[Node])
+        {
+            Portals.push_back(NodeTiles[Node]);
+        }
+        std::reverse(Portals.begin(), Portals.end());
+
+        std::vector<TilePoint> Path{Start};
+        TilePoint From = Start;
+        for (const TilePoint& Portal : Portals)
+        {
+            if (!AppendSegment(From, Portal, Pathfinder, Path))
+            {
+                return {};
+            }
+            From = Portal;
+        }
+        if (!AppendSegment(From, Goal, Pathfinder, Path))
+        {
+            return {};
+        }
+
+        if (OutCost)
+        {
+            *OutCost = Costs[GoalNode];
+        }
+        return Path;
+    }
+
+    bool NavigationGraph::AppendSegment(TilePoint From, TilePoint To, GridPathfinder& Pathfinder, std::vector<TilePoint>& Path) const
+    {
+        // Portals at a cluster's corner share a tile, and a step across a border is a single move
+        if (From == To)
+        {
+            return true;
+        }
+        if (std::abs(To.X - From.X) + std::abs(To.Y - From.Y) == 1)
+        {
+            Path.push_back(To);
+            return true;
+        }
+
+        const std::vector<TilePoint> Segment = Pathfinder.FindPath(Grid, From, To, GetClusterBounds(GetClusterIndex(From)));
+        if (Segment.empty())
+        {
+            return false;
+        }
+        Path.insert(Path.end(), Segment.begin() + 1, Segment.end());
+        return true;
+    }
+}
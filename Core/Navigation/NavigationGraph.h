@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "GridPathfinder.h"
+#include "../TileMap/TileCollisionGrid.h"
+#include "../TileMap/TileMap.h"
+
+namespace Core
+{
+    // Hierarchical pathfinding over an immutable copy of a TileCollisionGrid. The grid is cut into clusters laid out
+    // like TileMap chunks. Each stretch of open tiles along a cluster border gets one or two portals, and each cluster
+    // stores the cost between every pair of its portals. A long path is found on that graph of portals, then refined
+    // into tiles one cluster at a time with GridPathfinder, so no search ever spans more than a cluster or two.
+    // Paths come out near optimal rather than optimal.
+    class NavigationGraph
+    {
+    public:
+        static constexpr uint ClusterSize = TileMap::ChunkSize;
+
+        // Only clusters whose chunk or a neighbouring chunk changed version since Previous are rebuilt; the rest are
+        // shared with it. Previous has to come from the same map, or be null.
+        NavigationGraph(const TileCollisionGrid& InGrid, const NavigationGraph* Previous, GridPathfinder& Pathfinder);
+
+        const TileCollisionGrid& GetGrid() const { return Grid; }
+        std::uint64_t GetVersion() const { return Grid.GetVersion(); }
+
+        // Waypoints as GridPathfinder::FindPath returns them; empty when either end is blocked or they are not connected
+        std::vector<TilePoint> FindPath(TilePoint Start, TilePoint Goal, GridPathfinder& Pathfinder,
+                                        float* OutCost = nullptr) const;
+
+        std::size_t GetPortalCount() const { return NodeTiles.size(); }
+        std::size_t GetClusterCount() const { return Clusters.size(); }
+        std::size_t GetRebuiltClusterCount() const { return RebuiltClusterCount; }
+
+    private:
+        struct Portal
+        {
+            TilePoint Tile;
+
+            // The tile across the border, which is the matching portal of the neighbouring cluster
+            TilePoint Across;
+        };
+
+        struct Cluster
+        {
+            std::vector<Portal> Portals;
+
+            // Portals.size() squared, row-major; infinity between portals with no path inside the cluster
+            std::vector<float> Costs;
+        };
+
+        std::shared_ptr<const Cluster> BuildCluster(uint ClusterX, uint ClusterY, GridPathfinder& Pathfinder) const;
+
+        // Portals along the border from cluster (ClusterX, ClusterY) towards (DX, DY), one of the four neighbours
+        void AddBorderPortals(uint ClusterX, uint ClusterY, int DX, int DY, std::vector<Portal>& OutPortals) const;
+
+        TileMapBounds GetClusterBounds(uint ClusterIndex) const;
+        uint GetClusterIndex(TilePoint Tile) const;
+
+        // Refines the path across the portal graph into waypoints within each cluster, appending after the first
+        bool AppendSegment(TilePoint From, TilePoint To, GridPathfinder& Pathfinder, std::vector<TilePoint>& Path) const;
+
+        TileCollisionGrid Grid;
+        uint ClusterColumns = 0;
+        uint ClusterRows = 0;
+        std::vector<std::shared_ptr<const Cluster>> Clusters;
+        std::size_t RebuiltClusterCount = 0;
+
+        // Every portal numbered across clusters, for the search over them
+        std::vector<std::uint32_t> ClusterFirstNode;
+        std::vector<TilePoint> NodeTiles;
+        std::vector<std::uint32_t> NodeClusters;
+        std::vector<std::uint32_t> NodeAcross;
+    };
+}
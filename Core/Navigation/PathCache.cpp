@@ -0,0 +1,131 @@
+#include "PathCache.h"
+
+#include <algorithm>
+
+#include "../TileMap/TileCollisionGrid.h"
+#include "../TileMap/TileMap.h"
+
+namespace Core
+{
+    namespace
+    {
+        int GetStep(int From, int To)
+        {
+            return (To > From) - (To < From);
+        }
+    }
+
+    const PathResult* PathCache::Find(const PathKey& Key, const TileCollisionGrid& Grid)
+    {
+        const auto Found = Index.find(Key);
+        if (Found == Index.end())
+        {
+            return nullptr;
+        }
+
+        if (!IsCurrent(*Found->second, Grid))
+        {
+            Entries.erase(Found->second);
+            Index.erase(Found);
+            return nullptr;
+        }
+
+        Entries.splice(Entries.begin(), Entries, Found->second);
+        return &Found->second->Result;
+    }
+
+    void PathCache::Store(const PathResult& Result, const TileCollisionGrid& Grid)
+    {
+        if (Capacity == 0)
+        {
+            return;
+        }
+
+        Entry Stored;
+        Stored.Key = {Result.Start, Result.Goal};
+        Stored.Result = Result;
+        Stored.Result.bFromCache = false;
+        Stored.GridVersion = Grid.GetVersion();
+
+        // Every tile along the path, and for a diagonal step the two tiles beside it, since those have to stay open too
+        std::vector<std::uint64_t> ChunkIndices;
+        auto AddTile = [&](int X, int Y)
+        {
+            ChunkIndices.push_back(static_cast<std::uint64_t>(Y / static_cast<int>(TileMap::ChunkSize)) << 32 |
+                                   static_cast<std::uint32_t>(X / static_cast<int>(TileMap::ChunkSize)));
+        };
+
+        for (std::size_t Waypoint = 0; Waypoint < Result.Waypoints.size(); ++Waypoint)
+        {
+            TilePoint Current = Result.Waypoints[Waypoint];
+            AddTile(Current.X, Current.Y);
+            if (Waypoint + 1 == Result.Waypoints.size())
+            {
+                break;
+            }
+
+            const TilePoint Next = Result.Waypoints[Waypoint + 1];
+            const int DX = GetStep(Current.X, Next.X);
+            const int DY = GetStep(Current.Y, Next.Y);
+            while (!(Current == Next))
+            {
+                if (DX != 0 && DY != 0)
+                {
+                    AddTile(Current.X + DX, Current.Y);
+                    AddTile(Current.X, Current.Y + DY);
+                }
+                Current.X += DX;
+                Current.Y += DY;
+                AddTile(Current.X, Current.Y);
+            }
+        }
+
+        std::sort(ChunkIndices.begin(), ChunkIndices.end());
+        ChunkIndices.erase(std::unique(ChunkIndices.begin(), ChunkIndices.end()), ChunkIndices.end());
+        for (const std::uint64_t ChunkIndex : ChunkIndices)
+        {
+            const uint ChunkX = static_cast<uint>(ChunkIndex & 0xffffffffu);
+            const uint ChunkY = static_cast<uint>(ChunkIndex >> 32);
+            Stored.Chunks.push_back({ChunkX, ChunkY, Grid.GetChunkVersion(ChunkX, ChunkY)});
+        }
+
+        const auto Found = Index.find(Stored.Key);
+        if (Found != Index.end())
+        {
+            Entries.erase(Found->second);
+            Index.erase(Found);
+        }
+        else if (Entries.size() >= Capacity)
+        {
+            Index.erase(Entries.back().Key);
+            Entries.pop_back();
+        }
+
+        Entries.push_front(std::move(Stored));
+        Index.emplace(Entries.front().Key, Entries.begin());
+    }
+
+    void PathCache::Clear()
+    {
+        Entries.clear();
+        Index.clear();
+    }
+
+    bool PathCache::IsCurrent(const Entry& Cached, const TileCollisionGrid& Grid) const
+    {
+        if (!Cached.Result.IsFound())
+        {
+            return Cached.GridVersion == Grid.GetVersion();
+        }
+
+        for (const ChunkVersion& Chunk : Cached.Chunks)
+        {
+            if (Chunk.ChunkX >= Grid.GetChunkColumns() || Chunk.ChunkY >= Grid.GetChunkRows() ||
+                Grid.GetChunkVersion(Chunk.ChunkX, Chunk.ChunkY) != Chunk.Version)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "GridPathfinder.h"
+
+namespace Core
+{
+    class TileCollisionGrid;
+
+    struct PathResult
+    {
+        TilePoint Start;
+        TilePoint Goal;
+
+        // Turning points from Start to Goal, both included, as GridPathfinder::FindPath returns them; empty when
+        // there is no path
+        std::vector<TilePoint> Waypoints;
+        float Cost = 0.0f;
+        bool bFromCache = false;
+
+        bool IsFound() const { return !Waypoints.empty(); }
+    };
+
+    struct PathKey
+    {
+        TilePoint Start;
+        TilePoint Goal;
+
+        bool operator==(const PathKey&) const = default;
+    };
+
+    struct PathKeyHash
+    {
+        std::size_t operator()(const PathKey& Key) const
+        {
+            std::uint64_t Hash = 0xcbf29ce484222325ull;
+            for (const int Value : {Key.Start.X, Key.Start.Y, Key.Goal.X, Key.Goal.Y})
+            {
+                Hash = (Hash ^ static_cast<std::uint32_t>(Value)) * 0x100000001b3ull;
+            }
+            return static_cast<std::size_t>(Hash);
+        }
+    };
+
+    // The most recently used paths of one map. A found path remembers the version of every chunk it passes through
+    // and is dropped once one of them changes, so it is never handed out through a wall placed since. A missing path
+    // depends on the whole map and is only kept while the grid's version stays the same.
+    class PathCache
+    {
+    public:
+        explicit PathCache(std::size_t InCapacity = 4096) : Capacity(InCapacity) {}
+
+        // Null when there is no entry, or when Grid changed under it since; the pointer lasts until the next Store
+        const PathResult* Find(const PathKey& Key, const TileCollisionGrid& Grid);
+
+        // Grid is the one the path was found on, which may be older than the one it is looked up against
+        void Store(const PathResult& Result, const TileCollisionGrid& Grid);
+
+        void Clear();
+        std::size_t GetSize() const { return Entries.size(); }
+
+    private:
+        struct ChunkVersion
+        {
+            uint ChunkX = 0;
+            uint ChunkY = 0;
+            std::uint64_t Version = 0;
+        };
+
+        struct Entry
+        {
+            PathKey Key;
+            PathResult Result;
+            std::vector<ChunkVersion> Chunks;
+            std::uint64_t GridVersion = 0;
+        };
+
+        bool IsCurrent(const Entry& Cached, const TileCollisionGrid& Grid) const;
+
+        std::size_t Capacity = 0;
+
+        // Most recently used first
+        std::list<Entry> Entries;
+        std::unordered_map<PathKey, std::list<Entry>::iterator, PathKeyHash> Index;
+    };
+}
@@ -0,0 +1,284 @@
+#include "PathfindingService.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace Core
+{
+    namespace
+    {
+        // Graph rebuilds go ahead of searches, which would otherwise be run on a graph already out of date
+        constexpr std::size_t RebuildPriority = 0;
+        constexpr std::size_t SearchPriority = 1;
+
+        GridPathfinder& GetThreadPathfinder()
+        {
+            thread_local GridPathfinder Pathfinder;
+            return Pathfinder;
+        }
+    }
+
+    PathfindingService::PathfindingService(ThreadPool& InWorkers)
+        : Workers(InWorkers)
+    {
+    }
+
+    PathfindingService::~PathfindingService()
+    {
+        Wait();
+    }
+
+    void PathfindingService::RequestPath(TilePoint Start, TilePoint Goal, PathCallback Callback)
+    {
+        ++Stats.Requested;
+
+        const PathKey Key{Start, Goal};
+        const auto [Found, bInserted] = Waiting.try_emplace(Key);
+        Found->second.push_back(std::move(Callback));
+        if (bInserted)
+        {
+            Pending.push_back(Key);
+        }
+        else
+        {
+            ++Stats.Merged;
+        }
+    }
+
+    void PathfindingService::Tick(const TileCollisionGrid& Grid)
+    {
+        std::vector<SolvedPath> Finished;
+        {
+            std::lock_guard Lock(Mutex);
+            Finished.swap(Solved);
+            if (BuiltGraph)
+            {
+                Graph = std::move(BuiltGraph);
+                bRebuilding = false;
+                ++Stats.GraphBuilds;
+                Stats.ClustersRebuilt += Graph->GetRebuiltClusterCount();
+                Stats.LastBuildMs = BuiltGraphMs;
+            }
+        }
+
+        // A path found on an older grid is still good if nothing it crosses changed since
+        for (SolvedPath& Path : Finished)
+        {
+            const PathKey Key{Path.Result.Start, Path.Result.Goal};
+            Cache.Store(Path.Result, Path.Graph->GetGrid());
+            if (const PathResult* Current = Cache.Find(Key, Grid))
+            {
+                Deliver(Key, PathResult(*Current));
+            }
+            else
+            {
+                ++Stats.Stale;
+                Pending.push_back(Key);
+            }
+        }
+
+        const bool bGraphCurrent = Graph && Graph->GetVersion() == Grid.GetVersion();
+        if (!bGraphCurrent && !bRebuilding)
+        {
+            StartRebuild(Grid);
+        }
+
+        // Callbacks may ask for more paths, which wait for the next Tick
+        std::vector<PathKey> Batch;
+        std::vector<PathKey> StillPending;
+        for (const PathKey& Key : std::exchange(Pending, {}))
+        {
+            if (const PathResult* Cached = Cache.Find(Key, Grid))
+            {
+                ++Stats.CacheHits;
+                PathResult Result = *Cached;
+                Result.bFromCache = true;
+                Deliver(Key, Result);
+            }
+            else if (!bGraphCurrent)
+            {
+                StillPending.push_back(Key);
+            }
+            else
+            {
+                Batch.push_back(Key);
+                if (Batch.size() == BatchSize)
+                {
+                    Dispatch(std::move(Batch));
+                    Batch.clear();
+                }
+            }
+        }
+        if (!Batch.empty())
+        {
+            Dispatch(std::move(Batch));
+        }
+        Pending.insert(Pending.end(), StillPending.begin(), StillPending.end());
+
+        UpdateFlowFields(Grid);
+    }
+
+    std::shared_ptr<const FlowField> PathfindingService::GetFlowField(TilePoint Goal)
+    {
+        auto Found = FlowFields.find(Goal);
+        if (Found == FlowFields.end())
+        {
+            if (FlowFields.size() >= MaxFlowFields)
+            {
+                FlowFields.erase(std::min_element(FlowFields.begin(), FlowFields.end(), [](const auto& A, const auto& B)
+                {
+                    return A.second.LastUsedTick < B.second.LastUsedTick;
+                }));
+            }
+            Found = FlowFields.try_emplace(Goal).first;
+        }
+
+        Found->second.LastUsedTick = TickCount;
+        return Found->second.Field;
+    }
+
+    void PathfindingService::Wait()
+    {
+        std::unique_lock Lock(Mutex);
+        JobsFinished.wait(Lock, [this] { return RunningJobs == 0; });
+    }
+
+    void PathfindingService::Deliver(const PathKey& Key, const PathResult& Result)
+    {
+        const auto Found = Waiting.find(Key);
+        if (Found == Waiting.end())
+        {
+            return;
+        }
+
+        // Callbacks may ask for more paths, so they are taken out before any of them runs
+        const std::vector<PathCallback> Callbacks = std::move(Found->second);
+        Waiting.erase(Found);
+        for (const PathCallback& Callback : Callbacks)
+        {
+            Callback(Result);
+        }
+    }
+
+    void PathfindingService::StartRebuild(const TileCollisionGrid& Grid)
+    {
+        bRebuilding = true;
+        {
+            std::lock_guard Lock(Mutex);
+            ++RunningJobs;
+        }
+
+        Workers.Enqueue([this, Previous = Graph, Snapshot = Grid]()
+        {
+            const auto Started = std::chrono::steady_clock::now();
+            auto Built = std::make_shared<const NavigationGraph>(Snapshot, Previous.get(), GetThreadPathfinder());
+            const double ElapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Started).count();
+
+            std::lock_guard Lock(Mutex);
+            BuiltGraph = std::move(Built);
+            BuiltGraphMs = ElapsedMs;
+            --RunningJobs;
+            JobsFinished.notify_all();
+        }, RebuildPriority);
+    }
+
+    void PathfindingService::UpdateFlowFields(const TileCollisionGrid& Grid)
+    {
+        ++TickCount;
+
+        std::vector<std::pair<std::shared_ptr<const FlowField>, double>> Finished;
+        {
+            std::lock_guard Lock(Mutex);
+            Finished.swap(BuiltFlowFields);
+        }
+
+        // Fields dropped while they were being built are thrown away
+        for (auto& [Field, ElapsedMs] : Finished)
+        {
+            const auto Found = FlowFields.find(Field->GetGoal());
+            if (Found != FlowFields.end())
+            {
+                Found->second.Field = std::move(Field);
+                Found->second.bBuilding = false;
+                Stats.LastFlowFieldMs = ElapsedMs;
+            }
+        }
+
+        for (auto It = FlowFields.begin(); It != FlowFields.end();)
+        {
+            FlowFieldEntry& Entry = It->second;
+            if (TickCount - Entry.LastUsedTick > FlowFieldIdleTicks)
+            {
+                It = FlowFields.erase(It);
+                continue;
+            }
+
+            if (!Entry.bBuilding && (!Entry.Field || Entry.Field->GetVersion() != Grid.GetVersion()))
+            {
+                StartFlowField(It->first, Entry, Grid);
+            }
+            ++It;
+        }
+    }
+
+    void PathfindingService::StartFlowField(TilePoint Goal, FlowFieldEntry& Entry, const TileCollisionGrid& Grid)
+    {
+        Entry.bBuilding = true;
+        if (Entry.Field)
+        {
+            ++Stats.FlowFieldUpdates;
+        }
+        else
+        {
+            ++Stats.FlowFieldBuilds;
+        }
+        {
+            std::lock_guard Lock(Mutex);
+            ++RunningJobs;
+        }
+
+        Workers.Enqueue([this, Goal, Previous = Entry.Field, Snapshot = Grid]()
+        {
+            const auto Started = std::chrono::steady_clock::now();
+            auto Built = Previous ? std::make_shared<const FlowField>(*Previous, Snapshot)
+                                  : std::make_shared<const FlowField>(Snapshot, Goal);
+            const double ElapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Started).count();
+
+            std::lock_guard Lock(Mutex);
+            BuiltFlowFields.emplace_back(std::move(Built), ElapsedMs);
+            --RunningJobs;
+            JobsFinished.notify_all();
+        }, SearchPriority);
+    }
+
+    void PathfindingService::Dispatch(std::vector<PathKey> Batch)
+    {
+        Stats.Searched += Batch.size();
+        {
+            std::lock_guard Lock(Mutex);
+            ++RunningJobs;
+        }
+
+        Workers.Enqueue([this, Searched = Graph, Batch = std::move(Batch)]()
+        {
+            GridPathfinder& Pathfinder = GetThreadPathfinder();
+            std::vector<SolvedPath> Results;
+            Results.reserve(Batch.size());
+            for (const PathKey& Key : Batch)
+            {
+                SolvedPath Path;
+                Path.Graph = Searched;
+                Path.Result.Start = Key.Start;
+                Path.Result.Goal = Key.Goal;
+                Path.Result.Waypoints = Searched->FindPath(Key.Start, Key.Goal, Pathfinder, &Path.Result.Cost);
+                Results.push_back(std::move(Path));
+            }
+
+            std::lock_guard Lock(Mutex);
+            Solved.insert(Solved.end(), std::make_move_iterator(Results.begin()), std::make_move_iterator(Results.end()));
+            --RunningJobs;
+            JobsFinished.notify_all();
+        }, SearchPriority);
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "FlowField.h"
+#include "NavigationGraph.h"
+#include "PathCache.h"
+#include "../Async/ThreadPool.h"
+
+namespace Core
+{
+    using PathCallback = std::function<void(const PathResult&)>;
+
+    struct PathfindingStats
+    {
+        std::size_t Requested = 0;
+
+        // Requests for a path already waiting, answered along with it
+        std::size_t Merged = 0;
+        std::size_t CacheHits = 0;
+        std::size_t Searched = 0;
+
+        // Searches that finished on a graph older than the map and were run again
+        std::size_t Stale = 0;
+
+        std::size_t GraphBuilds = 0;
+        std::size_t ClustersRebuilt = 0;
+        double LastBuildMs = 0.0;
+
+        // Flow fields flooded from scratch, and brought up to date after an edit
+        std::size_t FlowFieldBuilds = 0;
+        std::size_t FlowFieldUpdates = 0;
+        double LastFlowFieldMs = 0.0;
+    };
+
+    // Answers path requests for one map on worker threads. Requests for the same ends are merged and answered
+    // from a PathCache when they can be. The rest are searched in batches on a NavigationGraph, which is rebuilt in
+    // the background, cluster by changed cluster, whenever the map's solidity changes; requests wait meanwhile.
+    // Crowds heading to one place share a FlowField instead, kept per goal and updated on the same workers.
+    // The workers are borrowed, so several services can share one pool; it must outlive the service.
+    class PathfindingService
+    {
+    public:
+        static constexpr std::size_t BatchSize = 32;
+
+        // Each field costs several bytes per tile, so only the most recently asked for are kept
+        static constexpr std::size_t MaxFlowFields = 16;
+
+        // Fields not asked for in this many ticks are dropped
+        static constexpr std::uint64_t FlowFieldIdleTicks = 600;
+
+        explicit PathfindingService(ThreadPool& InWorkers);
+
+        // Waits for this service's jobs, which write to it, to finish
+        ~PathfindingService();
+
+        PathfindingService(const PathfindingService&) = delete;
+        PathfindingService& operator=(const PathfindingService&) = delete;
+
+        // Callback runs on the main thread during a later Tick
+        void RequestPath(TilePoint Start, TilePoint Goal, PathCallback Callback);
+
+        // Main thread, once a frame, with the map's grid as it is now. Delivers finished paths, starts a graph
+        // rebuild or hands waiting requests to the workers, and starts updates of flow fields the map moved past.
+        void Tick(const TileCollisionGrid& Grid);
+
+        // The latest flow field towards Goal, or null until the first one is built. Asking keeps the field, and it
+        // is brought up to date in the background after the map changes, so it may trail the map by a few frames.
+        std::shared_ptr<const FlowField> GetFlowField(TilePoint Goal);
+
+        // Blocks until no job is queued or running; what they produced is delivered by the next Tick
+        void Wait();
+
+        std::size_t GetWaitingCount() const { return Waiting.size(); }
+        const PathfindingStats& GetStats() const { return Stats; }
+
+    private:
+        struct SolvedPath
+        {
+            PathResult Result;
+
+            // What it was found on, for the grid to cache it against
+            std::shared_ptr<const NavigationGraph> Graph;
+        };
+
+        struct FlowFieldEntry
+        {
+            std::shared_ptr<const FlowField> Field;
+            bool bBuilding = false;
+            std::uint64_t LastUsedTick = 0;
+        };
+
+        void Deliver(const PathKey& Key, const PathResult& Result);
+        void StartRebuild(const TileCollisionGrid& Grid);
+        void Dispatch(std::vector<PathKey> Batch);
+        void UpdateFlowFields(const TileCollisionGrid& Grid);
+        void StartFlowField(TilePoint Goal, FlowFieldEntry& Entry, const TileCollisionGrid& Grid);
+
+        // Main thread
+        std::unordered_map<PathKey, std::vector<PathCallback>, PathKeyHash> Waiting;
+        std::vector<PathKey> Pending;
+        PathCache Cache;
+        std::shared_ptr<const NavigationGraph> Graph;
+        bool bRebuilding = false;
+        std::unordered_map<TilePoint, FlowFieldEntry, TilePointHash> FlowFields;
+        std::uint64_t TickCount = 0;
+        PathfindingStats Stats;
+
+        // Written by the workers
+        mutable std::mutex Mutex;
+        std::condition_variable JobsFinished;
+        std::vector<SolvedPath> Solved;
+        std::shared_ptr<const NavigationGraph> BuiltGraph;
+        double BuiltGraphMs = 0.0;
+        std::vector<std::pair<std::shared_ptr<const FlowField>, double>> BuiltFlowFields;
+        std::size_t RunningJobs = 0;
+
+        ThreadPool& Workers;
+    };
+}
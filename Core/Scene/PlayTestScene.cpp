@@ -1,5 +1,4 @@
 #include "PlayTestScene.h"
-#include "SceneLoader.h"
 #include "../World/World.h"
 #include "../World/WorldObject.h"
 #include "../Components/CameraComponent.h"
@@ -12,8 +11,6 @@
 #include "../SystemsRegistry.hpp"
 #include "../Systems/SceneManagerSystem.h"
 #include "imgui.h"
-#include <thread>
-#include <chrono>
 
 namespace Core
 {
@@ -26,14 +23,6 @@ namespace Core
     void PlayTestScene::OnLoad()
     {
         Scene::OnLoad();
-
-        SceneLoader Loader(Context);
-        Task<std::vector<AssetId>> LoadTask = Loader.LoadScene(SceneName, World);
-        while (!LoadTask.await_ready())
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        }
-
         SpawnPlayer();
     }
 
@@ -51,16 +40,20 @@ namespace Core
     void PlayTestScene::RenderUI()
     {
         ImGui::SetNextWindowPos(ImVec2(10, 10));
-        ImGui::SetNextWindowSize(ImVec2(150, 50));
+        ImGui::SetNextWindowSize(ImVec2(150, 75));
         ImGui::Begin("PlayTest", nullptr, ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoCollapse);
 
-        if (ImGui::Button("Exit (Esc)", ImVec2(-1, 0)) || ImGui::IsKeyPressed(ImGuiKey_Escape))
+        std::shared_ptr<SceneManagerSystem> SceneManager = Context->SystemsRegistry->GetCoreSystem<SceneManagerSystem>();
+
+        // A fresh copy of this scene is handed every asset the current one holds, so restarting reads nothing again
+        if (ImGui::Button("Restart", ImVec2(-1, 0)) && SceneManager)
         {
-            if (std::shared_ptr<SceneManagerSystem> SceneManager = Context->SystemsRegistry->GetCoreSystem<
-                SceneManagerSystem>())
-            {
-                SceneManager->RequestPop();
-            }
+            SceneManager->RequestReplace<PlayTestScene>(SceneName);
+        }
+
+        if ((ImGui::Button("Exit (Esc)", ImVec2(-1, 0)) || ImGui::IsKeyPressed(ImGuiKey_Escape)) && SceneManager)
+        {
+            SceneManager->RequestPop();
         }
 
         ImGui::End();
@@ -79,10 +72,11 @@ namespace Core
             return;
 
         std::shared_ptr<TransformComponent> SpawnTransform = SpawnPoint->Components().Get<TransformComponent>();
-        sf::Vector2f SpawnPosition = SpawnTransform ? SpawnTransform->Position : sf::Vector2f(0.0f, 0.0f);
+        sf::Vector2f SpawnPosition = SpawnTransform ? SpawnTransform->GetWorldPosition() : sf::Vector2f(0.0f, 0.0f);
 
         PlayerController = World.Objects().CreateObject();
         PlayerController->SetName("PlayerController");
+        PlayerController->SetTickPolicy(TickPolicy::AlwaysFull);
         PlayerController->Components().Add<TransformComponent>();
         PlayerController->Components().Add<PlayerControllerComponent>();
         std::shared_ptr<PlayerControllerComponent> Controller = PlayerController->Components().Get<
@@ -90,29 +84,28 @@ namespace Core
 
         PlayerPawn = World.Objects().CreateObject();
         PlayerPawn->SetName("PlayerPawn");
+        PlayerPawn->SetTickPolicy(TickPolicy::AlwaysFull);
         PlayerPawn->Components().Add<TransformComponent>();
         std::shared_ptr<TransformComponent> PawnTransform = PlayerPawn->Components().Get<TransformComponent>();
-        PawnTransform->Position = SpawnPosition;
+        PawnTransform->SetPosition(SpawnPosition);
         PlayerPawn->Components().Add<SpriteComponent>();
         PlayerPawn->Components().Add<PlayerCharacterComponent>();
         PlayerPawn->Components().Add<CameraComponent>();
         std::shared_ptr<CameraComponent> Camera = PlayerPawn->Components().Get<CameraComponent>();
         Camera->SetZoom(0.25f);
+        World.SetActiveCamera(Camera);
 
         Controller->Possess(PlayerPawn);
     }
 
     WorldObject* PlayTestScene::FindPlayerSpawnPoint()
     {
-        const std::vector<std::shared_ptr<WorldObject>>& AllObjects = World.Objects().GetAll();
-        for (const std::shared_ptr<WorldObject>& Object : AllObjects)
+        const ComponentQuery<PlayerSpawnComponent> Spawns = World.Query<PlayerSpawnComponent>();
+        if (Spawns.empty())
         {
-            if (Object->Components().Get<PlayerSpawnComponent>())
-            {
-                return Object.get();
-            }
+            return nullptr;
         }
-        return nullptr;
+        return std::get<0>(*Spawns.begin())->GetOwner();
     }
 
     void PlayTestScene::CreateDefaultSpawnPoint()
@@ -121,7 +114,7 @@ namespace Core
         SpawnPoint->SetName("DefaultPlayerSpawn");
         SpawnPoint->Components().Add<TransformComponent>();
         std::shared_ptr<TransformComponent> Transform = SpawnPoint->Components().Get<TransformComponent>();
-        Transform->Position = sf::Vector2f(0.0f, 0.0f);
+        Transform->SetPosition(sf::Vector2f(0.0f, 0.0f));
         SpawnPoint->Components().Add<PlayerSpawnComponent>();
     }
 }
@@ -18,6 +18,7 @@ namespace Core
         void OnLoad() override;
         void PreRender() override;
         void RenderUI() override;
+        std::string GetManifestName() const override { return SceneName; }
 
     private:
         void SpawnPlayer();
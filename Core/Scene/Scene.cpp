@@ -1,10 +1,11 @@
 #include "Scene.h"
 
-#include <cstdio>
 
 #include "../Engine.h"
 #include "../Systems/AssetRegistrySystem.h"
 #include "../Scene/SceneLoader.h"
+#include "../Scene/SceneAssetHandoff.h"
+#include "../Log/Log.h"
 
 namespace Core
 {
@@ -15,6 +16,15 @@ namespace Core
     {
     }
 
+    Scene::~Scene()
+    {
+        // Streamed completions capture this scene; make sure none of them outlive it
+        if (LoadCancellation)
+        {
+            LoadCancellation->Cancel();
+        }
+    }
+
     void Scene::Tick(float DeltaTimeS)
     {
         World.Tick(DeltaTimeS);
@@ -29,36 +39,55 @@ namespace Core
 
     Task<> Scene::Load()
     {
-        std::printf("Scene '%s' loading...\n", Name.c_str());
+        Log::Verbose(ELogCategory::Scene, "Scene '%s' loading...", Name.c_str());
+
+        LoadCancellation = std::make_shared<AssetCancellationToken>();
 
         SceneLoader Loader(Context);
-        LoadedAssets = co_await Loader.LoadScene(Name, World);
+        LoadedAssets = co_await Loader.LoadScene(GetManifestName(), World, LoadCancellation, [this](AssetId Id)
+        {
+            StreamedAssets.push_back(Id);
+        });
 
-        std::printf("Scene '%s' loaded %zu assets\n", Name.c_str(), LoadedAssets.size());
+        Log::Info(ELogCategory::Scene, "Scene '%s' loaded %zu assets", Name.c_str(), LoadedAssets.size());
         OnLoad();
         co_return;
     }
 
     void Scene::Enter()
     {
-        std::printf("Scene '%s' entering...\n", Name.c_str());
+        Log::Verbose(ELogCategory::Scene, "Scene '%s' entering...", Name.c_str());
         OnEnter();
     }
 
-    void Scene::Exit()
+    void Scene::Exit(const Scene* Successor)
     {
-        std::printf("Scene '%s' exiting...\n", Name.c_str());
+        Log::Verbose(ELogCategory::Scene, "Scene '%s' exiting...", Name.c_str());
 
         OnExit();
 
-        auto AssetRegistry = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
-        for (AssetId Id : LoadedAssets)
+        // Anything still streaming in is dropped rather than stored for a scene that is gone
+        if (LoadCancellation)
         {
-            AssetRegistry->Release(Id);
+            LoadCancellation->Cancel();
         }
 
+        auto AssetRegistry = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
+        std::vector<AssetId> Outgoing = GetAssetIds();
+        const SceneAssetHandoff Handoff = HandOffSceneAssets(*AssetRegistry, Outgoing,
+                                                             Successor ? Successor->GetAssetIds() : std::vector<AssetId>{});
+
         LoadedAssets.clear();
+        StreamedAssets.clear();
 
-        std::printf("Scene '%s' exited and released assets\n", Name.c_str());
+        Log::Info(ELogCategory::Scene, "Scene '%s' exited: %zu assets kept for '%s', %zu released", Name.c_str(), Handoff.Kept,
+                  Successor ? Successor->Name.c_str() : "none", Handoff.Released);
+    }
+
+    std::vector<AssetId> Scene::GetAssetIds() const
+    {
+        std::vector<AssetId> Ids = LoadedAssets;
+        Ids.insert(Ids.end(), StreamedAssets.begin(), StreamedAssets.end());
+        return Ids;
     }
 }
@@ -9,6 +9,7 @@
 #include "../Interfaces/IRenderable.hpp"
 #include "../Interfaces/ITickable.hpp"
 #include "../Assets/AssetId.hpp"
+#include "../Assets/AssetCancellationToken.hpp"
 #include "../Async/Task.hpp"
 
 namespace Core
@@ -17,6 +18,7 @@ namespace Core
     {
     public:
         Scene(std::shared_ptr<EngineContext> Context, std::string Name);
+        virtual ~Scene();
         const std::string& GetName() { return Name; }
         Core::World& GetWorld() { return World; }
         const Core::World& GetWorld() const { return World; }
@@ -27,7 +29,18 @@ namespace Core
 
         Task<> Load();
         void Enter();
-        void Exit();
+
+        // Successor is the scene taking over, already loaded; assets both scenes use stay resident across the swap
+        void Exit(const Scene* Successor = nullptr);
+
+        // Every asset this scene holds a reference on, including those streamed in so far
+        virtual std::vector<AssetId> GetAssetIds() const;
+
+        // Scene file under Game/Assets/Scenes to load, defaults to the scene name
+        virtual std::string GetManifestName() const { return Name; }
+
+        // Non-critical assets that have finished streaming in since Load returned
+        std::size_t GetStreamedAssetCount() const { return StreamedAssets.size(); }
 
     protected:
         virtual void OnLoad()
@@ -53,6 +66,8 @@ namespace Core
     protected:
         std::shared_ptr<EngineContext> Context;
         std::vector<AssetId> LoadedAssets;
+        std::vector<AssetId> StreamedAssets;
+        std::shared_ptr<AssetCancellationToken> LoadCancellation;
         std::string Name;
         World World;
     };
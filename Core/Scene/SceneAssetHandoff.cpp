@@ -0,0 +1,49 @@
+#include "SceneAssetHandoff.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "../Systems/AssetRegistrySystem.h"
+
+namespace Core
+{
+    namespace
+    {
+        std::vector<int> ToSortedUnique(const std::vector<AssetId>& Ids)
+        {
+            std::vector<int> Sorted;
+            Sorted.reserve(Ids.size());
+            std::transform(Ids.begin(), Ids.end(), std::back_inserter(Sorted), [](AssetId Id)
+            {
+                return Id.Get();
+            });
+            std::sort(Sorted.begin(), Sorted.end());
+            Sorted.erase(std::unique(Sorted.begin(), Sorted.end()), Sorted.end());
+            return Sorted;
+        }
+    }
+
+    SceneAssetHandoff HandOffSceneAssets(AssetRegistrySystem& Registry, std::vector<AssetId>& Outgoing,
+                                         const std::vector<AssetId>& Incoming)
+    {
+        const std::vector<int> Before = ToSortedUnique(Outgoing);
+        const std::vector<int> After = ToSortedUnique(Incoming);
+
+        std::vector<int> Shared;
+        std::set_intersection(Before.begin(), Before.end(), After.begin(), After.end(), std::back_inserter(Shared));
+
+        SceneAssetHandoff Handoff;
+        Handoff.Kept = Shared.size();
+        Handoff.Loaded = After.size() - Shared.size();
+        Handoff.Released = Before.size() - Shared.size();
+
+        // Every entry is one reference; shared assets survive because Incoming took its own before this runs
+        for (AssetId Id : Outgoing)
+        {
+            Registry.Release(Id);
+        }
+        Outgoing.clear();
+
+        return Handoff;
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../Assets/AssetId.hpp"
+
+namespace Core
+{
+    class AssetRegistrySystem;
+
+    struct SceneAssetHandoff
+    {
+        // Held by both scenes, never dropped to zero references during the swap
+        std::size_t Kept = 0;
+
+        // Only in the incoming scene
+        std::size_t Loaded = 0;
+
+        // Only in the outgoing scene, no longer needed
+        std::size_t Released = 0;
+    };
+
+    // Releases Outgoing's references. Call once Incoming holds its own, so assets in both sets stay resident.
+    SceneAssetHandoff HandOffSceneAssets(AssetRegistrySystem& Registry, std::vector<AssetId>& Outgoing,
+                                         const std::vector<AssetId>& Incoming);
+}
@@ -1,7 +1,6 @@
 #include "SceneLoader.h"
 
 #include <unordered_set>
-#include <fstream>
 
 #include "../EngineContext.hpp"
 #include "../World/World.h"
@@ -9,13 +8,18 @@
 #include "../World/WorldEnvironment.h"
 #include "../Assets/AssetLoader.h"
 #include "../Assets/AssetManifest.h"
+#include "../Assets/AssetPack.h"
+#include "../Assets/CookedJsonCache.h"
 #include "../Assets/DataAsset.h"
+#include "../Assets/MappedFile.h"
+#include "../Systems/AssetPipelineSystem.h"
 #include "../Systems/AssetRegistrySystem.h"
 #include "../Systems/DataAssetRegistrySystem.h"
 #include "../Systems/WorldObjectSystem.h"
 #include "../Utils/StringUtils.h"
 #include "../SystemsRegistry.hpp"
 #include "../ThirdParty/json.hpp"
+#include "../Log/Log.h"
 
 namespace Core
 {
@@ -26,32 +30,17 @@ namespace Core
 
     SceneLoader::~SceneLoader() = default;
 
-    Task<std::vector<AssetId>> SceneLoader::LoadScene(const std::string& SceneName, World& TargetWorld)
+    Task<std::vector<AssetId>> SceneLoader::LoadScene(const std::string& SceneName, World& TargetWorld,
+                                                      std::shared_ptr<const AssetCancellationToken> Token,
+                                                      std::function<void(AssetId)> OnAssetStreamed)
     {
-        auto AssetRegistry = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
-        auto DataAssetRegistry = Context->SystemsRegistry->GetCoreSystem<DataAssetRegistrySystem>();
-        Loader = std::make_unique<AssetLoader>(AssetRegistry, DataAssetRegistry);
-
-        std::string ManifestPath = "Game/Assets/Scenes/" + ToLowercase(SceneName) + ".json";
-
-        nlohmann::json SceneJson;
-        std::ifstream File(ManifestPath);
-        if (File.is_open())
-        {
-            try
-            {
-                SceneJson = nlohmann::json::parse(File);
-            }
-            catch (const nlohmann::json::exception& E)
-            {
-                std::printf("Failed to parse scene %s: %s\n", ManifestPath.c_str(), E.what());
-            }
-        }
+        CreateLoader(std::move(Token));
 
+        const nlohmann::json SceneJson = ReadSceneJson(SceneName);
         AssetManifest Manifest = AssetManifest::FromJson(SceneJson, "Game/Assets/Scenes/");
 
         QueueAssetsFromManifest(Manifest);
-        std::vector<AssetId> LoadedAssets = co_await Loader->LoadAllAsync();
+        std::vector<AssetId> LoadedAssets = co_await Loader->LoadQueuedAsync(AssetLoader::LoadPriority::Critical);
 
         SpawnObjectsIntoWorld(Manifest, TargetWorld);
 
@@ -60,22 +49,71 @@ namespace Core
             TargetWorld.SetEnvironment(WorldEnvironment::FromJson(SceneJson["worldEnvironment"]));
         }
 
+        const std::size_t StreamedCount = Loader->StreamQueued(std::move(OnAssetStreamed));
+        if (StreamedCount > 0)
+        {
+            Log::Info(ELogCategory::Scene, "Scene '%s' streaming %zu assets", SceneName.c_str(), StreamedCount);
+        }
+
         co_return LoadedAssets;
     }
 
+    Task<std::vector<AssetId>> SceneLoader::PrefetchScene(const std::string& SceneName,
+                                                          std::shared_ptr<const AssetCancellationToken> Token,
+                                                          AssetLoader::LoadPriority Priority)
+    {
+        CreateLoader(std::move(Token));
+
+        // At the default, everything, objects included, waits behind any real load at every pipeline stage
+        Loader->SetPriorityFloor(Priority);
+
+        const AssetManifest Manifest = AssetManifest::FromJson(ReadSceneJson(SceneName), "Game/Assets/Scenes/");
+        QueueAssetsFromManifest(Manifest);
+
+        co_return co_await Loader->LoadQueuedAsync(AssetLoader::LoadPriority::Background);
+    }
+
+    void SceneLoader::CreateLoader(std::shared_ptr<const AssetCancellationToken> Token)
+    {
+        auto AssetRegistry = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
+        auto DataAssetRegistry = Context->SystemsRegistry->GetCoreSystem<DataAssetRegistrySystem>();
+        auto Pipeline = Context->SystemsRegistry->GetCoreSystem<AssetPipelineSystem>();
+        Loader = std::make_unique<AssetLoader>(AssetRegistry, DataAssetRegistry, Pipeline);
+        Loader->SetCancellationToken(std::move(Token));
+    }
+
+    nlohmann::json SceneLoader::ReadSceneJson(const std::string& SceneName) const
+    {
+        const std::string ManifestPath = "Game/Assets/Scenes/" + ToLowercase(SceneName) + ".json";
+
+        // Parse failures are reported by the cache; the scene then loads empty
+        std::optional<nlohmann::json> SceneJson;
+        const AssetPack* Pack = Context->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>()->GetMountedPack();
+        if (std::optional<AssetPackBlob> Blob = Pack ? Pack->Read(ManifestPath) : std::nullopt)
+        {
+            SceneJson = CookedJsonCache::Load(ManifestPath, Blob->Bytes);
+        }
+        else if (std::unique_ptr<MappedFile> File = MappedFile::Open(ManifestPath))
+        {
+            SceneJson = CookedJsonCache::Load(ManifestPath, File->GetBytes());
+        }
+
+        return SceneJson.value_or(nlohmann::json());
+    }
+
     void SceneLoader::QueueAssetsFromManifest(const AssetManifest& Manifest)
     {
         for (const auto& TextureEntry : Manifest.Textures)
         {
-            Loader->QueueTexture(TextureEntry.Path);
+            Loader->QueueTexture(TextureEntry.Path, TextureEntry.Priority);
         }
         for (const auto& FontEntry : Manifest.Fonts)
         {
-            Loader->QueueFont(FontEntry.Path, FontEntry.Size);
+            Loader->QueueFont(FontEntry.Path, FontEntry.Size, FontEntry.Priority);
         }
         for (const auto& SoundEntry : Manifest.Sounds)
         {
-            Loader->QueueSound(SoundEntry.Path);
+            Loader->QueueSound(SoundEntry.Path, SoundEntry.Priority);
         }
 
         std::unordered_set<std::string> ObjectsToLoad;
@@ -1,15 +1,19 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "../Async/Task.hpp"
 #include "../Assets/AssetId.hpp"
+#include "../Assets/AssetLoader.h"
+#include "../ThirdParty/json.hpp"
 
 namespace Core
 {
     struct EngineContext;
+    class AssetCancellationToken;
     struct AssetManifest;
     class World;
 
@@ -19,13 +23,26 @@ namespace Core
         SceneLoader(std::shared_ptr<EngineContext> Context);
         ~SceneLoader();
 
-        Task<std::vector<AssetId>> LoadScene(const std::string& SceneName, World& TargetWorld);
+        // Returns once critical assets are resident and objects are spawned; the rest stream in afterwards and are
+        // reported through OnAssetStreamed on the main thread. Firing Token drops whatever is still in flight.
+        Task<std::vector<AssetId>> LoadScene(const std::string& SceneName, World& TargetWorld,
+                                             std::shared_ptr<const AssetCancellationToken> Token = nullptr,
+                                             std::function<void(AssetId)> OnAssetStreamed = nullptr);
+
+        // Loads a scene's DataAssets, textures, fonts and sounds at no higher than Priority without spawning anything.
+        // The returned ids are references the caller owns.
+        Task<std::vector<AssetId>> PrefetchScene(const std::string& SceneName,
+                                                 std::shared_ptr<const AssetCancellationToken> Token = nullptr,
+                                                 AssetLoader::LoadPriority Priority = AssetLoader::LoadPriority::Background);
 
     private:
+        void CreateLoader(std::shared_ptr<const AssetCancellationToken> Token);
+        nlohmann::json ReadSceneJson(const std::string& SceneName) const;
+
         void QueueAssetsFromManifest(const AssetManifest& Manifest);
         void SpawnObjectsIntoWorld(const AssetManifest& Manifest, World& TargetWorld);
 
         std::shared_ptr<EngineContext> Context;
-        std::unique_ptr<class AssetLoader> Loader;
+        std::unique_ptr<AssetLoader> Loader;
     };
 }
@@ -0,0 +1,401 @@
+#include "AssetPipelineSystem.h"
+
+#include <algorithm>
+
+#include "AssetRegistrySystem.h"
+#include "../EngineContext.hpp"
+#include "../SystemsRegistry.hpp"
+#include "../Log/Log.h"
+
+namespace Core
+{
+    namespace
+    {
+        std::size_t DefaultDecodeConcurrency()
+        {
+            // Leave the main thread and an IO worker a core each
+            const unsigned int HardwareThreads = std::thread::hardware_concurrency();
+            return HardwareThreads > 2 ? HardwareThreads - 2 : 1;
+        }
+    }
+
+    AssetPipelineSystem::AssetPipelineSystem(std::shared_ptr<EngineContext> InContext)
+        : CoreSystem("AssetPipelineSystem", Type, std::move(InContext))
+          , Settings{.DecodeConcurrency = DefaultDecodeConcurrency()}
+          , DecodeWorkers(Settings.DecodeConcurrency)
+          , FileReader(Settings.IoQueueDepth, Settings.IoConcurrency)
+          , IoWorkers(Settings.IoConcurrency)
+    {
+    }
+
+    void AssetPipelineSystem::Tick(float DeltaTimeS)
+    {
+        ProcessUploads(Settings.UploadBudgetMs);
+    }
+
+    void AssetPipelineSystem::Shutdown()
+    {
+        // Nobody will pump uploads after this; resolve waiters so loader coroutines can unwind
+        std::vector<std::shared_ptr<Job>> Abandoned;
+        {
+            std::lock_guard Lock(MainThreadMutex);
+            while (std::shared_ptr<Job> PendingJob = Uploads.Pop())
+            {
+                Abandoned.push_back(std::move(PendingJob));
+            }
+            StreamingUploads = {};
+            StreamingCompletions.clear();
+        }
+
+        for (std::shared_ptr<Job>& AbandonedJob : Abandoned)
+        {
+            Finish(std::move(AbandonedJob), nullptr, "Asset pipeline shut down");
+        }
+
+        CoreSystem::Shutdown();
+    }
+
+    AssetLoader::LoadAwaiter AssetPipelineSystem::Submit(const AssetLoader::LoadRequest& Request, DecodeFunction Decode,
+                                                         UploadFunction Upload)
+    {
+        auto NewJob = std::make_shared<Job>();
+        NewJob->Request = Request;
+        NewJob->Decode = std::move(Decode);
+        NewJob->Upload = std::move(Upload);
+
+        NewJob->Waiter = std::make_shared<AssetLoader::PendingLoad>();
+
+        AssetLoader::LoadAwaiter Awaiter{NewJob->Waiter};
+        Enqueue(std::move(NewJob));
+        return Awaiter;
+    }
+
+    void AssetPipelineSystem::SubmitStreaming(const AssetLoader::LoadRequest& Request, DecodeFunction Decode,
+                                              UploadFunction Upload, CompletionFunction OnComplete)
+    {
+        auto NewJob = std::make_shared<Job>();
+        NewJob->Request = Request;
+        NewJob->Decode = std::move(Decode);
+        NewJob->Upload = std::move(Upload);
+        NewJob->OnComplete = std::move(OnComplete);
+
+        Enqueue(std::move(NewJob));
+    }
+
+    void AssetPipelineSystem::Enqueue(std::shared_ptr<Job> NewJob)
+    {
+        AddPending(Stats.Io);
+
+        const std::size_t Priority = GetPriorityIndex(*NewJob);
+        IoWorkers.Enqueue([this, NewJob = std::move(NewJob)]()
+        {
+            RunIo(NewJob);
+        }, Priority);
+    }
+
+    void AssetPipelineSystem::RunIo(std::shared_ptr<Job> PendingJob)
+    {
+        if (PendingJob->IsCancelled())
+        {
+            Cancel(PendingJob, Stats.Io);
+            return;
+        }
+
+        const Clock::time_point Start = Clock::now();
+
+        // The pack is mounted once during startup, before any loads are submitted
+        const AssetPack* Pack = GetContext()->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>()->GetMountedPack();
+
+        if (std::optional<AssetPackBlob> Bytes = Pack ? Pack->Read(PendingJob->Request.Path) : std::nullopt)
+        {
+            FinishIo(std::move(PendingJob), std::move(Bytes), Start);
+            return;
+        }
+
+        // Completes on the reader's thread; this worker moves straight on to the next request
+        std::string Path = PendingJob->Request.Path;
+        FileReader.Read(std::move(Path), [this, PendingJob = std::move(PendingJob), Start](
+            std::shared_ptr<std::vector<std::byte>> Storage) mutable
+        {
+            std::optional<AssetPackBlob> Bytes;
+            if (Storage)
+            {
+                Bytes = AssetPackBlob{.Bytes = *Storage, .Storage = std::move(Storage)};
+            }
+            FinishIo(std::move(PendingJob), std::move(Bytes), Start);
+        });
+    }
+
+    void AssetPipelineSystem::FinishIo(std::shared_ptr<Job> PendingJob, std::optional<AssetPackBlob> Bytes,
+                                       Clock::time_point Start)
+    {
+        RecordStage(Stats.Io, Start, Bytes.has_value());
+
+        if (!Bytes)
+        {
+            Finish(std::move(PendingJob), nullptr, "Failed to read asset");
+            return;
+        }
+
+        PendingJob->Bytes = std::move(*Bytes);
+
+        AddPending(Stats.Decode);
+
+        const std::size_t Priority = GetPriorityIndex(*PendingJob);
+        DecodeWorkers.Enqueue([this, PendingJob = std::move(PendingJob)]()
+        {
+            RunDecode(PendingJob);
+        }, Priority);
+    }
+
+    void AssetPipelineSystem::RunDecode(std::shared_ptr<Job> PendingJob)
+    {
+        if (PendingJob->IsCancelled())
+        {
+            Cancel(PendingJob, Stats.Decode);
+            return;
+        }
+
+        const Clock::time_point Start = Clock::now();
+
+        PendingJob->Decoded = PendingJob->Decode(PendingJob->Request, PendingJob->Bytes.Bytes);
+
+        // Decoders copy what they keep, so the raw bytes can go now rather than wait in the upload queue
+        PendingJob->Bytes = {};
+
+        RecordStage(Stats.Decode, Start, PendingJob->Decoded != nullptr);
+
+        if (!PendingJob->Decoded)
+        {
+            Finish(std::move(PendingJob), nullptr, "Failed to decode asset");
+            return;
+        }
+
+        if (!PendingJob->Upload)
+        {
+            std::shared_ptr<void> Decoded = std::move(PendingJob->Decoded);
+            Finish(std::move(PendingJob), std::move(Decoded), nullptr);
+            return;
+        }
+
+        AddPending(Stats.Upload);
+
+        std::lock_guard Lock(MainThreadMutex);
+        MainThreadQueue& Queue = PendingJob->OnComplete ? StreamingUploads : Uploads;
+        Queue.Push(std::move(PendingJob));
+    }
+
+    void AssetPipelineSystem::RunUpload(std::shared_ptr<Job> PendingJob)
+    {
+        if (PendingJob->IsCancelled())
+        {
+            Cancel(PendingJob, Stats.Upload);
+            return;
+        }
+
+        const Clock::time_point Start = Clock::now();
+        std::shared_ptr<void> Uploaded = PendingJob->Upload(std::move(PendingJob->Decoded));
+        RecordStage(Stats.Upload, Start, Uploaded != nullptr);
+
+        Finish(std::move(PendingJob), std::move(Uploaded), "Failed to upload asset");
+    }
+
+    std::size_t AssetPipelineSystem::ProcessUploads(float BudgetMs, bool bIncludeStreaming)
+    {
+        const Clock::time_point FrameStart = Clock::now();
+        const auto Budget = std::chrono::duration<float, std::milli>(BudgetMs);
+        const auto BackgroundBudget = std::chrono::duration<float, std::milli>(
+            std::min(Settings.BackgroundUploadBudgetMs, BudgetMs));
+
+        std::size_t Completed = 0;
+        while (Completed == 0 || Clock::now() - FrameStart < Budget)
+        {
+            const std::size_t LevelCount = Clock::now() - FrameStart < BackgroundBudget
+                ? AssetLoader::LoadPriorityCount
+                : AssetLoader::LoadPriorityCount - 1;
+
+            std::shared_ptr<Job> Upload;
+            std::shared_ptr<Job> Completion;
+            {
+                std::lock_guard Lock(MainThreadMutex);
+                Upload = Uploads.Pop(LevelCount);
+                if (!Upload && bIncludeStreaming)
+                {
+                    // Completions are cheap and make assets usable, so they go ahead of further streamed uploads
+                    if (!StreamingCompletions.empty())
+                    {
+                        Completion = std::move(StreamingCompletions.front());
+                        StreamingCompletions.pop_front();
+                    }
+                    else
+                    {
+                        Upload = StreamingUploads.Pop(LevelCount);
+                    }
+                }
+            }
+
+            if (Upload)
+            {
+                RunUpload(std::move(Upload));
+            }
+            else if (Completion)
+            {
+                if (Completion->IsCancelled())
+                {
+                    std::lock_guard Lock(StatsMutex);
+                    ++Stats.Cancelled;
+                }
+                else
+                {
+                    Completion->OnComplete(Completion->Result);
+                }
+            }
+            else
+            {
+                break;
+            }
+
+            ++Completed;
+        }
+
+        return Completed;
+    }
+
+    void AssetPipelineSystem::Finish(std::shared_ptr<Job> CompletedJob, std::shared_ptr<void> Data, const char* ErrorMessage)
+    {
+        AssetLoader::LoadedAsset& Result = CompletedJob->Result;
+        Result.Type = CompletedJob->Request.Type;
+        Result.Path = CompletedJob->Request.Path;
+        Result.Success = Data != nullptr;
+        Result.Data = std::move(Data);
+        if (!Result.Success && ErrorMessage)
+        {
+            Result.ErrorMessage = ErrorMessage;
+        }
+
+        if (CompletedJob->OnComplete)
+        {
+            std::lock_guard Lock(MainThreadMutex);
+            StreamingCompletions.push_back(std::move(CompletedJob));
+            return;
+        }
+
+        CompletedJob->Waiter->Complete(std::move(Result));
+    }
+
+    void AssetPipelineSystem::Cancel(const std::shared_ptr<Job>& CancelledJob, AssetStageStats& Stage)
+    {
+        {
+            std::lock_guard Lock(StatsMutex);
+            --Stage.Pending;
+            ++Stats.Cancelled;
+        }
+
+        // Streamed requests have nobody waiting; awaited ones still need resuming
+        if (CancelledJob->OnComplete)
+        {
+            return;
+        }
+
+        AssetLoader::LoadedAsset Result{.Type = CancelledJob->Request.Type,
+                                        .Path = CancelledJob->Request.Path,
+                                        .Data = nullptr,
+                                        .Success = false,
+                                        .ErrorMessage = "Cancelled",
+                                        .Cancelled = true};
+        CancelledJob->Waiter->Complete(std::move(Result));
+    }
+
+    void AssetPipelineSystem::SetSettings(const AssetPipelineSettings& InSettings)
+    {
+        Settings = InSettings;
+        IoWorkers.SetMaxConcurrency(Settings.IoConcurrency);
+        FileReader.SetFallbackConcurrency(Settings.IoConcurrency);
+        DecodeWorkers.SetMaxConcurrency(Settings.DecodeConcurrency);
+    }
+
+    AssetPipelineStats AssetPipelineSystem::GetStats() const
+    {
+        std::lock_guard Lock(StatsMutex);
+        return Stats;
+    }
+
+    void AssetPipelineSystem::ResetStats()
+    {
+        std::lock_guard Lock(StatsMutex);
+        for (AssetStageStats* Stage : {&Stats.Io, &Stats.Decode, &Stats.Upload})
+        {
+            const std::size_t Pending = Stage->Pending;
+            *Stage = {};
+            Stage->Pending = Pending;
+            Stage->PeakPending = Pending;
+        }
+        Stats.Cancelled = 0;
+    }
+
+    void AssetPipelineSystem::LogStats() const
+    {
+        const AssetPipelineStats Snapshot = GetStats();
+
+        const auto LogStage = [](const char* Name, const AssetStageStats& Stage)
+        {
+            Log::Info(ELogCategory::Assets, "  %-6s %4llu done, %2llu failed, avg %6.2fms, max %6.2fms, total %8.2fms, peak queue %zu",
+                      Name,
+                      static_cast<unsigned long long>(Stage.Processed),
+                      static_cast<unsigned long long>(Stage.Failed),
+                      Stage.GetAverageMs(), Stage.MaxMs, Stage.TotalMs, Stage.PeakPending);
+        };
+
+        Log::Info(ELogCategory::Assets, "Asset pipeline stats (%llu cancelled):", static_cast<unsigned long long>(Snapshot.Cancelled));
+        LogStage("IO", Snapshot.Io);
+        LogStage("Decode", Snapshot.Decode);
+        LogStage("Upload", Snapshot.Upload);
+    }
+
+    void AssetPipelineSystem::RecordStage(AssetStageStats& Stage, Clock::time_point Start, bool bSuccess)
+    {
+        const double ElapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - Start).count();
+
+        std::lock_guard Lock(StatsMutex);
+        ++Stage.Processed;
+        if (!bSuccess)
+        {
+            ++Stage.Failed;
+        }
+        Stage.TotalMs += ElapsedMs;
+        Stage.MaxMs = std::max(Stage.MaxMs, ElapsedMs);
+        --Stage.Pending;
+    }
+
+    void AssetPipelineSystem::AddPending(AssetStageStats& Stage)
+    {
+        std::lock_guard Lock(StatsMutex);
+        ++Stage.Pending;
+        Stage.PeakPending = std::max(Stage.PeakPending, Stage.Pending);
+    }
+
+    std::size_t AssetPipelineSystem::GetPriorityIndex(const Job& PendingJob)
+    {
+        return std::min(static_cast<std::size_t>(PendingJob.Request.Priority), AssetLoader::LoadPriorityCount - 1);
+    }
+
+    void AssetPipelineSystem::MainThreadQueue::Push(std::shared_ptr<Job> PendingJob)
+    {
+        Levels[GetPriorityIndex(*PendingJob)].push_back(std::move(PendingJob));
+    }
+
+    std::shared_ptr<AssetPipelineSystem::Job> AssetPipelineSystem::MainThreadQueue::Pop(std::size_t LevelCount)
+    {
+        for (std::size_t Index = 0; Index < std::min(LevelCount, Levels.size()); ++Index)
+        {
+            std::deque<std::shared_ptr<Job>>& Level = Levels[Index];
+            if (!Level.empty())
+            {
+                std::shared_ptr<Job> PendingJob = std::move(Level.front());
+                Level.pop_front();
+                return PendingJob;
+            }
+        }
+        return nullptr;
+    }
+}
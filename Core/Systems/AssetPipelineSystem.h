@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+
+#include "CoreSystem.hpp"
+#include "../Assets/AssetLoader.h"
+#include "../Assets/AssetPack.h"
+#include "../Async/AsyncFileReader.h"
+#include "../Async/Task.hpp"
+#include "../Async/ThreadPool.h"
+
+namespace Core
+{
+    struct AssetPipelineSettings
+    {
+        std::size_t IoConcurrency = 2;
+
+        // Loose-file reads in flight at once through io_uring. Fixed at construction; IoConcurrency sizes the
+        // fallback thread pool where io_uring is unavailable.
+        std::size_t IoQueueDepth = 64;
+        std::size_t DecodeConcurrency = 4;
+
+        // Main-thread time spent on GPU uploads and streamed completions per frame. At least one item runs per frame regardless.
+        float UploadBudgetMs = 4.f;
+
+        // Background-priority uploads (prefetching) only run within the first part of that budget
+        float BackgroundUploadBudgetMs = 1.f;
+    };
+
+    struct AssetStageStats
+    {
+        std::uint64_t Processed = 0;
+        std::uint64_t Failed = 0;
+        double TotalMs = 0.0;
+        double MaxMs = 0.0;
+        std::size_t Pending = 0;
+        std::size_t PeakPending = 0;
+
+        double GetAverageMs() const { return Processed > 0 ? TotalMs / static_cast<double>(Processed) : 0.0; }
+    };
+
+    struct AssetPipelineStats
+    {
+        AssetStageStats Io;
+        AssetStageStats Decode;
+        AssetStageStats Upload;
+        std::uint64_t Cancelled = 0;
+    };
+
+    // Loads assets in three stages: raw bytes on IO workers, CPU decode on decode workers, and GPU upload on
+    // the main thread within a per-frame budget. Every stage serves higher-priority requests first. IO workers read
+    // packed assets directly and hand loose files to an AsyncFileReader, so many small reads share a few threads.
+    class AssetPipelineSystem : public CoreSystem
+    {
+    public:
+        static constexpr ECoreSystemType Type = ECoreSystemType::AssetPipelineSystem;
+
+        // Runs on a decode worker and must not touch the GPU. Returns nullptr on failure.
+        using DecodeFunction = std::function<std::shared_ptr<void>(const AssetLoader::LoadRequest&, std::span<const std::byte>)>;
+
+        // Runs on the main thread. Returns nullptr on failure.
+        using UploadFunction = std::function<std::shared_ptr<void>(std::shared_ptr<void>)>;
+
+        // Runs on the main thread during Tick, never for cancelled requests
+        using CompletionFunction = std::function<void(const AssetLoader::LoadedAsset&)>;
+
+        AssetPipelineSystem(std::shared_ptr<EngineContext> InContext);
+
+        void Tick(float DeltaTimeS) override;
+        void Shutdown() override;
+
+        // The awaiting coroutine is resumed with the result on whichever thread finishes the last stage
+        AssetLoader::LoadAwaiter Submit(const AssetLoader::LoadRequest& Request, DecodeFunction Decode,
+                                                     UploadFunction Upload = nullptr);
+
+        // Result is delivered to OnComplete on the main thread, within the per-frame budget
+        void SubmitStreaming(const AssetLoader::LoadRequest& Request, DecodeFunction Decode, UploadFunction Upload,
+                             CompletionFunction OnComplete);
+
+        // Main thread only. Returns the number of uploads and completions processed.
+        std::size_t ProcessUploads(float BudgetMs, bool bIncludeStreaming = true);
+
+        // For callers that block the main thread on a load: keeps uploads flowing until Task completes.
+        // Streamed results wait for the next Tick so they never land while a loader is still running off-thread.
+        template <typename T>
+        void PumpUntilReady(const Task<T>& LoadTask);
+
+        void SetSettings(const AssetPipelineSettings& InSettings);
+        const AssetPipelineSettings& GetSettings() const { return Settings; }
+
+        AssetPipelineStats GetStats() const;
+        void ResetStats();
+        void LogStats() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Job
+        {
+            AssetLoader::LoadRequest Request;
+            DecodeFunction Decode;
+            UploadFunction Upload;
+            CompletionFunction OnComplete;
+            std::shared_ptr<AssetLoader::PendingLoad> Waiter;
+
+            AssetPackBlob Bytes;
+            std::shared_ptr<void> Decoded;
+            AssetLoader::LoadedAsset Result;
+
+            bool IsCancelled() const { return Request.CancellationToken && Request.CancellationToken->IsCancelled(); }
+        };
+
+        // Main-thread work, one deque per priority
+        struct MainThreadQueue
+        {
+            std::array<std::deque<std::shared_ptr<Job>>, AssetLoader::LoadPriorityCount> Levels;
+
+            void Push(std::shared_ptr<Job> PendingJob);
+
+            // Only considers the first LevelCount priorities
+            std::shared_ptr<Job> Pop(std::size_t LevelCount = AssetLoader::LoadPriorityCount);
+        };
+
+        void Enqueue(std::shared_ptr<Job> NewJob);
+        void RunIo(std::shared_ptr<Job> PendingJob);
+        void FinishIo(std::shared_ptr<Job> PendingJob, std::optional<AssetPackBlob> Bytes, Clock::time_point Start);
+        void RunDecode(std::shared_ptr<Job> PendingJob);
+        void RunUpload(std::shared_ptr<Job> PendingJob);
+        void Finish(std::shared_ptr<Job> CompletedJob, std::shared_ptr<void> Data, const char* ErrorMessage);
+        void Cancel(const std::shared_ptr<Job>& CancelledJob, AssetStageStats& Stage);
+
+        void RecordStage(AssetStageStats& Stage, Clock::time_point Start, bool bSuccess);
+        void AddPending(AssetStageStats& Stage);
+
+        static std::size_t GetPriorityIndex(const Job& PendingJob);
+
+        AssetPipelineSettings Settings;
+
+        std::mutex MainThreadMutex;
+        MainThreadQueue Uploads;
+        MainThreadQueue StreamingUploads;
+        std::deque<std::shared_ptr<Job>> StreamingCompletions;
+
+        mutable std::mutex StatsMutex;
+        AssetPipelineStats Stats;
+
+        // Declared last so the workers are joined before the queues and stats their jobs touch go away. Destroyed in
+        // reverse: IO jobs stop feeding the reader, then the reader's completions finish handing off to decode.
+        ThreadPool DecodeWorkers;
+        AsyncFileReader FileReader;
+        ThreadPool IoWorkers;
+    };
+
+    template <typename T>
+    void AssetPipelineSystem::PumpUntilReady(const Task<T>& LoadTask)
+    {
+        while (!LoadTask.await_ready())
+        {
+            if (ProcessUploads(Settings.UploadBudgetMs, false) == 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    }
+}
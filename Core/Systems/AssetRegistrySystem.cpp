@@ -1,90 +1,332 @@
 ﻿#include "AssetRegistrySystem.h"
 
-#include <cstdio>
+
+#include "imgui.h"
+#include "../World/WorldConstants.h"
+#include "../Log/Log.h"
 
 namespace Core
 {
     AssetRegistrySystem::AssetRegistrySystem(const std::shared_ptr<EngineContext>& InContext)
         : CoreSystem("AssetRegistrySystem", Type, InContext)
     {
+        constexpr std::size_t MiB = 1024 * 1024;
+        GetTypeResidency(AssetType::Texture).Residency.Budget = 256 * MiB;
+        GetTypeResidency(AssetType::Sound).Residency.Budget = 64 * MiB;
+        GetTypeResidency(AssetType::Font).Residency.Budget = 16 * MiB;
+    }
+
+    void AssetRegistrySystem::Start()
+    {
+        // Magenta/black checkerboard, one tile in size and repeated so any texture rect samples it
+        constexpr unsigned Size = static_cast<unsigned>(WorldConstants::TileSize);
+        constexpr unsigned CellSize = Size / 2;
+
+        sf::Image Image;
+        Image.resize({Size, Size}, sf::Color::Black);
+        for (unsigned Y = 0; Y < Size; ++Y)
+        {
+            for (unsigned X = 0; X < Size; ++X)
+            {
+                if ((X / CellSize + Y / CellSize) % 2 == 0)
+                {
+                    Image.setPixel({X, Y}, sf::Color::Magenta);
+                }
+            }
+        }
+
+        PlaceholderTexture = std::make_shared<sf::Texture>();
+        if (!PlaceholderTexture->loadFromImage(Image))
+        {
+            Log::Error(ELogCategory::Assets, "Failed to create placeholder texture");
+        }
+        PlaceholderTexture->setRepeated(true);
     }
 
     void AssetRegistrySystem::Shutdown()
     {
-        AssetToTexture.clear();
-        AssetToFont.clear();
-        AssetToSound.clear();
-        AssetToTileSheet.clear();
+        {
+            std::lock_guard Lock(WriteMutex);
+            Textures.Clear();
+            Fonts.Clear();
+            Sounds.Clear();
+            TileSheets.Clear();
 
-        Metadata.clear();
-        RefCounts.clear();
-        PathToAssetId.clear();
+            Records.clear();
+            for (TypeResidency& TypeEntry : Residency)
+            {
+                TypeEntry.Lru.clear();
+                TypeEntry.Residency = {.Budget = TypeEntry.Residency.Budget};
+            }
+            EvictionHistory.clear();
+            Paths.store(std::make_shared<const PathIndex>(), std::memory_order_release);
+        }
+
+        PlaceholderTexture.reset();
+
+        // Assets above may still reference mapped bytes, so the pack goes last
+        MountedPack.reset();
 
         CoreSystem::Shutdown();
     }
 
     void AssetRegistrySystem::Release(AssetId Id)
     {
-        if (!RefCounts.contains(Id))
+        std::lock_guard Lock(WriteMutex);
+        auto RecordIt = Records.find(Id);
+        if (RecordIt == Records.end())
         {
-            std::printf("Warning: Attempted to release non-existent asset ID\n");
+            Log::Warning(ELogCategory::Assets, "Attempted to release non-existent asset ID");
             return;
         }
 
-        RefCounts[Id]--;
-        if (RefCounts[Id] == 0)
+        AssetRecord& Record = RecordIt->second;
+        if (Record.RefCount <= 0 || --Record.RefCount > 0)
         {
-            Unload(Id);
+            return;
         }
+
+        // Keep it around in case the next scene wants it back; the budget decides how long
+        TypeResidency& TypeEntry = GetTypeResidency(Record.Metadata.Type);
+        Record.CacheEntry = TypeEntry.Lru.insert(TypeEntry.Lru.end(), Id);
+        TypeEntry.Residency.ResidentBytes -= Record.Bytes;
+        --TypeEntry.Residency.ResidentCount;
+        TypeEntry.Residency.CachedBytes += Record.Bytes;
+        ++TypeEntry.Residency.CachedCount;
+
+        EnforceBudgetLocked(Record.Metadata.Type);
+    }
+
+    AssetId AssetRegistrySystem::Acquire(const std::string& Path)
+    {
+        std::lock_guard Lock(WriteMutex);
+
+        const std::shared_ptr<const PathIndex> Current = LoadPathIndex();
+        auto PathIt = Current->find(Path);
+        if (PathIt == Current->end())
+        {
+            return AssetId::Zero;
+        }
+
+        AddReferenceLocked(Records[PathIt->second.Id]);
+        return PathIt->second.Id;
+    }
+
+    void AssetRegistrySystem::AddReferenceLocked(AssetRecord& Record)
+    {
+        ++Record.RefCount;
+        if (!Record.CacheEntry)
+        {
+            return;
+        }
+
+        TypeResidency& TypeEntry = GetTypeResidency(Record.Metadata.Type);
+        TypeEntry.Lru.erase(*Record.CacheEntry);
+        Record.CacheEntry.reset();
+        TypeEntry.Residency.CachedBytes -= Record.Bytes;
+        --TypeEntry.Residency.CachedCount;
+        TypeEntry.Residency.ResidentBytes += Record.Bytes;
+        ++TypeEntry.Residency.ResidentCount;
+    }
+
+    void AssetRegistrySystem::EnforceBudgetLocked(AssetType Type)
+    {
+        TypeResidency& TypeEntry = GetTypeResidency(Type);
+        while (TypeEntry.Residency.GetTotalBytes() > TypeEntry.Residency.Budget && !TypeEntry.Lru.empty())
+        {
+            auto RecordIt = Records.find(TypeEntry.Lru.front());
+
+            const float TimeS = std::chrono::duration<float>(std::chrono::steady_clock::now() - StartTime).count();
+            EvictionHistory.push_back({
+                .Path = RecordIt->second.Metadata.Path,
+                .Type = Type,
+                .Bytes = RecordIt->second.Bytes,
+                .TimeS = TimeS
+            });
+            if (EvictionHistory.size() > MaxEvictionHistory)
+            {
+                EvictionHistory.pop_front();
+            }
+            ++TypeEntry.Residency.Evictions;
+
+            UnloadLocked(RecordIt);
+        }
+    }
+
+    void AssetRegistrySystem::SetBudget(AssetType Type, std::size_t Bytes)
+    {
+        std::lock_guard Lock(WriteMutex);
+        GetTypeResidency(Type).Residency.Budget = Bytes;
+        EnforceBudgetLocked(Type);
+    }
+
+    AssetResidency AssetRegistrySystem::GetResidency(AssetType Type) const
+    {
+        std::lock_guard Lock(WriteMutex);
+        return Residency[static_cast<std::size_t>(Type)].Residency;
+    }
+
+    std::vector<AssetEviction> AssetRegistrySystem::GetEvictionHistory() const
+    {
+        std::lock_guard Lock(WriteMutex);
+        return {EvictionHistory.begin(), EvictionHistory.end()};
     }
 
     bool AssetRegistrySystem::Contains(const std::string& Path) const
     {
-        return PathToAssetId.contains(Path);
+        return LoadPathIndex()->contains(Path);
     }
 
     void AssetRegistrySystem::Unload(AssetId Id)
     {
-        if (!Metadata.contains(Id))
+        std::lock_guard Lock(WriteMutex);
+
+        auto RecordIt = Records.find(Id);
+        if (RecordIt != Records.end())
         {
-            return;
+            UnloadLocked(RecordIt);
         }
+    }
+
+    void AssetRegistrySystem::UnloadLocked(std::unordered_map<AssetId, AssetRecord>::iterator RecordIt)
+    {
+        const AssetRecord Record = std::move(RecordIt->second);
+        Records.erase(RecordIt);
 
-        const AssetMetadata& Meta = Metadata[Id];
+        TypeResidency& TypeEntry = GetTypeResidency(Record.Metadata.Type);
+        if (Record.CacheEntry)
+        {
+            TypeEntry.Lru.erase(*Record.CacheEntry);
+            TypeEntry.Residency.CachedBytes -= Record.Bytes;
+            --TypeEntry.Residency.CachedCount;
+        }
+        else
+        {
+            TypeEntry.Residency.ResidentBytes -= Record.Bytes;
+            --TypeEntry.Residency.ResidentCount;
+        }
 
-        switch (Meta.Type)
+        switch (Record.Metadata.Type)
         {
         case AssetType::Texture:
-            AssetToTexture.erase(Id);
+            Textures.Remove({Record.Index, Record.Generation});
             break;
         case AssetType::Font:
-            AssetToFont.erase(Id);
+            Fonts.Remove({Record.Index, Record.Generation});
             break;
         case AssetType::Sound:
-            AssetToSound.erase(Id);
+            Sounds.Remove({Record.Index, Record.Generation});
             break;
         case AssetType::TileSheet:
-            AssetToTileSheet.erase(Id);
+            TileSheets.Remove({Record.Index, Record.Generation});
+            break;
+        default:
             break;
         }
 
-        PathToAssetId.erase(Meta.Path);
-        Metadata.erase(Id);
-        RefCounts.erase(Id);
+        UpdatePathIndex([&](PathIndex& Index)
+        {
+            Index.erase(Record.Metadata.Path);
+        });
 
-        std::printf("Unloaded asset: %s\n", Meta.Path.c_str());
+        Log::Verbose(ELogCategory::Assets, "Unloaded asset: %s", Record.Metadata.Path.c_str());
+    }
+
+    bool AssetRegistrySystem::MountPack(const std::string& PackPath)
+    {
+        std::unique_ptr<AssetPack> Pack = AssetPack::Open(PackPath);
+        if (!Pack)
+        {
+            Log::Warning(ELogCategory::Assets, "Could not mount asset pack: %s", PackPath.c_str());
+            return false;
+        }
+
+        MountedPack = std::move(Pack);
+        return true;
     }
 
     std::vector<std::shared_ptr<const TileSheet>> AssetRegistrySystem::GetAllTileSheets() const
     {
         std::vector<std::shared_ptr<const TileSheet>> Result;
-        Result.reserve(AssetToTileSheet.size());
+        Result.reserve(TileSheets.GetLiveCount());
 
-        for (const auto& [Id, SheetPtr] : AssetToTileSheet)
+        TileSheets.ForEach([&Result](std::shared_ptr<const TileSheet> Sheet)
         {
-            Result.push_back(SheetPtr);
-        }
+            Result.push_back(std::move(Sheet));
+        });
 
         return Result;
     }
+
+    void AssetRegistrySystem::RenderUI()
+    {
+        if (ImGui::IsKeyPressed(ImGuiKey_F3, false))
+        {
+            bShowResidencyPanel = !bShowResidencyPanel;
+        }
+        if (!bShowResidencyPanel)
+        {
+            return;
+        }
+
+        constexpr float MiB = 1024.f * 1024.f;
+        constexpr std::array<std::pair<AssetType, const char*>, 4> Types{{
+            {AssetType::Texture, "Textures"},
+            {AssetType::Sound, "Sounds"},
+            {AssetType::Font, "Fonts"},
+            {AssetType::TileSheet, "TileSheets"}
+        }};
+
+        ImGui::SetNextWindowSize(ImVec2(460, 320), ImGuiCond_FirstUseEver);
+        ImGui::Begin("Asset Residency (F3)", &bShowResidencyPanel);
+
+        if (ImGui::BeginTable("Residency", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("Type");
+            ImGui::TableSetupColumn("Resident");
+            ImGui::TableSetupColumn("Cached");
+            ImGui::TableSetupColumn("Budget");
+            ImGui::TableSetupColumn("Evictions");
+            ImGui::TableHeadersRow();
+
+            for (const auto& [Type, Label] : Types)
+            {
+                const AssetResidency Stats = GetResidency(Type);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(Label);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u / %.1f MiB", Stats.ResidentCount, Stats.ResidentBytes / MiB);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u / %.1f MiB", Stats.CachedCount, Stats.CachedBytes / MiB);
+                ImGui::TableNextColumn();
+                if (Stats.Budget == std::numeric_limits<std::size_t>::max())
+                {
+                    ImGui::TextUnformatted("-");
+                }
+                else
+                {
+                    ImGui::ProgressBar(static_cast<float>(Stats.GetTotalBytes()) / static_cast<float>(Stats.Budget),
+                                       ImVec2(-1, 0), nullptr);
+                }
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(Stats.Evictions));
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::SeparatorText("Recent evictions");
+        const std::vector<AssetEviction> History = GetEvictionHistory();
+        for (auto It = History.rbegin(); It != History.rend(); ++It)
+        {
+            ImGui::Text("%7.1fs  %6.1f KiB  %s", It->TimeS, It->Bytes / 1024.f, It->Path.c_str());
+        }
+
+        ImGui::End();
+    }
+
+    std::shared_ptr<const AssetRegistrySystem::PathIndex> AssetRegistrySystem::LoadPathIndex() const
+    {
+        return Paths.load(std::memory_order_acquire);
+    }
 }
@@ -1,17 +1,61 @@
 ﻿#pragma once
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
 
 #include "../Assets/AssetId.hpp"
+#include "../Assets/AssetHandle.hpp"
 #include "../Assets/AssetMetadata.h"
+#include "../Assets/AssetPack.h"
+#include "../Assets/AssetSlotArray.hpp"
 #include "CoreSystem.hpp"
 #include "../Tilemap/TileSheet.h"
+#include "../Log/Log.h"
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Audio/SoundBuffer.hpp>
 
 namespace Core
 {
+    struct AssetResidency
+    {
+        std::size_t Budget = std::numeric_limits<std::size_t>::max();
+
+        // Referenced by at least one owner
+        std::size_t ResidentBytes = 0;
+        std::uint32_t ResidentCount = 0;
+
+        // Unreferenced but kept for reuse, evicted least recently released first once over budget
+        std::size_t CachedBytes = 0;
+        std::uint32_t CachedCount = 0;
+
+        std::uint64_t Evictions = 0;
+
+        std::size_t GetTotalBytes() const { return ResidentBytes + CachedBytes; }
+    };
+
+    struct AssetEviction
+    {
+        std::string Path;
+        AssetType Type = AssetType::INVALID;
+        std::size_t Bytes = 0;
+        float TimeS = 0.f;
+    };
+
+    // Assets live in dense per-type arrays addressed by generational handles.
+    // Lookups (Get, Find, Contains, GetHandle) never take a lock and are safe from loader threads: the path index is
+    // an immutable snapshot republished on every Store or Unload. Writes are serialized by a single writer mutex.
     class AssetRegistrySystem : public CoreSystem
     {
     public:
@@ -19,114 +63,332 @@ namespace Core
 
         AssetRegistrySystem(const std::shared_ptr<EngineContext>& InContext);
 
+        void Start() override;
         void Shutdown() override;
 
         void Release(AssetId Id);
 
         bool Contains(const std::string& Path) const;
 
+        // SizeBytes of 0 estimates the footprint from the asset itself (texels x 4, samples x 2)
+        template <typename T>
+        AssetId Store(std::shared_ptr<T> Asset, const std::string& Path, std::size_t SizeBytes = 0);
+
+        // Swaps a stored asset for a freshly loaded one in place: its id, references and handles stay valid and resolve to
+        // the new asset. Consumers that keep the asset itself should rebind when GetReloadVersion changes.
+        // Returns false when Path is not stored as a T.
+        template <typename T>
+        bool Replace(const std::string& Path, std::shared_ptr<T> Asset, std::size_t SizeBytes = 0);
+
+        // Takes a reference on an asset that is already stored, reviving it from the cache if unreferenced.
+        // Returns AssetId::Zero when the path is not stored.
+        AssetId Acquire(const std::string& Path);
+
+        // Resolve once and keep the handle; Get(Handle) is the per-frame path
         template <typename T>
-        AssetId Store(std::shared_ptr<T> Asset, const std::string& Path);
+        AssetHandle<T> GetHandle(const std::string& Path) const;
 
         template <typename T>
-        std::shared_ptr<const T> Get(const std::string& Path);
+        std::shared_ptr<const T> Get(AssetHandle<T> Handle) const;
 
         template <typename T>
-        std::shared_ptr<const T> Get(AssetId Id);
+        std::shared_ptr<const T> Get(const std::string& Path) const;
 
+        template <typename T>
+        std::shared_ptr<const T> Get(AssetId Id) const;
+
+        // Same as Get, but silent when the asset is missing; for assets that may still be streaming in
+        template <typename T>
+        std::shared_ptr<const T> Find(const std::string& Path) const;
+
+        // Drops the asset immediately, whether referenced or cached
         void Unload(AssetId Id);
 
+        // Cached assets of Type are evicted until the type fits in Bytes; referenced assets are never evicted
+        void SetBudget(AssetType Type, std::size_t Bytes);
+        AssetResidency GetResidency(AssetType Type) const;
+        std::vector<AssetEviction> GetEvictionHistory() const;
+
+        void RenderUI() override;
+
+        // In the order the sheets were stored
         std::vector<std::shared_ptr<const TileSheet>> GetAllTileSheets() const;
 
+        // Mounted pack is consulted before loose files. Only one pack is mounted at a time.
+        bool MountPack(const std::string& PackPath);
+        const AssetPack* GetMountedPack() const { return MountedPack.get(); }
+
+        // Drawn in place of textures that have not finished streaming in
+        std::shared_ptr<const sf::Texture> GetPlaceholderTexture() const { return PlaceholderTexture; }
+
+        // Bumped on every new Store, so consumers waiting on an asset only need to retry when this changes
+        std::uint64_t GetStoreVersion() const { return StoreVersion.load(std::memory_order_acquire); }
+
+        // Bumped on every Replace
+        std::uint64_t GetReloadVersion() const { return ReloadVersion.load(std::memory_order_acquire); }
+
     private:
+        struct PathEntry
+        {
+            AssetId Id;
+            AssetType Type = AssetType::INVALID;
+            std::uint32_t Index = 0;
+            std::uint32_t Generation = 0;
+        };
+
+        using PathIndex = std::unordered_map<std::string, PathEntry>;
+
+        struct AssetRecord
+        {
+            AssetMetadata Metadata;
+            int RefCount = 0;
+            std::uint32_t Index = 0;
+            std::uint32_t Generation = 0;
+            std::size_t Bytes = 0;
+
+            // Position in the type's LRU while unreferenced
+            std::optional<std::list<AssetId>::iterator> CacheEntry = std::nullopt;
+        };
+
+        struct TypeResidency
+        {
+            AssetResidency Residency;
+            std::list<AssetId> Lru;
+        };
+
+        static constexpr std::size_t AssetTypeCount = static_cast<std::size_t>(AssetType::TileSheet) + 1;
+        static constexpr std::size_t MaxEvictionHistory = 64;
+
+        template <typename T>
+        AssetSlotArray<T>& GetStorage();
+
+        template <typename T>
+        const AssetSlotArray<T>& GetStorage() const;
 
         template <typename T>
-        std::unordered_map<AssetId, std::shared_ptr<T>>* GetAssetMap();
+        static constexpr AssetType GetAssetType();
 
         template <typename T>
-        AssetType GetAssetType();
+        static std::size_t EstimateBytes(const T& Asset);
 
-        std::unordered_map<AssetId, std::shared_ptr<sf::Texture>> AssetToTexture;
-        std::unordered_map<AssetId, std::shared_ptr<sf::Font>> AssetToFont;
-        std::unordered_map<AssetId, std::shared_ptr<sf::SoundBuffer>> AssetToSound;
-        std::unordered_map<AssetId, std::shared_ptr<TileSheet>> AssetToTileSheet;
+        std::shared_ptr<const PathIndex> LoadPathIndex() const;
+        void UnloadLocked(std::unordered_map<AssetId, AssetRecord>::iterator RecordIt);
 
-        std::unordered_map<AssetId, AssetMetadata> Metadata;
-        std::unordered_map<AssetId, int> RefCounts;
+        // Caller holds WriteMutex
+        void AddReferenceLocked(AssetRecord& Record);
+        void EnforceBudgetLocked(AssetType Type);
+        TypeResidency& GetTypeResidency(AssetType Type) { return Residency[static_cast<std::size_t>(Type)]; }
 
-        std::unordered_map<std::string, AssetId> PathToAssetId;
+        // Copy-on-write: builds a new index from the current one and publishes it. Caller holds WriteMutex.
+        template <typename Func>
+        void UpdatePathIndex(Func&& Mutate);
+
+        AssetSlotArray<sf::Texture> Textures;
+        AssetSlotArray<sf::Font> Fonts;
+        AssetSlotArray<sf::SoundBuffer> Sounds;
+        AssetSlotArray<TileSheet> TileSheets;
+
+        std::atomic<std::shared_ptr<const PathIndex>> Paths{std::make_shared<const PathIndex>()};
+
+        // Writer side, guarded by WriteMutex
+        mutable std::mutex WriteMutex;
+        std::unordered_map<AssetId, AssetRecord> Records;
+        std::array<TypeResidency, AssetTypeCount> Residency;
+        std::deque<AssetEviction> EvictionHistory;
+        std::chrono::steady_clock::time_point StartTime = std::chrono::steady_clock::now();
+
+        bool bShowResidencyPanel = false;
+
+        std::atomic<std::uint64_t> StoreVersion{0};
+        std::atomic<std::uint64_t> ReloadVersion{0};
+
+        std::unique_ptr<AssetPack> MountedPack;
+
+        std::shared_ptr<sf::Texture> PlaceholderTexture;
     };
 
     template <typename T>
-    AssetId AssetRegistrySystem::Store(std::shared_ptr<T> Asset, const std::string& Path)
+    AssetId AssetRegistrySystem::Store(std::shared_ptr<T> Asset, const std::string& Path, std::size_t SizeBytes)
     {
-        if (PathToAssetId.contains(Path))
+        std::lock_guard Lock(WriteMutex);
+
+        const std::shared_ptr<const PathIndex> Current = LoadPathIndex();
+        if (auto Existing = Current->find(Path); Existing != Current->end())
+        {
+            AddReferenceLocked(Records[Existing->second.Id]);
+            return Existing->second.Id;
+        }
+
+        const std::size_t Bytes = SizeBytes > 0 ? SizeBytes : EstimateBytes(*Asset);
+
+        const AssetHandle<T> Handle = GetStorage<T>().Add(std::move(Asset));
+        if (!Handle.IsValid())
         {
-            AssetId ExistingId = PathToAssetId[Path];
-            RefCounts[ExistingId]++;
-            return ExistingId;
+            Log::Error(ELogCategory::Assets, "Asset storage full, could not store: %s", Path.c_str());
+            return AssetId::Zero;
         }
 
         AssetId Id;
-        GetAssetMap<T>()->emplace(Id, Asset);
+        Records[Id] = {
+            .Metadata = {.Type = GetAssetType<T>(), .Path = Path},
+            .RefCount = 1,
+            .Index = Handle.GetIndex(),
+            .Generation = Handle.GetGeneration(),
+            .Bytes = Bytes
+        };
 
-        PathToAssetId[Path] = Id;
-        RefCounts[Id] = 1;
-        Metadata[Id] = {.Type = GetAssetType<T>(), .Path = Path};
+        AssetResidency& TypeStats = GetTypeResidency(GetAssetType<T>()).Residency;
+        TypeStats.ResidentBytes += Bytes;
+        ++TypeStats.ResidentCount;
+
+        UpdatePathIndex([&](PathIndex& Index)
+        {
+            Index[Path] = {
+                .Id = Id,
+                .Type = GetAssetType<T>(),
+                .Index = Handle.GetIndex(),
+                .Generation = Handle.GetGeneration()
+            };
+        });
+        StoreVersion.fetch_add(1, std::memory_order_release);
+
+        // Making room for the new asset can only cost cached ones
+        EnforceBudgetLocked(GetAssetType<T>());
 
         return Id;
     }
 
     template <typename T>
-    std::shared_ptr<const T> AssetRegistrySystem::Get(const std::string& Path)
+    bool AssetRegistrySystem::Replace(const std::string& Path, std::shared_ptr<T> Asset, std::size_t SizeBytes)
+    {
+        std::lock_guard Lock(WriteMutex);
+
+        const std::shared_ptr<const PathIndex> Current = LoadPathIndex();
+        auto PathIt = Current->find(Path);
+        if (PathIt == Current->end() || PathIt->second.Type != GetAssetType<T>())
+        {
+            return false;
+        }
+
+        const std::size_t Bytes = SizeBytes > 0 ? SizeBytes : EstimateBytes(*Asset);
+
+        AssetRecord& Record = Records[PathIt->second.Id];
+        if (!GetStorage<T>().Replace({Record.Index, Record.Generation}, std::move(Asset)))
+        {
+            return false;
+        }
+
+        AssetResidency& TypeStats = GetTypeResidency(GetAssetType<T>()).Residency;
+        std::size_t& TypeBytes = Record.CacheEntry ? TypeStats.CachedBytes : TypeStats.ResidentBytes;
+        TypeBytes = TypeBytes - Record.Bytes + Bytes;
+        Record.Bytes = Bytes;
+
+        ReloadVersion.fetch_add(1, std::memory_order_release);
+
+        // The new asset may be larger than the one it replaced
+        EnforceBudgetLocked(GetAssetType<T>());
+
+        return true;
+    }
+
+    template <typename T>
+    std::size_t AssetRegistrySystem::EstimateBytes(const T& Asset)
     {
-        auto PathIt = PathToAssetId.find(Path);
-        if (PathIt == PathToAssetId.end())
+        if constexpr (std::is_same_v<T, sf::Texture>)
         {
-            std::printf("Asset not found for path: %s\n", Path.c_str());
-            return nullptr;
+            const sf::Vector2u Size = Asset.getSize();
+            return static_cast<std::size_t>(Size.x) * Size.y * 4;
         }
-        return Get<T>(PathIt->second);
+        else if constexpr (std::is_same_v<T, sf::SoundBuffer>)
+        {
+            return static_cast<std::size_t>(Asset.getSampleCount()) * sizeof(std::int16_t);
+        }
+
+        // Fonts pass their source size explicitly; tilesheets share their texture, which is counted on its own
+        return 0;
     }
 
     template <typename T>
-    std::shared_ptr<const T> AssetRegistrySystem::Get(AssetId AssetId)
+    AssetHandle<T> AssetRegistrySystem::GetHandle(const std::string& Path) const
     {
-        auto AssetMap = GetAssetMap<T>();
-        auto it = AssetMap->find(AssetId);
-        if (it != AssetMap->end())
+        const std::shared_ptr<const PathIndex> Current = LoadPathIndex();
+        auto PathIt = Current->find(Path);
+        if (PathIt == Current->end() || PathIt->second.Type != GetAssetType<T>())
         {
-            return it->second;
+            return {};
         }
+        return {PathIt->second.Index, PathIt->second.Generation};
+    }
 
-        return nullptr;
+    template <typename T>
+    std::shared_ptr<const T> AssetRegistrySystem::Get(AssetHandle<T> Handle) const
+    {
+        return GetStorage<T>().Get(Handle);
     }
 
     template <typename T>
-    std::unordered_map<AssetId, std::shared_ptr<T>>* AssetRegistrySystem::GetAssetMap()
+    std::shared_ptr<const T> AssetRegistrySystem::Get(const std::string& Path) const
+    {
+        std::shared_ptr<const T> Asset = Find<T>(Path);
+        if (!Asset)
+        {
+            Log::Warning(ELogCategory::Assets, "Asset not found for path: %s", Path.c_str());
+        }
+        return Asset;
+    }
+
+    template <typename T>
+    std::shared_ptr<const T> AssetRegistrySystem::Get(AssetId Id) const
+    {
+        AssetHandle<T> Handle;
+        {
+            std::lock_guard Lock(WriteMutex);
+            auto RecordIt = Records.find(Id);
+            if (RecordIt == Records.end() || RecordIt->second.Metadata.Type != GetAssetType<T>())
+            {
+                return nullptr;
+            }
+            Handle = {RecordIt->second.Index, RecordIt->second.Generation};
+        }
+        return Get<T>(Handle);
+    }
+
+    template <typename T>
+    std::shared_ptr<const T> AssetRegistrySystem::Find(const std::string& Path) const
+    {
+        return Get<T>(GetHandle<T>(Path));
+    }
+
+    template <typename T>
+    AssetSlotArray<T>& AssetRegistrySystem::GetStorage()
+    {
+        return const_cast<AssetSlotArray<T>&>(std::as_const(*this).GetStorage<T>());
+    }
+
+    template <typename T>
+    const AssetSlotArray<T>& AssetRegistrySystem::GetStorage() const
     {
         if constexpr (std::is_same_v<T, sf::Texture>)
         {
-            return &AssetToTexture;
+            return Textures;
         }
         else if constexpr (std::is_same_v<T, sf::Font>)
         {
-            return &AssetToFont;
+            return Fonts;
         }
         else if constexpr (std::is_same_v<T, sf::SoundBuffer>)
         {
-            return &AssetToSound;
+            return Sounds;
         }
-        else if constexpr (std::is_same_v<T, TileSheet>)
+        else
         {
-            return &AssetToTileSheet;
+            static_assert(std::is_same_v<T, TileSheet>, "Unsupported asset type");
+            return TileSheets;
         }
-
-        return nullptr;
     }
 
     template <typename T>
-    AssetType AssetRegistrySystem::GetAssetType()
+    constexpr AssetType AssetRegistrySystem::GetAssetType()
     {
         if constexpr (std::is_same_v<T, sf::Texture>)
         {
@@ -147,4 +409,12 @@ namespace Core
 
         return AssetType::INVALID;
     }
+
+    template <typename Func>
+    void AssetRegistrySystem::UpdatePathIndex(Func&& Mutate)
+    {
+        auto Next = std::make_shared<PathIndex>(*LoadPathIndex());
+        Mutate(*Next);
+        Paths.store(std::move(Next), std::memory_order_release);
+    }
 }
@@ -7,10 +7,13 @@ namespace Core
         InputSystem,
         SceneManagerSystem,
         AssetRegistrySystem,
+        AssetPipelineSystem,
         DataAssetRegistrySystem,
         WorldObjectSystem,
         ImGuiSystem,
         CoordinateProjectionSystem,
-        ShaderPipeline
+        ShaderPipeline,
+        HotReloadSystem,
+        NavigationSystem
     };
 }
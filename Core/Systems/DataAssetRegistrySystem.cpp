@@ -1,5 +1,7 @@
 ﻿#include "DataAssetRegistrySystem.h"
 
+#include "../Log/Log.h"
+
 namespace Core
 {
     DataAssetRegistrySystem::DataAssetRegistrySystem(std::shared_ptr<EngineContext> InContext)
@@ -14,10 +16,15 @@ namespace Core
             return Cache[Name];
         }
 
-        std::printf("DataAsset '%s' not found in cache\n", Name.c_str());
+        Log::Warning(ELogCategory::Assets, "DataAsset '%s' not found in cache", Name.c_str());
         return nullptr;
     }
 
+    bool DataAssetRegistrySystem::Contains(const std::string& Name) const
+    {
+        return Cache.contains(Name);
+    }
+
     void DataAssetRegistrySystem::Store(const std::string& Name, std::shared_ptr<DataAsset> Asset)
     {
         Cache[Name] = Asset;
@@ -15,6 +15,7 @@ namespace Core
         ~DataAssetRegistrySystem() override = default;
 
         std::shared_ptr<DataAsset> Get(const std::string& Name);
+        bool Contains(const std::string& Name) const;
         void Store(const std::string& Name, std::shared_ptr<DataAsset> Asset);
 
     private:
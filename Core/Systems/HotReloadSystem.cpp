@@ -0,0 +1,289 @@
+#include "HotReloadSystem.h"
+
+#include <filesystem>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#include "AssetPipelineSystem.h"
+#include "AssetRegistrySystem.h"
+#include "DataAssetRegistrySystem.h"
+#include "SceneManagerSystem.h"
+#include "WorldObjectSystem.h"
+#include "../EngineContext.hpp"
+#include "../SystemsRegistry.hpp"
+#include "../Assets/AssetPackFormat.hpp"
+#include "../Assets/DataAsset.h"
+#include "../TileMap/TileSheet.h"
+#include "../Utils/StringUtils.h"
+#include "../Log/Log.h"
+
+namespace Core
+{
+    namespace
+    {
+        constexpr const char* WatchRoot = "Game/Assets";
+        constexpr const char* ObjectDirectory = "Game/Assets/Objects/";
+    }
+
+    HotReloadSystem::HotReloadSystem(std::shared_ptr<EngineContext> InContext)
+        : CoreSystem("HotReloadSystem", Type, std::move(InContext))
+    {
+    }
+
+    void HotReloadSystem::Start()
+    {
+        CoreSystem::Start();
+
+        Loader = std::make_unique<AssetLoader>(GetContext()->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>(),
+                                               GetContext()->SystemsRegistry->GetCoreSystem<DataAssetRegistrySystem>(),
+                                               GetContext()->SystemsRegistry->GetCoreSystem<AssetPipelineSystem>());
+
+#ifdef __linux__
+        WatchHandle = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (WatchHandle < 0)
+        {
+            Log::Warning(ELogCategory::Assets, "Hot reload disabled: could not initialize inotify");
+            return;
+        }
+
+        AddWatchRecursive(WatchRoot);
+        Log::Info(ELogCategory::Assets, "Hot reload watching %zu directories under %s", WatchedDirectories.size(), WatchRoot);
+#else
+        Log::Warning(ELogCategory::Assets, "Hot reload is not supported on this platform; RequestReload still works");
+#endif
+    }
+
+    void HotReloadSystem::Tick(float DeltaTimeS)
+    {
+        PollWatchEvents();
+
+        const Clock::time_point Now = Clock::now();
+        for (auto ChangeIt = PendingChanges.begin(); ChangeIt != PendingChanges.end();)
+        {
+            if (Now - ChangeIt->second < CoalesceDelay)
+            {
+                ++ChangeIt;
+                continue;
+            }
+
+            Reload(ChangeIt->first);
+            ChangeIt = PendingChanges.erase(ChangeIt);
+        }
+    }
+
+    void HotReloadSystem::Shutdown()
+    {
+#ifdef __linux__
+        if (WatchHandle >= 0)
+        {
+            close(WatchHandle);
+        }
+#endif
+        WatchHandle = -1;
+        WatchedDirectories.clear();
+        PendingChanges.clear();
+        Loader.reset();
+
+        CoreSystem::Shutdown();
+    }
+
+    void HotReloadSystem::RequestReload(const std::string& Path)
+    {
+        PendingChanges[AssetPackFormat::NormalizePath(Path)] = Clock::now();
+    }
+
+    void HotReloadSystem::SetReinstantiateObjects(bool bEnabled)
+    {
+        bReinstantiateObjects = bEnabled;
+        GetContext()->SystemsRegistry->GetCoreSystem<WorldObjectSystem>()->SetRecordSources(bEnabled);
+    }
+
+    void HotReloadSystem::PollWatchEvents()
+    {
+#ifdef __linux__
+        if (WatchHandle < 0)
+        {
+            return;
+        }
+
+        alignas(inotify_event) char Buffer[4096];
+        while (true)
+        {
+            const ssize_t Length = read(WatchHandle, Buffer, sizeof(Buffer));
+            if (Length <= 0)
+            {
+                // EAGAIN: drained for this frame
+                return;
+            }
+
+            const Clock::time_point Now = Clock::now();
+            for (char* Cursor = Buffer; Cursor < Buffer + Length;)
+            {
+                const auto* Event = reinterpret_cast<const inotify_event*>(Cursor);
+                Cursor += sizeof(inotify_event) + Event->len;
+
+                if (Event->mask & IN_Q_OVERFLOW)
+                {
+                    Log::Warning(ELogCategory::Assets, "Hot reload dropped file events; save again to reload");
+                    continue;
+                }
+                if (Event->mask & IN_IGNORED)
+                {
+                    WatchedDirectories.erase(Event->wd);
+                    continue;
+                }
+
+                auto DirectoryIt = WatchedDirectories.find(Event->wd);
+                if (DirectoryIt == WatchedDirectories.end() || Event->len == 0)
+                {
+                    continue;
+                }
+
+                const std::string Name = Event->name;
+                const std::string Path = DirectoryIt->second + "/" + Name;
+                if (Event->mask & IN_ISDIR)
+                {
+                    if (Event->mask & (IN_CREATE | IN_MOVED_TO))
+                    {
+                        AddWatchRecursive(Path);
+                    }
+                    continue;
+                }
+
+                // Editor swap and backup files
+                if (Name.starts_with(".") || Name.ends_with("~"))
+                {
+                    continue;
+                }
+
+                PendingChanges[Path] = Now;
+            }
+        }
+#endif
+    }
+
+    void HotReloadSystem::AddWatchRecursive(const std::string& Directory)
+    {
+#ifdef __linux__
+        const int Watch = inotify_add_watch(WatchHandle, Directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+        if (Watch < 0)
+        {
+            Log::Warning(ELogCategory::Assets, "Hot reload could not watch: %s", Directory.c_str());
+            return;
+        }
+        WatchedDirectories[Watch] = Directory;
+
+        std::error_code Error;
+        for (const auto& Entry : std::filesystem::directory_iterator(Directory, Error))
+        {
+            if (Entry.is_directory(Error))
+            {
+                AddWatchRecursive(AssetPackFormat::NormalizePath(Entry.path().generic_string()));
+            }
+        }
+#endif
+    }
+
+    void HotReloadSystem::Reload(const std::string& Path)
+    {
+        std::shared_ptr<AssetRegistrySystem> AssetRegistry = GetContext()->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
+
+        // The pipeline reads the pack before loose files, so reloading would only read the old bytes again
+        if (const AssetPack* Pack = AssetRegistry->GetMountedPack(); Pack && Pack->Contains(Path))
+        {
+            Log::Warning(ELogCategory::Assets, "Ignoring change to packed asset: %s", Path.c_str());
+            return;
+        }
+
+        // Sheets read their metadata when they are built, so the sheet is rebuilt around the texture it already has
+        if (Path.ends_with(".tilesheet.json"))
+        {
+            RebindTileSheet(Path.substr(0, Path.rfind(".json")));
+            return;
+        }
+
+        const AssetLoader::AssetType ReloadType = GetReloadType(Path);
+        if (ReloadType == AssetLoader::AssetType::Object)
+        {
+            const std::string Name = ToLowercase(std::filesystem::path(Path).stem().string());
+            if (!GetContext()->SystemsRegistry->GetCoreSystem<DataAssetRegistrySystem>()->Contains(Name))
+            {
+                return;
+            }
+        }
+        else if (ReloadType == AssetLoader::AssetType::Invalid || !AssetRegistry->Contains(Path))
+        {
+            // Never loaded, so there is nothing to swap; the next load reads the new file anyway
+            return;
+        }
+
+        Loader->StreamReload(ReloadType, Path, [this](const AssetLoader::LoadedAsset& Result)
+        {
+            OnReloaded(Result);
+        });
+    }
+
+    void HotReloadSystem::OnReloaded(const AssetLoader::LoadedAsset& Result)
+    {
+        Log::Info(ELogCategory::Assets, "Hot reloaded %s", Result.Path.c_str());
+
+        if (Result.Type == AssetLoader::AssetType::Texture)
+        {
+            RebindTileSheet(Result.Path);
+            return;
+        }
+
+        if (Result.Type != AssetLoader::AssetType::Object || !bReinstantiateObjects)
+        {
+            return;
+        }
+
+        std::shared_ptr<Scene> ActiveScene = GetContext()->SystemsRegistry->GetCoreSystem<SceneManagerSystem>()->GetActiveScene();
+        if (!ActiveScene)
+        {
+            return;
+        }
+
+        const DataAsset& Reloaded = *std::static_pointer_cast<DataAsset>(Result.Data);
+        const std::size_t Count = GetContext()->SystemsRegistry->GetCoreSystem<WorldObjectSystem>()->Reinstantiate(
+            &ActiveScene->GetWorld(), Reloaded);
+        Log::Info(ELogCategory::Assets, "Reinstantiated %zu '%s' objects", Count, Reloaded.Name.c_str());
+    }
+
+    void HotReloadSystem::RebindTileSheet(const std::string& TexturePath)
+    {
+        std::shared_ptr<AssetRegistrySystem> AssetRegistry = GetContext()->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
+
+        const std::string Key = TileSheet::GetRegistryKey(TexturePath);
+        std::shared_ptr<const TileSheet> Existing = AssetRegistry->Find<TileSheet>(Key);
+        if (!Existing)
+        {
+            return;
+        }
+
+        // Rebuilt around the current texture and metadata; the id stays so tiles already placed keep pointing at this sheet
+        std::optional<TileSheet> Rebuilt = TileSheet::Create(TexturePath, AssetRegistry.get());
+        if (!Rebuilt)
+        {
+            return;
+        }
+        Rebuilt->SetId(Existing->GetId());
+        AssetRegistry->Replace<TileSheet>(Key, std::make_shared<TileSheet>(std::move(*Rebuilt)));
+    }
+
+    AssetLoader::AssetType HotReloadSystem::GetReloadType(const std::string& Path)
+    {
+        if (Path.ends_with(".tilesheet"))
+        {
+            return AssetLoader::AssetType::Texture;
+        }
+        if (Path.starts_with(ObjectDirectory) && Path.ends_with(".json"))
+        {
+            return AssetLoader::AssetType::Object;
+        }
+        return AssetLoader::GetAssetTypeFromExtension(Path);
+    }
+}
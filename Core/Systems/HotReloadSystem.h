@@ -0,0 +1,63 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "CoreSystem.hpp"
+#include "../Assets/AssetLoader.h"
+
+namespace Core
+{
+    // Watches Game/Assets (inotify on Linux) and reloads textures, tilesheets and their .tilesheet.json metadata, fonts,
+    // sounds and DataAssets that are already loaded when their files change. Bursts of events for one file are coalesced, the asset is read and decoded
+    // off-thread through the normal pipeline, then swapped in place in the registry so existing ids and handles follow it.
+    class HotReloadSystem : public CoreSystem
+    {
+    public:
+        static constexpr ECoreSystemType Type = ECoreSystemType::HotReloadSystem;
+
+        HotReloadSystem(std::shared_ptr<EngineContext> InContext);
+
+        void Start() override;
+        void Tick(float DeltaTimeS) override;
+        void Shutdown() override;
+
+        // Queues Path as if it had changed on disk
+        void RequestReload(const std::string& Path);
+
+        // Respawns live objects of the active scene when their DataAsset changes. Off by default, since it resets
+        // whatever runtime state those objects had. Only objects spawned while it is on can be respawned, as their
+        // source is not recorded otherwise.
+        void SetReinstantiateObjects(bool bEnabled);
+        bool GetReinstantiateObjects() const { return bReinstantiateObjects; }
+
+        bool IsWatching() const { return WatchHandle >= 0; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        // Editors often save in several writes; a file is reloaded once it has been quiet this long
+        static constexpr std::chrono::milliseconds CoalesceDelay{150};
+
+        void PollWatchEvents();
+        void AddWatchRecursive(const std::string& Directory);
+
+        void Reload(const std::string& Path);
+        void OnReloaded(const AssetLoader::LoadedAsset& Result);
+        void RebindTileSheet(const std::string& TexturePath);
+
+        static AssetLoader::AssetType GetReloadType(const std::string& Path);
+
+        std::unique_ptr<AssetLoader> Loader;
+
+        int WatchHandle = -1;
+        std::unordered_map<int, std::string> WatchedDirectories;
+
+        // Path to the time of its latest change event
+        std::unordered_map<std::string, Clock::time_point> PendingChanges;
+
+        bool bReinstantiateObjects = false;
+    };
+}
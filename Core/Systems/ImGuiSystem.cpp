@@ -3,6 +3,7 @@
 #include <SFML/Graphics/RenderWindow.hpp>
 #include "imgui-SFML.h"
 #include "../EngineContext.hpp"
+#include "../Log/Log.h"
 
 namespace Core
 {
@@ -15,7 +16,7 @@ namespace Core
     {
         if (!ImGui::SFML::Init(*GetContext()->Window))
         {
-            std::printf("Failed to initialize ImGui System\n");
+            Log::Error(ELogCategory::Render, "Failed to initialize ImGui System");
         }
     }
 
@@ -0,0 +1,74 @@
+#include "NavigationSystem.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "../Components/TileMapComponent.h"
+
+namespace Core
+{
+    NavigationSystem::NavigationSystem(std::shared_ptr<EngineContext> InContext)
+        : CoreSystem("NavigationSystem", Type, std::move(InContext))
+          , Workers(std::max<std::size_t>(1, std::thread::hardware_concurrency() / 2))
+    {
+    }
+
+    void NavigationSystem::Tick(float DeltaTimeS)
+    {
+        for (auto It = Maps.begin(); It != Maps.end();)
+        {
+            std::shared_ptr<TileMapComponent> Map = It->second.Map.lock();
+            if (!Map)
+            {
+                It = Maps.erase(It);
+                continue;
+            }
+
+            It->second.Service->Tick(Map->GetCollisionGrid());
+            ++It;
+        }
+    }
+
+    void NavigationSystem::Shutdown()
+    {
+        Maps.clear();
+    }
+
+    void NavigationSystem::RequestPath(const std::shared_ptr<TileMapComponent>& Map, TilePoint Start, TilePoint Goal,
+                                       PathCallback Callback)
+    {
+        if (PathfindingService* Service = GetOrAddService(Map))
+        {
+            Service->RequestPath(Start, Goal, std::move(Callback));
+        }
+    }
+
+    std::shared_ptr<const FlowField> NavigationSystem::GetFlowField(const std::shared_ptr<TileMapComponent>& Map, TilePoint Goal)
+    {
+        PathfindingService* Service = GetOrAddService(Map);
+        return Service ? Service->GetFlowField(Goal) : nullptr;
+    }
+
+    PathfindingService* NavigationSystem::GetOrAddService(const std::shared_ptr<TileMapComponent>& Map)
+    {
+        if (!Map)
+        {
+            return nullptr;
+        }
+
+        // A map at the address of one that went away is a different map
+        MapNavigation& Navigation = Maps[Map.get()];
+        if (!Navigation.Service || Navigation.Map.expired())
+        {
+            Navigation.Map = Map;
+            Navigation.Service = std::make_unique<PathfindingService>(Workers);
+        }
+        return Navigation.Service.get();
+    }
+
+    const PathfindingService* NavigationSystem::GetService(const TileMapComponent* Map) const
+    {
+        const auto Found = Maps.find(Map);
+        return Found != Maps.end() && !Found->second.Map.expired() ? Found->second.Service.get() : nullptr;
+    }
+}
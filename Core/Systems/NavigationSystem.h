@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include "CoreSystem.hpp"
+#include "../Navigation/PathfindingService.h"
+
+namespace Core
+{
+    class TileMapComponent;
+
+    // Finds paths across tile maps for anything in the world that walks, one PathfindingService per map. Each frame
+    // every service is handed its map's current collision grid, and services of maps that went away are dropped.
+    // All services search and build on one pool of workers, however many maps there are.
+    class NavigationSystem : public CoreSystem
+    {
+    public:
+        static constexpr ECoreSystemType Type = ECoreSystemType::NavigationSystem;
+
+        NavigationSystem(std::shared_ptr<EngineContext> InContext);
+
+        void Tick(float DeltaTimeS) override;
+        void Shutdown() override;
+
+        // Start and Goal are tiles of Map. Callback runs on the main thread during a later Tick, unless Map goes
+        // away first.
+        void RequestPath(const std::shared_ptr<TileMapComponent>& Map, TilePoint Start, TilePoint Goal,
+                         PathCallback Callback);
+
+        // The latest flow field across Map towards Goal, or null while the first one is built; see
+        // PathfindingService::GetFlowField. Cheap enough to ask every frame.
+        std::shared_ptr<const FlowField> GetFlowField(const std::shared_ptr<TileMapComponent>& Map, TilePoint Goal);
+
+        // Null until a path or flow field is requested on Map
+        const PathfindingService* GetService(const TileMapComponent* Map) const;
+
+    private:
+        PathfindingService* GetOrAddService(const std::shared_ptr<TileMapComponent>& Map);
+
+        struct MapNavigation
+        {
+            std::weak_ptr<TileMapComponent> Map;
+            std::unique_ptr<PathfindingService> Service;
+        };
+
+        // Declared before Maps so it outlives every service's jobs
+        ThreadPool Workers;
+        std::unordered_map<const TileMapComponent*, MapNavigation> Maps;
+    };
+}
@@ -1,5 +1,11 @@
 ﻿#include "SceneManagerSystem.h"
 
+
+#include "AssetRegistrySystem.h"
+#include "../Assets/AssetCancellationToken.hpp"
+#include "../Utils/StringUtils.h"
+#include "../Log/Log.h"
+
 namespace Core
 {
     SceneManagerSystem::SceneManagerSystem(std::shared_ptr<EngineContext> InContext)
@@ -14,22 +20,120 @@ namespace Core
             return false;
         }
 
-        if (ActiveScene)
+        std::shared_ptr<Scene> Outgoing = Scenes.top();
+        Scenes.pop();
+        ActiveScene = Scenes.empty() ? nullptr : Scenes.top();
+
+        // The scene underneath is already loaded, so anything it shares with the popped one stays resident
+        Outgoing->Exit(ActiveScene.get());
+
+        return true;
+    }
+
+    void SceneManagerSystem::Replace(const std::shared_ptr<Scene>& Incoming)
+    {
+        std::shared_ptr<Scene> Outgoing = Scenes.empty() ? nullptr : Scenes.top();
+
+        // Load before the outgoing scene lets go, so assets both need are acquired rather than read again
+        LoadScene(Incoming);
+
+        if (Outgoing)
         {
-            ActiveScene->Exit();
+            Scenes.pop();
         }
+        Scenes.push(Incoming);
+        ActiveScene = Incoming;
+        Incoming->Enter();
 
-        Scenes.pop();
+        if (Outgoing)
+        {
+            Outgoing->Exit(Incoming.get());
+        }
+    }
 
-        if (Scenes.empty())
+    void SceneManagerSystem::LoadScene(const std::shared_ptr<Scene>& NewScene)
+    {
+        std::shared_ptr<AssetPipelineSystem> Pipeline = GetContext()->SystemsRegistry->GetCoreSystem<AssetPipelineSystem>();
+
+        // Let a prefetch of this scene land first, so the load below acquires its assets rather than reading them again
+        auto Prefetched = Prefetches.find(ToLowercase(NewScene->GetManifestName()));
+        if (Prefetched != Prefetches.end() && Prefetched->second.LoadTask)
+        {
+            Pipeline->PumpUntilReady(*Prefetched->second.LoadTask);
+        }
+
+        Task<> LoadTask = NewScene->Load();
+        Pipeline->PumpUntilReady(LoadTask);
+
+        // The scene holds its own references now
+        if (Prefetched != Prefetches.end())
+        {
+            TryRetirePrefetch(Prefetched->second);
+            Prefetches.erase(Prefetched);
+        }
+    }
+
+    void SceneManagerSystem::Push(std::shared_ptr<Scene> NewScene)
+    {
+        Scenes.push(NewScene);
+        ActiveScene = Scenes.top();
+
+        LoadScene(NewScene);
+        NewScene->Enter();
+    }
+
+    void SceneManagerSystem::Prefetch(const std::string& SceneName, AssetLoader::LoadPriority Priority)
+    {
+        const std::string Key = ToLowercase(SceneName);
+        if (Prefetches.contains(Key))
+        {
+            return;
+        }
+
+        Log::Info(ELogCategory::Scene, "Prefetching scene '%s'", SceneName.c_str());
+
+        PrefetchEntry& Entry = Prefetches[Key];
+        Entry.Token = std::make_shared<AssetCancellationToken>();
+        Entry.Loader = std::make_unique<SceneLoader>(GetContext());
+        Entry.LoadTask.emplace(Entry.Loader->PrefetchScene(SceneName, Entry.Token, Priority));
+    }
+
+    void SceneManagerSystem::CancelPrefetch(const std::string& SceneName)
+    {
+        auto Prefetched = Prefetches.find(ToLowercase(SceneName));
+        if (Prefetched == Prefetches.end())
         {
-            ActiveScene.reset();
+            return;
         }
-        else
+
+        Prefetched->second.Token->Cancel();
+        RetiringPrefetches.push_back(std::move(Prefetched->second));
+        Prefetches.erase(Prefetched);
+    }
+
+    bool SceneManagerSystem::IsPrefetchReady(const std::string& SceneName) const
+    {
+        auto Prefetched = Prefetches.find(ToLowercase(SceneName));
+        return Prefetched != Prefetches.end() && Prefetched->second.LoadTask->await_ready();
+    }
+
+    bool SceneManagerSystem::TryRetirePrefetch(PrefetchEntry& Entry)
+    {
+        if (!Entry.LoadTask)
+        {
+            return true;
+        }
+        if (!Entry.LoadTask->await_ready())
         {
-            ActiveScene = Scenes.top();
+            return false;
         }
 
+        std::shared_ptr<AssetRegistrySystem> AssetRegistry = GetContext()->SystemsRegistry->GetCoreSystem<AssetRegistrySystem>();
+        for (AssetId Id : Entry.LoadTask->await_resume())
+        {
+            AssetRegistry->Release(Id);
+        }
+        Entry.LoadTask.reset();
         return true;
     }
 
@@ -44,6 +148,11 @@ namespace Core
 
     void SceneManagerSystem::Tick(float DeltaTimeS)
     {
+        std::erase_if(RetiringPrefetches, [this](PrefetchEntry& Entry)
+        {
+            return TryRetirePrefetch(Entry);
+        });
+
         if (bPopRequested)
         {
             bPopRequested = false;
@@ -51,6 +160,14 @@ namespace Core
             return;
         }
 
+        if (PendingReplacement)
+        {
+            std::function<std::shared_ptr<Scene>()> MakeScene = std::move(PendingReplacement);
+            PendingReplacement = nullptr;
+            Replace(MakeScene());
+            return;
+        }
+
         if (ActiveScene)
         {
             ActiveScene->Tick(DeltaTimeS);
@@ -65,6 +182,29 @@ namespace Core
         }
     }
 
+    void SceneManagerSystem::Shutdown()
+    {
+        for (auto& [Name, Entry] : Prefetches)
+        {
+            Entry.Token->Cancel();
+            RetiringPrefetches.push_back(std::move(Entry));
+        }
+        Prefetches.clear();
+
+        // The registry has already dropped every asset by now; only drain the cancelled loads so their loaders can go
+        std::shared_ptr<AssetPipelineSystem> Pipeline = GetContext()->SystemsRegistry->GetCoreSystem<AssetPipelineSystem>();
+        for (PrefetchEntry& Entry : RetiringPrefetches)
+        {
+            if (Entry.LoadTask)
+            {
+                Pipeline->PumpUntilReady(*Entry.LoadTask);
+            }
+        }
+        RetiringPrefetches.clear();
+
+        CoreSystem::Shutdown();
+    }
+
     void SceneManagerSystem::RenderUI()
     {
         if (ActiveScene)
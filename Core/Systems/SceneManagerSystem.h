@@ -1,10 +1,17 @@
 ﻿#pragma once
+#include <functional>
+#include <memory>
+#include <optional>
 #include <stack>
-#include <thread>
-#include <chrono>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "CoreSystem.hpp"
+#include "AssetPipelineSystem.h"
 #include "../Scene/Scene.h"
+#include "../Scene/SceneLoader.h"
+#include "../SystemsRegistry.hpp"
 
 namespace Core
 {
@@ -20,35 +27,75 @@ namespace Core
             requires IsScene<T>
         void Push(Args&&... args);
 
+        void Push(std::shared_ptr<Scene> NewScene);
+
         void RequestPop();
 
+        // Swaps the active scene for a new one at the start of the next Tick. The new scene loads and enters while
+        // the old one still holds its assets, so shared assets stay resident and only the difference is loaded or
+        // released.
+        template <typename T, typename... Args>
+            requires IsScene<T>
+        void RequestReplace(Args&&... args);
+
         std::shared_ptr<Scene> GetActiveScene() const { return ActiveScene; }
 
+        // Warms a scene's DataAssets, textures, fonts and sounds at background priority while the current scene runs.
+        // Uploads are held to AssetPipelineSettings::BackgroundUploadBudgetMs per frame. A later Push or Replace of that
+        // scene waits for anything still in flight and then acquires the warmed assets instead of reading them.
+        // Startup prefetches the initial scene at a higher Priority, since nothing else is running yet.
+        void Prefetch(const std::string& SceneName,
+                      AssetLoader::LoadPriority Priority = AssetLoader::LoadPriority::Background);
+
+        // Stops a prefetch and lets go of what it loaded; cached assets stay subject to the residency budget
+        void CancelPrefetch(const std::string& SceneName);
+
+        bool IsPrefetchReady(const std::string& SceneName) const;
+
         virtual void Start() override;
         virtual void Tick(float DeltaTimeS) override;
         virtual void Render() override;
         virtual void RenderUI() override;
+        virtual void Shutdown() override;
 
     private:
         bool Pop();
+        void Replace(const std::shared_ptr<Scene>& Incoming);
+        void LoadScene(const std::shared_ptr<Scene>& NewScene);
+
+        struct PrefetchEntry
+        {
+            std::shared_ptr<AssetCancellationToken> Token;
+
+            // Owns the loader the task runs on, so it must outlive the task
+            std::unique_ptr<SceneLoader> Loader;
+            std::optional<Task<std::vector<AssetId>>> LoadTask;
+        };
+
+        // Releases the entry's references once its task is done; returns false if it is still running
+        bool TryRetirePrefetch(PrefetchEntry& Entry);
+
+        std::unordered_map<std::string, PrefetchEntry> Prefetches;
+        std::vector<PrefetchEntry> RetiringPrefetches;
+
         std::stack<std::shared_ptr<Scene>> Scenes;
         std::shared_ptr<Scene> ActiveScene{nullptr};
         bool bPopRequested = false;
+        std::function<std::shared_ptr<Scene>()> PendingReplacement;
     };
 
     template <typename T, typename... Args> requires IsScene<T>
     void SceneManagerSystem::Push(Args&&... args)
     {
-        auto NewScene = std::make_shared<T>(GetContext(), std::forward<Args>(args)...);
-        Scenes.push(NewScene);
-        ActiveScene = Scenes.top();
+        Push(std::make_shared<T>(GetContext(), std::forward<Args>(args)...));
+    }
 
-        Task<> LoadTask = NewScene->Load();
-        while (!LoadTask.await_ready())
+    template <typename T, typename... Args> requires IsScene<T>
+    void SceneManagerSystem::RequestReplace(Args&&... args)
+    {
+        PendingReplacement = [this, ...CapturedArgs = std::forward<Args>(args)]()
         {
-            std::this_thread::sleep_for(std::chrono::milliseconds(1));
-        }
-
-        NewScene->Enter();
+            return std::static_pointer_cast<Scene>(std::make_shared<T>(GetContext(), CapturedArgs...));
+        };
     }
 }
@@ -5,6 +5,7 @@
 #include "../World/WorldEnvironment.h"
 #include "../EngineContext.hpp"
 #include "../SystemsRegistry.hpp"
+#include "../Log/Log.h"
 
 namespace Core
 {
@@ -13,13 +14,13 @@ namespace Core
     {
     }
 
-    void ShaderPipeline::Start()
+    void ShaderPipeline::CompilePasses()
     {
         ShaderPass DayNightPass;
 
         if (!DayNightPass.Shader.loadFromFile("Core/Shaders/daynight.frag", sf::Shader::Type::Fragment))
         {
-            std::printf("Failed to load daynight.frag shader\n");
+            Log::Error(ELogCategory::Render, "Failed to load daynight.frag shader");
             return;
         }
 
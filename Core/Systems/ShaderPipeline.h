@@ -23,7 +23,9 @@ namespace Core
 
         ShaderPipeline(std::shared_ptr<EngineContext> Context);
 
-        void Start() override;
+        // Builds the post-process passes. Called from a startup worker: SFML gives that thread its own context,
+        // shared with the window's, so compilation overlaps the rest of startup.
+        void CompilePasses();
 
         void ApplyAll(sf::RenderTexture& InputTexture, sf::RenderTexture& OutputTexture);
 
@@ -3,6 +3,7 @@
 #include "../Assets/DataAsset.h"
 #include "../Components/ComponentRegistry.h"
 #include "../Components/TransformComponent.h"
+#include "../Log/Log.h"
 #include "../World/WorldObject.h"
 #include "../World/World.h"
 #include "../Utils/JsonUtils.h"
@@ -18,6 +19,10 @@ namespace Core
                                                            const nlohmann::json& OverrideValues)
     {
         std::shared_ptr<WorldObject> WorldObj = TargetWorld->Objects().CreateObject();
+        if (bRecordSources)
+        {
+            WorldObj->SetSource(DataAsset.Name, OverrideValues);
+        }
 
         for (const ComponentData& AssetComponentData : DataAsset.Components)
         {
@@ -74,6 +79,60 @@ namespace Core
         return WorldObj;
     }
 
+    std::size_t WorldObjectSystem::Reinstantiate(World* TargetWorld, const DataAsset& Asset)
+    {
+        std::vector<std::shared_ptr<WorldObject>> Stale;
+        for (const std::shared_ptr<WorldObject>& Obj : TargetWorld->Objects().GetAll())
+        {
+            if (Obj && Obj->GetSourceDataAsset() == Asset.Name)
+            {
+                Stale.push_back(Obj);
+            }
+        }
+
+        for (const std::shared_ptr<WorldObject>& OldObj : Stale)
+        {
+            std::shared_ptr<WorldObject> NewObj = Create(TargetWorld, Asset, OldObj->GetSourceOverrides());
+            NewObj->SetTag(OldObj->GetTag());
+
+            // Keep wherever the object has moved to since it spawned, and its place in the transform hierarchy
+            std::shared_ptr<TransformComponent> OldTransform = OldObj->Components().Get<TransformComponent>();
+            std::shared_ptr<TransformComponent> NewTransform = NewObj->Components().Get<TransformComponent>();
+            if (OldTransform && NewTransform)
+            {
+                if (std::shared_ptr<TransformComponent> OldParent = OldTransform->GetParent())
+                {
+                    NewTransform->SetParent(OldParent, false);
+                }
+                NewTransform->SetPosition(OldTransform->GetPosition());
+                NewTransform->SetRotation(OldTransform->GetRotation());
+                NewTransform->SetScale(OldTransform->GetScale());
+
+                // Removing the old object orphans its children, so hand them over first. Copied because SetParent
+                // edits the old transform's child list.
+                const std::vector<std::weak_ptr<TransformComponent>> Children = OldTransform->GetChildren();
+                for (const std::weak_ptr<TransformComponent>& WeakChild : Children)
+                {
+                    std::shared_ptr<TransformComponent> Child = WeakChild.lock();
+                    if (Child && !Child->SetParent(NewTransform, false))
+                    {
+                        Log::Warning(ELogCategory::Components, "Could not move a child of '%s' to its respawned object",
+                                     OldObj->GetName().c_str());
+                    }
+                }
+            }
+
+            const std::string Name = OldObj->GetName();
+            TargetWorld->Objects().Remove(OldObj);
+            if (!Name.empty())
+            {
+                NewObj->SetName(Name);
+            }
+        }
+
+        return Stale.size();
+    }
+
     std::shared_ptr<WorldObject> WorldObjectSystem::Create(World* TargetWorld, const nlohmann::json& ObjectData)
     {
         std::shared_ptr<WorldObject> WorldObj = TargetWorld->Objects().CreateObject();
@@ -17,5 +17,17 @@ namespace Core
         WorldObjectSystem(std::shared_ptr<EngineContext> InContext);
         std::shared_ptr<WorldObject> Create(World* TargetWorld, const DataAsset& DataAsset, const nlohmann::json& OverrideValues);
         std::shared_ptr<WorldObject> Create(World* TargetWorld, const nlohmann::json& ObjectData);
+
+        // Whether objects created from a DataAsset remember it and their overrides. Off by default so the override
+        // JSON is not kept around per object; hot reload turns it on while it may need to respawn them.
+        void SetRecordSources(bool bEnabled) { bRecordSources = bEnabled; }
+
+        // Respawns every object in TargetWorld that was created from a DataAsset named like Asset while sources were
+        // recorded, with its original overrides, name, tag and current transform. Returns the number of objects
+        // replaced.
+        std::size_t Reinstantiate(World* TargetWorld, const DataAsset& Asset);
+
+    private:
+        bool bRecordSources = false;
     };
 }
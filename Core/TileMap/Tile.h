@@ -20,6 +20,8 @@ namespace Core
         uint GetTileIndex() const { return TileIndex; }
         bool IsEmpty() const { return !TileSheetId.has_value(); }
 
+        bool operator==(const Tile& Other) const = default;
+
         nlohmann::json ToJson() const;
         static Tile FromJson(const nlohmann::json& Json);
 
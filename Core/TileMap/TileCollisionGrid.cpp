@@ -0,0 +1,271 @@
+#include "TileCollisionGrid.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "TileMap.h"
+
+namespace Core
+{
+    static_assert(64 % TileMap::ChunkSize == 0, "A row of a chunk has to fit in one word of the grid");
+
+    namespace
+    {
+        // The tile a coordinate falls in; far-off coordinates are clamped well past any map rather than overflowing
+        int ToTile(float Value, float TileSize)
+        {
+            return static_cast<int>(std::clamp(std::floor(Value / TileSize), -1.0e9f, 1.0e9f));
+        }
+
+        // Bits First up to and including Last
+        std::uint64_t WordMask(uint First, uint Last)
+        {
+            const uint Length = Last - First + 1;
+            return (Length >= 64 ? ~0ull : (1ull << Length) - 1ull) << First;
+        }
+    }
+
+    void TileCollisionGrid::Update(const TileMap& Map, const SolidityFunction& IsTileSolid, bool bFull)
+    {
+        if (!bFull && Map.GetRevision() == BuiltRevision)
+        {
+            return;
+        }
+
+        const std::size_t ChunkCount = static_cast<std::size_t>(Map.GetChunkColumns()) * Map.GetChunkRows();
+
+        if (Map.GetWidth() != Width || Map.GetHeight() != Height || Map.GetLayerCount() != LayerCount)
+        {
+            Width = Map.GetWidth();
+            Height = Map.GetHeight();
+            WordsPerRow = (Width + 63) / 64;
+            Bits.assign(static_cast<std::size_t>(WordsPerRow) * Height, 0);
+
+            LayerCount = Map.GetLayerCount();
+            ChunkRevisions.assign(LayerCount * ChunkCount, 0);
+
+            // Versions carry on from the old grid, so nothing built from it can mistake the new one for it
+            ChunkColumns = Map.GetChunkColumns();
+            ChunkRows = Map.GetChunkRows();
+            ++Version;
+            ChunkVersions.assign(ChunkCount, Version);
+            bFull = true;
+        }
+
+        for (uint ChunkY = 0; ChunkY < ChunkRows; ++ChunkY)
+        {
+            for (uint ChunkX = 0; ChunkX < ChunkColumns; ++ChunkX)
+            {
+                bool bChanged = bFull;
+                for (uint Layer = 0; Layer < LayerCount; ++Layer)
+                {
+                    const std::uint64_t Revision = Map.GetChunkRevision(Layer, ChunkX, ChunkY);
+                    std::uint64_t& Built = ChunkRevisions[Layer * ChunkCount + ChunkY * ChunkColumns + ChunkX];
+                    if (Built != Revision)
+                    {
+                        Built = Revision;
+                        bChanged = true;
+                    }
+                }
+
+                if (bChanged && UpdateChunk(Map, ChunkX, ChunkY, IsTileSolid))
+                {
+                    ChunkVersions[ChunkY * ChunkColumns + ChunkX] = ++Version;
+                }
+            }
+        }
+
+        BuiltRevision = Map.GetRevision();
+    }
+
+    bool TileCollisionGrid::UpdateChunk(const TileMap& Map, uint ChunkX, uint ChunkY, const SolidityFunction& IsTileSolid)
+    {
+        const uint FirstX = ChunkX * TileMap::ChunkSize;
+        const uint Shift = FirstX % 64;
+        const uint ColumnCount = std::min(TileMap::ChunkSize, Width - FirstX);
+        const std::uint64_t ChunkMask = WordMask(Shift, Shift + ColumnCount - 1);
+        const uint LastY = std::min(Height, (ChunkY + 1) * TileMap::ChunkSize);
+
+        // Neighbouring tiles are mostly the same few, so the last answer is kept while the tile repeats. Empty
+        // tiles are never asked about, and are never solid.
+        Tile LastTile;
+        bool bLastSolid = false;
+        bool bChanged = false;
+
+        for (uint Y = ChunkY * TileMap::ChunkSize; Y < LastY; ++Y)
+        {
+            std::uint64_t Solid = 0;
+            for (uint Layer = 0; Layer < LayerCount; ++Layer)
+            {
+                for (std::uint32_t Occupied = Map.GetChunkRowOccupancy(Layer, ChunkX, Y); Occupied != 0;
+                     Occupied &= Occupied - 1)
+                {
+                    const uint Column = std::countr_zero(Occupied);
+                    if ((Solid >> Column) & 1)
+                    {
+                        continue;
+                    }
+
+                    const Tile& Current = Map.GetTile(FirstX + Column, Y, Layer);
+                    if (!(Current == LastTile))
+                    {
+                        LastTile = Current;
+                        bLastSolid = IsTileSolid(Current);
+                    }
+                    if (bLastSolid)
+                    {
+                        Solid |= 1ull << Column;
+                    }
+                }
+            }
+
+            std::uint64_t& Word = Bits[static_cast<std::size_t>(Y) * WordsPerRow + FirstX / 64];
+            const std::uint64_t Updated = (Word & ~ChunkMask) | (Solid << Shift);
+            bChanged = bChanged || Updated != Word;
+            Word = Updated;
+        }
+
+        return bChanged;
+    }
+
+    std::size_t TileCollisionGrid::GetSolidCount() const
+    {
+        std::size_t Count = 0;
+        for (const std::uint64_t Word : Bits)
+        {
+            Count += std::popcount(Word);
+        }
+        return Count;
+    }
+
+    bool TileCollisionGrid::IsColumnSolid(int X, int MinY, int MaxY) const
+    {
+        const std::uint64_t* Word = Bits.data() + static_cast<std::size_t>(MinY) * WordsPerRow + X / 64;
+        for (int Y = MinY; Y <= MaxY; ++Y, Word += WordsPerRow)
+        {
+            if ((*Word >> (X % 64)) & 1)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool TileCollisionGrid::IsRowSolid(int Y, int MinX, int MaxX) const
+    {
+        const std::uint64_t* Row = Bits.data() + static_cast<std::size_t>(Y) * WordsPerRow;
+        const uint FirstWord = MinX / 64;
+        const uint LastWord = MaxX / 64;
+
+        for (uint WordIndex = FirstWord; WordIndex <= LastWord; ++WordIndex)
+        {
+            const uint First = WordIndex == FirstWord ? MinX % 64 : 0;
+            const uint Last = WordIndex == LastWord ? MaxX % 64 : 63;
+            if (Row[WordIndex] & WordMask(First, Last))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    CollisionMove TileCollisionGrid::Sweep(const CollisionBox& Box, float DeltaX, float DeltaY, float TileSize) const
+    {
+        CollisionMove Move;
+        Move.X = SweepX(Box, DeltaX, TileSize, Move.bBlockedX);
+
+        CollisionBox Moved = Box;
+        Moved.Left += Move.X;
+        Move.Y = SweepY(Moved, DeltaY, TileSize, Move.bBlockedY);
+
+        return Move;
+    }
+
+    float TileCollisionGrid::SweepX(const CollisionBox& Box, float Delta, float TileSize, bool& bBlocked) const
+    {
+        const float Skin = TileSize * SkinFraction;
+
+        // Rows the box overlaps. An edge on a tile boundary, or within the skin of one, does not reach the next row.
+        const int MinY = std::max(ToTile(Box.Top + Skin, TileSize), 0);
+        const int MaxY = std::min(ToTile(Box.Top + Box.Height - Skin, TileSize), static_cast<int>(Height) - 1);
+        if (Delta == 0.0f || MinY > MaxY)
+        {
+            return Delta;
+        }
+
+        // Columns past the one the leading edge is in now, up to the one it would end in. A box already overlapping
+        // a solid tile is not held by it, so it can always move out.
+        if (Delta > 0.0f)
+        {
+            const float Right = Box.Left + Box.Width;
+            const int First = std::max(ToTile(Right - Skin, TileSize) + 1, 0);
+            const int Last = std::min(ToTile(Right + Delta - Skin, TileSize), static_cast<int>(Width) - 1);
+            for (int X = First; X <= Last; ++X)
+            {
+                if (IsColumnSolid(X, MinY, MaxY))
+                {
+                    bBlocked = true;
+                    return std::max(X * TileSize - Right, 0.0f);
+                }
+            }
+        }
+        else
+        {
+            const int First = std::min(ToTile(Box.Left + Skin, TileSize) - 1, static_cast<int>(Width) - 1);
+            const int Last = std::max(ToTile(Box.Left + Delta + Skin, TileSize), 0);
+            for (int X = First; X >= Last; --X)
+            {
+                if (IsColumnSolid(X, MinY, MaxY))
+                {
+                    bBlocked = true;
+                    return std::min((X + 1) * TileSize - Box.Left, 0.0f);
+                }
+            }
+        }
+
+        return Delta;
+    }
+
+    float TileCollisionGrid::SweepY(const CollisionBox& Box, float Delta, float TileSize, bool& bBlocked) const
+    {
+        const float Skin = TileSize * SkinFraction;
+
+        const int MinX = std::max(ToTile(Box.Left + Skin, TileSize), 0);
+        const int MaxX = std::min(ToTile(Box.Left + Box.Width - Skin, TileSize), static_cast<int>(Width) - 1);
+        if (Delta == 0.0f || MinX > MaxX)
+        {
+            return Delta;
+        }
+
+        if (Delta > 0.0f)
+        {
+            const float Bottom = Box.Top + Box.Height;
+            const int First = std::max(ToTile(Bottom - Skin, TileSize) + 1, 0);
+            const int Last = std::min(ToTile(Bottom + Delta - Skin, TileSize), static_cast<int>(Height) - 1);
+            for (int Y = First; Y <= Last; ++Y)
+            {
+                if (IsRowSolid(Y, MinX, MaxX))
+                {
+                    bBlocked = true;
+                    return std::max(Y * TileSize - Bottom, 0.0f);
+                }
+            }
+        }
+        else
+        {
+            const int First = std::min(ToTile(Box.Top + Skin, TileSize) - 1, static_cast<int>(Height) - 1);
+            const int Last = std::max(ToTile(Box.Top + Delta + Skin, TileSize), 0);
+            for (int Y = First; Y >= Last; --Y)
+            {
+                if (IsRowSolid(Y, MinX, MaxX))
+                {
+                    bBlocked = true;
+                    return std::min((Y + 1) * TileSize - Box.Top, 0.0f);
+                }
+            }
+        }
+
+        return Delta;
+    }
+}
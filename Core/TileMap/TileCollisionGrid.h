@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Tile.h"
+#include "../Common.h"
+
+namespace Core
+{
+    class TileMap;
+
+    // An axis-aligned box in the grid's local space, in the same units as the tile size it is swept with
+    struct CollisionBox
+    {
+        float Left = 0.0f;
+        float Top = 0.0f;
+        float Width = 0.0f;
+        float Height = 0.0f;
+    };
+
+    // How far a box got along each axis, and whether a solid tile stopped it
+    struct CollisionMove
+    {
+        float X = 0.0f;
+        float Y = 0.0f;
+        bool bBlockedX = false;
+        bool bBlockedY = false;
+    };
+
+    // A bit per tile of a TileMap, set when the tile on any layer there is solid, with a swept-AABB resolver against
+    // it. Tiles outside the map are open.
+    class TileCollisionGrid
+    {
+    public:
+        using SolidityFunction = std::function<bool(const Tile&)>;
+
+        // How far, as a fraction of a tile, a box may rest inside a solid tile it touches without counting as overlapping
+        static constexpr float SkinFraction = 1.0f / 1024.0f;
+
+        // Re-evaluates only the chunks whose revision changed on some layer since the last update. The whole map is
+        // when its size or layer count changed, or when bFull is set because IsTileSolid now answers differently.
+        void Update(const TileMap& Map, const SolidityFunction& IsTileSolid, bool bFull = false);
+
+        uint GetWidth() const { return Width; }
+        uint GetHeight() const { return Height; }
+        std::size_t GetSolidCount() const;
+
+        bool IsSolid(int X, int Y) const
+        {
+            if (X < 0 || Y < 0 || X >= static_cast<int>(Width) || Y >= static_cast<int>(Height))
+            {
+                return false;
+            }
+            return (Bits[static_cast<std::size_t>(Y) * WordsPerRow + X / 64] >> (X % 64)) & 1;
+        }
+
+        // Chunks share TileMap's layout. A chunk's version changes only when a tile in it became solid or open, so
+        // edits that leave solidity alone, like repainting a floor, keep it. The grid's version is the latest of them.
+        uint GetChunkColumns() const { return ChunkColumns; }
+        uint GetChunkRows() const { return ChunkRows; }
+        std::uint64_t GetChunkVersion(uint ChunkX, uint ChunkY) const { return ChunkVersions[ChunkY * ChunkColumns + ChunkX]; }
+        std::uint64_t GetVersion() const { return Version; }
+
+        // Moves Box by DeltaX, then by DeltaY from where that stopped, so it can slide along walls. Only the columns
+        // and rows the box's leading edge enters are visited, so the cost follows the distance moved rather than the
+        // map, and a box never passes through a solid tile however far it moves in one step. TileSize is the edge
+        // length of a tile in Box's units.
+        CollisionMove Sweep(const CollisionBox& Box, float DeltaX, float DeltaY, float TileSize) const;
+
+    private:
+        float SweepX(const CollisionBox& Box, float Delta, float TileSize, bool& bBlocked) const;
+        float SweepY(const CollisionBox& Box, float Delta, float TileSize, bool& bBlocked) const;
+
+        // Inclusive ranges, already clipped to the map
+        bool IsColumnSolid(int X, int MinY, int MaxY) const;
+        bool IsRowSolid(int Y, int MinX, int MaxX) const;
+
+        // Returns whether any bit changed
+        bool UpdateChunk(const TileMap& Map, uint ChunkX, uint ChunkY, const SolidityFunction& IsTileSolid);
+
+        uint Width = 0;
+        uint Height = 0;
+        uint WordsPerRow = 0;
+        std::vector<std::uint64_t> Bits;
+
+        // The map revision and the chunk revisions per layer, layer by layer, the bits were last built from
+        std::uint64_t BuiltRevision = 0;
+        uint LayerCount = 0;
+        std::vector<std::uint64_t> ChunkRevisions;
+
+        uint ChunkColumns = 0;
+        uint ChunkRows = 0;
+        std::vector<std::uint64_t> ChunkVersions;
+        std::uint64_t Version = 0;
+    };
+}
@@ -1,7 +1,28 @@
 #include "TileMap.h"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
 namespace Core
 {
+    namespace
+    {
+        std::atomic<std::uint64_t> NextRevision{1};
+
+        std::uint64_t ReserveRevisions(std::size_t Count)
+        {
+            return NextRevision.fetch_add(Count, std::memory_order_relaxed);
+        }
+
+        // Bits First up to, not including, End
+        std::uint32_t SpanMask(uint First, uint End)
+        {
+            const uint Length = End - First;
+            return (Length >= 32 ? ~0u : (1u << Length) - 1u) << First;
+        }
+    }
+
     TileMap::TileMap(uint Width, uint Height)
         : Width(0)
           , Height(0)
@@ -11,12 +32,7 @@ namespace Core
 
     void TileMap::SetTile(uint X, uint Y, uint Layer, uint TileSheetId, uint TileIndex)
     {
-        if (!IsValidCoordinate(X, Y) || !IsValidLayer(Layer))
-        {
-            return;
-        }
-
-        Layers[Layer][GetIndex(X, Y)] = Tile(TileSheetId, TileIndex);
+        SetTile(X, Y, Layer, Tile(TileSheetId, TileIndex));
     }
 
     void TileMap::SetTile(uint X, uint Y, uint Layer, const Tile& InTile)
@@ -26,41 +42,38 @@ namespace Core
             return;
         }
 
-        Layers[Layer][GetIndex(X, Y)] = InTile;
-    }
-
-    const Tile& TileMap::GetTile(uint X, uint Y, uint Layer) const
-    {
-        static const Tile EmptyTile;
-
-        if (!IsValidCoordinate(X, Y) || !IsValidLayer(Layer))
+        TileLayer& Target = Layers[Layer];
+        Tile& Slot = Target.Tiles[GetIndex(X, Y)];
+        if (Slot.IsEmpty() != InTile.IsEmpty())
         {
-            return EmptyTile;
+            SetOccupied(Target, X, Y, !InTile.IsEmpty());
         }
-
-        return Layers[Layer][GetIndex(X, Y)];
+        Slot = InTile;
+        StampChunk(Target, X, Y);
     }
 
-    Tile& TileMap::GetTile(uint X, uint Y, uint Layer)
+    const Tile& TileMap::GetTile(uint X, uint Y, uint Layer) const
     {
-        static Tile EmptyTile;
+        static const Tile EmptyTile;
 
         if (!IsValidCoordinate(X, Y) || !IsValidLayer(Layer))
         {
             return EmptyTile;
         }
 
-        return Layers[Layer][GetIndex(X, Y)];
+        return Layers[Layer].Tiles[GetIndex(X, Y)];
     }
 
     void TileMap::Clear()
     {
-        for (auto& Layer : Layers)
+        for (TileLayer& Layer : Layers)
         {
-            for (Tile& tile : Layer)
+            for (Tile& tile : Layer.Tiles)
             {
                 tile = Tile();
             }
+            StampLayer(Layer);
+            RebuildOccupancy(Layer);
         }
     }
 
@@ -71,16 +84,20 @@ namespace Core
             return;
         }
 
-        for (Tile& tile : Layers[Layer])
+        for (Tile& tile : Layers[Layer].Tiles)
         {
             tile = Tile();
         }
+        StampLayer(Layers[Layer]);
+        RebuildOccupancy(Layers[Layer]);
     }
 
     void TileMap::AddLayer()
     {
-        std::vector<Tile> NewLayer;
-        NewLayer.resize(Width * Height, Tile());
+        TileLayer NewLayer;
+        NewLayer.Tiles.resize(Width * Height, Tile());
+        StampLayer(NewLayer);
+        RebuildOccupancy(NewLayer);
         Layers.push_back(std::move(NewLayer));
     }
 
@@ -92,6 +109,7 @@ namespace Core
         }
 
         Layers.erase(Layers.begin() + Layer);
+        Revision = ReserveRevisions(1);
     }
 
     void TileMap::SwapLayers(uint LayerA, uint LayerB)
@@ -107,6 +125,7 @@ namespace Core
         }
 
         std::swap(Layers[LayerA], Layers[LayerB]);
+        Revision = ReserveRevisions(1);
     }
 
     const std::vector<Tile>& TileMap::GetLayerTiles(uint Layer) const
@@ -118,7 +137,241 @@ namespace Core
             return EmptyLayer;
         }
 
-        return Layers[Layer];
+        return Layers[Layer].Tiles;
+    }
+
+    std::span<const Tile> TileMap::GetRow(uint Layer, uint X, uint Y, uint Count) const
+    {
+        if (!IsValidLayer(Layer) || Y >= Height || X >= Width || Count > Width - X)
+        {
+            return {};
+        }
+
+        return std::span<const Tile>(Layers[Layer].Tiles).subspan(GetIndex(X, Y), Count);
+    }
+
+    std::span<Tile> TileMap::BeginRowEdit(uint Layer, uint X, uint Y, uint Count)
+    {
+        if (!IsValidLayer(Layer) || Y >= Height || X >= Width || Count > Width - X || Count == 0)
+        {
+            return {};
+        }
+
+        return std::span<Tile>(Layers[Layer].Tiles).subspan(GetIndex(X, Y), Count);
+    }
+
+    void TileMap::EndRowEdit(TileLayer& Target, uint X, uint Y, uint Count)
+    {
+        StampChunks(Target, X, Y, Count);
+
+        // Rebuilds the row's bits chunk by chunk over the edited stretch
+        const Tile* Row = Target.Tiles.data() + GetIndex(0, Y);
+        const uint End = X + Count;
+        for (uint ChunkStart = X - X % ChunkSize; ChunkStart < End; ChunkStart += ChunkSize)
+        {
+            const uint First = std::max(X, ChunkStart);
+            const uint Last = std::min(End, ChunkStart + ChunkSize);
+
+            std::uint32_t Bits = 0;
+            for (uint Column = First; Column < Last; ++Column)
+            {
+                Bits |= static_cast<std::uint32_t>(!Row[Column].IsEmpty()) << (Column - ChunkStart);
+            }
+
+            const std::size_t ChunkIndex = GetChunkIndex(ChunkStart, Y);
+            std::uint32_t& Occupancy = Target.Occupancy[ChunkIndex * ChunkSize + Y % ChunkSize];
+            const std::uint32_t Mask = SpanMask(First - ChunkStart, Last - ChunkStart);
+            const int Delta = std::popcount(Bits) - std::popcount(Occupancy & Mask);
+
+            Occupancy = (Occupancy & ~Mask) | Bits;
+            Target.ChunkTileCounts[ChunkIndex] = static_cast<std::uint16_t>(Target.ChunkTileCounts[ChunkIndex] + Delta);
+            Target.TileCount += Delta;
+        }
+    }
+
+    std::uint64_t TileMap::GetChunkRevision(uint Layer, uint ChunkX, uint ChunkY) const
+    {
+        if (!IsValidLayer(Layer) || ChunkX >= GetChunkColumns() || ChunkY >= GetChunkRows())
+        {
+            return 0;
+        }
+
+        return Layers[Layer].ChunkRevisions[ChunkY * GetChunkColumns() + ChunkX];
+    }
+
+    std::size_t TileMap::GetTileCount(uint Layer) const
+    {
+        return IsValidLayer(Layer) ? Layers[Layer].TileCount : 0;
+    }
+
+    std::size_t TileMap::GetChunkTileCount(uint Layer, uint ChunkX, uint ChunkY) const
+    {
+        if (!IsValidLayer(Layer) || ChunkX >= GetChunkColumns() || ChunkY >= GetChunkRows())
+        {
+            return 0;
+        }
+
+        return Layers[Layer].ChunkTileCounts[ChunkY * GetChunkColumns() + ChunkX];
+    }
+
+    std::uint32_t TileMap::GetChunkRowOccupancy(uint Layer, uint ChunkX, uint Y) const
+    {
+        if (!IsValidLayer(Layer) || ChunkX >= GetChunkColumns() || Y >= Height)
+        {
+            return 0;
+        }
+
+        return Layers[Layer].Occupancy[GetChunkIndex(ChunkX * ChunkSize, Y) * ChunkSize + Y % ChunkSize];
+    }
+
+    std::size_t TileMap::CountTiles(uint Layer, uint X, uint Y, uint RegionWidth, uint RegionHeight) const
+    {
+        if (!IsValidLayer(Layer) || !IsValidCoordinate(X, Y))
+        {
+            return 0;
+        }
+
+        return CountRegion(Layers[Layer], X, Y, std::min(RegionWidth, Width - X), std::min(RegionHeight, Height - Y), false);
+    }
+
+    bool TileMap::IsRegionEmpty(uint Layer, uint X, uint Y, uint RegionWidth, uint RegionHeight) const
+    {
+        if (!IsValidLayer(Layer) || !IsValidCoordinate(X, Y))
+        {
+            return true;
+        }
+
+        return CountRegion(Layers[Layer], X, Y, std::min(RegionWidth, Width - X), std::min(RegionHeight, Height - Y), true) == 0;
+    }
+
+    std::size_t TileMap::CountRegion(const TileLayer& Source, uint X, uint Y, uint RegionWidth, uint RegionHeight,
+                                     bool bAnyTile) const
+    {
+        if (RegionWidth == 0 || RegionHeight == 0)
+        {
+            return 0;
+        }
+
+        const uint EndX = X + RegionWidth;
+        const uint EndY = Y + RegionHeight;
+        std::size_t Count = 0;
+
+        for (uint ChunkY = Y / ChunkSize; ChunkY * ChunkSize < EndY; ++ChunkY)
+        {
+            const uint FirstRow = std::max(Y, ChunkY * ChunkSize);
+            const uint LastRow = std::min(EndY, (ChunkY + 1) * ChunkSize);
+
+            for (uint ChunkX = X / ChunkSize; ChunkX * ChunkSize < EndX; ++ChunkX)
+            {
+                const std::size_t ChunkIndex = static_cast<std::size_t>(ChunkY) * GetChunkColumns() + ChunkX;
+                const std::uint16_t ChunkCount = Source.ChunkTileCounts[ChunkIndex];
+                if (ChunkCount == 0)
+                {
+                    continue;
+                }
+
+                const uint FirstColumn = std::max(X, ChunkX * ChunkSize);
+                const uint LastColumn = std::min(EndX, (ChunkX + 1) * ChunkSize);
+
+                // Chunks wholly inside the region count without looking at their bits; edge chunks end at the map edge
+                const bool bCoversColumns = FirstColumn == ChunkX * ChunkSize && LastColumn == std::min(Width, (ChunkX + 1) * ChunkSize);
+                const bool bCoversRows = FirstRow == ChunkY * ChunkSize && LastRow == std::min(Height, (ChunkY + 1) * ChunkSize);
+                if (bCoversColumns && bCoversRows)
+                {
+                    Count += ChunkCount;
+                }
+                else
+                {
+                    const std::uint32_t Mask = SpanMask(FirstColumn - ChunkX * ChunkSize, LastColumn - ChunkX * ChunkSize);
+                    const std::uint32_t* Rows = Source.Occupancy.data() + ChunkIndex * ChunkSize;
+                    for (uint Row = FirstRow; Row < LastRow; ++Row)
+                    {
+                        Count += std::popcount(Rows[Row % ChunkSize] & Mask);
+                    }
+                }
+
+                if (bAnyTile && Count > 0)
+                {
+                    return Count;
+                }
+            }
+        }
+
+        return Count;
+    }
+
+    std::optional<TileMapBounds> TileMap::GetUsedBounds(uint Layer) const
+    {
+        if (!IsValidLayer(Layer) || Layers[Layer].TileCount == 0)
+        {
+            return std::nullopt;
+        }
+
+        const TileLayer& Source = Layers[Layer];
+        const uint ChunkColumns = GetChunkColumns();
+        const uint ChunkRows = GetChunkRows();
+
+        TileMapBounds Bounds;
+        Bounds.MinX = Width;
+        Bounds.MinY = Height;
+
+        // Each occupied chunk narrows the bounds from its row bits alone
+        for (uint ChunkY = 0; ChunkY < ChunkRows; ++ChunkY)
+        {
+            for (uint ChunkX = 0; ChunkX < ChunkColumns; ++ChunkX)
+            {
+                const std::size_t ChunkIndex = static_cast<std::size_t>(ChunkY) * ChunkColumns + ChunkX;
+                if (Source.ChunkTileCounts[ChunkIndex] == 0)
+                {
+                    continue;
+                }
+
+                const std::uint32_t* Rows = Source.Occupancy.data() + ChunkIndex * ChunkSize;
+                std::uint32_t Columns = 0;
+                uint FirstRow = ChunkSize;
+                uint LastRow = 0;
+                for (uint Row = 0; Row < ChunkSize; ++Row)
+                {
+                    if (Rows[Row] != 0)
+                    {
+                        Columns |= Rows[Row];
+                        FirstRow = std::min(FirstRow, Row);
+                        LastRow = Row;
+                    }
+                }
+
+                Bounds.MinX = std::min(Bounds.MinX, ChunkX * ChunkSize + std::countr_zero(Columns));
+                Bounds.MaxX = std::max(Bounds.MaxX, ChunkX * ChunkSize + 31 - std::countl_zero(Columns));
+                Bounds.MinY = std::min(Bounds.MinY, ChunkY * ChunkSize + FirstRow);
+                Bounds.MaxY = std::max(Bounds.MaxY, ChunkY * ChunkSize + LastRow);
+            }
+        }
+
+        return Bounds;
+    }
+
+    std::optional<TileMapBounds> TileMap::GetUsedBounds() const
+    {
+        std::optional<TileMapBounds> Combined;
+        for (uint Layer = 0; Layer < GetLayerCount(); ++Layer)
+        {
+            const std::optional<TileMapBounds> LayerBounds = GetUsedBounds(Layer);
+            if (!LayerBounds)
+            {
+                continue;
+            }
+            if (!Combined)
+            {
+                Combined = LayerBounds;
+                continue;
+            }
+
+            Combined->MinX = std::min(Combined->MinX, LayerBounds->MinX);
+            Combined->MinY = std::min(Combined->MinY, LayerBounds->MinY);
+            Combined->MaxX = std::max(Combined->MaxX, LayerBounds->MaxX);
+            Combined->MaxY = std::max(Combined->MaxY, LayerBounds->MaxY);
+        }
+        return Combined;
     }
 
     void TileMap::Resize(uint NewWidth, uint NewHeight)
@@ -141,13 +394,13 @@ namespace Core
             return;
         }
 
-        std::vector<std::vector<Tile>> NewLayers;
+        std::vector<TileLayer> NewLayers;
         NewLayers.reserve(Layers.size());
 
-        for (const auto& OldLayer : Layers)
+        for (const TileLayer& OldLayer : Layers)
         {
-            std::vector<Tile> NewLayer;
-            NewLayer.resize(NewWidth * NewHeight, Tile());
+            TileLayer NewLayer;
+            NewLayer.Tiles.resize(NewWidth * NewHeight, Tile());
 
             uint CopyWidth = (NewWidth < Width) ? NewWidth : Width;
             uint CopyHeight = (NewHeight < Height) ? NewHeight : Height;
@@ -158,7 +411,7 @@ namespace Core
                 {
                     uint OldIndex = Y * Width + X;
                     uint NewIndex = Y * NewWidth + X;
-                    NewLayer[NewIndex] = OldLayer[OldIndex];
+                    NewLayer.Tiles[NewIndex] = OldLayer.Tiles[OldIndex];
                 }
             }
 
@@ -168,6 +421,13 @@ namespace Core
         Width = NewWidth;
         Height = NewHeight;
         Layers = std::move(NewLayers);
+
+        // The chunk grid changed with the size
+        for (TileLayer& Layer : Layers)
+        {
+            StampLayer(Layer);
+            RebuildOccupancy(Layer);
+        }
     }
 
     bool TileMap::IsValidCoordinate(uint X, uint Y) const
@@ -184,4 +444,86 @@ namespace Core
     {
         return Y * Width + X;
     }
+
+    std::size_t TileMap::GetChunkIndex(uint X, uint Y) const
+    {
+        return static_cast<std::size_t>(Y / ChunkSize) * GetChunkColumns() + X / ChunkSize;
+    }
+
+    void TileMap::StampChunk(TileLayer& Target, uint X, uint Y)
+    {
+        Revision = ReserveRevisions(1);
+        Target.ChunkRevisions[GetChunkIndex(X, Y)] = Revision;
+    }
+
+    void TileMap::StampChunks(TileLayer& Target, uint X, uint Y, uint Count)
+    {
+        const uint FirstChunk = X / ChunkSize;
+        const uint LastChunk = (X + Count - 1) / ChunkSize;
+        const std::uint64_t First = ReserveRevisions(LastChunk - FirstChunk + 1);
+
+        std::uint64_t* RowRevisions = Target.ChunkRevisions.data() + static_cast<std::size_t>(Y / ChunkSize) * GetChunkColumns();
+        for (uint Chunk = FirstChunk; Chunk <= LastChunk; ++Chunk)
+        {
+            RowRevisions[Chunk] = First + (Chunk - FirstChunk);
+        }
+        Revision = First + (LastChunk - FirstChunk);
+    }
+
+    void TileMap::StampLayer(TileLayer& Target)
+    {
+        const std::size_t ChunkCount = static_cast<std::size_t>(GetChunkColumns()) * GetChunkRows();
+        const std::uint64_t First = ReserveRevisions(ChunkCount + 1);
+        Revision = First + ChunkCount;
+
+        Target.ChunkRevisions.resize(ChunkCount);
+        for (std::size_t Index = 0; Index < ChunkCount; ++Index)
+        {
+            Target.ChunkRevisions[Index] = First + Index;
+        }
+    }
+
+    void TileMap::SetOccupied(TileLayer& Target, uint X, uint Y, bool bOccupied)
+    {
+        const std::size_t ChunkIndex = GetChunkIndex(X, Y);
+        std::uint32_t& Occupancy = Target.Occupancy[ChunkIndex * ChunkSize + Y % ChunkSize];
+        const std::uint32_t Bit = 1u << (X % ChunkSize);
+
+        if (bOccupied)
+        {
+            Occupancy |= Bit;
+            ++Target.ChunkTileCounts[ChunkIndex];
+            ++Target.TileCount;
+        }
+        else
+        {
+            Occupancy &= ~Bit;
+            --Target.ChunkTileCounts[ChunkIndex];
+            --Target.TileCount;
+        }
+    }
+
+    void TileMap::RebuildOccupancy(TileLayer& Target) const
+    {
+        const std::size_t ChunkCount = static_cast<std::size_t>(GetChunkColumns()) * GetChunkRows();
+        Target.Occupancy.assign(ChunkCount * ChunkSize, 0);
+        Target.ChunkTileCounts.assign(ChunkCount, 0);
+        Target.TileCount = 0;
+
+        for (uint Y = 0; Y < Height; ++Y)
+        {
+            for (uint X = 0; X < Width; ++X)
+            {
+                if (Target.Tiles[GetIndex(X, Y)].IsEmpty())
+                {
+                    continue;
+                }
+
+                const std::size_t ChunkIndex = GetChunkIndex(X, Y);
+                Target.Occupancy[ChunkIndex * ChunkSize + Y % ChunkSize] |= 1u << (X % ChunkSize);
+                ++Target.ChunkTileCounts[ChunkIndex];
+                ++Target.TileCount;
+            }
+        }
+    }
 }
@@ -1,20 +1,35 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
 #include <vector>
 #include "Tile.h"
 #include "../Common.h"
 
 namespace Core
 {
+	// Inclusive tile coordinates of the smallest rectangle holding every non-empty tile
+	struct TileMapBounds
+	{
+		uint MinX = 0;
+		uint MinY = 0;
+		uint MaxX = 0;
+		uint MaxY = 0;
+	};
+
 	class TileMap
 	{
 	public:
+		// Edge length, in tiles, of the square chunks changes and occupancy are tracked in
+		static constexpr uint ChunkSize = 32;
+
 		TileMap(uint Width, uint Height);
 
 		void SetTile(uint X, uint Y, uint Layer, uint TileSheetId, uint TileIndex);
 		void SetTile(uint X, uint Y, uint Layer, const Tile& InTile);
 		const Tile& GetTile(uint X, uint Y, uint Layer) const;
-		Tile& GetTile(uint X, uint Y, uint Layer);
 
 		void Clear();
 		void ClearLayer(uint Layer);
@@ -28,16 +43,87 @@ namespace Core
 		uint GetHeight() const { return Height; }
 		const std::vector<Tile>& GetLayerTiles(uint Layer) const;
 
+		// Count tiles of row Y from X on, for bulk edits such as TileMapOps. Empty unless all of them are on the map.
+		std::span<const Tile> GetRow(uint Layer, uint X, uint Y, uint Count) const;
+
+		// Calls Edit with the same tiles as GetRow, writable, then stamps their chunks and updates occupancy. Returns
+		// false without calling it when the row is off the map.
+		template <typename EditFunction>
+		bool EditRow(uint Layer, uint X, uint Y, uint Count, EditFunction&& Edit)
+		{
+			const std::span<Tile> Row = BeginRowEdit(Layer, X, Y, Count);
+			if (Row.empty())
+			{
+				return false;
+			}
+
+			Edit(Row);
+			EndRowEdit(Layers[Layer], X, Y, Count);
+			return true;
+		}
+
+		uint GetChunkColumns() const { return (Width + ChunkSize - 1) / ChunkSize; }
+		uint GetChunkRows() const { return (Height + ChunkSize - 1) / ChunkSize; }
+
+		// Changes whenever the chunk's tiles may have. Revisions are unique across every map, so a chunk that still
+		// has a revision seen before still has the tiles it had then, at the same coordinates.
+		std::uint64_t GetChunkRevision(uint Layer, uint ChunkX, uint ChunkY) const;
+
+		// Changes whenever any tile or layer may have, and is unique across every map in the same way
+		std::uint64_t GetRevision() const { return Revision; }
+
+		// Occupancy is kept as it changes, so these cost time in proportion to chunks rather than tiles
+		std::size_t GetTileCount(uint Layer) const;
+		std::size_t GetChunkTileCount(uint Layer, uint ChunkX, uint ChunkY) const;
+		bool IsChunkEmpty(uint Layer, uint ChunkX, uint ChunkY) const { return GetChunkTileCount(Layer, ChunkX, ChunkY) == 0; }
+
+		// Bit N is set when tile (ChunkX * ChunkSize + N, Y) is not empty
+		std::uint32_t GetChunkRowOccupancy(uint Layer, uint ChunkX, uint Y) const;
+
+		// Non-empty tiles in a rectangle, clipped to the map
+		std::size_t CountTiles(uint Layer, uint X, uint Y, uint RegionWidth, uint RegionHeight) const;
+		bool IsRegionEmpty(uint Layer, uint X, uint Y, uint RegionWidth, uint RegionHeight) const;
+
+		// Empty when there are no tiles; the overload without a layer covers all of them
+		std::optional<TileMapBounds> GetUsedBounds(uint Layer) const;
+		std::optional<TileMapBounds> GetUsedBounds() const;
+
 		void Resize(uint NewWidth, uint NewHeight);
 
 		bool IsValidCoordinate(uint X, uint Y) const;
 		bool IsValidLayer(uint Layer) const;
 
 	private:
+		struct TileLayer
+		{
+			std::vector<Tile> Tiles;
+			std::vector<std::uint64_t> ChunkRevisions;
+
+			// ChunkSize rows of bits per chunk, in chunk order
+			std::vector<std::uint32_t> Occupancy;
+			std::vector<std::uint16_t> ChunkTileCounts;
+			std::size_t TileCount = 0;
+		};
+
 		uint Width;
 		uint Height;
-		std::vector<std::vector<Tile>> Layers;
+		std::vector<TileLayer> Layers;
+		std::uint64_t Revision = 0;
 
 		uint GetIndex(uint X, uint Y) const;
+		std::size_t GetChunkIndex(uint X, uint Y) const;
+
+		std::span<Tile> BeginRowEdit(uint Layer, uint X, uint Y, uint Count);
+		void EndRowEdit(TileLayer& Target, uint X, uint Y, uint Count);
+
+		void StampChunk(TileLayer& Target, uint X, uint Y);
+		void StampChunks(TileLayer& Target, uint X, uint Y, uint Count);
+		void StampLayer(TileLayer& Target);
+
+		void SetOccupied(TileLayer& Target, uint X, uint Y, bool bOccupied);
+		void RebuildOccupancy(TileLayer& Target) const;
+
+		// Counts tiles in a rectangle already clipped to the map, stopping at the first when bAnyTile is set
+		std::size_t CountRegion(const TileLayer& Source, uint X, uint Y, uint RegionWidth, uint RegionHeight, bool bAnyTile) const;
 	};
 }
@@ -0,0 +1,265 @@
+#include "TileMapOps.h"
+
+#include <algorithm>
+#include <span>
+#include <utility>
+
+#include "TileMap.h"
+
+namespace Core
+{
+    namespace
+    {
+        // Clips a rectangle to the map, returning false when nothing is left of it
+        bool ClipRect(const TileMap& Map, uint X, uint Y, uint& Width, uint& Height)
+        {
+            if (X >= Map.GetWidth() || Y >= Map.GetHeight())
+            {
+                return false;
+            }
+
+            Width = std::min(Width, Map.GetWidth() - X);
+            Height = std::min(Height, Map.GetHeight() - Y);
+            return Width > 0 && Height > 0;
+        }
+    }
+
+    namespace TileMapOps
+    {
+        std::size_t FloodFill(TileMap& Map, uint Layer, uint X, uint Y, const Tile& Replacement,
+                              std::vector<TileSpan>* FilledSpans)
+        {
+            if (!Map.IsValidLayer(Layer) || !Map.IsValidCoordinate(X, Y))
+            {
+                return 0;
+            }
+
+            // A copy, since the tile it came from is about to be overwritten
+            const Tile Target = Map.GetTile(X, Y, Layer);
+            if (Target == Replacement)
+            {
+                return 0;
+            }
+
+            const uint MapWidth = Map.GetWidth();
+            const uint MapHeight = Map.GetHeight();
+            std::size_t FilledCount = 0;
+
+            std::vector<std::pair<uint, uint>> Seeds;
+            Seeds.emplace_back(X, Y);
+
+            // Pushes one seed per run of matching tiles in a neighbouring row, under the span just filled
+            auto PushSeeds = [&](uint Left, uint Length, uint NeighbourY)
+            {
+                const std::span<const Tile> Neighbour = Map.GetRow(Layer, Left, NeighbourY, Length);
+                bool bInRun = false;
+                for (uint Offset = 0; Offset < Length; ++Offset)
+                {
+                    const bool bMatches = Neighbour[Offset] == Target;
+                    if (bMatches && !bInRun)
+                    {
+                        Seeds.emplace_back(Left + Offset, NeighbourY);
+                    }
+                    bInRun = bMatches;
+                }
+            };
+
+            while (!Seeds.empty())
+            {
+                const auto [SeedX, SeedY] = Seeds.back();
+                Seeds.pop_back();
+
+                const std::span<const Tile> Row = Map.GetRow(Layer, 0, SeedY, MapWidth);
+
+                // Already filled from another seed
+                if (!(Row[SeedX] == Target))
+                {
+                    continue;
+                }
+
+                uint Left = SeedX;
+                while (Left > 0 && Row[Left - 1] == Target)
+                {
+                    --Left;
+                }
+                uint Right = SeedX + 1;
+                while (Right < MapWidth && Row[Right] == Target)
+                {
+                    ++Right;
+                }
+
+                const uint Length = Right - Left;
+                Map.EditRow(Layer, Left, SeedY, Length, [&Replacement](std::span<Tile> Filled)
+                {
+                    std::fill(Filled.begin(), Filled.end(), Replacement);
+                });
+
+                FilledCount += Length;
+                if (FilledSpans)
+                {
+                    FilledSpans->push_back({Left, SeedY, Length});
+                }
+
+                if (SeedY > 0)
+                {
+                    PushSeeds(Left, Length, SeedY - 1);
+                }
+                if (SeedY + 1 < MapHeight)
+                {
+                    PushSeeds(Left, Length, SeedY + 1);
+                }
+            }
+
+            return FilledCount;
+        }
+
+        std::size_t FillRect(TileMap& Map, uint Layer, uint X, uint Y, uint Width, uint Height, const Tile& Value)
+        {
+            if (!Map.IsValidLayer(Layer) || !ClipRect(Map, X, Y, Width, Height))
+            {
+                return 0;
+            }
+
+            for (uint Row = 0; Row < Height; ++Row)
+            {
+                Map.EditRow(Layer, X, Y + Row, Width, [&Value](std::span<Tile> Tiles)
+                {
+                    std::fill(Tiles.begin(), Tiles.end(), Value);
+                });
+            }
+
+            return static_cast<std::size_t>(Width) * Height;
+        }
+
+        std::size_t ClearRect(TileMap& Map, uint Layer, uint X, uint Y, uint Width, uint Height)
+        {
+            return FillRect(Map, Layer, X, Y, Width, Height, Tile());
+        }
+
+        TileRegion CopyRegion(const TileMap& Map, uint Layer, uint X, uint Y, uint Width, uint Height)
+        {
+            TileRegion Region;
+            if (!Map.IsValidLayer(Layer) || !ClipRect(Map, X, Y, Width, Height))
+            {
+                return Region;
+            }
+
+            Region.Width = Width;
+            Region.Height = Height;
+            Region.Tiles.resize(static_cast<std::size_t>(Width) * Height);
+
+            for (uint Row = 0; Row < Height; ++Row)
+            {
+                const std::span<const Tile> Tiles = Map.GetRow(Layer, X, Y + Row, Width);
+                std::copy(Tiles.begin(), Tiles.end(), Region.Tiles.begin() + static_cast<std::size_t>(Row) * Width);
+            }
+
+            return Region;
+        }
+
+        std::size_t PasteRegion(TileMap& Map, uint Layer, uint X, uint Y, const TileRegion& Region)
+        {
+            uint Width = Region.Width;
+            uint Height = Region.Height;
+            if (!Map.IsValidLayer(Layer) || Region.IsEmpty() || !ClipRect(Map, X, Y, Width, Height))
+            {
+                return 0;
+            }
+
+            for (uint Row = 0; Row < Height; ++Row)
+            {
+                const auto Source = Region.Tiles.begin() + static_cast<std::size_t>(Row) * Region.Width;
+                Map.EditRow(Layer, X, Y + Row, Width, [Source, Width](std::span<Tile> Tiles)
+                {
+                    std::copy(Source, Source + Width, Tiles.begin());
+                });
+            }
+
+            return static_cast<std::size_t>(Width) * Height;
+        }
+
+        std::size_t StampRegion(TileMap& Map, uint Layer, uint X, uint Y, const TileRegion& Region)
+        {
+            uint Width = Region.Width;
+            uint Height = Region.Height;
+            if (!Map.IsValidLayer(Layer) || Region.IsEmpty() || !ClipRect(Map, X, Y, Width, Height))
+            {
+                return 0;
+            }
+
+            std::size_t WrittenCount = 0;
+            for (uint Row = 0; Row < Height; ++Row)
+            {
+                const Tile* Source = Region.Tiles.data() + static_cast<std::size_t>(Row) * Region.Width;
+
+                // Only the stretch between the first and last non-empty tile is written
+                uint Start = 0;
+                while (Start < Width && Source[Start].IsEmpty())
+                {
+                    ++Start;
+                }
+                uint End = Width;
+                while (End > Start && Source[End - 1].IsEmpty())
+                {
+                    --End;
+                }
+                if (Start == End)
+                {
+                    continue;
+                }
+
+                Map.EditRow(Layer, X + Start, Y + Row, End - Start, [&](std::span<Tile> Tiles)
+                {
+                    for (uint Column = Start; Column < End; ++Column)
+                    {
+                        if (!Source[Column].IsEmpty())
+                        {
+                            Tiles[Column - Start] = Source[Column];
+                            ++WrittenCount;
+                        }
+                    }
+                });
+            }
+
+            return WrittenCount;
+        }
+
+        std::size_t ReplaceTiles(TileMap& Map, uint Layer, const Tile& From, const Tile& To)
+        {
+            if (!Map.IsValidLayer(Layer) || From == To)
+            {
+                return 0;
+            }
+
+            const uint MapWidth = Map.GetWidth();
+            std::size_t ReplacedCount = 0;
+
+            for (uint Y = 0; Y < Map.GetHeight(); ++Y)
+            {
+                // Only the stretch between the first and last match is written, so rows without one stay unchanged
+                const std::span<const Tile> Row = Map.GetRow(Layer, 0, Y, MapWidth);
+                const auto First = std::find(Row.begin(), Row.end(), From);
+                if (First == Row.end())
+                {
+                    continue;
+                }
+                const auto Last = std::find(Row.rbegin(), Row.rend(), From).base();
+
+                const uint Left = static_cast<uint>(First - Row.begin());
+                Map.EditRow(Layer, Left, Y, static_cast<uint>(Last - First), [&](std::span<Tile> Tiles)
+                {
+                    for (Tile& Current : Tiles)
+                    {
+                        if (Current == From)
+                        {
+                            Current = To;
+                            ++ReplacedCount;
+                        }
+                    }
+                });
+            }
+
+            return ReplacedCount;
+        }
+    }
+}
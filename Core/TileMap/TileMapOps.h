@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include "Tile.h"
+#include "../Common.h"
+
+namespace Core
+{
+    class TileMap;
+
+    // A run of tiles along one row
+    struct TileSpan
+    {
+        uint X = 0;
+        uint Y = 0;
+        uint Length = 0;
+    };
+
+    // A rectangle of tiles lifted off a layer, row-major
+    struct TileRegion
+    {
+        uint Width = 0;
+        uint Height = 0;
+        std::vector<Tile> Tiles;
+
+        bool IsEmpty() const { return Tiles.empty(); }
+    };
+
+    // Bulk edits that work a row at a time on a layer's tile memory instead of through GetTile and SetTile per
+    // cell. Rectangles are clipped to the map; each edit returns how many tiles it wrote.
+    namespace TileMapOps
+    {
+        // Scanline fill of the 4-connected area of tiles matching the one at (X, Y). Each row span filled is
+        // appended to FilledSpans when given.
+        std::size_t FloodFill(TileMap& Map, uint Layer, uint X, uint Y, const Tile& Replacement,
+                              std::vector<TileSpan>* FilledSpans = nullptr);
+
+        std::size_t FillRect(TileMap& Map, uint Layer, uint X, uint Y, uint Width, uint Height, const Tile& Value);
+        std::size_t ClearRect(TileMap& Map, uint Layer, uint X, uint Y, uint Width, uint Height);
+
+        TileRegion CopyRegion(const TileMap& Map, uint Layer, uint X, uint Y, uint Width, uint Height);
+
+        // Writes every tile of Region with its top-left corner at (X, Y)
+        std::size_t PasteRegion(TileMap& Map, uint Layer, uint X, uint Y, const TileRegion& Region);
+
+        // As PasteRegion, but empty tiles in Region leave the map's tiles under them alone
+        std::size_t StampRegion(TileMap& Map, uint Layer, uint X, uint Y, const TileRegion& Region);
+
+        // Replaces every tile equal to From on the layer
+        std::size_t ReplaceTiles(TileMap& Map, uint Layer, const Tile& From, const Tile& To);
+    }
+}
@@ -1,5 +1,13 @@
 ﻿#include "TileSheet.h"
+
+#include <filesystem>
+
+#include "../Assets/AssetPack.h"
+#include "../Assets/CookedJsonCache.h"
+#include "../Assets/MappedFile.h"
+#include "../Log/Log.h"
 #include "../Systems/AssetRegistrySystem.h"
+#include "../ThirdParty/json.hpp"
 
 namespace Core
 {
@@ -35,6 +43,12 @@ namespace Core
         return Rows * Columns;
     }
 
+    bool TileSheet::IsTileSolid(uint TileIndex) const
+    {
+        const uint Word = TileIndex / 64;
+        return Word < SolidTiles.size() && ((SolidTiles[Word] >> (TileIndex % 64)) & 1);
+    }
+
     std::optional<TileSheet> TileSheet::Create(const std::string& Path, AssetRegistrySystem* Registry)
     {
         std::shared_ptr<const sf::Texture> Texture = Registry->Get<sf::Texture>(Path);
@@ -52,6 +66,60 @@ namespace Core
         Sheet.Columns = Size.x / Sheet.TileDimensions.x;
         Sheet.Rows = Size.y / Sheet.TileDimensions.y;
 
+        Sheet.LoadMetadata(Registry);
         return Sheet;
     }
+
+    void TileSheet::LoadMetadata(AssetRegistrySystem* Registry)
+    {
+        const std::string MetadataPath = GetMetadataPath(AbsolutePath);
+
+        std::optional<nlohmann::json> Metadata;
+        const AssetPack* Pack = Registry->GetMountedPack();
+        if (std::optional<AssetPackBlob> Blob = Pack ? Pack->Read(MetadataPath) : std::nullopt)
+        {
+            Metadata = CookedJsonCache::Load(MetadataPath, Blob->Bytes);
+        }
+        else if (std::filesystem::exists(MetadataPath))
+        {
+            if (std::unique_ptr<MappedFile> File = MappedFile::Open(MetadataPath))
+            {
+                Metadata = CookedJsonCache::Load(MetadataPath, File->GetBytes());
+            }
+        }
+
+        // Metadata is optional; without it no tile of the sheet is solid
+        if (!Metadata)
+        {
+            Log::Verbose(ELogCategory::Assets, "Tilesheet %s has no metadata, none of its tiles are solid", Name.c_str());
+            return;
+        }
+
+        const auto SolidList = Metadata->find("solidTiles");
+        if (SolidList == Metadata->end() || !SolidList->is_array())
+        {
+            return;
+        }
+
+        const uint TileCount = GetTileCount();
+        SolidTiles.assign((TileCount + 63) / 64, 0);
+        for (const nlohmann::json& Entry : *SolidList)
+        {
+            if (!Entry.is_number_unsigned() || Entry.get<std::uint64_t>() >= TileCount)
+            {
+                Log::Warning(ELogCategory::Assets, "Tilesheet %s lists solid tile %s, which it does not have", Name.c_str(),
+                             Entry.dump().c_str());
+                continue;
+            }
+
+            const uint TileIndex = Entry.get<uint>();
+            std::uint64_t& Word = SolidTiles[TileIndex / 64];
+            const std::uint64_t Bit = 1ull << (TileIndex % 64);
+            if (!(Word & Bit))
+            {
+                Word |= Bit;
+                ++SolidTileCount;
+            }
+        }
+    }
 }
@@ -1,8 +1,10 @@
 ﻿#pragma once
 
+#include <cstdint>
 #include <optional>
 #include <memory>
 #include <string>
+#include <vector>
 #include <SFML/Graphics/Texture.hpp>
 
 #include "../Common.h"
@@ -16,6 +18,13 @@ namespace Core
     public:
         static std::optional<TileSheet> Create(const std::string& Path, AssetRegistrySystem* Registry);
 
+        // Sheets are stored under a prefixed key, since their texture is already stored under the plain path
+        static std::string GetRegistryKey(const std::string& TexturePath) { return "tilesheet://" + TexturePath; }
+
+        // Optional JSON next to the sheet, e.g. RA_Cavern.tilesheet.json, listing the indices of tiles characters
+        // cannot pass through as "solidTiles"
+        static std::string GetMetadataPath(const std::string& TexturePath) { return TexturePath + ".json"; }
+
         uint GetId() const { return Id; }
         const std::string& GetName() const { return Name; }
         const std::string& GetAbsolutePath() const { return AbsolutePath; }
@@ -29,6 +38,9 @@ namespace Core
         uint GetTileRow(uint TileIndex) const;
         uint GetTileCount() const;
 
+        bool IsTileSolid(uint TileIndex) const;
+        bool HasSolidTiles() const { return SolidTileCount > 0; }
+
         void SetId(uint InId) { Id = InId; }
 
     private:
@@ -39,5 +51,11 @@ namespace Core
         uint Columns = 0;
         uint Rows = 0;
         sf::Vector2u TileDimensions = sf::Vector2u(16, 16);
+
+        // A bit per tile index
+        std::vector<std::uint64_t> SolidTiles;
+        uint SolidTileCount = 0;
+
+        void LoadMetadata(AssetRegistrySystem* Registry);
     };
 }
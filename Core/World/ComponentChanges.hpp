@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace Core
+{
+    class Component;
+
+    // Per-component bookkeeping owned by the World; components only read it
+    struct ComponentChangeTracking
+    {
+        std::uint64_t Version = 0;
+        bool bRegistered = false;
+        bool bChangePending = false;
+    };
+
+    // Everything that happened to one component type during a frame
+    struct ComponentChangeSet
+    {
+        std::vector<Component*> Added;
+        std::vector<Component*> Changed;
+        std::vector<std::uint64_t> Removed;
+
+        bool IsEmpty() const { return Added.empty() && Changed.empty() && Removed.empty(); }
+
+        void Clear()
+        {
+            Added.clear();
+            Changed.clear();
+            Removed.clear();
+        }
+    };
+
+    // Typed view over the changes World published for T at the start of the current frame
+    template <typename T>
+    class ComponentChanges
+    {
+    public:
+        explicit ComponentChanges(const ComponentChangeSet& InSet)
+            : Set(&InSet)
+        {
+        }
+
+        template <typename Func>
+        void ForEachAdded(Func&& Fn) const
+        {
+            for (Component* Comp : Set->Added)
+            {
+                Fn(static_cast<T*>(Comp));
+            }
+        }
+
+        template <typename Func>
+        void ForEachChanged(Func&& Fn) const
+        {
+            for (Component* Comp : Set->Changed)
+            {
+                Fn(static_cast<T*>(Comp));
+            }
+        }
+
+        // World ids of the objects whose T was removed; the components themselves may already be destroyed
+        std::span<const std::uint64_t> GetRemoved() const { return Set->Removed; }
+
+        std::size_t GetAddedCount() const { return Set->Added.size(); }
+        std::size_t GetChangedCount() const { return Set->Changed.size(); }
+        bool IsEmpty() const { return Set->IsEmpty(); }
+
+    private:
+        const ComponentChangeSet* Set;
+    };
+}
@@ -1,6 +1,8 @@
 #include "ComponentManager.h"
 
 #include "../Components/Component.h"
+#include "World.h"
+#include "WorldObject.h"
 #include <ranges>
 
 namespace Core
@@ -12,7 +14,10 @@ namespace Core
 
     void ComponentManager::Attach(const std::shared_ptr<Component>& Component)
     {
-        TypeToComponent.emplace(std::type_index(typeid(*Component)), Component);
+        if (TypeToComponent.emplace(std::type_index(typeid(*Component)), Component).second)
+        {
+            NotifyComponentAttached(*Component);
+        }
     }
 
     bool ComponentManager::Remove(Component* Comp)
@@ -23,9 +28,11 @@ namespace Core
         }
 
         auto it = TypeToComponent.find(std::type_index(typeid(*Comp)));
-        if (it != TypeToComponent.end())
+        if (it != TypeToComponent.end() && it->second.get() == Comp)
         {
+            std::shared_ptr<Component> Removed = std::move(it->second);
             TypeToComponent.erase(it);
+            NotifyComponentRemoved(*Removed);
             return true;
         }
 
@@ -36,7 +43,10 @@ namespace Core
     {
         for (std::shared_ptr<Component>& Component : TypeToComponent | std::views::values)
         {
-            Component->Tick(DeltaTimeS);
+            if (HasPhase(Component->GetPhases(), ComponentPhase::Tick))
+            {
+                Component->Tick(DeltaTimeS);
+            }
         }
     }
 
@@ -44,7 +54,10 @@ namespace Core
     {
         for (std::shared_ptr<Component>& Component : TypeToComponent | std::views::values)
         {
-            Component->Render();
+            if (HasPhase(Component->GetPhases(), ComponentPhase::Render))
+            {
+                Component->Render();
+            }
         }
     }
 
@@ -66,4 +79,20 @@ namespace Core
             }
         }
     }
+
+    void ComponentManager::NotifyComponentAttached(Component& Comp)
+    {
+        if (Owner && Owner->GetWorld())
+        {
+            Owner->GetWorld()->RegisterComponent(*Owner, Comp);
+        }
+    }
+
+    void ComponentManager::NotifyComponentRemoved(Component& Comp)
+    {
+        if (Owner && Owner->GetWorld())
+        {
+            Owner->GetWorld()->UnregisterComponent(*Owner, Comp);
+        }
+    }
 }
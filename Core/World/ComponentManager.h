@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include "../Components/ComponentConcept.hpp"
+#include "../Components/ComponentPhase.hpp"
 
 namespace Core
 {
@@ -26,6 +27,11 @@ namespace Core
             requires IsComponent<T>
         std::shared_ptr<T> Get() const;
 
+        // Same as Get, but marks the component as changed for this frame's change tracking
+        template <class T>
+            requires IsComponent<T>
+        std::shared_ptr<T> Write();
+
         template <class T>
             requires IsComponent<T>
         bool Remove();
@@ -40,6 +46,9 @@ namespace Core
         void Shutdown();
 
     private:
+        void NotifyComponentAttached(Component& Comp);
+        void NotifyComponentRemoved(Component& Comp);
+
         WorldObject* Owner;
         std::unordered_map<std::type_index, std::shared_ptr<Component>> TypeToComponent;
     };
@@ -55,13 +64,26 @@ namespace Core
         return nullptr;
     }
 
+    template <typename T> requires IsComponent<T>
+    std::shared_ptr<T> ComponentManager::Write()
+    {
+        std::shared_ptr<T> Found = Get<T>();
+        if (Found)
+        {
+            Found->MarkChanged();
+        }
+        return Found;
+    }
+
     template <typename T> requires IsComponent<T>
     bool ComponentManager::Remove()
     {
         auto it = TypeToComponent.find(std::type_index(typeid(T)));
         if (it != TypeToComponent.end())
         {
+            std::shared_ptr<Component> Removed = std::move(it->second);
             TypeToComponent.erase(it);
+            NotifyComponentRemoved(*Removed);
             return true;
         }
 
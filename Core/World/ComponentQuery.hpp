@@ -0,0 +1,178 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <future>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace Core
+{
+    class Component;
+
+    // Components of one type, sorted by the owning object's world id
+    struct ComponentTypeList
+    {
+        std::vector<std::uint64_t> ObjectIds;
+        std::vector<Component*> Components;
+        std::uint64_t Version = 0;
+    };
+
+    struct ComponentQueryCacheBase
+    {
+        virtual ~ComponentQueryCacheBase() = default;
+    };
+
+    template <typename... Ts>
+    struct ComponentQueryCache : ComponentQueryCacheBase
+    {
+        static constexpr std::size_t TypeCount = sizeof...(Ts);
+
+        std::array<const ComponentTypeList*, TypeCount> Lists{};
+        std::array<std::uint64_t, TypeCount> Versions{};
+        std::vector<std::tuple<Ts*...>> Rows;
+        bool bBuilt = false;
+
+        bool IsStale() const
+        {
+            if (!bBuilt)
+            {
+                return true;
+            }
+
+            for (std::size_t Index = 0; Index < TypeCount; ++Index)
+            {
+                if (Lists[Index]->Version != Versions[Index])
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void Rebuild()
+        {
+            Rows.clear();
+
+            // Drive the intersection from the smallest list; the others only ever move forward
+            std::size_t Driver = 0;
+            for (std::size_t Index = 1; Index < TypeCount; ++Index)
+            {
+                if (Lists[Index]->ObjectIds.size() < Lists[Driver]->ObjectIds.size())
+                {
+                    Driver = Index;
+                }
+            }
+
+            std::array<std::size_t, TypeCount> Cursors{};
+            std::array<Component*, TypeCount> Matched{};
+
+            for (const std::uint64_t ObjectId : Lists[Driver]->ObjectIds)
+            {
+                bool bHasAll = true;
+                for (std::size_t Index = 0; Index < TypeCount && bHasAll; ++Index)
+                {
+                    const std::vector<std::uint64_t>& Ids = Lists[Index]->ObjectIds;
+                    auto It = std::lower_bound(Ids.begin() + Cursors[Index], Ids.end(), ObjectId);
+                    Cursors[Index] = static_cast<std::size_t>(It - Ids.begin());
+
+                    if (It == Ids.end() || *It != ObjectId)
+                    {
+                        bHasAll = false;
+                    }
+                    else
+                    {
+                        Matched[Index] = Lists[Index]->Components[Cursors[Index]];
+                    }
+                }
+
+                if (bHasAll)
+                {
+                    [&]<std::size_t... Is>(std::index_sequence<Is...>)
+                    {
+                        Rows.emplace_back(static_cast<Ts*>(Matched[Is])...);
+                    }(std::index_sequence_for<Ts...>{});
+                }
+            }
+
+            for (std::size_t Index = 0; Index < TypeCount; ++Index)
+            {
+                Versions[Index] = Lists[Index]->Version;
+            }
+            bBuilt = true;
+        }
+    };
+
+    // View over the cached result of World::Query. Attaching or removing queried component types invalidates it.
+    template <typename... Ts>
+    class ComponentQuery
+    {
+    public:
+        using Row = std::tuple<Ts*...>;
+
+        explicit ComponentQuery(const std::vector<Row>& InRows)
+            : Rows(&InRows)
+        {
+        }
+
+        auto begin() const { return Rows->begin(); }
+        auto end() const { return Rows->end(); }
+        std::size_t size() const { return Rows->size(); }
+        bool empty() const { return Rows->empty(); }
+
+        template <typename Func>
+        void ForEach(Func&& Fn) const
+        {
+            for (const Row& Entry : *Rows)
+            {
+                std::apply(Fn, Entry);
+            }
+        }
+
+        // Splits the rows into contiguous batches across worker threads; small result sets run inline
+        template <typename Func>
+        void ParallelForEach(Func&& Fn, std::size_t MinBatchSize = 256) const
+        {
+            const std::size_t Count = Rows->size();
+            const std::size_t MaxWorkers = std::max(1u, std::thread::hardware_concurrency());
+            const std::size_t BatchCount = std::min(MaxWorkers, Count / std::max<std::size_t>(MinBatchSize, 1));
+
+            if (BatchCount <= 1)
+            {
+                ForEach(Fn);
+                return;
+            }
+
+            const std::size_t BatchSize = (Count + BatchCount - 1) / BatchCount;
+            auto RunBatch = [this, &Fn](std::size_t Begin, std::size_t End)
+            {
+                for (std::size_t Index = Begin; Index < End; ++Index)
+                {
+                    std::apply(Fn, (*Rows)[Index]);
+                }
+            };
+
+            std::vector<std::future<void>> Futures;
+            Futures.reserve(BatchCount - 1);
+            for (std::size_t Batch = 1; Batch < BatchCount; ++Batch)
+            {
+                const std::size_t Begin = Batch * BatchSize;
+                const std::size_t End = std::min(Count, Begin + BatchSize);
+                Futures.push_back(std::async(std::launch::async, RunBatch, Begin, End));
+            }
+
+            RunBatch(0, std::min(Count, BatchSize));
+
+            for (std::future<void>& Future : Futures)
+            {
+                Future.get();
+            }
+        }
+
+    private:
+        const std::vector<Row>* Rows;
+    };
+}
@@ -1,5 +1,6 @@
 #include "ObjectManager.h"
 #include "WorldObject.h"
+#include "World.h"
 #include <algorithm>
 
 namespace Core
@@ -14,6 +15,8 @@ namespace Core
         std::shared_ptr<WorldObject> Object = std::make_shared<WorldObject>(Context, Owner);
         Objects.push_back(Object);
         PendingStartObjects.push_back(Object);
+        Owner->RegisterObjectComponents(*Object);
+        Owner->InvalidateComponentPhaseLists();
         return Object;
     }
 
@@ -21,6 +24,8 @@ namespace Core
     {
         Objects.push_back(Object);
         PendingStartObjects.push_back(Object);
+        Owner->RegisterObjectComponents(*Object);
+        Owner->InvalidateComponentPhaseLists();
     }
 
     std::shared_ptr<WorldObject> ObjectManager::GetByName(const std::string& Name) const
@@ -50,6 +55,14 @@ namespace Core
             return Obj && Obj->GetTag() == ObjectTag::Game;
         };
 
+        for (const std::shared_ptr<WorldObject>& Object : Objects)
+        {
+            if (IsGameObject(Object))
+            {
+                Owner->UnregisterObjectComponents(*Object);
+            }
+        }
+
         Objects.erase(
             std::remove_if(Objects.begin(), Objects.end(), IsGameObject),
             Objects.end()
@@ -71,6 +84,8 @@ namespace Core
                 ++It;
             }
         }
+
+        Owner->InvalidateComponentPhaseLists();
     }
 
     void ObjectManager::Remove(const std::shared_ptr<WorldObject>& Object)
@@ -78,6 +93,11 @@ namespace Core
         if (!Object)
             return;
 
+        if (std::find(Objects.begin(), Objects.end(), Object) != Objects.end())
+        {
+            Owner->UnregisterObjectComponents(*Object);
+        }
+
         Objects.erase(std::remove(Objects.begin(), Objects.end(), Object), Objects.end());
         PendingStartObjects.erase(std::remove(PendingStartObjects.begin(), PendingStartObjects.end(), Object),
                                   PendingStartObjects.end());
@@ -93,6 +113,8 @@ namespace Core
                 ++It;
             }
         }
+
+        Owner->InvalidateComponentPhaseLists();
     }
 
     bool ObjectManager::MoveUp(const std::shared_ptr<WorldObject>& Object)
@@ -104,6 +126,7 @@ namespace Core
         }
 
         std::iter_swap(It, It - 1);
+        Owner->InvalidateComponentPhaseLists();
         return true;
     }
 
@@ -116,6 +139,7 @@ namespace Core
         }
 
         std::iter_swap(It, It + 1);
+        Owner->InvalidateComponentPhaseLists();
         return true;
     }
 
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Core
+{
+    enum class TickPolicy
+    {
+        DistanceLOD,   // Tick rate follows distance to the active camera
+        AlwaysFull     // Ticks every frame regardless of distance (controllers, players)
+    };
+
+    enum class TickRate : std::uint8_t
+    {
+        Sleeping = 0,
+        Full = 1,
+        Quarter = 4,
+        Sixteenth = 16
+    };
+
+    struct TickLODSettings
+    {
+        bool bEnabled = true;
+        float FullRateDistance = 640.0f;
+        float QuarterRateDistance = 1280.0f;
+        float SixteenthRateDistance = 2560.0f;
+    };
+
+    struct TickLODStats
+    {
+        std::uint32_t Ticked = 0;
+        std::uint32_t Throttled = 0;
+        std::uint32_t Sleeping = 0;
+    };
+}
@@ -1,7 +1,11 @@
 ﻿#include "World.h"
 
 #include <algorithm>
+#include <ranges>
 #include "WorldObject.h"
+#include "../Components/CameraComponent.h"
+#include "../Components/Component.h"
+#include "../Components/TransformComponent.h"
 
 namespace Core
 {
@@ -14,20 +18,332 @@ namespace Core
     {
         Environment.GetTime().Tick(DeltaTimeS);
 
+        PublishComponentChanges();
         ObjectMgr.StartPendingComponents();
+        UpdateTransforms();
 
-        for (const std::shared_ptr<WorldObject>& Object : ObjectMgr.GetAll())
+        if (bComponentPhaseListsDirty)
+        {
+            RebuildComponentPhaseLists();
+        }
+
+        sf::Vector2f ViewerPosition;
+        bool bHasViewer = false;
+        if (std::shared_ptr<CameraComponent> Camera = ActiveCamera.lock())
+        {
+            if (WorldObject* CameraOwner = Camera->GetOwner())
+            {
+                if (TransformComponent* CameraTransform = CameraOwner->Transform())
+                {
+                    ViewerPosition = CameraTransform->GetWorldPosition();
+                    bHasViewer = true;
+                }
+            }
+        }
+
+        LODStats = TickLODStats{};
+
+        for (const TickingObjectRange& Range : TickingObjects)
+        {
+            const TickRate Rate = ResolveTickRate(Range, bHasViewer ? &ViewerPosition : nullptr);
+
+            float ObjectDeltaS = 0.0f;
+            if (!Range.Object->AdvanceTickSchedule(Rate, FrameIndex, DeltaTimeS, ObjectDeltaS))
+            {
+                if (Range.Object->IsSleeping())
+                {
+                    ++LODStats.Sleeping;
+                }
+                else
+                {
+                    ++LODStats.Throttled;
+                }
+                continue;
+            }
+
+            ++LODStats.Ticked;
+            for (size_t Index = Range.Begin; Index < Range.End; ++Index)
+            {
+                TickingComponents[Index]->Tick(ObjectDeltaS);
+            }
+        }
+
+        ++FrameIndex;
+    }
+
+    TickRate World::ResolveTickRate(const TickingObjectRange& Range, const sf::Vector2f* ViewerPosition) const
+    {
+        if (!LODSettings.bEnabled || !ViewerPosition || !Range.Transform ||
+            Range.Object->GetTickPolicy() == TickPolicy::AlwaysFull)
+        {
+            return TickRate::Full;
+        }
+
+        const sf::Vector2f Delta = Range.Transform->GetWorldPosition() - *ViewerPosition;
+        const float DistanceSq = Delta.x * Delta.x + Delta.y * Delta.y;
+
+        if (DistanceSq <= LODSettings.FullRateDistance * LODSettings.FullRateDistance)
+        {
+            return TickRate::Full;
+        }
+        if (DistanceSq <= LODSettings.QuarterRateDistance * LODSettings.QuarterRateDistance)
         {
-            Object->Tick(DeltaTimeS);
+            return TickRate::Quarter;
         }
+        if (DistanceSq <= LODSettings.SixteenthRateDistance * LODSettings.SixteenthRateDistance)
+        {
+            return TickRate::Sixteenth;
+        }
+
+        return TickRate::Sleeping;
     }
 
     void World::Render()
     {
+        UpdateTransforms();
+
+        if (bComponentPhaseListsDirty)
+        {
+            RebuildComponentPhaseLists();
+        }
+
+        for (const std::shared_ptr<Component>& Comp : RenderingComponents)
+        {
+            Comp->Render();
+        }
+    }
+
+    void World::RegisterObjectComponents(WorldObject& Object)
+    {
+        if (Object.GetWorldId() == 0)
+        {
+            Object.SetWorldId(NextObjectId++);
+        }
+
+        for (const std::shared_ptr<Component>& Comp : Object.Components().GetAll() | std::views::values)
+        {
+            if (Comp)
+            {
+                RegisterComponent(Object, *Comp);
+            }
+        }
+    }
+
+    void World::UnregisterObjectComponents(WorldObject& Object)
+    {
+        for (const std::shared_ptr<Component>& Comp : Object.Components().GetAll() | std::views::values)
+        {
+            if (Comp)
+            {
+                UnregisterComponent(Object, *Comp);
+            }
+        }
+
+        Object.SetWorldId(0);
+    }
+
+    void World::RegisterComponent(WorldObject& Owner, Component& Comp)
+    {
+        InvalidateComponentPhaseLists();
+
+        const std::uint64_t ObjectId = Owner.GetWorldId();
+        if (ObjectId == 0)
+        {
+            return;
+        }
+
+        const std::type_index Type(typeid(Comp));
+        ComponentTypeList& List = ComponentLists[Type];
+
+        // Ids grow monotonically, so this is an append unless components are added to older objects
+        auto It = std::upper_bound(List.ObjectIds.begin(), List.ObjectIds.end(), ObjectId);
+        const auto Offset = It - List.ObjectIds.begin();
+        if (It != List.ObjectIds.begin() && *(It - 1) == ObjectId)
+        {
+            List.Components[Offset - 1] = &Comp;
+        }
+        else
+        {
+            List.ObjectIds.insert(It, ObjectId);
+            List.Components.insert(List.Components.begin() + Offset, &Comp);
+        }
+        ++List.Version;
+
+        ComponentChangeTracking& Tracking = Comp.GetChangeTracking();
+        Tracking.bRegistered = true;
+        if (!Tracking.bChangePending)
+        {
+            Tracking.bChangePending = true;
+            PendingChanges[Type].Added.push_back(&Comp);
+            bHasPendingChanges = true;
+        }
+    }
+
+    void World::UnregisterComponent(WorldObject& Owner, Component& Comp)
+    {
+        InvalidateComponentPhaseLists();
+
+        const std::uint64_t ObjectId = Owner.GetWorldId();
+        if (ObjectId == 0)
+        {
+            return;
+        }
+
+        const std::type_index Type(typeid(Comp));
+        auto ListIt = ComponentLists.find(Type);
+        if (ListIt == ComponentLists.end())
+        {
+            return;
+        }
+
+        ComponentTypeList& List = ListIt->second;
+        auto It = std::lower_bound(List.ObjectIds.begin(), List.ObjectIds.end(), ObjectId);
+        if (It == List.ObjectIds.end() || *It != ObjectId)
+        {
+            return;
+        }
+
+        List.Components.erase(List.Components.begin() + (It - List.ObjectIds.begin()));
+        List.ObjectIds.erase(It);
+        ++List.Version;
+
+        ComponentChangeTracking& Tracking = Comp.GetChangeTracking();
+        Tracking.bRegistered = false;
+        Tracking.bChangePending = false;
+
+        // Drop the pointer from every change list; a component added and removed in the same frame is never reported
+        bool bAddedThisFrame = false;
+        if (auto PendingIt = PendingChanges.find(Type); PendingIt != PendingChanges.end())
+        {
+            bAddedThisFrame = std::erase(PendingIt->second.Added, &Comp) > 0;
+            std::erase(PendingIt->second.Changed, &Comp);
+        }
+        if (auto PublishedIt = PublishedChanges.find(Type); PublishedIt != PublishedChanges.end())
+        {
+            std::erase(PublishedIt->second.Added, &Comp);
+            std::erase(PublishedIt->second.Changed, &Comp);
+        }
+
+        if (!bAddedThisFrame)
+        {
+            PendingChanges[Type].Removed.push_back(ObjectId);
+            bHasPendingChanges = true;
+        }
+    }
+
+    void World::RecordComponentChanged(Component& Comp)
+    {
+        Comp.GetChangeTracking().bChangePending = true;
+        PendingChanges[std::type_index(typeid(Comp))].Changed.push_back(&Comp);
+        bHasPendingChanges = true;
+    }
+
+    void World::PublishComponentChanges()
+    {
+        if (bHasPublishedChanges)
+        {
+            for (ComponentChangeSet& Set : PublishedChanges | std::views::values)
+            {
+                Set.Clear();
+            }
+            bHasPublishedChanges = false;
+        }
+
+        if (!bHasPendingChanges)
+        {
+            return;
+        }
+
+        for (auto& [Type, Set] : PendingChanges)
+        {
+            if (Set.IsEmpty())
+                continue;
+
+            for (Component* Comp : Set.Added)
+            {
+                Comp->GetChangeTracking().bChangePending = false;
+            }
+            for (Component* Comp : Set.Changed)
+            {
+                Comp->GetChangeTracking().bChangePending = false;
+            }
+
+            // Swapping hands the cleared published buffers back to the pending side so capacity is reused
+            std::swap(PublishedChanges[Type], Set);
+        }
+
+        bHasPendingChanges = false;
+        bHasPublishedChanges = true;
+    }
+
+    void World::UpdateTransforms()
+    {
+        if (DirtyTransforms.empty())
+        {
+            return;
+        }
+
+        TransformUpdateBatch.clear();
+        for (const std::weak_ptr<TransformComponent>& TransformWeak : DirtyTransforms)
+        {
+            if (std::shared_ptr<TransformComponent> Transform = TransformWeak.lock(); Transform && Transform->IsWorldTransformDirty())
+            {
+                TransformUpdateBatch.push_back(std::move(Transform));
+            }
+        }
+        DirtyTransforms.clear();
+
+        // Parents first, so every subtree is resolved once against an up-to-date parent
+        std::ranges::stable_sort(TransformUpdateBatch, {}, &TransformComponent::GetDepth);
+
+        for (const std::shared_ptr<TransformComponent>& Transform : TransformUpdateBatch)
+        {
+            if (Transform->IsWorldTransformDirty())
+            {
+                Transform->UpdateWorldTransforms();
+            }
+        }
+        TransformUpdateBatch.clear();
+    }
+
+    void World::RebuildComponentPhaseLists()
+    {
+        TickingComponents.clear();
+        TickingObjects.clear();
+        RenderingComponents.clear();
+
+        // Walk objects in ObjectManager order so render order still follows the hierarchy ordering
         for (const std::shared_ptr<WorldObject>& Object : ObjectMgr.GetAll())
         {
-            Object->Render();
+            const size_t FirstTicking = TickingComponents.size();
+
+            for (const std::shared_ptr<Component>& Comp : Object->Components().GetAll() | std::views::values)
+            {
+                if (!Comp)
+                    continue;
+
+                if (HasPhase(Comp->GetPhases(), ComponentPhase::Tick))
+                {
+                    TickingComponents.push_back(Comp);
+                }
+                if (HasPhase(Comp->GetPhases(), ComponentPhase::Render))
+                {
+                    RenderingComponents.push_back(Comp);
+                }
+            }
+
+            if (TickingComponents.size() > FirstTicking)
+            {
+                TickingObjects.push_back({
+                    .Object = Object,
+                    .Transform = Object->Components().Get<TransformComponent>(),
+                    .Begin = FirstTicking,
+                    .End = TickingComponents.size()
+                });
+            }
         }
+
+        bComponentPhaseListsDirty = false;
     }
 
     nlohmann::json World::ToJson() const
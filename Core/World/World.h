@@ -1,16 +1,25 @@
 ﻿#pragma once
 
 #include <memory>
+#include <typeindex>
+#include <unordered_map>
 #include "../ThirdParty/json.hpp"
 
+#include "../Components/ComponentConcept.hpp"
 #include "../Interfaces/IRenderable.hpp"
 #include "../Interfaces/ITickable.hpp"
+#include "ComponentChanges.hpp"
+#include "ComponentQuery.hpp"
 #include "ObjectManager.h"
+#include "TickLOD.h"
 #include "WorldEnvironment.h"
 
 namespace Core
 {
     struct EngineContext;
+    class Component;
+    class CameraComponent;
+    class TransformComponent;
 }
 
 namespace Core
@@ -31,9 +40,107 @@ namespace Core
 
         nlohmann::json ToJson() const;
 
+        // Returns every object's components that have all of Ts, in object creation order. The result is cached
+        // and only rebuilt after a component of one of the queried types is attached or removed.
+        template <typename... Ts>
+            requires (IsComponent<Ts> && ...) && (sizeof...(Ts) > 0)
+        ComponentQuery<Ts...> Query();
+
+        // Changes recorded during the previous frame, published at the start of Tick so every consumer sees them
+        template <typename T>
+            requires IsComponent<T>
+        ComponentChanges<T> GetChanges() const;
+
+        void RecordComponentChanged(Component& Comp);
+
+        void RegisterObjectComponents(WorldObject& Object);
+        void UnregisterObjectComponents(WorldObject& Object);
+        void RegisterComponent(WorldObject& Owner, Component& Comp);
+        void UnregisterComponent(WorldObject& Owner, Component& Comp);
+
+        void InvalidateComponentPhaseLists() { bComponentPhaseListsDirty = true; }
+        size_t GetTickingComponentCount() const { return TickingComponents.size(); }
+        size_t GetRenderingComponentCount() const { return RenderingComponents.size(); }
+
+        void SetActiveCamera(const std::shared_ptr<CameraComponent>& Camera) { ActiveCamera = Camera; }
+        std::shared_ptr<CameraComponent> GetActiveCamera() const { return ActiveCamera.lock(); }
+
+        TickLODSettings& GetTickLODSettings() { return LODSettings; }
+        const TickLODSettings& GetTickLODSettings() const { return LODSettings; }
+        const TickLODStats& GetTickLODStats() const { return LODStats; }
+
+        void QueueTransformUpdate(const std::weak_ptr<TransformComponent>& Transform) { DirtyTransforms.push_back(Transform); }
+        void UpdateTransforms();
+
     private:
+        struct TickingObjectRange
+        {
+            std::shared_ptr<WorldObject> Object;
+            std::shared_ptr<TransformComponent> Transform;
+            size_t Begin = 0;
+            size_t End = 0;
+        };
+
+        void RebuildComponentPhaseLists();
+        void PublishComponentChanges();
+        TickRate ResolveTickRate(const TickingObjectRange& Range, const sf::Vector2f* ViewerPosition) const;
+
         std::shared_ptr<EngineContext> Context;
         ObjectManager ObjectMgr;
         WorldEnvironment Environment;
+
+        std::vector<std::shared_ptr<Component>> TickingComponents;
+        std::vector<TickingObjectRange> TickingObjects;
+        std::vector<std::shared_ptr<Component>> RenderingComponents;
+        bool bComponentPhaseListsDirty = true;
+
+        std::weak_ptr<CameraComponent> ActiveCamera;
+        TickLODSettings LODSettings;
+        TickLODStats LODStats;
+        std::uint64_t FrameIndex = 0;
+
+        std::vector<std::weak_ptr<TransformComponent>> DirtyTransforms;
+        std::vector<std::shared_ptr<TransformComponent>> TransformUpdateBatch;
+
+        std::unordered_map<std::type_index, ComponentTypeList> ComponentLists;
+        std::unordered_map<std::type_index, std::unique_ptr<ComponentQueryCacheBase>> QueryCaches;
+        std::uint64_t NextObjectId = 1;
+
+        std::unordered_map<std::type_index, ComponentChangeSet> PendingChanges;
+        std::unordered_map<std::type_index, ComponentChangeSet> PublishedChanges;
+        bool bHasPendingChanges = false;
+        bool bHasPublishedChanges = false;
     };
+
+    template <typename... Ts>
+        requires (IsComponent<Ts> && ...) && (sizeof...(Ts) > 0)
+    ComponentQuery<Ts...> World::Query()
+    {
+        using CacheType = ComponentQueryCache<Ts...>;
+
+        std::unique_ptr<ComponentQueryCacheBase>& CacheSlot = QueryCaches[std::type_index(typeid(CacheType))];
+        if (!CacheSlot)
+        {
+            std::unique_ptr<CacheType> NewCache = std::make_unique<CacheType>();
+            NewCache->Lists = {&ComponentLists[std::type_index(typeid(Ts))]...};
+            CacheSlot = std::move(NewCache);
+        }
+
+        CacheType& Cache = static_cast<CacheType&>(*CacheSlot);
+        if (Cache.IsStale())
+        {
+            Cache.Rebuild();
+        }
+        return ComponentQuery<Ts...>(Cache.Rows);
+    }
+
+    template <typename T>
+        requires IsComponent<T>
+    ComponentChanges<T> World::GetChanges() const
+    {
+        static const ComponentChangeSet EmptySet;
+
+        auto It = PublishedChanges.find(std::type_index(typeid(T)));
+        return ComponentChanges<T>(It != PublishedChanges.end() ? It->second : EmptySet);
+    }
 }
@@ -8,6 +8,8 @@ namespace Core
         : Context(std::move(Context))
           , OwningWorld(InWorld)
     {
+        static std::uint32_t NextTickSlice = 0;
+        TickSlice = NextTickSlice++;
     }
 
     void WorldObject::SetName(const std::string& InName)
@@ -35,6 +37,51 @@ namespace Core
         ComponentsMgr.Render();
     }
 
+    void WorldObject::Sleep()
+    {
+        bSleepRequested = true;
+        CurrentRate = TickRate::Sleeping;
+        AccumulatedDeltaS = 0.0f;
+    }
+
+    void WorldObject::Wake()
+    {
+        bSleepRequested = false;
+        if (CurrentRate == TickRate::Sleeping)
+        {
+            CurrentRate = TickRate::Full;
+        }
+    }
+
+    bool WorldObject::AdvanceTickSchedule(TickRate Rate, std::uint64_t FrameIndex, float DeltaTimeS, float& OutDeltaS)
+    {
+        if (bSleepRequested)
+        {
+            Rate = TickRate::Sleeping;
+        }
+
+        if (Rate == TickRate::Sleeping)
+        {
+            CurrentRate = TickRate::Sleeping;
+            AccumulatedDeltaS = 0.0f;
+            return false;
+        }
+
+        CurrentRate = Rate;
+        AccumulatedDeltaS += DeltaTimeS;
+
+        // Offsetting by the per-object slice spreads reduced-rate objects evenly across frames
+        const std::uint64_t Interval = static_cast<std::uint64_t>(Rate);
+        if ((FrameIndex + TickSlice) % Interval != 0)
+        {
+            return false;
+        }
+
+        OutDeltaS = AccumulatedDeltaS;
+        AccumulatedDeltaS = 0.0f;
+        return true;
+    }
+
     TransformComponent* WorldObject::Transform()
     {
         return ComponentsMgr.Get<TransformComponent>().get();
@@ -47,22 +94,20 @@ namespace Core
 
     WorldCoordinate WorldObject::WorldToLocal(const WorldCoordinate& WorldPos) const
     {
-        sf::Vector2f ObjectPosition(0.0f, 0.0f);
         if (std::shared_ptr<TransformComponent> TransformComp = ComponentsMgr.Get<TransformComponent>())
         {
-            ObjectPosition = TransformComp->Position;
+            return WorldCoordinate(TransformComp->GetWorldTransform().getInverse().transformPoint(WorldPos.Value));
         }
-        return WorldCoordinate(WorldPos.Value.x - ObjectPosition.x, WorldPos.Value.y - ObjectPosition.y);
+        return WorldPos;
     }
 
     WorldCoordinate WorldObject::LocalToWorld(const WorldCoordinate& LocalPos) const
     {
-        sf::Vector2f ObjectPosition(0.0f, 0.0f);
         if (std::shared_ptr<TransformComponent> TransformComp = ComponentsMgr.Get<TransformComponent>())
         {
-            ObjectPosition = TransformComp->Position;
+            return WorldCoordinate(TransformComp->GetWorldTransform().transformPoint(LocalPos.Value));
         }
-        return WorldCoordinate(LocalPos.Value.x + ObjectPosition.x, LocalPos.Value.y + ObjectPosition.y);
+        return LocalPos;
     }
 
     nlohmann::json WorldObject::ToJson() const
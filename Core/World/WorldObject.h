@@ -5,6 +5,7 @@
 #include "../Thirdparty/json.hpp"
 
 #include "ComponentManager.h"
+#include "TickLOD.h"
 #include "../Interfaces/IRenderable.hpp"
 #include "../Interfaces/ITickable.hpp"
 #include "../Coordinates/WorldCoordinate.h"
@@ -43,6 +44,32 @@ namespace Core
         void SetTag(ObjectTag InTag) { Tag = InTag; }
         ObjectTag GetTag() const { return Tag; }
 
+        // DataAsset this object was spawned from and the overrides applied to it, recorded only while
+        // WorldObjectSystem::SetRecordSources is on; empty otherwise
+        void SetSource(const std::string& InDataAssetName, const nlohmann::json& InOverrides)
+        {
+            SourceDataAsset = InDataAssetName;
+            SourceOverrides = InOverrides;
+        }
+        const std::string& GetSourceDataAsset() const { return SourceDataAsset; }
+        const nlohmann::json& GetSourceOverrides() const { return SourceOverrides; }
+
+        // Assigned by the World while the object is registered with it, 0 otherwise
+        std::uint64_t GetWorldId() const { return WorldId; }
+        void SetWorldId(std::uint64_t InWorldId) { WorldId = InWorldId; }
+
+        void SetTickPolicy(TickPolicy InPolicy) { Policy = InPolicy; }
+        TickPolicy GetTickPolicy() const { return Policy; }
+        TickRate GetTickRate() const { return CurrentRate; }
+
+        void Sleep();
+        void Wake();
+        bool IsSleeping() const { return CurrentRate == TickRate::Sleeping; }
+
+        // Advances the object's tick schedule for this frame. Returns true when the object should tick, with the
+        // delta accumulated since its last tick in OutDeltaS.
+        bool AdvanceTickSchedule(TickRate Rate, std::uint64_t FrameIndex, float DeltaTimeS, float& OutDeltaS);
+
         WorldCoordinate WorldToLocal(const WorldCoordinate& WorldPos) const;
         WorldCoordinate LocalToWorld(const WorldCoordinate& LocalPos) const;
 
@@ -54,6 +81,16 @@ namespace Core
         ComponentManager ComponentsMgr{this};
         std::string Name;
         ObjectTag Tag = ObjectTag::Game;
+        std::uint64_t WorldId = 0;
+
+        std::string SourceDataAsset;
+        nlohmann::json SourceOverrides;
+
+        TickPolicy Policy = TickPolicy::DistanceLOD;
+        TickRate CurrentRate = TickRate::Full;
+        bool bSleepRequested = false;
+        std::uint32_t TickSlice = 0;
+        float AccumulatedDeltaS = 0.0f;
     };
 
     template <typename T>
@@ -63,7 +100,11 @@ namespace Core
     T* ComponentManager::Add()
     {
         std::shared_ptr<T> Component = std::make_shared<T>(Owner->shared_from_this(), Owner->GetContextPtr());
-        TypeToComponent.emplace(std::type_index(typeid(T)), Component);
+        Component->SetPhases(DetectComponentPhases<T>());
+        if (TypeToComponent.emplace(std::type_index(typeid(T)), Component).second)
+        {
+            NotifyComponentAttached(*Component);
+        }
         return Component.get();
     }
 }
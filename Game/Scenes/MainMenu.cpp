@@ -30,41 +30,44 @@ namespace Game
 
     void MainMenuScene::OnEnter()
     {
-        bool bHasCamera = false;
+        std::shared_ptr<Core::CameraComponent> ActiveCamera;
         for (const auto& Obj : World.Objects().GetAll())
         {
-            if (Obj && Obj->Components().Get<Core::CameraComponent>())
+            if (!Obj)
+                continue;
+
+            if (std::shared_ptr<Core::CameraComponent> Camera = Obj->Components().Get<Core::CameraComponent>())
             {
-                bHasCamera = true;
+                ActiveCamera = Camera;
                 break;
             }
         }
 
-        if (!bHasCamera)
+        if (!ActiveCamera)
         {
             std::shared_ptr<Core::WorldObject> CameraObj = World.Objects().CreateObject();
             CameraObj->SetName("MainMenuCamera");
             CameraObj->Components().Add<Core::TransformComponent>();
             CameraObj->Components().Add<Core::CameraComponent>();
+            ActiveCamera = CameraObj->Components().Get<Core::CameraComponent>();
         }
 
+        World.SetActiveCamera(ActiveCamera);
+
         ZoomCameraToFitTileMap();
+
+        // Warm the editor's assets while the menu is idle
+        Context->SystemsRegistry->GetCoreSystem<Core::SceneManagerSystem>()->Prefetch("LevelDesigner");
     }
 
     void MainMenuScene::PreRender()
     {
         bool bCameraFound = false;
-        for (const auto& Obj : World.Objects().GetAll())
+        for (const auto& [Camera] : World.Query<Core::CameraComponent>())
         {
-            if (!Obj)
-                continue;
-
-            if (std::shared_ptr<Core::CameraComponent> Camera = Obj->Components().Get<Core::CameraComponent>())
-            {
-                Context->Renderer->setView(Camera->GetView());
-                bCameraFound = true;
-                break;
-            }
+            Context->Renderer->setView(Camera->GetView());
+            bCameraFound = true;
+            break;
         }
 
         if (!bCameraFound)
@@ -186,7 +189,7 @@ namespace Game
             if (std::shared_ptr<Core::TransformComponent> TileMapTransform = TileMapOwner->Components().Get<
                 Core::TransformComponent>())
             {
-                TileMapPosition = TileMapTransform->Position;
+                TileMapPosition = TileMapTransform->GetWorldPosition();
             }
         }
 
@@ -195,6 +198,6 @@ namespace Game
         float CenterY = TileMapPosition.y + (Bounds.MinY + Bounds.MaxY) * 0.5f * Core::WorldConstants::TileSize +
             Core::WorldConstants::TileSize * 0.5f;
 
-        CameraTransform->Position = sf::Vector2f(CenterX, CenterY);
+        CameraTransform->SetWorldPosition(sf::Vector2f(CenterX, CenterY));
     }
 }
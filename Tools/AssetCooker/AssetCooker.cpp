@@ -0,0 +1,104 @@
+// Offline cook step: converts every JSON asset under Game/Assets into its Core::CookedJsonCache entry, then
+// benchmarks a raw JSON parse against a cooked load (content hash, cache read and MessagePack decode) per file.
+// Usage: AssetCooker [AssetsDirectory=Game/Assets] [Iterations=20]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../Core/Assets/AssetPackFormat.hpp"
+#include "../../Core/Assets/CookedJsonCache.h"
+#include "../../Core/Assets/MappedFile.h"
+
+namespace
+{
+    // Runtime lookups use the same working-directory-relative paths the loose files have
+    constexpr const char* MountPrefix = "Game/Assets/";
+
+    template <typename FunctionType>
+    double MeasureAverageMs(int Iterations, FunctionType&& Function)
+    {
+        const auto Start = std::chrono::steady_clock::now();
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            Function();
+        }
+        const auto End = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(End - Start).count() / Iterations;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Core;
+
+    const std::filesystem::path AssetsDirectory = argc > 1 ? argv[1] : "Game/Assets";
+    const int Iterations = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 20;
+
+    if (!std::filesystem::is_directory(AssetsDirectory))
+    {
+        std::printf("Assets directory does not exist: %s\n", AssetsDirectory.string().c_str());
+        return 1;
+    }
+
+    std::size_t CookedCount = 0;
+    std::uint64_t TotalSourceBytes = 0;
+    std::uint64_t TotalCookedBytes = 0;
+    double TotalParseMs = 0.0;
+    double TotalCookedMs = 0.0;
+
+    std::printf("%-48s %10s %10s %10s %10s %8s\n", "Asset", "JSON B", "Cooked B", "Parse ms", "Cooked ms", "Speedup");
+
+    for (const auto& DirectoryEntry : std::filesystem::recursive_directory_iterator(AssetsDirectory))
+    {
+        if (!DirectoryEntry.is_regular_file() || DirectoryEntry.path().extension() != ".json")
+        {
+            continue;
+        }
+
+        std::unique_ptr<MappedFile> File = MappedFile::Open(DirectoryEntry.path().string());
+        if (!File)
+        {
+            return 1;
+        }
+
+        const std::string Path = AssetPackFormat::NormalizePath(
+            MountPrefix + std::filesystem::relative(DirectoryEntry.path(), AssetsDirectory).generic_string());
+        const std::span<const std::byte> Bytes = File->GetBytes();
+        if (!CookedJsonCache::Cook(Path, Bytes))
+        {
+            std::printf("Failed to cook: %s\n", Path.c_str());
+            return 1;
+        }
+
+        const char* Begin = reinterpret_cast<const char*>(Bytes.data());
+        const double ParseMs = MeasureAverageMs(Iterations, [&]()
+        {
+            nlohmann::json Json = nlohmann::json::parse(Begin, Begin + Bytes.size());
+        });
+        const double CookedMs = MeasureAverageMs(Iterations, [&]()
+        {
+            std::optional<nlohmann::json> Json = CookedJsonCache::Load(Path, Bytes);
+        });
+
+        const std::uint64_t CookedBytes = std::filesystem::file_size(CookedJsonCache::GetCookedPath(Path));
+        std::printf("%-48s %10zu %10llu %10.3f %10.3f %7.2fx\n", Path.c_str(), Bytes.size(),
+                    static_cast<unsigned long long>(CookedBytes), ParseMs, CookedMs, CookedMs > 0.0 ? ParseMs / CookedMs : 0.0);
+
+        ++CookedCount;
+        TotalSourceBytes += Bytes.size();
+        TotalCookedBytes += CookedBytes;
+        TotalParseMs += ParseMs;
+        TotalCookedMs += CookedMs;
+    }
+
+    std::printf("Cooked %zu files into %s: %llu bytes -> %llu bytes, load %.3f ms -> %.3f ms (%d iterations)\n",
+                CookedCount, CookedJsonCache::CacheDirectory, static_cast<unsigned long long>(TotalSourceBytes),
+                static_cast<unsigned long long>(TotalCookedBytes), TotalParseMs, TotalCookedMs, Iterations);
+    return 0;
+}
@@ -0,0 +1,166 @@
+// Offline packer: bundles Game/Assets into a single .pak read by Core::AssetPack.
+// Usage: AssetPacker [AssetsDirectory=Game/Assets] [OutputPath=Game/Assets.pak]
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "../../Core/Assets/AssetPackFormat.hpp"
+#include "../../Core/Assets/LzCompression.h"
+
+namespace
+{
+    // Entries are only compressed when it saves at least this share; png/ogg/otf rarely qualify
+    constexpr double MaxCompressedRatio = 0.9;
+
+    // Runtime lookups use the same working-directory-relative paths the loose files have
+    constexpr const char* MountPrefix = "Game/Assets/";
+
+    struct PackedFile
+    {
+        std::string Path;
+        std::vector<std::byte> Stored;
+        std::uint64_t Size = 0;
+        Core::AssetPackFormat::CompressionMethod Compression = Core::AssetPackFormat::CompressionMethod::None;
+    };
+
+    bool ReadFile(const std::filesystem::path& Path, std::vector<std::byte>& OutBytes)
+    {
+        std::ifstream Stream(Path, std::ios::binary | std::ios::ate);
+        if (!Stream.is_open())
+        {
+            return false;
+        }
+
+        const std::streamsize Size = Stream.tellg();
+        Stream.seekg(0, std::ios::beg);
+        OutBytes.resize(static_cast<std::size_t>(Size));
+        return Size == 0 || static_cast<bool>(Stream.read(reinterpret_cast<char*>(OutBytes.data()), Size));
+    }
+
+    void WritePadding(std::ofstream& Stream, std::uint64_t& Offset, std::uint64_t Alignment)
+    {
+        static constexpr char Zeros[16] = {};
+        const std::uint64_t Aligned = Core::AssetPackFormat::AlignUp(Offset, Alignment);
+        Stream.write(Zeros, static_cast<std::streamsize>(Aligned - Offset));
+        Offset = Aligned;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Core;
+
+    const std::filesystem::path AssetsDirectory = argc > 1 ? argv[1] : "Game/Assets";
+    const std::filesystem::path OutputPath = argc > 2 ? argv[2] : "Game/Assets.pak";
+
+    if (!std::filesystem::is_directory(AssetsDirectory))
+    {
+        std::printf("Assets directory does not exist: %s\n", AssetsDirectory.string().c_str());
+        return 1;
+    }
+
+    std::vector<PackedFile> Files;
+    std::uint64_t TotalSize = 0;
+    std::uint64_t TotalStored = 0;
+
+    for (const auto& DirectoryEntry : std::filesystem::recursive_directory_iterator(AssetsDirectory))
+    {
+        if (!DirectoryEntry.is_regular_file())
+        {
+            continue;
+        }
+
+        std::vector<std::byte> Bytes;
+        if (!ReadFile(DirectoryEntry.path(), Bytes))
+        {
+            std::printf("Failed to read: %s\n", DirectoryEntry.path().string().c_str());
+            return 1;
+        }
+
+        PackedFile File;
+        File.Path = AssetPackFormat::NormalizePath(
+            MountPrefix + std::filesystem::relative(DirectoryEntry.path(), AssetsDirectory).generic_string());
+        File.Size = Bytes.size();
+
+        std::vector<std::byte> Compressed = LzCompression::Compress(Bytes);
+        if (!Bytes.empty() && static_cast<double>(Compressed.size()) < static_cast<double>(Bytes.size()) * MaxCompressedRatio)
+        {
+            File.Stored = std::move(Compressed);
+            File.Compression = AssetPackFormat::CompressionMethod::Lz;
+        }
+        else
+        {
+            File.Stored = std::move(Bytes);
+        }
+
+        TotalSize += File.Size;
+        TotalStored += File.Stored.size();
+        Files.push_back(std::move(File));
+    }
+
+    std::ofstream Stream(OutputPath, std::ios::binary | std::ios::trunc);
+    if (!Stream.is_open())
+    {
+        std::printf("Failed to open output: %s\n", OutputPath.string().c_str());
+        return 1;
+    }
+
+    AssetPackFormat::Header Header;
+    Header.EntryCount = static_cast<std::uint32_t>(Files.size());
+    Stream.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+    std::uint64_t Offset = sizeof(Header);
+
+    std::vector<AssetPackFormat::Entry> Entries;
+    Entries.reserve(Files.size());
+    std::string Paths;
+
+    for (const PackedFile& File : Files)
+    {
+        WritePadding(Stream, Offset, AssetPackFormat::BlobAlignment);
+
+        AssetPackFormat::Entry Entry;
+        Entry.PathHash = AssetPackFormat::HashPath(File.Path);
+        Entry.Offset = Offset;
+        Entry.StoredSize = File.Stored.size();
+        Entry.Size = File.Size;
+        Entry.PathOffset = static_cast<std::uint32_t>(Paths.size());
+        Entry.PathLength = static_cast<std::uint32_t>(File.Path.size());
+        Entry.Compression = File.Compression;
+        Entries.push_back(Entry);
+
+        Paths += File.Path;
+        Stream.write(reinterpret_cast<const char*>(File.Stored.data()), static_cast<std::streamsize>(File.Stored.size()));
+        Offset += File.Stored.size();
+    }
+
+    // The reader binary-searches by hash, so the index must be sorted
+    std::sort(Entries.begin(), Entries.end(), [](const AssetPackFormat::Entry& A, const AssetPackFormat::Entry& B)
+    {
+        return A.PathHash < B.PathHash;
+    });
+
+    WritePadding(Stream, Offset, AssetPackFormat::BlobAlignment);
+    Header.IndexOffset = Offset;
+    Stream.write(reinterpret_cast<const char*>(Entries.data()), static_cast<std::streamsize>(Entries.size() * sizeof(AssetPackFormat::Entry)));
+    Offset += Entries.size() * sizeof(AssetPackFormat::Entry);
+
+    Header.PathsOffset = Offset;
+    Stream.write(Paths.data(), static_cast<std::streamsize>(Paths.size()));
+
+    Stream.seekp(0);
+    Stream.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+
+    if (!Stream)
+    {
+        std::printf("Failed to write: %s\n", OutputPath.string().c_str());
+        return 1;
+    }
+
+    std::printf("Packed %zu files into %s: %llu bytes -> %llu bytes\n", Files.size(), OutputPath.string().c_str(),
+                static_cast<unsigned long long>(TotalSize), static_cast<unsigned long long>(TotalStored));
+    return 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+// The map the tile benchmarks share: floor everywhere on layer 0, and on layer 1 rooms 16 tiles across with a
+// doorway in the middle of each wall, and pillars scattered inside them. Header only, so each benchmark still
+// builds from a single source file plus the engine sources it measures.
+
+#include <cstdint>
+
+#include "../../Core/Navigation/GridPathfinder.h"
+#include "../../Core/TileMap/TileCollisionGrid.h"
+#include "../../Core/TileMap/TileMap.h"
+
+namespace RoomMap
+{
+    constexpr Core::uint RoomSize = 16;
+
+    inline const Core::Tile Floor(0, 0);
+    inline const Core::Tile Wall(0, 1);
+
+    inline bool IsTileSolid(const Core::Tile& Value)
+    {
+        return Value == Wall;
+    }
+
+    // A small LCG, so every run and every benchmark sees the same map and the same picks
+    inline std::uint32_t NextRandom(std::uint32_t& State)
+    {
+        State = State * 1664525u + 1013904223u;
+        return State >> 8;
+    }
+
+    inline void BuildRooms(Core::TileMap& Map)
+    {
+        Map.AddLayer();
+        std::uint32_t Seed = 7;
+        for (Core::uint Y = 0; Y < Map.GetHeight(); ++Y)
+        {
+            for (Core::uint X = 0; X < Map.GetWidth(); ++X)
+            {
+                Map.SetTile(X, Y, 0, Floor);
+
+                const bool bRoomWall = (X % RoomSize == 0 && Y % RoomSize != RoomSize / 2) ||
+                                       (Y % RoomSize == 0 && X % RoomSize != RoomSize / 2);
+                const bool bPillar = NextRandom(Seed) % 100 < 6;
+                if (bRoomWall || bPillar)
+                {
+                    Map.SetTile(X, Y, 1, Wall);
+                }
+            }
+        }
+    }
+
+    inline bool IsOpen(const Core::TileCollisionGrid& Grid, int X, int Y)
+    {
+        return X >= 0 && Y >= 0 && X < static_cast<int>(Grid.GetWidth()) && Y < static_cast<int>(Grid.GetHeight()) &&
+               !Grid.IsSolid(X, Y);
+    }
+
+    inline Core::TilePoint RandomOpenTile(const Core::TileCollisionGrid& Grid, std::uint32_t& Seed)
+    {
+        while (true)
+        {
+            const Core::TilePoint Point{static_cast<int>(NextRandom(Seed) % Grid.GetWidth()),
+                                        static_cast<int>(NextRandom(Seed) % Grid.GetHeight())};
+            if (!Grid.IsSolid(Point.X, Point.Y))
+            {
+                return Point;
+            }
+        }
+    }
+}
@@ -0,0 +1,307 @@
+// Builds a Core::FlowField towards one goal on a map of walled rooms and checks it against a plain Dijkstra, then
+// times updating it after one-tile edits against flooding it again and checks both agree. Then moves thousands of
+// agents down the field for a number of frames, and compares that with finding each agent a path of its own on a
+// Core::NavigationGraph.
+// Usage: FlowFieldBenchmark [Size=1000] [Agents=10000] [Frames=120]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../../Core/Navigation/FlowField.h"
+#include "../../Core/Navigation/GridPathfinder.h"
+#include "../../Core/Navigation/NavigationGraph.h"
+#include "../../Core/Navigation/PathfindingService.h"
+#include "../../Core/TileMap/TileCollisionGrid.h"
+#include "../../Core/TileMap/TileMap.h"
+#include "../Common/RoomMap.h"
+
+namespace
+{
+    using Core::FlowField;
+    using Core::GridPathfinder;
+    using Core::NavigationGraph;
+    using Core::PathfindingService;
+    using Core::ThreadPool;
+    using Core::Tile;
+    using Core::TileCollisionGrid;
+    using Core::TileMap;
+    using Core::TilePoint;
+    using Core::uint;
+    using namespace RoomMap;
+
+    constexpr float AgentSpeedTiles = 6.0f;
+    constexpr float FrameTimeS = 1.0f / 60.0f;
+
+    bool CanMove(const TileCollisionGrid& Grid, int X, int Y, int DX, int DY)
+    {
+        return IsOpen(Grid, X + DX, Y + DY) && (DX == 0 || DY == 0 || (IsOpen(Grid, X + DX, Y) && IsOpen(Grid, X, Y + DY)));
+    }
+
+    // Costs to Goal with FlowField's move costs, by the textbook Dijkstra
+    std::vector<std::uint32_t> ReferenceCosts(const TileCollisionGrid& Grid, TilePoint Goal)
+    {
+        const int Width = static_cast<int>(Grid.GetWidth());
+        std::vector<std::uint32_t> Costs(static_cast<std::size_t>(Width) * Grid.GetHeight(), FlowField::Unreachable);
+        std::vector<std::pair<std::uint32_t, int>> Open;
+        if (!IsOpen(Grid, Goal.X, Goal.Y))
+        {
+            return Costs;
+        }
+
+        Costs[Goal.Y * Width + Goal.X] = 0;
+        Open.emplace_back(0, Goal.Y * Width + Goal.X);
+        while (!Open.empty())
+        {
+            std::pop_heap(Open.begin(), Open.end(), std::greater<>());
+            const auto [Cost, Index] = Open.back();
+            Open.pop_back();
+            if (Cost != Costs[Index])
+            {
+                continue;
+            }
+
+            for (int DY = -1; DY <= 1; ++DY)
+            {
+                for (int DX = -1; DX <= 1; ++DX)
+                {
+                    if ((DX == 0 && DY == 0) || !CanMove(Grid, Index % Width, Index / Width, DX, DY))
+                    {
+                        continue;
+                    }
+
+                    const int Next = Index + DY * Width + DX;
+                    const std::uint32_t NextCost = Cost + (DX != 0 && DY != 0 ? FlowField::DiagonalCost : FlowField::StraightCost);
+                    if (NextCost < Costs[Next])
+                    {
+                        Costs[Next] = NextCost;
+                        Open.emplace_back(NextCost, Next);
+                        std::push_heap(Open.begin(), Open.end(), std::greater<>());
+                    }
+                }
+            }
+        }
+        return Costs;
+    }
+
+    // Every cost matches, and from every reachable tile but the goal the field steps by an allowed move to a tile
+    // exactly one move's cost cheaper
+    bool IsFieldCorrect(const TileCollisionGrid& Grid, const FlowField& Field, const std::vector<std::uint32_t>& Expected)
+    {
+        const int Width = static_cast<int>(Grid.GetWidth());
+        for (int Y = 0; Y < static_cast<int>(Grid.GetHeight()); ++Y)
+        {
+            for (int X = 0; X < Width; ++X)
+            {
+                const std::uint32_t Cost = Field.GetCost(X, Y);
+                if (Cost != Expected[Y * Width + X])
+                {
+                    return false;
+                }
+
+                const TilePoint Step = Field.GetStep(X, Y);
+                if (Cost == FlowField::Unreachable || Cost == 0)
+                {
+                    if (!(Step == TilePoint{}))
+                    {
+                        return false;
+                    }
+                    continue;
+                }
+
+                const std::uint32_t MoveCost = Step.X != 0 && Step.Y != 0 ? FlowField::DiagonalCost : FlowField::StraightCost;
+                if ((Step.X == 0 && Step.Y == 0) || !CanMove(Grid, X, Y, Step.X, Step.Y) ||
+                    Field.GetCost(X + Step.X, Y + Step.Y) + MoveCost != Cost)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    struct Agent
+    {
+        float X = 0.0f;
+        float Y = 0.0f;
+    };
+
+    double ElapsedMs(std::chrono::steady_clock::time_point Start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Core;
+
+    const uint Size = argc > 1 ? static_cast<uint>(std::max(std::atoi(argv[1]), 64)) : 1000;
+    const uint AgentCount = argc > 2 ? static_cast<uint>(std::max(std::atoi(argv[2]), 1)) : 10000;
+    const int Frames = argc > 3 ? std::max(std::atoi(argv[3]), 1) : 120;
+
+    TileMap Map(Size, Size);
+    BuildRooms(Map);
+
+    TileCollisionGrid Grid;
+    Grid.Update(Map, IsTileSolid);
+
+    std::uint32_t Seed = 5;
+    const TilePoint Goal = RandomOpenTile(Grid, Seed);
+
+    auto Started = std::chrono::steady_clock::now();
+    auto Field = std::make_shared<const FlowField>(Grid, Goal);
+    const double FloodMs = ElapsedMs(Started);
+
+    std::printf("%u x %u map, %zu solid tiles, goal (%d, %d)\n\n", Size, Size, Grid.GetSolidCount(), Goal.X, Goal.Y);
+    std::printf("%-28s %12s %14s %10s\n", "Field build", "ms", "Tiles costed", "Check");
+    std::printf("%-28s %12.3f %14zu %10s\n", "Flood from the goal", FloodMs, Field->GetCostedCount(),
+                IsFieldCorrect(Grid, *Field, ReferenceCosts(Grid, Goal)) ? "ok" : "MISMATCH");
+
+    // One wall tile toggled per update, as an editor brush or a door would, each checked against a fresh flood
+    constexpr int EditCount = 20;
+    double UpdateMs = 0.0;
+    double ReflowMs = 0.0;
+    std::size_t UpdateCosted = 0;
+    bool bUpdatesMatch = true;
+    for (int Edit = 0; Edit < EditCount; ++Edit)
+    {
+        const uint X = static_cast<uint>(Edit * 337 + 5) % Size;
+        const uint Y = static_cast<uint>(Edit * 191 + 3) % Size;
+        Map.SetTile(X, Y, 1, Map.GetTile(X, Y, 1) == Wall ? Tile() : Wall);
+        Grid.Update(Map, IsTileSolid);
+
+        Started = std::chrono::steady_clock::now();
+        Field = std::make_shared<const FlowField>(*Field, Grid);
+        UpdateMs += ElapsedMs(Started);
+        UpdateCosted += Field->GetCostedCount();
+
+        Started = std::chrono::steady_clock::now();
+        const FlowField Reflowed(Grid, Goal);
+        ReflowMs += ElapsedMs(Started);
+
+        bUpdatesMatch = bUpdatesMatch && IsFieldCorrect(Grid, *Field, ReferenceCosts(Grid, Goal));
+    }
+    std::printf("%-28s %12.3f %14zu %10s\n", "One tile edited, updated", UpdateMs / EditCount, UpdateCosted / EditCount,
+                bUpdatesMatch ? "ok" : "MISMATCH");
+    std::printf("%-28s %12.3f\n", "One tile edited, reflooded", ReflowMs / EditCount);
+
+    // Closing the doorways of the goal's room sends nearly every tile's way round; opening them brings it back
+    const uint RoomX = static_cast<uint>(Goal.X) / RoomSize * RoomSize;
+    const uint RoomY = static_cast<uint>(Goal.Y) / RoomSize * RoomSize;
+    const uint Doors[4][2] = {{RoomX, RoomY + RoomSize / 2}, {RoomX + RoomSize, RoomY + RoomSize / 2},
+                              {RoomX + RoomSize / 2, RoomY}, {RoomX + RoomSize / 2, RoomY + RoomSize}};
+    for (const bool bClose : {true, false})
+    {
+        for (const auto& Door : Doors)
+        {
+            if (Door[0] < Size && Door[1] < Size)
+            {
+                Map.SetTile(Door[0], Door[1], 1, bClose ? Wall : Tile());
+            }
+        }
+        Grid.Update(Map, IsTileSolid);
+
+        Started = std::chrono::steady_clock::now();
+        Field = std::make_shared<const FlowField>(*Field, Grid);
+        const double DoorMs = ElapsedMs(Started);
+        std::printf("%-28s %12.3f %14zu %10s\n", bClose ? "Goal room doors closed" : "Goal room doors opened", DoorMs,
+                    Field->GetCostedCount(), IsFieldCorrect(Grid, *Field, ReferenceCosts(Grid, Goal)) ? "ok" : "MISMATCH");
+    }
+
+    // Agents on tiles that reach the goal, each heading for the tile the field points to from its own
+    std::vector<Agent> Agents;
+    std::vector<TilePoint> AgentTiles;
+    while (Agents.size() < AgentCount)
+    {
+        const TilePoint Start = RandomOpenTile(Grid, Seed);
+        if (Field->IsReachable(Start.X, Start.Y))
+        {
+            Agents.push_back({static_cast<float>(Start.X), static_cast<float>(Start.Y)});
+            AgentTiles.push_back(Start);
+        }
+    }
+
+    const float Step = AgentSpeedTiles * FrameTimeS;
+    std::size_t Arrived = 0;
+    Started = std::chrono::steady_clock::now();
+    for (int Frame = 0; Frame < Frames; ++Frame)
+    {
+        Arrived = 0;
+        for (Agent& Current : Agents)
+        {
+            const int TileX = static_cast<int>(std::floor(Current.X + 0.5f));
+            const int TileY = static_cast<int>(std::floor(Current.Y + 0.5f));
+            const TilePoint Offset = Field->GetStep(TileX, TileY);
+
+            const float ToX = static_cast<float>(TileX + Offset.X) - Current.X;
+            const float ToY = static_cast<float>(TileY + Offset.Y) - Current.Y;
+            const float Distance = std::sqrt(ToX * ToX + ToY * ToY);
+            if (Distance <= Step)
+            {
+                Current.X += ToX;
+                Current.Y += ToY;
+            }
+            else
+            {
+                Current.X += ToX / Distance * Step;
+                Current.Y += ToY / Distance * Step;
+            }
+            Arrived += TilePoint{TileX, TileY} == Goal ? 1 : 0;
+        }
+    }
+    const double FollowMs = ElapsedMs(Started) / Frames;
+
+    // The same agents each asking for a path of their own, timed on a sample and scaled up
+    GridPathfinder Pathfinder;
+    const NavigationGraph Graph(Grid, nullptr, Pathfinder);
+    const std::size_t SampleCount = std::min<std::size_t>(AgentTiles.size(), 200);
+    Started = std::chrono::steady_clock::now();
+    for (std::size_t Index = 0; Index < SampleCount; ++Index)
+    {
+        Graph.FindPath(AgentTiles[Index], Goal, Pathfinder);
+    }
+    const double PathsMs = ElapsedMs(Started) / SampleCount * AgentTiles.size();
+
+    std::printf("\n%-28s %12s %14s\n", "Agents to one goal", "ms", "At goal");
+    std::printf("%-28s %12.3f %14zu\n", "Follow field, per frame", FollowMs, Arrived);
+    std::printf("%-28s %12.3f\n", "Path per agent, once", PathsMs);
+
+    // Through the service: asked for each tick, built on a worker, then updated after an edit
+    ThreadPool Workers(std::max<std::size_t>(1, std::thread::hardware_concurrency() / 2));
+    PathfindingService Service(Workers);
+    Started = std::chrono::steady_clock::now();
+    std::shared_ptr<const FlowField> Served;
+    while (!Served)
+    {
+        Served = Service.GetFlowField(Goal);
+        Service.Tick(Grid);
+        Service.Wait();
+    }
+    const double ServedMs = ElapsedMs(Started);
+
+    Map.SetTile(RoomX + 4, RoomY + 4, 1, Wall);
+    Grid.Update(Map, IsTileSolid);
+    Started = std::chrono::steady_clock::now();
+    while (Served->GetVersion() != Grid.GetVersion())
+    {
+        Served = Service.GetFlowField(Goal);
+        Service.Tick(Grid);
+        Service.Wait();
+    }
+    const double ServedUpdateMs = ElapsedMs(Started);
+
+    std::printf("\n%-28s %12s %14s\n", "Service", "ms", "Check");
+    std::printf("%-28s %12.3f\n", "First field", ServedMs);
+    std::printf("%-28s %12.3f %14s\n", "Field after an edit", ServedUpdateMs,
+                IsFieldCorrect(Grid, *Served, ReferenceCosts(Grid, Goal)) ? "ok" : "MISMATCH");
+
+    return 0;
+}
@@ -0,0 +1,316 @@
+// Finds paths between random open tiles of a map of walled rooms, with plain A* expanding every tile, with
+// Core::GridPathfinder's jump point search and with Core::NavigationGraph. Checks that every path only crosses open
+// tiles, that jump point search finds the same costs as A*, and how much longer the graph's paths are. Then times
+// rebuilding the graph after an edit, and answering requests through Core::PathfindingService.
+// Usage: PathfindingBenchmark [Size=1000] [Queries=200] [Requests=4000]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "../../Core/Navigation/GridPathfinder.h"
+#include "../../Core/Navigation/NavigationGraph.h"
+#include "../../Core/Navigation/PathfindingService.h"
+#include "../../Core/TileMap/TileCollisionGrid.h"
+#include "../../Core/TileMap/TileMap.h"
+#include "../Common/RoomMap.h"
+
+namespace
+{
+    using Core::GridPathfinder;
+    using Core::NavigationGraph;
+    using Core::PathfindingService;
+    using Core::PathResult;
+    using Core::ThreadPool;
+    using Core::Tile;
+    using Core::TileCollisionGrid;
+    using Core::TileMap;
+    using Core::TileMapBounds;
+    using Core::TilePoint;
+    using Core::uint;
+    using namespace RoomMap;
+
+    // The same search GridPathfinder makes, expanding every tile instead of jumping. Returns the cost, or infinity.
+    float PlainAStar(const TileCollisionGrid& Grid, TilePoint Start, TilePoint Goal, std::vector<float>& Costs,
+                     std::vector<bool>& Closed)
+    {
+        const int Width = static_cast<int>(Grid.GetWidth());
+        std::fill(Costs.begin(), Costs.end(), std::numeric_limits<float>::infinity());
+        std::fill(Closed.begin(), Closed.end(), false);
+
+        std::vector<std::pair<float, int>> Open;
+        Costs[Start.Y * Width + Start.X] = 0.0f;
+        Open.emplace_back(GridPathfinder::GetDistance(Start, Goal), Start.Y * Width + Start.X);
+
+        while (!Open.empty())
+        {
+            std::pop_heap(Open.begin(), Open.end(), std::greater<>());
+            const int Index = Open.back().second;
+            Open.pop_back();
+            if (Closed[Index])
+            {
+                continue;
+            }
+            Closed[Index] = true;
+
+            const TilePoint Point{Index % Width, Index / Width};
+            if (Point == Goal)
+            {
+                return Costs[Index];
+            }
+
+            for (int DY = -1; DY <= 1; ++DY)
+            {
+                for (int DX = -1; DX <= 1; ++DX)
+                {
+                    const bool bDiagonal = DX != 0 && DY != 0;
+                    if ((DX == 0 && DY == 0) || !IsOpen(Grid, Point.X + DX, Point.Y + DY) ||
+                        (bDiagonal && (!IsOpen(Grid, Point.X + DX, Point.Y) || !IsOpen(Grid, Point.X, Point.Y + DY))))
+                    {
+                        continue;
+                    }
+
+                    const int Next = (Point.Y + DY) * Width + Point.X + DX;
+                    const float Cost = Costs[Index] + (bDiagonal ? GridPathfinder::DiagonalCost : 1.0f);
+                    if (!Closed[Next] && Cost < Costs[Next])
+                    {
+                        Costs[Next] = Cost;
+                        Open.emplace_back(Cost + GridPathfinder::GetDistance({Point.X + DX, Point.Y + DY}, Goal), Next);
+                        std::push_heap(Open.begin(), Open.end(), std::greater<>());
+                    }
+                }
+            }
+        }
+
+        return std::numeric_limits<float>::infinity();
+    }
+
+    // Whether the waypoints run from Start to Goal along straight or diagonal lines of open tiles, never cutting the
+    // corner of a wall, and the cost of walking them
+    bool IsPathValid(const TileCollisionGrid& Grid, const std::vector<TilePoint>& Waypoints, TilePoint Start,
+                     TilePoint Goal, float& OutCost)
+    {
+        OutCost = 0.0f;
+        if (Waypoints.empty() || !(Waypoints.front() == Start) || !(Waypoints.back() == Goal))
+        {
+            return false;
+        }
+
+        for (std::size_t Index = 1; Index < Waypoints.size(); ++Index)
+        {
+            TilePoint Point = Waypoints[Index - 1];
+            const TilePoint Next = Waypoints[Index];
+            const int DX = (Next.X > Point.X) - (Next.X < Point.X);
+            const int DY = (Next.Y > Point.Y) - (Next.Y < Point.Y);
+            if (DX != 0 && DY != 0 && std::abs(Next.X - Point.X) != std::abs(Next.Y - Point.Y))
+            {
+                return false;
+            }
+
+            while (!(Point == Next))
+            {
+                if (DX != 0 && DY != 0 && (!IsOpen(Grid, Point.X + DX, Point.Y) || !IsOpen(Grid, Point.X, Point.Y + DY)))
+                {
+                    return false;
+                }
+                Point.X += DX;
+                Point.Y += DY;
+                if (!IsOpen(Grid, Point.X, Point.Y))
+                {
+                    return false;
+                }
+                OutCost += DX != 0 && DY != 0 ? GridPathfinder::DiagonalCost : 1.0f;
+            }
+        }
+        return true;
+    }
+
+    double ElapsedMs(std::chrono::steady_clock::time_point Start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Core;
+
+    const uint Size = argc > 1 ? static_cast<uint>(std::max(std::atoi(argv[1]), 64)) : 1000;
+    const int QueryCount = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 200;
+    const int RequestCount = argc > 3 ? std::max(std::atoi(argv[3]), 1) : 4000;
+
+    TileMap Map(Size, Size);
+    BuildRooms(Map);
+
+    TileCollisionGrid Grid;
+    Grid.Update(Map, IsTileSolid);
+
+    GridPathfinder Pathfinder;
+    auto Started = std::chrono::steady_clock::now();
+    NavigationGraph Graph(Grid, nullptr, Pathfinder);
+    const double BuildMs = ElapsedMs(Started);
+
+    std::printf("%u x %u map, %zu solid tiles, %zu clusters, %zu portals\n\n", Size, Size, Grid.GetSolidCount(),
+                Graph.GetClusterCount(), Graph.GetPortalCount());
+
+    std::uint32_t Seed = 11;
+    std::vector<std::pair<TilePoint, TilePoint>> Queries;
+    for (int Query = 0; Query < QueryCount; ++Query)
+    {
+        const TilePoint Start = RandomOpenTile(Grid, Seed);
+        Queries.emplace_back(Start, RandomOpenTile(Grid, Seed));
+    }
+
+    // Plain A*, as the reference every other cost is checked against
+    std::vector<float> Costs(static_cast<std::size_t>(Size) * Size);
+    std::vector<bool> Closed(Costs.size());
+    std::vector<float> ReferenceCosts;
+    Started = std::chrono::steady_clock::now();
+    for (const auto& [Start, Goal] : Queries)
+    {
+        ReferenceCosts.push_back(PlainAStar(Grid, Start, Goal, Costs, Closed));
+    }
+    const double PlainMs = ElapsedMs(Started) / QueryCount;
+
+    const TileMapBounds Everywhere{0, 0, Size - 1, Size - 1};
+    std::vector<std::vector<TilePoint>> JumpPaths;
+    std::size_t JumpExpanded = 0;
+    Started = std::chrono::steady_clock::now();
+    for (const auto& [Start, Goal] : Queries)
+    {
+        JumpPaths.push_back(Pathfinder.FindPath(Grid, Start, Goal, Everywhere));
+        JumpExpanded += Pathfinder.GetExpandedCount();
+    }
+    const double JumpMs = ElapsedMs(Started) / QueryCount;
+
+    std::vector<std::vector<TilePoint>> GraphPaths;
+    Started = std::chrono::steady_clock::now();
+    for (const auto& [Start, Goal] : Queries)
+    {
+        GraphPaths.push_back(Graph.FindPath(Start, Goal, Pathfinder));
+    }
+    const double GraphMs = ElapsedMs(Started) / QueryCount;
+
+    bool bJumpMatches = true;
+    bool bGraphValid = true;
+    double RatioSum = 0.0;
+    double WorstRatio = 1.0;
+    int Found = 0;
+    for (std::size_t Query = 0; Query < Queries.size(); ++Query)
+    {
+        const auto& [Start, Goal] = Queries[Query];
+        const bool bReachable = std::isfinite(ReferenceCosts[Query]);
+
+        float JumpCost = 0.0f;
+        const bool bJumpValid = IsPathValid(Grid, JumpPaths[Query], Start, Goal, JumpCost);
+        bJumpMatches = bJumpMatches && bJumpValid == bReachable &&
+                       (!bReachable || std::abs(JumpCost - ReferenceCosts[Query]) <= 1.0e-3f * ReferenceCosts[Query] + 1.0e-3f);
+
+        float GraphCost = 0.0f;
+        const bool bValid = IsPathValid(Grid, GraphPaths[Query], Start, Goal, GraphCost);
+        bGraphValid = bGraphValid && bValid == bReachable;
+        if (bValid && ReferenceCosts[Query] > 0.0f)
+        {
+            const double Ratio = GraphCost / ReferenceCosts[Query];
+            RatioSum += Ratio;
+            WorstRatio = std::max(WorstRatio, Ratio);
+            ++Found;
+        }
+    }
+
+    std::printf("%-28s %12s %14s %12s\n", "Search", "ms/path", "Cost vs A*", "Check");
+    std::printf("%-28s %12.3f %14s %12s\n", "Plain A*", PlainMs, "1.000", "reference");
+    std::printf("%-28s %12.3f %14s %12s   %zu jump points expanded per path\n", "Jump point search", JumpMs, "1.000",
+                bJumpMatches ? "ok" : "MISMATCH", JumpExpanded / Queries.size());
+    std::printf("%-28s %12.3f %8.3f avg %5.3f max %5s\n", "Navigation graph", GraphMs, Found ? RatioSum / Found : 1.0,
+                WorstRatio, bGraphValid ? "ok" : "MISMATCH");
+
+    // One wall tile toggled per rebuild, as an editor brush or a door would
+    std::printf("\n%-28s %12s %14s\n", "Graph build", "ms", "Clusters");
+    std::printf("%-28s %12.3f %14zu\n", "Full", BuildMs, Graph.GetRebuiltClusterCount());
+
+    NavigationGraph Edited = Graph;
+    double EditMs = 0.0;
+    std::size_t EditClusters = 0;
+    constexpr int EditCount = 20;
+    for (int Edit = 0; Edit < EditCount; ++Edit)
+    {
+        const uint X = static_cast<uint>(Edit * 337 + 5) % Size;
+        const uint Y = static_cast<uint>(Edit * 191 + 3) % Size;
+        Map.SetTile(X, Y, 1, Map.GetTile(X, Y, 1) == Wall ? Tile() : Wall);
+        Grid.Update(Map, IsTileSolid);
+
+        Started = std::chrono::steady_clock::now();
+        Edited = NavigationGraph(Grid, &Edited, Pathfinder);
+        EditMs += ElapsedMs(Started);
+        EditClusters += Edited.GetRebuiltClusterCount();
+    }
+    std::printf("%-28s %12.3f %14zu\n", "One tile edited", EditMs / EditCount, EditClusters / EditCount);
+
+    // The edited graph has to answer as one built from scratch would
+    const NavigationGraph Rebuilt(Grid, nullptr, Pathfinder);
+    bool bRebuildMatches = Rebuilt.GetPortalCount() == Edited.GetPortalCount();
+    for (const auto& [Start, Goal] : Queries)
+    {
+        float EditedCost = 0.0f;
+        float RebuiltCost = 0.0f;
+        const bool bEditedFound = !Edited.FindPath(Start, Goal, Pathfinder, &EditedCost).empty();
+        const bool bRebuiltFound = !Rebuilt.FindPath(Start, Goal, Pathfinder, &RebuiltCost).empty();
+        bRebuildMatches = bRebuildMatches && bEditedFound == bRebuiltFound && std::abs(EditedCost - RebuiltCost) < 1.0e-3f;
+    }
+    std::printf("%-28s %12s\n", "Incremental vs rebuilt", bRebuildMatches ? "ok" : "MISMATCH");
+
+    // Many agents asking at once, a good share of them for the same few destinations
+    ThreadPool Workers(std::max<std::size_t>(1, std::thread::hardware_concurrency() / 2));
+    PathfindingService Service(Workers);
+    std::vector<std::pair<TilePoint, TilePoint>> Requests;
+    std::vector<TilePoint> Destinations;
+    for (int Destination = 0; Destination < 16; ++Destination)
+    {
+        Destinations.push_back(RandomOpenTile(Grid, Seed));
+    }
+    for (int Request = 0; Request < RequestCount; ++Request)
+    {
+        const TilePoint Start = RandomOpenTile(Grid, Seed);
+        Requests.emplace_back(Start, NextRandom(Seed) % 4 == 0 ? Destinations[NextRandom(Seed) % 16] : RandomOpenTile(Grid, Seed));
+    }
+
+    std::printf("\n%-28s %12s %14s %12s %10s\n", "Service", "ms", "Paths/s", "Cache hits", "Check");
+    auto RunRequests = [&](const char* Name)
+    {
+        const std::size_t HitsBefore = Service.GetStats().CacheHits;
+        std::size_t Delivered = 0;
+        bool bAllValid = true;
+
+        const auto RequestsStarted = std::chrono::steady_clock::now();
+        for (const auto& [Start, Goal] : Requests)
+        {
+            Service.RequestPath(Start, Goal, [&, Start, Goal](const PathResult& Result)
+            {
+                float Cost = 0.0f;
+                bAllValid = bAllValid && (!Result.IsFound() || IsPathValid(Grid, Result.Waypoints, Start, Goal, Cost));
+                ++Delivered;
+            });
+        }
+        while (Delivered < Requests.size())
+        {
+            Service.Tick(Grid);
+            Service.Wait();
+        }
+        const double RequestsMs = ElapsedMs(RequestsStarted);
+
+        std::printf("%-28s %12.1f %14.0f %12zu %10s\n", Name, RequestsMs, Requests.size() / (RequestsMs / 1000.0),
+                    Service.GetStats().CacheHits - HitsBefore, bAllValid ? "ok" : "MISMATCH");
+    };
+    RunRequests("First requests");
+    RunRequests("Same requests again");
+
+    return 0;
+}
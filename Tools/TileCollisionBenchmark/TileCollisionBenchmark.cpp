@@ -0,0 +1,307 @@
+// Moves thousands of boxes through a walled two-layer map for a number of frames, once with Core::TileCollisionGrid
+// and once with the same sweep reading each crossed tile through TileMap::GetTile on every layer, and checks that
+// both end with every box in the same place and none inside a wall. Then times keeping the grid up to date.
+// Usage: TileCollisionBenchmark [Size=1000] [Agents=10000] [Frames=120]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../../Core/TileMap/TileCollisionGrid.h"
+#include "../../Core/TileMap/TileMap.h"
+#include "../Common/RoomMap.h"
+
+namespace
+{
+    using Core::CollisionBox;
+    using Core::CollisionMove;
+    using Core::Tile;
+    using Core::TileCollisionGrid;
+    using Core::TileMap;
+    using Core::uint;
+    using namespace RoomMap;
+
+    constexpr float TileSize = 16.0f;
+    constexpr float FrameTimeS = 1.0f / 60.0f;
+    constexpr float AgentSize = 12.0f;
+
+    struct Agent
+    {
+        CollisionBox Box;
+        float VelocityX = 0.0f;
+        float VelocityY = 0.0f;
+    };
+
+    bool IsMapSolid(const TileMap& Map, int X, int Y)
+    {
+        for (uint Layer = 0; Layer < Map.GetLayerCount(); ++Layer)
+        {
+            if (IsTileSolid(Map.GetTile(static_cast<uint>(X), static_cast<uint>(Y), Layer)))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int ToTile(float Value)
+    {
+        return static_cast<int>(std::floor(Value / TileSize));
+    }
+
+    // TileCollisionGrid's sweep along one axis, asking the map about every tile the box's leading edge crosses
+    float PerTileSweepAxis(const TileMap& Map, const CollisionBox& Box, float Delta, bool bAlongX, bool& bBlocked)
+    {
+        const float Skin = TileSize * TileCollisionGrid::SkinFraction;
+        const float Near = bAlongX ? Box.Left : Box.Top;
+        const float Extent = bAlongX ? Box.Width : Box.Height;
+        const float Side = bAlongX ? Box.Top : Box.Left;
+        const float SideExtent = bAlongX ? Box.Height : Box.Width;
+        const int Limit = static_cast<int>(bAlongX ? Map.GetWidth() : Map.GetHeight()) - 1;
+        const int SideLimit = static_cast<int>(bAlongX ? Map.GetHeight() : Map.GetWidth()) - 1;
+
+        const int MinSide = std::max(ToTile(Side + Skin), 0);
+        const int MaxSide = std::min(ToTile(Side + SideExtent - Skin), SideLimit);
+        if (Delta == 0.0f || MinSide > MaxSide)
+        {
+            return Delta;
+        }
+
+        auto IsLineSolid = [&](int Line)
+        {
+            for (int Across = MinSide; Across <= MaxSide; ++Across)
+            {
+                if (bAlongX ? IsMapSolid(Map, Line, Across) : IsMapSolid(Map, Across, Line))
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        if (Delta > 0.0f)
+        {
+            const float Far = Near + Extent;
+            for (int Line = std::max(ToTile(Far - Skin) + 1, 0); Line <= std::min(ToTile(Far + Delta - Skin), Limit); ++Line)
+            {
+                if (IsLineSolid(Line))
+                {
+                    bBlocked = true;
+                    return std::max(Line * TileSize - Far, 0.0f);
+                }
+            }
+        }
+        else
+        {
+            for (int Line = std::min(ToTile(Near + Skin) - 1, Limit); Line >= std::max(ToTile(Near + Delta + Skin), 0); --Line)
+            {
+                if (IsLineSolid(Line))
+                {
+                    bBlocked = true;
+                    return std::min((Line + 1) * TileSize - Near, 0.0f);
+                }
+            }
+        }
+
+        return Delta;
+    }
+
+    CollisionMove PerTileSweep(const TileMap& Map, const CollisionBox& Box, float DeltaX, float DeltaY)
+    {
+        CollisionMove Move;
+        Move.X = PerTileSweepAxis(Map, Box, DeltaX, true, Move.bBlockedX);
+
+        CollisionBox Moved = Box;
+        Moved.Left += Move.X;
+        Move.Y = PerTileSweepAxis(Map, Moved, DeltaY, false, Move.bBlockedY);
+
+        return Move;
+    }
+
+    // Agents on open tiles, heading in random directions at Speed pixels per second
+    std::vector<Agent> SpawnAgents(const TileMap& Map, uint Count, float Speed)
+    {
+        std::vector<Agent> Agents;
+        Agents.reserve(Count);
+
+        std::uint32_t Seed = 42;
+        while (Agents.size() < Count)
+        {
+            const int X = static_cast<int>(NextRandom(Seed) % Map.GetWidth());
+            const int Y = static_cast<int>(NextRandom(Seed) % Map.GetHeight());
+            if (IsMapSolid(Map, X, Y))
+            {
+                continue;
+            }
+
+            const float Angle = static_cast<float>(NextRandom(Seed) % 3600) * 0.1f * 3.14159265f / 180.0f;
+            Agent NewAgent;
+            NewAgent.Box = {X * TileSize + 2.0f, Y * TileSize + 2.0f, AgentSize, AgentSize};
+            NewAgent.VelocityX = std::cos(Angle) * Speed;
+            NewAgent.VelocityY = std::sin(Angle) * Speed;
+            Agents.push_back(NewAgent);
+        }
+        return Agents;
+    }
+
+    // Moves every agent one frame, bouncing it off whatever stopped it
+    template <typename SweepFunction>
+    void StepAgents(std::vector<Agent>& Agents, SweepFunction&& Sweep)
+    {
+        for (Agent& Current : Agents)
+        {
+            const CollisionMove Move = Sweep(Current.Box, Current.VelocityX * FrameTimeS, Current.VelocityY * FrameTimeS);
+            Current.Box.Left += Move.X;
+            Current.Box.Top += Move.Y;
+            if (Move.bBlockedX)
+            {
+                Current.VelocityX = -Current.VelocityX;
+            }
+            if (Move.bBlockedY)
+            {
+                Current.VelocityY = -Current.VelocityY;
+            }
+        }
+    }
+
+    // Agents whose box, less the skin it may rest in, overlaps a solid tile
+    std::size_t CountInsideWalls(const TileMap& Map, const std::vector<Agent>& Agents)
+    {
+        const float Skin = TileSize * TileCollisionGrid::SkinFraction * 2.0f;
+        std::size_t Count = 0;
+        for (const Agent& Current : Agents)
+        {
+            bool bInside = false;
+            for (int Y = ToTile(Current.Box.Top + Skin); Y <= ToTile(Current.Box.Top + Current.Box.Height - Skin); ++Y)
+            {
+                for (int X = ToTile(Current.Box.Left + Skin); X <= ToTile(Current.Box.Left + Current.Box.Width - Skin); ++X)
+                {
+                    const bool bOnMap = X >= 0 && Y >= 0 && X < static_cast<int>(Map.GetWidth()) &&
+                                        Y < static_cast<int>(Map.GetHeight());
+                    bInside = bInside || (bOnMap && IsMapSolid(Map, X, Y));
+                }
+            }
+            Count += bInside ? 1 : 0;
+        }
+        return Count;
+    }
+
+    bool AgentsMatch(const std::vector<Agent>& A, const std::vector<Agent>& B)
+    {
+        for (std::size_t Index = 0; Index < A.size(); ++Index)
+        {
+            if (A[Index].Box.Left != B[Index].Box.Left || A[Index].Box.Top != B[Index].Box.Top)
+            {
+                return false;
+            }
+        }
+        return A.size() == B.size();
+    }
+
+    void Run(const char* Name, const TileMap& Map, const TileCollisionGrid& Grid, uint AgentCount, int Frames, float Speed)
+    {
+        std::vector<Agent> PerTileAgents = SpawnAgents(Map, AgentCount, Speed);
+        std::vector<Agent> GridAgents = PerTileAgents;
+
+        auto Start = std::chrono::steady_clock::now();
+        for (int Frame = 0; Frame < Frames; ++Frame)
+        {
+            StepAgents(PerTileAgents, [&Map](const CollisionBox& Box, float DeltaX, float DeltaY)
+            {
+                return PerTileSweep(Map, Box, DeltaX, DeltaY);
+            });
+        }
+        const double PerTileMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count() /
+                                 Frames;
+
+        Start = std::chrono::steady_clock::now();
+        for (int Frame = 0; Frame < Frames; ++Frame)
+        {
+            StepAgents(GridAgents, [&Grid](const CollisionBox& Box, float DeltaX, float DeltaY)
+            {
+                return Grid.Sweep(Box, DeltaX, DeltaY, TileSize);
+            });
+        }
+        const double GridMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count() /
+                              Frames;
+        const std::size_t InsideWalls = CountInsideWalls(Map, GridAgents);
+
+        const bool bMatches = AgentsMatch(PerTileAgents, GridAgents) && InsideWalls == 0;
+        std::printf("%-28s %10u %12.3f %10.3f %8.1fx %10zu  %s\n", Name, AgentCount, PerTileMs, GridMs,
+                    GridMs > 0.0 ? PerTileMs / GridMs : 0.0, InsideWalls, bMatches ? "ok" : "MISMATCH");
+    }
+
+    template <typename UpdateFunction>
+    double TimeUpdates(int Iterations, UpdateFunction&& Update)
+    {
+        const auto Start = std::chrono::steady_clock::now();
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            Update(Iteration);
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count() / Iterations;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Core;
+
+    const uint Size = argc > 1 ? static_cast<uint>(std::max(std::atoi(argv[1]), 32)) : 1000;
+    const uint AgentCount = argc > 2 ? static_cast<uint>(std::max(std::atoi(argv[2]), 1)) : 10000;
+    const int Frames = argc > 3 ? std::max(std::atoi(argv[3]), 1) : 120;
+
+    TileMap Map(Size, Size);
+    BuildRooms(Map);
+
+    TileCollisionGrid Grid;
+    Grid.Update(Map, IsTileSolid);
+
+    std::printf("%u x %u map, 2 layers, %zu solid tiles, %u agents, %d frames\n", Size, Size, Grid.GetSolidCount(),
+                AgentCount, Frames);
+    std::printf("%-28s %10s %12s %10s %9s %10s\n", "Movement", "Agents", "Per-tile ms", "Grid ms", "Speedup", "In walls");
+
+    Run("Walking, 200 px/s", Map, Grid, AgentCount, Frames, 200.0f);
+    Run("Dashing, 3000 px/s", Map, Grid, AgentCount, Frames, 3000.0f);
+
+    std::printf("\n%-28s %12s\n", "Grid update", "ms");
+
+    const double FullMs = TimeUpdates(5, [&](int)
+    {
+        TileCollisionGrid Fresh;
+        Fresh.Update(Map, IsTileSolid);
+    });
+    std::printf("%-28s %12.3f\n", "Full build", FullMs);
+
+    // One wall tile toggled per update, as an editor brush or a door would
+    const double EditMs = TimeUpdates(200, [&](int Iteration)
+    {
+        const uint X = static_cast<uint>(Iteration * 37) % Size;
+        const uint Y = static_cast<uint>(Iteration * 91) % Size;
+        Map.SetTile(X, Y, 1, Map.GetTile(X, Y, 1) == Wall ? Tile() : Wall);
+        Grid.Update(Map, IsTileSolid);
+    });
+    std::printf("%-28s %12.3f\n", "One tile edited", EditMs);
+
+    const double UnchangedMs = TimeUpdates(10000, [&](int) { Grid.Update(Map, IsTileSolid); });
+    std::printf("%-28s %12.5f\n", "Nothing changed", UnchangedMs);
+
+    TileCollisionGrid Rebuilt;
+    Rebuilt.Update(Map, IsTileSolid);
+    bool bGridMatches = Rebuilt.GetSolidCount() == Grid.GetSolidCount();
+    for (uint Y = 0; Y < Size && bGridMatches; ++Y)
+    {
+        for (uint X = 0; X < Size && bGridMatches; ++X)
+        {
+            bGridMatches = Grid.IsSolid(static_cast<int>(X), static_cast<int>(Y)) ==
+                           IsMapSolid(Map, static_cast<int>(X), static_cast<int>(Y));
+        }
+    }
+    std::printf("%-28s %12s\n", "Incremental vs rebuilt", bGridMatches ? "ok" : "MISMATCH");
+
+    return 0;
+}
@@ -0,0 +1,346 @@
+// Benchmarks Core::TileMapOps against the per-cell GetTile/SetTile loops they replace, on worst-case maps, and checks
+// that both leave the layer with the same tiles and occupancy. Then times TileMap's occupancy queries against full
+// scans.
+// Usage: TileMapBenchmark [Size=1000] [Iterations=5]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "../../Core/TileMap/TileMap.h"
+#include "../../Core/TileMap/TileMapOps.h"
+
+namespace
+{
+    using Core::Tile;
+    using Core::TileMap;
+    using Core::TileMapBounds;
+    using Core::uint;
+
+    const Tile Wall(0, 1);
+    const Tile Paint(0, 2);
+
+    using MapBuilder = std::function<void(TileMap&)>;
+    using Operation = std::function<std::size_t(TileMap&)>;
+
+    // The flood fill the level editor used before TileMapOps: a DFS pushing all four neighbours of every filled tile
+    std::size_t PerCellFloodFill(TileMap& Map, uint StartX, uint StartY, const Tile& Replacement)
+    {
+        const Tile Target = Map.GetTile(StartX, StartY, 0);
+        if (Target == Replacement)
+        {
+            return 0;
+        }
+
+        std::size_t Filled = 0;
+        std::vector<std::pair<uint, uint>> Stack;
+        Stack.emplace_back(StartX, StartY);
+        while (!Stack.empty())
+        {
+            const auto [X, Y] = Stack.back();
+            Stack.pop_back();
+
+            if (X >= Map.GetWidth() || Y >= Map.GetHeight() || !(Map.GetTile(X, Y, 0) == Target))
+            {
+                continue;
+            }
+
+            Map.SetTile(X, Y, 0, Replacement);
+            ++Filled;
+
+            if (X > 0)
+                Stack.emplace_back(X - 1, Y);
+            if (X < Map.GetWidth() - 1)
+                Stack.emplace_back(X + 1, Y);
+            if (Y > 0)
+                Stack.emplace_back(X, Y - 1);
+            if (Y < Map.GetHeight() - 1)
+                Stack.emplace_back(X, Y + 1);
+        }
+        return Filled;
+    }
+
+    std::size_t PerCellFillRect(TileMap& Map, uint X, uint Y, uint Width, uint Height, const Tile& Value)
+    {
+        std::size_t Written = 0;
+        for (uint Row = Y; Row < Y + Height && Row < Map.GetHeight(); ++Row)
+        {
+            for (uint Column = X; Column < X + Width && Column < Map.GetWidth(); ++Column)
+            {
+                Map.SetTile(Column, Row, 0, Value);
+                ++Written;
+            }
+        }
+        return Written;
+    }
+
+    std::size_t PerCellPaste(TileMap& Map, const TileMap& Source, uint X, uint Y, bool bSkipEmpty)
+    {
+        std::size_t Written = 0;
+        for (uint Row = 0; Row < Source.GetHeight() && Y + Row < Map.GetHeight(); ++Row)
+        {
+            for (uint Column = 0; Column < Source.GetWidth() && X + Column < Map.GetWidth(); ++Column)
+            {
+                const Tile& Value = Source.GetTile(Column, Row, 0);
+                if (bSkipEmpty && Value.IsEmpty())
+                {
+                    continue;
+                }
+                Map.SetTile(X + Column, Y + Row, 0, Value);
+                ++Written;
+            }
+        }
+        return Written;
+    }
+
+    std::size_t PerCellReplace(TileMap& Map, const Tile& From, const Tile& To)
+    {
+        std::size_t Replaced = 0;
+        for (uint Y = 0; Y < Map.GetHeight(); ++Y)
+        {
+            for (uint X = 0; X < Map.GetWidth(); ++X)
+            {
+                if (Map.GetTile(X, Y, 0) == From)
+                {
+                    Map.SetTile(X, Y, 0, To);
+                    ++Replaced;
+                }
+            }
+        }
+        return Replaced;
+    }
+
+    // Vertical walls on every odd column, open at alternate ends: one corridor snaking through the whole map, so
+    // every scanline span is a single tile and the fill has as many spans as it has tiles in the corridors
+    void BuildSerpentine(TileMap& Map)
+    {
+        for (uint X = 1; X < Map.GetWidth(); X += 2)
+        {
+            const uint Gap = (X / 2) % 2 == 0 ? Map.GetHeight() - 1 : 0;
+            for (uint Y = 0; Y < Map.GetHeight(); ++Y)
+            {
+                if (Y != Gap)
+                {
+                    Map.SetTile(X, Y, 0, Wall);
+                }
+            }
+        }
+    }
+
+    // Walls on every other tile of every other row, so most rows split into many short runs
+    void BuildLattice(TileMap& Map)
+    {
+        for (uint Y = 1; Y < Map.GetHeight(); Y += 2)
+        {
+            for (uint X = 1; X < Map.GetWidth(); X += 2)
+            {
+                Map.SetTile(X, Y, 0, Wall);
+            }
+        }
+    }
+
+    // A few tiles scattered near the middle, the case a bounds query is for
+    void BuildSparse(TileMap& Map)
+    {
+        const uint Middle = Map.GetWidth() / 2;
+        for (uint Offset = 0; Offset < 64; ++Offset)
+        {
+            Map.SetTile(Middle - Offset * 3 % 97, Middle + Offset * 7 % 89, 0, Wall);
+        }
+    }
+
+    std::size_t ScanTileCount(const TileMap& Map, uint X, uint Y, uint Width, uint Height)
+    {
+        std::size_t Count = 0;
+        for (uint Row = Y; Row < Y + Height && Row < Map.GetHeight(); ++Row)
+        {
+            for (uint Column = X; Column < X + Width && Column < Map.GetWidth(); ++Column)
+            {
+                Count += Map.GetTile(Column, Row, 0).IsEmpty() ? 0 : 1;
+            }
+        }
+        return Count;
+    }
+
+    std::optional<TileMapBounds> ScanUsedBounds(const TileMap& Map)
+    {
+        std::optional<TileMapBounds> Bounds;
+        for (uint Y = 0; Y < Map.GetHeight(); ++Y)
+        {
+            for (uint X = 0; X < Map.GetWidth(); ++X)
+            {
+                if (Map.GetTile(X, Y, 0).IsEmpty())
+                {
+                    continue;
+                }
+                if (!Bounds)
+                {
+                    Bounds = TileMapBounds{X, Y, X, Y};
+                    continue;
+                }
+                Bounds->MinX = std::min(Bounds->MinX, X);
+                Bounds->MinY = std::min(Bounds->MinY, Y);
+                Bounds->MaxX = std::max(Bounds->MaxX, X);
+                Bounds->MaxY = std::max(Bounds->MaxY, Y);
+            }
+        }
+        return Bounds;
+    }
+
+    bool BoundsMatch(const std::optional<TileMapBounds>& A, const std::optional<TileMapBounds>& B)
+    {
+        if (!A || !B)
+        {
+            return !A && !B;
+        }
+        return A->MinX == B->MinX && A->MinY == B->MinY && A->MaxX == B->MaxX && A->MaxY == B->MaxY;
+    }
+
+    bool OccupancyMatches(const TileMap& Map)
+    {
+        return Map.GetTileCount(0) == ScanTileCount(Map, 0, 0, Map.GetWidth(), Map.GetHeight()) &&
+               BoundsMatch(Map.GetUsedBounds(0), ScanUsedBounds(Map));
+    }
+
+    bool LayersMatch(const TileMap& A, const TileMap& B)
+    {
+        return A.GetLayerTiles(0) == B.GetLayerTiles(0) && OccupancyMatches(A) && OccupancyMatches(B);
+    }
+
+    void Run(const char* Name, uint Size, int Iterations, const MapBuilder& Build, const Operation& PerCell,
+             const Operation& Spans)
+    {
+        double PerCellMs = 0.0;
+        double SpansMs = 0.0;
+        std::size_t Written = 0;
+        bool bMatches = true;
+
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            TileMap PerCellMap(Size, Size);
+            Build(PerCellMap);
+            TileMap SpansMap = PerCellMap;
+
+            auto Start = std::chrono::steady_clock::now();
+            const std::size_t PerCellWritten = PerCell(PerCellMap);
+            auto End = std::chrono::steady_clock::now();
+            PerCellMs += std::chrono::duration<double, std::milli>(End - Start).count();
+
+            Start = std::chrono::steady_clock::now();
+            Written = Spans(SpansMap);
+            End = std::chrono::steady_clock::now();
+            SpansMs += std::chrono::duration<double, std::milli>(End - Start).count();
+
+            bMatches = bMatches && PerCellWritten == Written && LayersMatch(PerCellMap, SpansMap);
+        }
+
+        PerCellMs /= Iterations;
+        SpansMs /= Iterations;
+        std::printf("%-28s %10zu %12.2f %10.2f %8.1fx  %s\n", Name, Written, PerCellMs, SpansMs,
+                    SpansMs > 0.0 ? PerCellMs / SpansMs : 0.0, bMatches ? "ok" : "MISMATCH");
+    }
+
+    template <typename ScanFunction, typename QueryFunction>
+    void RunQuery(const char* Name, const TileMap& Map, int Iterations, ScanFunction&& Scan, QueryFunction&& Query)
+    {
+        bool bMatches = true;
+
+        auto Start = std::chrono::steady_clock::now();
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            bMatches = bMatches && Scan(Map) == Query(Map);
+        }
+        const double BothMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+
+        Start = std::chrono::steady_clock::now();
+        for (int Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            Query(Map);
+        }
+        const double QueryMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count() /
+                               Iterations;
+        const double ScanMs = std::max(BothMs / Iterations - QueryMs, 0.0);
+
+        std::printf("%-28s %10s %12.3f %10.3f %8.1fx  %s\n", Name, "", ScanMs, QueryMs, QueryMs > 0.0 ? ScanMs / QueryMs : 0.0,
+                    bMatches ? "ok" : "MISMATCH");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace Core;
+
+    const uint Size = argc > 1 ? static_cast<uint>(std::max(std::atoi(argv[1]), 2)) : 1000;
+    const int Iterations = argc > 2 ? std::max(std::atoi(argv[2]), 1) : 5;
+
+    std::printf("%u x %u layer, %d iterations\n", Size, Size, Iterations);
+    std::printf("%-28s %10s %12s %10s %9s\n", "Operation", "Tiles", "Per-cell ms", "Spans ms", "Speedup");
+
+    const MapBuilder Empty = [](TileMap&) {};
+
+    Run("Flood fill, empty layer", Size, Iterations, Empty,
+        [](TileMap& Map) { return PerCellFloodFill(Map, 0, 0, Paint); },
+        [](TileMap& Map) { return TileMapOps::FloodFill(Map, 0, 0, 0, Paint); });
+
+    Run("Flood fill, serpentine", Size, Iterations, BuildSerpentine,
+        [](TileMap& Map) { return PerCellFloodFill(Map, 0, 0, Paint); },
+        [](TileMap& Map) { return TileMapOps::FloodFill(Map, 0, 0, 0, Paint); });
+
+    Run("Flood fill, lattice", Size, Iterations, BuildLattice,
+        [](TileMap& Map) { return PerCellFloodFill(Map, 0, 0, Paint); },
+        [](TileMap& Map) { return TileMapOps::FloodFill(Map, 0, 0, 0, Paint); });
+
+    Run("Fill rect, whole layer", Size, Iterations, Empty,
+        [Size](TileMap& Map) { return PerCellFillRect(Map, 0, 0, Size, Size, Paint); },
+        [Size](TileMap& Map) { return TileMapOps::FillRect(Map, 0, 0, 0, Size, Size, Paint); });
+
+    Run("Clear rect, whole layer", Size, Iterations, BuildLattice,
+        [Size](TileMap& Map) { return PerCellFillRect(Map, 0, 0, Size, Size, Tile()); },
+        [Size](TileMap& Map) { return TileMapOps::ClearRect(Map, 0, 0, 0, Size, Size); });
+
+    // Half the layer copied onto its other half; the lattice's empty tiles make stamping skip every other one
+    const uint Half = Size / 2;
+    TileMap Source(Half, Half);
+    BuildLattice(Source);
+    const TileRegion Region = TileMapOps::CopyRegion(Source, 0, 0, 0, Half, Half);
+
+    Run("Paste, half layer", Size, Iterations, BuildSerpentine,
+        [&Source, Half](TileMap& Map) { return PerCellPaste(Map, Source, Half, Half, false); },
+        [&Region, Half](TileMap& Map) { return TileMapOps::PasteRegion(Map, 0, Half, Half, Region); });
+
+    Run("Stamp, half layer", Size, Iterations, BuildSerpentine,
+        [&Source, Half](TileMap& Map) { return PerCellPaste(Map, Source, Half, Half, true); },
+        [&Region, Half](TileMap& Map) { return TileMapOps::StampRegion(Map, 0, Half, Half, Region); });
+
+    Run("Replace, serpentine walls", Size, Iterations, BuildSerpentine,
+        [](TileMap& Map) { return PerCellReplace(Map, Wall, Paint); },
+        [](TileMap& Map) { return TileMapOps::ReplaceTiles(Map, 0, Wall, Paint); });
+
+    std::printf("\n%-28s %10s %12s %10s %9s\n", "Query", "", "Scan ms", "Chunks ms", "Speedup");
+
+    TileMap Sparse(Size, Size);
+    BuildSparse(Sparse);
+    TileMap Lattice(Size, Size);
+    BuildLattice(Lattice);
+
+    const auto ScanBounds = [](const TileMap& Map) { return ScanUsedBounds(Map).value_or(TileMapBounds{}).MaxX; };
+    const auto QueryBounds = [](const TileMap& Map) { return Map.GetUsedBounds(0).value_or(TileMapBounds{}).MaxX; };
+    RunQuery("Used bounds, sparse", Sparse, Iterations * 10, ScanBounds, QueryBounds);
+    RunQuery("Used bounds, lattice", Lattice, Iterations * 10, ScanBounds, QueryBounds);
+
+    // An unaligned rectangle, so edge chunks take the bit-masked path
+    const uint Inset = Size / 7;
+    const uint Extent = Size - 2 * Inset;
+    RunQuery("Count tiles, lattice", Lattice, Iterations * 10,
+             [=](const TileMap& Map) { return ScanTileCount(Map, Inset, Inset, Extent, Extent); },
+             [=](const TileMap& Map) { return Map.CountTiles(0, Inset, Inset, Extent, Extent); });
+    RunQuery("Region empty, sparse", Sparse, Iterations * 10,
+             [=](const TileMap& Map) { return ScanTileCount(Map, 0, 0, Inset, Size) == 0; },
+             [=](const TileMap& Map) { return Map.IsRegionEmpty(0, 0, 0, Inset, Size); });
+
+    return 0;
+}